@@ -47,7 +47,9 @@ const int P_INIT_PRESSURE = 1;           // Initial polynomial degree for pressu
                                          // P_INIT_PRESSURE because of the inf-sup condition
 
 // Adaptivity
-const int UNREF_FREQ = 1;        // Every UNREF_FREQth time step the mesh is unrefined.
+const int UNREF_FREQ = 1;        // Every UNREF_FREQth time step the mesh is coarsened.
+const double COARSEN_THRESHOLD = 0.01; // Relative error which one coarsening of the meshes may add
+                                 // (see Adapt::coarsen()).
 const double THRESHOLD = 0.3;    // This is a quantitative parameter of the adapt(...) function and
                                  // it has different meanings for various adaptive strategies (see below).
 const int STRATEGY = 1;          // Adaptive strategy:
@@ -258,33 +260,32 @@ int main(int argc, char* argv[])
   int num_time_steps = (int)(T_FINAL / TAU + 0.5);
   for (int ts = 1; ts <= num_time_steps; ts++)
   {
-    // Periodic global derefinements.
+    // Periodic coarsening of the meshes. Instead of returning to the base mesh,
+    // only the parts where the solution is resolved with fewer DOFs are coarsened,
+    // so the meshes follow the moving features incrementally.
     if (ts > 1 && ts % UNREF_FREQ == 0) {
-      info("Global mesh derefinement.");
-      mesh.copy(&basemesh);
-      xvel_space.set_uniform_order(P_INIT_VEL);
-      yvel_space.set_uniform_order(P_INIT_VEL);
-      p_space.set_uniform_order(P_INIT_PRESSURE);
-
-      // Project fine mesh solution on the globally derefined meshes.
       info("---- Time step %d:", ts);
-      if (SOLVE_ON_COARSE_MESH) 
-        info("Projecting fine mesh solutions to obtain initial vector on globally derefined meshes.");
-      else 
-        info("Projecting fine mesh solutions on globally derefined meshes for error calculation.");
-      nls.project_global(Tuple<MeshFunction*>(&xvel_prev_newton, &yvel_prev_newton, &p_prev_newton),
+      info("Projecting fine mesh solutions on coarse meshes.");
+      nls.project_global(Tuple<MeshFunction*>(&xvel_fine, &yvel_fine, &p_fine),
                          Tuple<Solution*>(&xvel_prev_newton, &yvel_prev_newton, &p_prev_newton),
                          Tuple<int>(vel_proj_norm, vel_proj_norm, p_proj_norm));
 
+      // Coarsen the meshes, the solutions are transferred onto the new spaces.
+      H1Adapt hp(&nls);
+      hp.set_solutions(Tuple<Solution*>(&xvel_prev_newton, &yvel_prev_newton, &p_prev_newton),
+                       Tuple<Solution*>(&xvel_fine, &yvel_fine, &p_fine));
+      int num_changed = hp.coarsen(COARSEN_THRESHOLD, &basemesh);
+      info("Coarsened elements: %d, ndof_coarse: %d.", num_changed, nls.get_num_dofs());
+
       if (SOLVE_ON_COARSE_MESH) {
-        // Newton's loop on the globally derefined meshes.
-        info("Solving on globally derefined meshes.", ts);
+        // Newton's loop on the coarsened meshes.
+        info("Solving on coarsened meshes.");
         if (!nls.solve_newton(Tuple<Solution*>(&xvel_prev_newton, &yvel_prev_newton, &p_prev_newton), 
                               NEWTON_TOL_COARSE, NEWTON_MAX_ITER, verbose))
           error("Newton's method did not converge.");
       }
 
-      // Store the result on coarse meshes..
+      // Store the result on coarse meshes.
       xvel_coarse.copy(&xvel_prev_newton);
       yvel_coarse.copy(&yvel_prev_newton);
       p_coarse.copy(&p_prev_newton);
@@ -247,7 +247,7 @@ int main(int argc, char* argv[])
       // Set initial condition for the Newton's method on the fine mesh.
       if (as == 1) {
         info("Projecting coarse mesh solution to obtain initial vector on new fine mesh.");
-        rnls.project_global(&sln_coarse, &u_prev_newton);
+        rnls.prolong(&sln_coarse, &u_prev_newton);
       }
       else {
         info("Projecting previous fine mesh solution to obtain initial vector on new fine mesh.");
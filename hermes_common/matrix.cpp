@@ -4,6 +4,9 @@
 // Email: hermes1d@googlegroups.com, home page: http://hpfem.org/
 
 #include "matrix.h"
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
 
 // print vector - int
 void print_vector(const char *label, int *value, int size) {
@@ -522,6 +525,29 @@ CSRMatrix::CSRMatrix(Matrix *m) : Matrix()
         _error("Matrix type not supported.");
 }
 
+CSRMatrix::CSRMatrix(int size, int nnz, int *Ap, int *Ai, double *Ax) : Matrix()
+{
+    init();
+    this->size = size;
+    this->nnz = nnz;
+
+    this->Ap = Ap;
+    this->Ai = Ai;
+    this->Ax = Ax;
+}
+
+CSRMatrix::CSRMatrix(int size, int nnz, int *Ap, int *Ai, cplx *Ax_cplx) : Matrix()
+{
+    init();
+    this->size = size;
+    this->nnz = nnz;
+    this->complex = true;
+
+    this->Ap = Ap;
+    this->Ai = Ai;
+    this->Ax_cplx = Ax_cplx;
+}
+
 CSRMatrix::~CSRMatrix()
 {
     free_data();
@@ -537,10 +563,39 @@ void CSRMatrix::init()
     this->Ax_cplx = NULL;
     this->Ap = NULL;
     this->Ai = NULL;
+
+    this->map_addr = NULL;
+    this->map_len = 0;
+}
+
+void CSRMatrix::set_mapped_data(int size, int nnz, int *Ap, int *Ai, double *Ax, cplx *Ax_cplx,
+                                void *map_addr, size_t map_len)
+{
+    free_data();
+    this->size = size;
+    this->nnz = nnz;
+    this->complex = (Ax_cplx != NULL);
+    this->Ap = Ap;
+    this->Ai = Ai;
+    this->Ax = Ax;
+    this->Ax_cplx = Ax_cplx;
+    this->map_addr = map_addr;
+    this->map_len = map_len;
 }
 
 void CSRMatrix::free_data()
 {
+    if (this->map_addr)
+    {
+#ifndef _WIN32
+        munmap(this->map_addr, this->map_len);
+#endif
+        this->map_addr = NULL;
+        this->map_len = 0;
+        this->Ap = this->Ai = NULL;
+        this->Ax = NULL;
+        this->Ax_cplx = NULL;
+    }
     if (this->Ap) { delete[] this->Ap; this->Ap = NULL; }
     if (this->Ai) { delete[] this->Ai; this->Ai = NULL; }
     if (this->Ax) { delete[] this->Ax; this->Ax = NULL; }
@@ -710,6 +765,7 @@ CSCMatrix::CSCMatrix(Matrix *m) : Matrix()
 
 CSCMatrix::CSCMatrix(int size, int nnz, int *Ap, int *Ai, double *Ax)
 {
+    init();
     this->size = size;
     this->nnz = nnz;
     this->complex = false;
@@ -721,6 +777,7 @@ CSCMatrix::CSCMatrix(int size, int nnz, int *Ap, int *Ai, double *Ax)
 
 CSCMatrix::CSCMatrix(int size, int nnz, int *Ap, int *Ai, cplx *Ax_cplx)
 {
+    init();
     this->size = size;
     this->nnz = nnz;
     this->complex = true;
@@ -746,10 +803,39 @@ void CSCMatrix::init()
     this->Ax_cplx = NULL;
     this->Ap = NULL;
     this->Ai = NULL;
+
+    this->map_addr = NULL;
+    this->map_len = 0;
+}
+
+void CSCMatrix::set_mapped_data(int size, int nnz, int *Ap, int *Ai, double *Ax, cplx *Ax_cplx,
+                                void *map_addr, size_t map_len)
+{
+    free_data();
+    this->size = size;
+    this->nnz = nnz;
+    this->complex = (Ax_cplx != NULL);
+    this->Ap = Ap;
+    this->Ai = Ai;
+    this->Ax = Ax;
+    this->Ax_cplx = Ax_cplx;
+    this->map_addr = map_addr;
+    this->map_len = map_len;
 }
 
 void CSCMatrix::free_data()
 {
+    if (this->map_addr)
+    {
+#ifndef _WIN32
+        munmap(this->map_addr, this->map_len);
+#endif
+        this->map_addr = NULL;
+        this->map_len = 0;
+        this->Ap = this->Ai = NULL;
+        this->Ax = NULL;
+        this->Ax_cplx = NULL;
+    }
     if (this->Ap) { delete[] this->Ap; this->Ap = NULL; }
     if (this->Ai) { delete[] this->Ai; this->Ai = NULL; }
     if (this->Ax) { delete[] this->Ax; this->Ax = NULL; }
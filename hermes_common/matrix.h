@@ -251,6 +251,10 @@ public:
 
     virtual void times_vector(double* vec, double* result, int rank);
 
+    // Read-only access to the entries (rows, then columns in ascending order).
+    inline const std::map<size_t, std::map<size_t, double> >& get_entries() const { return A; }
+    inline const std::map<size_t, std::map<size_t, cplx> >& get_entries_cplx() const { return A_cplx; }
+
 protected:
     std::map<size_t, std::map<size_t, double> > A;
     std::map<size_t, std::map<size_t, cplx> > A_cplx;
@@ -321,6 +325,9 @@ public:
     CSRMatrix(CooMatrix *m);
     CSRMatrix(CSCMatrix *m);
     CSRMatrix(DenseMatrix *m);
+    // The matrix takes ownership of the arrays (allocated by new[]).
+    CSRMatrix(int size, int nnz, int *Ap, int *Ai, double *Ax);
+    CSRMatrix(int size, int nnz, int *Ap, int *Ai, cplx *Ax_cplx);
     ~CSRMatrix();
 
     virtual void init();
@@ -361,6 +368,11 @@ public:
     inline double *get_Ax() { return this->Ax; }
     inline cplx *get_Ax_cplx() { return this->Ax_cplx; }
 
+    // Makes the arrays point into a memory mapped file region, which is
+    // unmapped instead of deleted in free_data() (see read_bin_csr()).
+    void set_mapped_data(int size, int nnz, int *Ap, int *Ai, double *Ax, cplx *Ax_cplx,
+                         void *map_addr, size_t map_len);
+
 private:
     // number of non-zeros
     int nnz;
@@ -369,6 +381,10 @@ private:
     int *Ai;
     double *Ax;
     cplx *Ax_cplx;
+
+    // memory mapped region holding Ap, Ai and Ax (NULL if the arrays are owned)
+    void *map_addr;
+    size_t map_len;
 };
 
 // **********************************************************************************************************
@@ -424,6 +440,11 @@ public:
     inline double *get_Ax() { return this->Ax; }
     inline cplx *get_Ax_cplx() { return this->Ax_cplx; }
 
+    // Makes the arrays point into a memory mapped file region, which is
+    // unmapped instead of deleted in free_data() (see read_bin_csc()).
+    void set_mapped_data(int size, int nnz, int *Ap, int *Ai, double *Ax, cplx *Ax_cplx,
+                         void *map_addr, size_t map_len);
+
 private:
     // number of non-zeros
     int nnz;
@@ -433,6 +454,10 @@ private:
 
     int *Ap;
     int *Ai;
+
+    // memory mapped region holding Ap, Ai and Ax (NULL if the arrays are owned)
+    void *map_addr;
+    size_t map_len;
 };
 
 template<typename T>
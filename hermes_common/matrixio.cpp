@@ -2,11 +2,25 @@
 // Distributed under the terms of the BSD license (see the LICENSE
 // file for the exact terms).
 // Email: hermes1d@googlegroups.com, home page: http://hpfem.org/
-// Harwell-Boeing format
 
 #include "matrixio.h"
 #include "iohb.h"
 
+#include <stdio.h>
+#include <ctype.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Harwell-Boeing format
+
 CSCMatrix *read_hb_csc(const char *filename)
 {
     int M, N, nnz, nrhs;
@@ -38,7 +52,6 @@ CSRMatrix *read_hb_csr(const char *filename)
 CooMatrix *read_hb_coo(const char *filename)
 {
     CSCMatrix *Acsc = read_hb_csc(filename);
-    Acsc->print();
     CooMatrix *Acoo = new CooMatrix(Acsc);
     delete Acsc;
 
@@ -74,6 +87,7 @@ void write_hb_csr(const char *filename, CSRMatrix *A, double *rhs)
     CSCMatrix *Acsc = new CSCMatrix(A);
 
     write_hb_csc(filename, Acsc, rhs);
+    delete Acsc;
 }
 
 void write_hb_coo(const char *filename, CooMatrix *A, double *rhs)
@@ -81,4 +95,633 @@ void write_hb_coo(const char *filename, CooMatrix *A, double *rhs)
     CSCMatrix *Acsc = new CSCMatrix(A);
 
     write_hb_csc(filename, Acsc, rhs);
+    delete Acsc;
+}
+
+// Matrix Market format
+
+enum { MM_GENERAL, MM_SYMMETRIC, MM_SKEW_SYMMETRIC, MM_HERMITIAN };
+
+struct MMHeader
+{
+    bool complex, pattern;
+    int symmetry;
+    int size, nnz;
+    long data_pos;
+};
+
+static void io_fail(FILE *f, const char *filename, const char *what)
+{
+    if (f != NULL) fclose(f);
+    std::string msg = std::string("File '") + filename + "': " + what;
+    _error(msg.c_str());
+}
+
+static void to_lower(char *s)
+{
+    for (; *s; s++) *s = tolower(*s);
+}
+
+static bool is_blank_or_comment(const char *line)
+{
+    while (isspace(*line)) line++;
+    return *line == '\0' || *line == '%';
+}
+
+static FILE *mm_open(const char *filename, MMHeader &h)
+{
+    FILE *f = fopen(filename, "r");
+    if (f == NULL) io_fail(NULL, filename, "cannot open file.");
+
+    char line[1024];
+    char banner[64], object[64], format[64], field[64], symmetry[64];
+    if (fgets(line, sizeof(line), f) == NULL ||
+        sscanf(line, "%63s %63s %63s %63s %63s", banner, object, format, field, symmetry) != 5 ||
+        strcmp(banner, "%%MatrixMarket") != 0)
+        io_fail(f, filename, "missing Matrix Market header.");
+    to_lower(object); to_lower(format); to_lower(field); to_lower(symmetry);
+
+    if (strcmp(object, "matrix") != 0 || strcmp(format, "coordinate") != 0)
+        io_fail(f, filename, "only sparse (coordinate) matrices are supported.");
+
+    h.complex = h.pattern = false;
+    if (!strcmp(field, "complex")) h.complex = true;
+    else if (!strcmp(field, "pattern")) h.pattern = true;
+    else if (strcmp(field, "real") != 0 && strcmp(field, "integer") != 0 && strcmp(field, "double") != 0)
+        io_fail(f, filename, "unknown field type.");
+
+    if (!strcmp(symmetry, "general")) h.symmetry = MM_GENERAL;
+    else if (!strcmp(symmetry, "symmetric")) h.symmetry = MM_SYMMETRIC;
+    else if (!strcmp(symmetry, "skew-symmetric")) h.symmetry = MM_SKEW_SYMMETRIC;
+    else if (!strcmp(symmetry, "hermitian")) h.symmetry = MM_HERMITIAN;
+    else io_fail(f, filename, "unknown symmetry type.");
+
+    do {
+        if (fgets(line, sizeof(line), f) == NULL)
+            io_fail(f, filename, "missing matrix size.");
+    } while (is_blank_or_comment(line));
+
+    int m, n, nnz;
+    if (sscanf(line, "%d %d %d", &m, &n, &nnz) != 3 || m < 0 || nnz < 0)
+        io_fail(f, filename, "invalid matrix size.");
+    if (m != n)
+        io_fail(f, filename, "the matrix is not square.");
+
+    h.size = n;
+    h.nnz = nnz;
+    h.data_pos = ftell(f);
+    return f;
+}
+
+// Reads the next entry (0-based indices); pattern entries are ones.
+static void mm_read_entry(FILE *f, const char *filename, const MMHeader &h, int &row, int &col, cplx &val)
+{
+    char line[256];
+    do {
+        if (fgets(line, sizeof(line), f) == NULL)
+            io_fail(f, filename, "unexpected end of file.");
+    } while (is_blank_or_comment(line));
+
+    char *p = line, *end;
+    row = strtol(p, &end, 10) - 1;
+    if (end == p) io_fail(f, filename, "invalid entry.");
+    p = end;
+    col = strtol(p, &end, 10) - 1;
+    if (end == p) io_fail(f, filename, "invalid entry.");
+    p = end;
+
+    double re = 1.0, im = 0.0;
+    if (!h.pattern)
+    {
+        re = strtod(p, &end);
+        if (end == p) io_fail(f, filename, "invalid entry.");
+        p = end;
+        if (h.complex)
+        {
+            im = strtod(p, &end);
+            if (end == p) io_fail(f, filename, "invalid entry.");
+        }
+    }
+    val = cplx(re, im);
+
+    if (row < 0 || row >= h.size || col < 0 || col >= h.size)
+        io_fail(f, filename, "entry index out of range.");
+}
+
+// Value of the entry (col, row) implied by the symmetry of the matrix.
+static cplx mm_mirror(const MMHeader &h, cplx val)
+{
+    if (h.symmetry == MM_SKEW_SYMMETRIC) return -val;
+    if (h.symmetry == MM_HERMITIAN) return std::conj(val);
+    return val;
+}
+
+template<typename T>
+struct CompareIndex
+{
+    bool operator()(const std::pair<int, T> &a, const std::pair<int, T> &b) const { return a.first < b.first; }
+};
+
+// Sorts the indices in each compressed row (column) and sums duplicate entries.
+// Returns the resulting number of non-zeros; Ap is updated in place.
+template<typename T>
+static int sort_and_merge(int size, int *Ap, int *Ai, T *Ax)
+{
+    std::vector<std::pair<int, T> > tmp;
+    int out = 0;
+    for (int i = 0; i < size; i++)
+    {
+        int start = Ap[i], end = Ap[i + 1];
+
+        bool sorted = true;
+        for (int k = start + 1; k < end && sorted; k++)
+            if (Ai[k] < Ai[k - 1]) sorted = false;
+        if (!sorted)
+        {
+            tmp.clear();
+            for (int k = start; k < end; k++)
+                tmp.push_back(std::make_pair(Ai[k], Ax[k]));
+            std::stable_sort(tmp.begin(), tmp.end(), CompareIndex<T>());
+            for (int k = start; k < end; k++)
+            {
+                Ai[k] = tmp[k - start].first;
+                Ax[k] = tmp[k - start].second;
+            }
+        }
+
+        Ap[i] = out;
+        for (int k = start; k < end; k++)
+        {
+            if (out > Ap[i] && Ai[out - 1] == Ai[k])
+                Ax[out - 1] += Ax[k];
+            else
+            {
+                Ai[out] = Ai[k];
+                Ax[out] = Ax[k];
+                out++;
+            }
+        }
+    }
+    Ap[size] = out;
+    return out;
+}
+
+// Reads the file into compressed rows (by_cols == false) or columns.
+static void mm_read_compressed(const char *filename, bool by_cols, int &size, int &nnz,
+                               int *&Ap, int *&Ai, double *&Ax, cplx *&Ax_cplx)
+{
+    MMHeader h;
+    FILE *f = mm_open(filename, h);
+    bool mirror = (h.symmetry != MM_GENERAL);
+    int row, col, k;
+    cplx val;
+
+    // first pass: count the entries in each row (column)
+    size = h.size;
+    Ap = new int[size + 1];
+    memset(Ap, 0, (size + 1) * sizeof(int));
+    for (k = 0; k < h.nnz; k++)
+    {
+        mm_read_entry(f, filename, h, row, col, val);
+        Ap[(by_cols ? col : row) + 1]++;
+        if (mirror && row != col) Ap[(by_cols ? row : col) + 1]++;
+    }
+    for (k = 0; k < size; k++)
+        Ap[k + 1] += Ap[k];
+
+    int total = Ap[size];
+    Ai = new int[total];
+    Ax = NULL;
+    Ax_cplx = NULL;
+    if (h.complex) Ax_cplx = new cplx[total];
+    else Ax = new double[total];
+
+    // second pass: fill the arrays
+    fseek(f, h.data_pos, SEEK_SET);
+    int *pos = new int[size];
+    memcpy(pos, Ap, size * sizeof(int));
+    for (k = 0; k < h.nnz; k++)
+    {
+        mm_read_entry(f, filename, h, row, col, val);
+        for (int m = 0; m < ((mirror && row != col) ? 2 : 1); m++)
+        {
+            int i = by_cols ? col : row, j = by_cols ? row : col;
+            int p = pos[i]++;
+            Ai[p] = j;
+            if (h.complex) Ax_cplx[p] = val;
+            else Ax[p] = val.real();
+            std::swap(row, col);
+            val = mm_mirror(h, val);
+        }
+    }
+    delete [] pos;
+    fclose(f);
+
+    if (h.complex) nnz = sort_and_merge(size, Ap, Ai, Ax_cplx);
+    else nnz = sort_and_merge(size, Ap, Ai, Ax);
+}
+
+CSRMatrix *read_mm_csr(const char *filename)
+{
+    int size, nnz, *Ap, *Ai;
+    double *Ax;
+    cplx *Ax_cplx;
+    mm_read_compressed(filename, false, size, nnz, Ap, Ai, Ax, Ax_cplx);
+    if (Ax_cplx != NULL) return new CSRMatrix(size, nnz, Ap, Ai, Ax_cplx);
+    return new CSRMatrix(size, nnz, Ap, Ai, Ax);
+}
+
+CSCMatrix *read_mm_csc(const char *filename)
+{
+    int size, nnz, *Ap, *Ai;
+    double *Ax;
+    cplx *Ax_cplx;
+    mm_read_compressed(filename, true, size, nnz, Ap, Ai, Ax, Ax_cplx);
+    if (Ax_cplx != NULL) return new CSCMatrix(size, nnz, Ap, Ai, Ax_cplx);
+    return new CSCMatrix(size, nnz, Ap, Ai, Ax);
+}
+
+CooMatrix *read_mm_coo(const char *filename)
+{
+    MMHeader h;
+    FILE *f = mm_open(filename, h);
+    CooMatrix *A = new CooMatrix(h.size, h.complex);
+    int row, col;
+    cplx val;
+    for (int k = 0; k < h.nnz; k++)
+    {
+        mm_read_entry(f, filename, h, row, col, val);
+        if (h.complex) A->add(row, col, val);
+        else A->add(row, col, val.real());
+        if (h.symmetry != MM_GENERAL && row != col)
+        {
+            if (h.complex) A->add(col, row, mm_mirror(h, val));
+            else A->add(col, row, mm_mirror(h, val).real());
+        }
+    }
+    fclose(f);
+    return A;
+}
+
+static FILE *mm_create(const char *filename, bool complex, int size, int nnz)
+{
+    FILE *f = fopen(filename, "w");
+    if (f == NULL) io_fail(NULL, filename, "cannot create file.");
+    fprintf(f, "%%%%MatrixMarket matrix coordinate %s general\n", complex ? "complex" : "real");
+    fprintf(f, "%d %d %d\n", size, size, nnz);
+    return f;
+}
+
+static void io_close(FILE *f, const char *filename)
+{
+    bool failed = ferror(f) != 0;
+    if (fclose(f) != 0 || failed) io_fail(NULL, filename, "write error.");
+}
+
+static inline void mm_write_entry(FILE *f, int row, int col, double val)
+{
+    fprintf(f, "%d %d %.17g\n", row + 1, col + 1, val);
+}
+
+static inline void mm_write_entry(FILE *f, int row, int col, cplx val)
+{
+    fprintf(f, "%d %d %.17g %.17g\n", row + 1, col + 1, val.real(), val.imag());
+}
+
+void write_mm_csr(const char *filename, CSRMatrix *A)
+{
+    int size = A->get_size(), *Ap = A->get_Ap(), *Ai = A->get_Ai();
+    FILE *f = mm_create(filename, A->is_complex(), size, A->get_nnz());
+    for (int i = 0; i < size; i++)
+        for (int k = Ap[i]; k < Ap[i + 1]; k++)
+        {
+            if (A->is_complex()) mm_write_entry(f, i, Ai[k], A->get_Ax_cplx()[k]);
+            else mm_write_entry(f, i, Ai[k], A->get_Ax()[k]);
+        }
+    io_close(f, filename);
+}
+
+void write_mm_csc(const char *filename, CSCMatrix *A)
+{
+    int size = A->get_size(), *Ap = A->get_Ap(), *Ai = A->get_Ai();
+    FILE *f = mm_create(filename, A->is_complex(), size, A->get_nnz());
+    for (int j = 0; j < size; j++)
+        for (int k = Ap[j]; k < Ap[j + 1]; k++)
+        {
+            if (A->is_complex()) mm_write_entry(f, Ai[k], j, A->get_Ax_cplx()[k]);
+            else mm_write_entry(f, Ai[k], j, A->get_Ax()[k]);
+        }
+    io_close(f, filename);
+}
+
+template<typename T>
+static void mm_write_entries(FILE *f, const std::map<size_t, std::map<size_t, T> > &entries)
+{
+    typename std::map<size_t, std::map<size_t, T> >::const_iterator it_row;
+    typename std::map<size_t, T>::const_iterator it_col;
+    for (it_row = entries.begin(); it_row != entries.end(); ++it_row)
+        for (it_col = it_row->second.begin(); it_col != it_row->second.end(); ++it_col)
+            mm_write_entry(f, it_row->first, it_col->first, it_col->second);
+}
+
+void write_mm_coo(const char *filename, CooMatrix *A)
+{
+    FILE *f = mm_create(filename, A->is_complex(), A->get_size(), A->get_nnz());
+    if (A->is_complex()) mm_write_entries(f, A->get_entries_cplx());
+    else mm_write_entries(f, A->get_entries());
+    io_close(f, filename);
+}
+
+// Binary format
+
+#define BIN_MAGIC       "H2DSPMAT"
+#define BIN_VERSION     1
+#define BIN_BYTE_ORDER  0x01020304
+#define BIN_COMPLEX     1
+#define BIN_CSC         2
+
+struct BinHeader
+{
+    char magic[8];
+    int byte_order;
+    int version;
+    int flags;
+    int size;
+    int nnz;
+    int reserved;
+};
+
+static size_t bin_ai_offset(const BinHeader &h)
+{
+    return sizeof(BinHeader) + (h.size + 1) * sizeof(int);
+}
+
+static size_t bin_ax_offset(const BinHeader &h)
+{
+    return (bin_ai_offset(h) + h.nnz * sizeof(int) + 7) & ~(size_t) 7;
+}
+
+static size_t bin_file_size(const BinHeader &h)
+{
+    return bin_ax_offset(h) + h.nnz * ((h.flags & BIN_COMPLEX) ? sizeof(cplx) : sizeof(double));
+}
+
+static FILE *bin_create(const char *filename, BinHeader &h, int flags, int size, int nnz)
+{
+    memcpy(h.magic, BIN_MAGIC, 8);
+    h.byte_order = BIN_BYTE_ORDER;
+    h.version = BIN_VERSION;
+    h.flags = flags;
+    h.size = size;
+    h.nnz = nnz;
+    h.reserved = 0;
+
+    FILE *f = fopen(filename, "wb");
+    if (f == NULL) io_fail(NULL, filename, "cannot create file.");
+    fwrite(&h, sizeof(BinHeader), 1, f);
+    return f;
+}
+
+// Writes zeros up to the beginning of Ax.
+static void bin_pad(FILE *f, const BinHeader &h)
+{
+    static const char zeros[8] = { 0 };
+    fwrite(zeros, 1, bin_ax_offset(h) - bin_ai_offset(h) - h.nnz * sizeof(int), f);
+}
+
+static void bin_write_compressed(const char *filename, int flags, int size, int nnz,
+                                 int *Ap, int *Ai, double *Ax, cplx *Ax_cplx)
+{
+    BinHeader h;
+    FILE *f = bin_create(filename, h, flags, size, nnz);
+    fwrite(Ap, sizeof(int), size + 1, f);
+    fwrite(Ai, sizeof(int), nnz, f);
+    bin_pad(f, h);
+    if (flags & BIN_COMPLEX) fwrite(Ax_cplx, sizeof(cplx), nnz, f);
+    else fwrite(Ax, sizeof(double), nnz, f);
+    io_close(f, filename);
+}
+
+void write_bin_csr(const char *filename, CSRMatrix *A)
+{
+    bin_write_compressed(filename, A->is_complex() ? BIN_COMPLEX : 0, A->get_size(), A->get_nnz(),
+                         A->get_Ap(), A->get_Ai(), A->get_Ax(), A->get_Ax_cplx());
+}
+
+void write_bin_csc(const char *filename, CSCMatrix *A)
+{
+    bin_write_compressed(filename, BIN_CSC | (A->is_complex() ? BIN_COMPLEX : 0), A->get_size(), A->get_nnz(),
+                         A->get_Ap(), A->get_Ai(), A->get_Ax(), A->get_Ax_cplx());
+}
+
+// Writes the entries of a CooMatrix as compressed rows, directly from its map.
+template<typename T>
+static void bin_write_entries(const char *filename, int flags, int size,
+                              const std::map<size_t, std::map<size_t, T> > &entries)
+{
+    typename std::map<size_t, std::map<size_t, T> >::const_iterator it_row;
+    typename std::map<size_t, T>::const_iterator it_col;
+
+    std::vector<int> Ap(size + 1, 0);
+    for (it_row = entries.begin(); it_row != entries.end(); ++it_row)
+        Ap[it_row->first + 1] = it_row->second.size();
+    for (int i = 0; i < size; i++)
+        Ap[i + 1] += Ap[i];
+
+    BinHeader h;
+    FILE *f = bin_create(filename, h, flags, size, Ap[size]);
+    fwrite(&Ap[0], sizeof(int), size + 1, f);
+    for (it_row = entries.begin(); it_row != entries.end(); ++it_row)
+        for (it_col = it_row->second.begin(); it_col != it_row->second.end(); ++it_col)
+        {
+            int col = it_col->first;
+            fwrite(&col, sizeof(int), 1, f);
+        }
+    bin_pad(f, h);
+    for (it_row = entries.begin(); it_row != entries.end(); ++it_row)
+        for (it_col = it_row->second.begin(); it_col != it_row->second.end(); ++it_col)
+            fwrite(&it_col->second, sizeof(T), 1, f);
+    io_close(f, filename);
+}
+
+void write_bin_coo(const char *filename, CooMatrix *A)
+{
+    if (A->is_complex()) bin_write_entries(filename, BIN_COMPLEX, A->get_size(), A->get_entries_cplx());
+    else bin_write_entries(filename, 0, A->get_size(), A->get_entries());
+}
+
+static FILE *bin_open(const char *filename, BinHeader &h)
+{
+    FILE *f = fopen(filename, "rb");
+    if (f == NULL) io_fail(NULL, filename, "cannot open file.");
+    if (fread(&h, sizeof(BinHeader), 1, f) != 1 || memcmp(h.magic, BIN_MAGIC, 8) != 0)
+        io_fail(f, filename, "not a binary matrix file.");
+    if (h.byte_order != BIN_BYTE_ORDER)
+        io_fail(f, filename, "the file was written on a machine with a different byte order.");
+    if (h.version != BIN_VERSION)
+        io_fail(f, filename, "unsupported version of the binary format.");
+    if (h.size < 0 || h.nnz < 0)
+        io_fail(f, filename, "invalid matrix size.");
+
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    if (len < 0 || (size_t) len < bin_file_size(h))
+        io_fail(f, filename, "the file is truncated.");
+    return f;
+}
+
+static void bin_read(FILE *f, const char *filename, void *ptr, size_t size, size_t n)
+{
+    if (fread(ptr, size, n, f) != n) io_fail(f, filename, "read error.");
+}
+
+// Reads the compressed arrays, either into new arrays or by mapping the file.
+// Returns the address of the mapping, or NULL.
+static void *bin_read_compressed(const char *filename, BinHeader &h, bool use_mmap,
+                                 int *&Ap, int *&Ai, double *&Ax, cplx *&Ax_cplx)
+{
+    FILE *f = bin_open(filename, h);
+    bool complex = (h.flags & BIN_COMPLEX) != 0;
+    Ax = NULL;
+    Ax_cplx = NULL;
+
+#ifndef _WIN32
+    if (use_mmap)
+    {
+        fclose(f);
+        int fd = open(filename, O_RDONLY);
+        if (fd < 0) io_fail(NULL, filename, "cannot open file.");
+        // private mapping: the matrix may be modified without touching the file
+        void *addr = mmap(NULL, bin_file_size(h), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (addr == MAP_FAILED) io_fail(NULL, filename, "mmap failed.");
+
+        char *base = (char *) addr;
+        Ap = (int *) (base + sizeof(BinHeader));
+        Ai = (int *) (base + bin_ai_offset(h));
+        if (complex) Ax_cplx = (cplx *) (base + bin_ax_offset(h));
+        else Ax = (double *) (base + bin_ax_offset(h));
+        return addr;
+    }
+#endif
+
+    Ap = new int[h.size + 1];
+    Ai = new int[h.nnz];
+    fseek(f, sizeof(BinHeader), SEEK_SET);
+    bin_read(f, filename, Ap, sizeof(int), h.size + 1);
+    bin_read(f, filename, Ai, sizeof(int), h.nnz);
+    fseek(f, bin_ax_offset(h), SEEK_SET);
+    if (complex)
+    {
+        Ax_cplx = new cplx[h.nnz];
+        bin_read(f, filename, Ax_cplx, sizeof(cplx), h.nnz);
+    }
+    else
+    {
+        Ax = new double[h.nnz];
+        bin_read(f, filename, Ax, sizeof(double), h.nnz);
+    }
+    fclose(f);
+    return NULL;
+}
+
+CSRMatrix *read_bin_csr(const char *filename, bool use_mmap)
+{
+    BinHeader h;
+    int *Ap, *Ai;
+    double *Ax;
+    cplx *Ax_cplx;
+
+    {
+        FILE *f = bin_open(filename, h);
+        fclose(f);
+    }
+    if (h.flags & BIN_CSC)
+    {
+        CSCMatrix *Acsc = read_bin_csc(filename);
+        CSRMatrix *Acsr = new CSRMatrix(Acsc);
+        delete Acsc;
+        return Acsr;
+    }
+
+    void *addr = bin_read_compressed(filename, h, use_mmap, Ap, Ai, Ax, Ax_cplx);
+    if (addr != NULL)
+    {
+        CSRMatrix *A = new CSRMatrix(h.size);
+        A->set_mapped_data(h.size, h.nnz, Ap, Ai, Ax, Ax_cplx, addr, bin_file_size(h));
+        return A;
+    }
+    if (Ax_cplx != NULL) return new CSRMatrix(h.size, h.nnz, Ap, Ai, Ax_cplx);
+    return new CSRMatrix(h.size, h.nnz, Ap, Ai, Ax);
+}
+
+CSCMatrix *read_bin_csc(const char *filename, bool use_mmap)
+{
+    BinHeader h;
+    int *Ap, *Ai;
+    double *Ax;
+    cplx *Ax_cplx;
+
+    {
+        FILE *f = bin_open(filename, h);
+        fclose(f);
+    }
+    if (!(h.flags & BIN_CSC))
+    {
+        CSRMatrix *Acsr = read_bin_csr(filename);
+        CSCMatrix *Acsc = new CSCMatrix(Acsr);
+        delete Acsr;
+        return Acsc;
+    }
+
+    void *addr = bin_read_compressed(filename, h, use_mmap, Ap, Ai, Ax, Ax_cplx);
+    if (addr != NULL)
+    {
+        CSCMatrix *A = new CSCMatrix(h.size);
+        A->set_mapped_data(h.size, h.nnz, Ap, Ai, Ax, Ax_cplx, addr, bin_file_size(h));
+        return A;
+    }
+    if (Ax_cplx != NULL) return new CSCMatrix(h.size, h.nnz, Ap, Ai, Ax_cplx);
+    return new CSCMatrix(h.size, h.nnz, Ap, Ai, Ax);
+}
+
+// Streams the file into a CooMatrix, reading the indices and the values
+// through two file positions at once.
+CooMatrix *read_bin_coo(const char *filename)
+{
+    BinHeader h;
+    FILE *fi = bin_open(filename, h);
+    bool complex = (h.flags & BIN_COMPLEX) != 0, by_cols = (h.flags & BIN_CSC) != 0;
+
+    FILE *fx = fopen(filename, "rb");
+    if (fx == NULL) io_fail(fi, filename, "cannot open file.");
+    fseek(fx, bin_ax_offset(h), SEEK_SET);
+
+    std::vector<int> Ap(h.size + 1);
+    fseek(fi, sizeof(BinHeader), SEEK_SET);
+    bin_read(fi, filename, &Ap[0], sizeof(int), h.size + 1);
+
+    CooMatrix *A = new CooMatrix(h.size, complex);
+    for (int i = 0; i < h.size; i++)
+        for (int k = Ap[i]; k < Ap[i + 1]; k++)
+        {
+            int j;
+            bin_read(fi, filename, &j, sizeof(int), 1);
+            int row = by_cols ? j : i, col = by_cols ? i : j;
+            if (complex)
+            {
+                cplx v;
+                bin_read(fx, filename, &v, sizeof(cplx), 1);
+                A->add(row, col, v);
+            }
+            else
+            {
+                double v;
+                bin_read(fx, filename, &v, sizeof(double), 1);
+                A->add(row, col, v);
+            }
+        }
+    fclose(fi);
+    fclose(fx);
+    return A;
 }
@@ -14,3 +14,24 @@ void write_hb_csr(const char *filename, CSRMatrix *A, double *rhs);
 void write_hb_coo(const char *filename, CooMatrix *A, double *rhs);
 
 double *read_rhs(const char *filename, int j = 0);
+
+// Matrix Market coordinate format (real, integer, pattern or complex entries,
+// general, symmetric, skew-symmetric or hermitian). The readers make two passes
+// over the file and fill the compressed arrays directly; duplicate entries are summed.
+CSRMatrix *read_mm_csr(const char *filename);
+CSCMatrix *read_mm_csc(const char *filename);
+CooMatrix *read_mm_coo(const char *filename);
+void write_mm_csr(const char *filename, CSRMatrix *A);
+void write_mm_csc(const char *filename, CSCMatrix *A);
+void write_mm_coo(const char *filename, CooMatrix *A);
+
+// Binary compressed format: a 32-byte header followed by the arrays Ap, Ai and Ax
+// in the native byte order, Ax aligned to 8 bytes. With use_mmap, the arrays of the
+// returned matrix point directly into a private mapping of the file.
+// CooMatrix is stored row-compressed.
+CSRMatrix *read_bin_csr(const char *filename, bool use_mmap = false);
+CSCMatrix *read_bin_csc(const char *filename, bool use_mmap = false);
+CooMatrix *read_bin_coo(const char *filename);
+void write_bin_csr(const char *filename, CSRMatrix *A);
+void write_bin_csc(const char *filename, CSCMatrix *A);
+void write_bin_coo(const char *filename, CooMatrix *A);
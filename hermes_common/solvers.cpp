@@ -17,51 +17,60 @@ bool CommonSolver::solve(Matrix *mat, Vector *res)
 // Standard CG method starting from zero vector
 // (because we solve for the increment)
 // x... comes as right-hand side, leaves as solution
+// With a preconditioner M, z = M^{-1} r is used for the search directions.
 bool CommonSolverCG::_solve(Matrix* A, double *x, double tol, int maxiter)
 {
-    printf("CG solver\n");
+    if (precond == NULL) printf("CG solver\n");
+    else printf("PCG solver\n");
 
     int n_dof = A->get_size();
     double *r = new double[n_dof];
     double *p = new double[n_dof];
+    double *z = (precond != NULL) ? new double[n_dof] : r;
     double *help_vec = new double[n_dof];
-    if (r == NULL || p == NULL || help_vec == NULL) {
+    if (r == NULL || p == NULL || z == NULL || help_vec == NULL) {
         _error("a vector could not be allocated in solve_linear_system_iter().");
     }
     // r = b - A*x0  (where b is x and x0 = 0)
     for (int i=0; i < n_dof; i++) r[i] = x[i];
-    // p = r
-    for (int i=0; i < n_dof; i++) p[i] = r[i];
+    // z = M^{-1} r
+    if (precond != NULL) precond->apply(r, z);
+    // p = z
+    for (int i=0; i < n_dof; i++) p[i] = z[i];
 
     // setting initial condition x = 0
     for (int i=0; i < n_dof; i++) x[i] = 0;
 
     // CG iteration
     int iter_current = 0;
-    double tol_current;
-    while (1)
+    double tol_current = sqrt(vec_dot(r, r, n_dof));
+    double r_times_z = vec_dot(r, z, n_dof);
+    while (tol_current >= tol && iter_current < maxiter)
     {
         mat_dot(A, p, help_vec, n_dof);
-        double r_times_r = vec_dot(r, r, n_dof);
-        double alpha = r_times_r / vec_dot(p, help_vec, n_dof);
+        double alpha = r_times_z / vec_dot(p, help_vec, n_dof);
         for (int i=0; i < n_dof; i++) {
             x[i] += alpha*p[i];
             r[i] -= alpha*help_vec[i];
         }
-        double r_times_r_new = vec_dot(r, r, n_dof);
         iter_current++;
-        tol_current = sqrt(r_times_r_new);
+        tol_current = sqrt(vec_dot(r, r, n_dof));
         if (tol_current < tol
             || iter_current >= maxiter) break;
-        double beta = r_times_r_new/r_times_r;
-        for (int i=0; i < n_dof; i++) p[i] = r[i] + beta*p[i];
+        if (precond != NULL) precond->apply(r, z);
+        double r_times_z_new = vec_dot(r, z, n_dof);
+        double beta = r_times_z_new/r_times_z;
+        r_times_z = r_times_z_new;
+        for (int i=0; i < n_dof; i++) p[i] = z[i] + beta*p[i];
     }
+    num_iters = iter_current;
     bool flag;
     if (tol_current <= tol)
         flag = true;
     else
         flag = false;
 
+    if (z != r) delete [] z;
     if (r != NULL) delete [] r;
     if (p != NULL) delete [] p;
     if (help_vec != NULL) delete [] help_vec;
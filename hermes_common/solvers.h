@@ -22,18 +22,36 @@ private:
     char *log;
 };
 
-// c++ cg
+// abstract preconditioner for the c++ iterative solvers
+class CommonPrecond
+{
+public:
+    virtual ~CommonPrecond() {}
+    // z = M^{-1} r
+    virtual void apply(double *r, double *z) = 0;
+};
+
+// c++ cg, preconditioned if a preconditioner is set
 class CommonSolverCG : public CommonSolver
 {
 public:
+    CommonSolverCG() { precond = NULL; num_iters = 0; }
+
     bool _solve(Matrix *mat, double *res)
     {
-        _solve(mat, res, 1e-6, 1000);
+        return _solve(mat, res, 1e-6, 1000);
     }
     bool _solve(Matrix *mat, double *res,
                double tol,
                int maxiter);
     bool _solve(Matrix *mat, cplx *res);
+    inline void set_precond(CommonPrecond *precond) { this->precond = precond; }
+    // number of iterations of the last solve
+    inline int get_num_iters() { return this->num_iters; }
+
+private:
+    CommonPrecond *precond;
+    int num_iters;
 };
 inline bool solve_linear_system_cg(Matrix *mat, double *res,
                                    double tolerance,
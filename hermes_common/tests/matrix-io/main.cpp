@@ -1,5 +1,6 @@
 #include <iostream>
 #include <stdexcept>
+#include <unistd.h>
 
 #include "matrix.h"
 #include "matrixio.h"
@@ -59,6 +60,121 @@ void test_matrix_hb()
     Acsrr->print();
     remove("/tmp/csr.rua");
 }
+
+// compares the compressed arrays of two CSR (or CSC) matrices
+template<typename M>
+void compare_compressed(M *A, M *B)
+{
+    _assert(A->get_size() == B->get_size());
+    _assert(A->get_nnz() == B->get_nnz());
+    _assert(A->is_complex() == B->is_complex());
+    int n = A->get_size(), nnz = A->get_nnz();
+    _assert(memcmp(A->get_Ap(), B->get_Ap(), (n + 1) * sizeof(int)) == 0);
+    _assert(memcmp(A->get_Ai(), B->get_Ai(), nnz * sizeof(int)) == 0);
+    if (A->is_complex())
+        _assert(memcmp(A->get_Ax_cplx(), B->get_Ax_cplx(), nnz * sizeof(cplx)) == 0);
+    else
+        _assert(memcmp(A->get_Ax(), B->get_Ax(), nnz * sizeof(double)) == 0);
+}
+
+void compare_coo(CooMatrix *A, CooMatrix *B)
+{
+    CSRMatrix Acsr(A), Bcsr(B);
+    compare_compressed(&Acsr, &Bcsr);
+}
+
+void test_matrix_mm_bin()
+{
+    // tridiagonal matrix with values that are not exact in decimal
+    int n = 50;
+    CooMatrix Acoo(n);
+    CooMatrix Ccoo(n, true);
+    for (int i = 0; i < n; i++)
+    {
+        Acoo.add(i, i, 2.0 + 1.0 / (i + 3));
+        Ccoo.add(i, i, cplx(2.0, 1.0 / (i + 3)));
+        if (i > 0)
+        {
+            Acoo.add(i, i - 1, -1.0 / 3.0);
+            Ccoo.add(i, i - 1, cplx(-1.0 / 3.0, 0.1));
+        }
+        if (i < n - 1)
+        {
+            Acoo.add(i, i + 1, -1.0 / 7.0);
+            Ccoo.add(i, i + 1, cplx(0.7, -1.0 / 7.0));
+        }
+    }
+    CSRMatrix Acsr(&Acoo), Ccsr(&Ccoo);
+    CSCMatrix Acsc(&Acoo), Ccsc(&Ccoo);
+
+    // Matrix Market
+    write_mm_csr("/tmp/csr.mtx", &Acsr);
+    CSRMatrix *Acsrr = read_mm_csr("/tmp/csr.mtx");
+    compare_compressed(&Acsr, Acsrr);
+    CSCMatrix *Acscr = read_mm_csc("/tmp/csr.mtx");
+    compare_compressed(&Acsc, Acscr);
+    delete Acsrr;
+    delete Acscr;
+
+    write_mm_csc("/tmp/csc.mtx", &Ccsc);
+    CSRMatrix *Ccsrr = read_mm_csr("/tmp/csc.mtx");
+    compare_compressed(&Ccsr, Ccsrr);
+    delete Ccsrr;
+
+    write_mm_coo("/tmp/coo.mtx", &Acoo);
+    CooMatrix *Acoor = read_mm_coo("/tmp/coo.mtx");
+    compare_coo(&Acoo, Acoor);
+    delete Acoor;
+    remove("/tmp/csr.mtx");
+    remove("/tmp/csc.mtx");
+    remove("/tmp/coo.mtx");
+
+    // symmetric storage and duplicate entries
+    FILE *f = fopen("/tmp/sym.mtx", "w");
+    fprintf(f, "%%%%MatrixMarket matrix coordinate real symmetric\n%% comment\n3 3 5\n");
+    fprintf(f, "3 1 4.0\n1 1 1.0\n2 1 2.0\n2 2 3.0\n1 1 0.5\n");
+    fclose(f);
+    CSRMatrix *S = read_mm_csr("/tmp/sym.mtx");
+    remove("/tmp/sym.mtx");
+    int Sp[] = { 0, 3, 5, 6 };
+    int Si[] = { 0, 1, 2, 0, 1, 0 };
+    double Sx[] = { 1.5, 2.0, 4.0, 2.0, 3.0, 4.0 };
+    _assert(S->get_nnz() == 6);
+    _assert(memcmp(S->get_Ap(), Sp, sizeof(Sp)) == 0);
+    _assert(memcmp(S->get_Ai(), Si, sizeof(Si)) == 0);
+    _assert(memcmp(S->get_Ax(), Sx, sizeof(Sx)) == 0);
+    delete S;
+
+    // binary, with and without mmap
+    for (int m = 0; m < 2; m++)
+    {
+        bool use_mmap = (m == 1);
+        write_bin_csr("/tmp/csr.bin", &Acsr);
+        Acsrr = read_bin_csr("/tmp/csr.bin", use_mmap);
+        compare_compressed(&Acsr, Acsrr);
+        Acscr = read_bin_csc("/tmp/csr.bin", use_mmap);
+        compare_compressed(&Acsc, Acscr);
+        delete Acsrr;
+        delete Acscr;
+
+        write_bin_csc("/tmp/csc.bin", &Ccsc);
+        CSCMatrix *Ccscr = read_bin_csc("/tmp/csc.bin", use_mmap);
+        compare_compressed(&Ccsc, Ccscr);
+        delete Ccscr;
+
+        write_bin_coo("/tmp/coo.bin", &Ccoo);
+        Ccsrr = read_bin_csr("/tmp/coo.bin", use_mmap);
+        compare_compressed(&Ccsr, Ccsrr);
+        delete Ccsrr;
+        CooMatrix *Ccoor = read_bin_coo("/tmp/coo.bin");
+        compare_coo(&Ccoo, Ccoor);
+        delete Ccoor;
+    }
+    remove("/tmp/csr.bin");
+    remove("/tmp/csc.bin");
+    remove("/tmp/coo.bin");
+}
+
 int main(int argc, char* argv[])
 {
     long size;
@@ -74,6 +190,7 @@ int main(int argc, char* argv[])
 
     try {
         test_matrix_hb();
+        test_matrix_mm_bin();
 
         return ERROR_SUCCESS;
     } catch(std::exception const &ex) {
@@ -70,8 +70,7 @@ bool CommonSolverUmfpack::_solve(Matrix *mat, double *res)
 
     umfpack_di_free_symbolic(&symbolic);
 
-    double *x;
-    x = (double*) malloc(size * sizeof(double));
+    double *x = new double[size];
 
     /* solve system */
     int status_solve = umfpack_di_solve(UMFPACK_A,
@@ -90,6 +89,7 @@ bool CommonSolverUmfpack::_solve(Matrix *mat, double *res)
 
     if (!dynamic_cast<CSCMatrix*>(mat))
         delete Acsc;
+    return true;
 }
 
 bool CommonSolverUmfpack::_solve(Matrix *mat, cplx *res)
@@ -110,7 +110,7 @@ bool CommonSolverUmfpack::_solve(Matrix *mat, cplx *res)
     int nnz = Acsc->get_nnz();
     int size = Acsc->get_size();
 
-    // complex components
+    // UMFPACK works with split (zi) storage: real and imaginary parts in separate arrays
     double *Axr = new double[nnz];
     double *Axi = new double[nnz];
     cplx *Ax = Acsc->get_Ax_cplx();
@@ -125,7 +125,7 @@ bool CommonSolverUmfpack::_solve(Matrix *mat, cplx *res)
     /* symbolic analysis */
     void *symbolic, *numeric;
     int status_symbolic = umfpack_zi_symbolic(size, size,
-                                              Acsc->get_Ap(), Acsc->get_Ai(), NULL, NULL, &symbolic,
+                                              Acsc->get_Ap(), Acsc->get_Ai(), Axr, Axi, &symbolic,
                                               control_array, info_array);
     print_status(status_symbolic);
 
@@ -136,44 +136,34 @@ bool CommonSolverUmfpack::_solve(Matrix *mat, cplx *res)
 
     umfpack_zi_free_symbolic(&symbolic);
 
-    double *xr, *xi;
-    xr = (double*) malloc(size * sizeof(double));
-    xi = (double*) malloc(size * sizeof(double));
-
-    double *resr = new double[size];
-    double *resi = new double[size];
-
+    // the right-hand side and the solution share one buffer: [xr | xi | br | bi]
+    double *buf = new double[4 * size];
+    double *xr = buf, *xi = buf + size, *br = buf + 2 * size, *bi = buf + 3 * size;
     for (int i = 0; i < size; i++)
     {
-        resr[i] = res[i].real();
-        resi[i] = res[i].imag();
+        br[i] = res[i].real();
+        bi[i] = res[i].imag();
     }
 
     /* solve system */
     int status_solve = umfpack_zi_solve(UMFPACK_A,
-                                        Acsc->get_Ap(), Acsc->get_Ai(), Axr, Axi, xr, xi, resr, resi, numeric,
+                                        Acsc->get_Ap(), Acsc->get_Ai(), Axr, Axi, xr, xi, br, bi, numeric,
                                         control_array, info_array);
 
     print_status(status_solve);
 
     umfpack_zi_free_numeric(&numeric);
 
-    delete[] resr;
-    delete[] resi;
-    delete[] Axr;
-    delete[] Axi;
-
-    if (symbolic) umfpack_di_free_symbolic(&symbolic);
-    if (numeric) umfpack_di_free_numeric(&numeric);
-
-    for (int i = 0; i < Acsc->get_size(); i++)
+    for (int i = 0; i < size; i++)
         res[i] = cplx(xr[i], xi[i]);
 
-    delete xr;
-    delete xi;
+    delete[] buf;
+    delete[] Axr;
+    delete[] Axi;
 
     if (!dynamic_cast<CSCMatrix*>(mat))
         delete Acsc;
+    return true;
 }
 
 #else
@@ -261,12 +261,17 @@ cdef extern from "hermes2d.h":
     c_SquareFilter *new_SquareFilter "new SquareFilter" (c_MeshFunction *sln1,
             int item1)
 
+    ctypedef int c_SymFlag "SymFlag"
+
     cdef struct c_WeakForm "WeakForm":
         void add_matrix_form(int i, int j, ...)
         void add_matrix_form_surf(int i, int j, ...)
         void add_vector_form(int i, ...)
         void add_vector_form_data(int i, void *data)
         void add_vector_form_surf(int i, ...)
+        void add_matrix_form_text "add_matrix_form" (int i, int j, char *text, c_SymFlag sym, int area)
+        void add_vector_form_text "add_vector_form" (int i, char *text, int area)
+        void set_constant(char *name, double value)
     c_WeakForm *new_WeakForm "new WeakForm" (int neq)
 
     cdef struct c_CommonSolver "CommonSolver":
@@ -1114,6 +1114,28 @@ cdef class WeakForm:
     def __dealloc__(self):
         delete(self.thisptr)
 
+    def add_matrix_form(self, int i, int j, char *text, int sym=H2D_UNSYM,
+            int area=H2D_ANY):
+        """
+        Adds a matrix form given as text, e.g. "vol u,v: ux*vx + uy*vy".
+
+        The form is compiled to bytecode and its integration order is derived
+        from the expression, so no callbacks are needed.
+        """
+        self.thisptr.add_matrix_form_text(i, j, text, <c_SymFlag>sym, area)
+
+    def add_vector_form(self, int i, char *text, int area=H2D_ANY):
+        """
+        Adds a vector form given as text, e.g. "vol v: 2*v".
+        """
+        self.thisptr.add_vector_form_text(i, text, area)
+
+    def set_constant(self, char *name, double value):
+        """
+        Defines a named constant used in the forms given as text.
+        """
+        self.thisptr.set_constant(name, value)
+
 cdef class DummySolver(CommonSolver):
 
     def __cinit__(self):
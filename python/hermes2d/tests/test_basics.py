@@ -40,6 +40,26 @@ def test_matrix():
     A = sys.get_matrix()
     #dp.solve_system(sln)
 
+def test_text_forms():
+    set_verbose(False)
+
+    mesh = Mesh()
+    mesh.load(domain_mesh)
+    mesh.refine_element(0)
+
+    space = H1Space(mesh, 1)
+
+    # the forms are given as text, no callbacks are needed
+    wf = WeakForm(1)
+    wf.set_constant("k", 2.0)
+    wf.add_matrix_form(0, 0, "vol u,v: ux*vx + uy*vy")
+    wf.add_vector_form(0, "vol v: k*v")
+
+    sys = LinSystem(wf)
+    sys.set_spaces(space)
+    sys.assemble()
+    A = sys.get_matrix()
+
 def test_fe_solutions():
     mesh = Mesh()
     mesh.load(domain_mesh)
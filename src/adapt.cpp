@@ -24,6 +24,7 @@
 #include "norm.h"
 #include "element_to_refine.h"
 #include "ref_selectors/selector.h"
+#include "precalc.h"
 #include "adapt.h"
 
 using namespace std;
@@ -300,7 +301,7 @@ void Adapt::fix_shared_mesh_refinements(Mesh** meshes, std::vector<ElementToRefi
 void Adapt::homogenize_shared_mesh_orders(Mesh** meshes) {
   Element* e;
   for (int i = 0; i < num_comps; i++) {
-    for_all_active_elements(e, meshes[i]) {
+    for_all_active_elements_fast(e, meshes[i]) {
       int current_quad_order = this->ls->spaces[i]->get_element_order(e->id);
       int current_order_h = H2D_GET_H_ORDER(current_quad_order), current_order_v = H2D_GET_V_ORDER(current_quad_order);
 
@@ -402,7 +403,7 @@ void Adapt::unrefine(double thr)
         }
       }
     }
-    for_all_active_elements(e, mesh[0])
+    for_all_active_elements_fast(e, mesh[0])
     {
       for (int i = 0; i < 2; i++)
         if (errors_squared[i][e->id] < thr/4 * errors_squared[regular_queue[0].comp][regular_queue[0].id])
@@ -446,7 +447,7 @@ void Adapt::unrefine(double thr)
           }
         }
       }
-      for_all_active_elements(e, mesh[m])
+      for_all_active_elements_fast(e, mesh[m])
       {
         if (errors_squared[m][e->id] < thr/4 * errors_squared[regular_queue[0].comp][regular_queue[0].id])
         {
@@ -461,6 +462,358 @@ void Adapt::unrefine(double thr)
   have_errors = false;
 }
 
+///// Coarsening ////////////////////////////////////////////////////////////////////////////////////
+
+// Inner product of two functions in the norm used by Adapt::coarsen(): 0 = L2, 1 = H1, 2 = Hcurl.
+// The first function is a real shape function, so no conjugation is needed.
+template<typename T>
+static T coarsen_product(int norm, int n, double* jwt, Func<double>* u, Func<T>* v)
+{
+  T result = 0;
+  if (u->nc == 1)
+  {
+    for (int i = 0; i < n; i++)
+      result += jwt[i] * (u->val[i] * v->val[i]);
+    if (norm == 1)
+      for (int i = 0; i < n; i++)
+        result += jwt[i] * (u->dx[i] * v->dx[i] + u->dy[i] * v->dy[i]);
+  }
+  else
+  {
+    for (int i = 0; i < n; i++)
+      result += jwt[i] * (u->val0[i] * v->val0[i] + u->val1[i] * v->val1[i]);
+    if (norm == 2)
+      for (int i = 0; i < n; i++)
+        result += jwt[i] * (u->curl[i] * v->curl[i]);
+  }
+  return result;
+}
+
+// Squared norm of a function in the norm used by Adapt::coarsen().
+static double coarsen_norm_squared(int norm, int n, double* jwt, Func<scalar>* u)
+{
+  double result = 0.0;
+  if (u->nc == 1)
+  {
+    for (int i = 0; i < n; i++)
+      result += jwt[i] * sqr(u->val[i]);
+    if (norm == 1)
+      for (int i = 0; i < n; i++)
+        result += jwt[i] * (sqr(u->dx[i]) + sqr(u->dy[i]));
+  }
+  else
+  {
+    for (int i = 0; i < n; i++)
+      result += jwt[i] * (sqr(u->val0[i]) + sqr(u->val1[i]));
+    if (norm == 2)
+      for (int i = 0; i < n; i++)
+        result += jwt[i] * sqr(u->curl[i]);
+  }
+  return result;
+}
+
+// Subtracts a multiple of a shape function from a function.
+static void coarsen_subtract(Func<scalar>* u, scalar coef, Func<double>* phi, int n)
+{
+  if (u->nc == 1)
+  {
+    for (int i = 0; i < n; i++)
+    {
+      u->val[i] -= coef * phi->val[i];
+      u->dx[i] -= coef * phi->dx[i];
+      u->dy[i] -= coef * phi->dy[i];
+    }
+  }
+  else
+  {
+    for (int i = 0; i < n; i++)
+    {
+      u->val0[i] -= coef * phi->val0[i];
+      u->val1[i] -= coef * phi->val1[i];
+      u->curl[i] -= coef * phi->curl[i];
+    }
+  }
+}
+
+// Returns the order lowered by one in each direction, but not below one.
+static int coarsen_lower_order(Element* e, int order)
+{
+  if (e->is_triangle())
+    return std::max(order - 1, 1);
+  return H2D_MAKE_QUAD_ORDER(std::max(H2D_GET_H_ORDER(order) - 1, 1), std::max(H2D_GET_V_ORDER(order) - 1, 1));
+}
+
+double Adapt::eval_coarsening_error(int comp, Element* e, int order, int norm, double& norm_squared)
+{
+  Space* space = this->ls->spaces[comp];
+  Shapeset* ss = space->get_shapeset();
+  Solution* u = sln[comp];
+  Mesh* umesh = u->get_mesh();
+  int type = space->get_type();
+  ss->set_mode(e->get_mode());
+  update_limit_table(e->get_mode());
+
+  // shape functions which span the polynomials of the given order on e
+  std::vector<int> shapes;
+  int order_h = H2D_GET_H_ORDER(order), order_v = H2D_GET_V_ORDER(order);
+  if (type == 0)
+    for (unsigned int j = 0; j < e->nvert; j++)
+      shapes.push_back(ss->get_vertex_index(j));
+  if (type != 3)
+    for (unsigned int j = 0; j < e->nvert; j++)
+    {
+      int eo = (e->is_triangle() || !(j & 1)) ? order_h : order_v;
+      for (int k = (type == 0) ? 2 : 0; k <= eo; k++)
+        shapes.push_back(ss->get_edge_index(j, 0, k));
+    }
+  int* bubbles = ss->get_bubble_indices(order);
+  shapes.insert(shapes.end(), bubbles, bubbles + ss->get_num_bubbles(order));
+  int n = shapes.size();
+
+  // the solution is integrated over the sons of e, which are sub-elements of e
+  Element* parts[H2D_MAX_ELEMENT_SONS];
+  int trfs[H2D_MAX_ELEMENT_SONS];
+  int num_parts = 0;
+  if (e->active) {
+    parts[0] = e;
+    trfs[0] = -1;
+    num_parts = 1;
+  }
+  else {
+    bool aniso = e->is_quad() && (e->sons[0] == NULL || e->sons[2] == NULL);
+    for (int s = 0; s < H2D_MAX_ELEMENT_SONS; s++)
+      if (e->sons[s] != NULL) {
+        parts[num_parts] = e->sons[s];
+        trfs[num_parts++] = aniso ? s + 4 : s; // halves of a quad are the transformations 4 to 7
+      }
+  }
+
+  Quad2D* quad = &g_quad_2d_std;
+  PrecalcShapeset fu(ss);
+  fu.set_quad_2d(quad);
+  RefMap rm;
+  rm.set_quad_2d(quad);
+
+  double** mat = new_matrix<double>(n, n);
+  double* diag = new double[n];
+  scalar* coef = new scalar[n];
+  for (int k = 0; k < n; k++) coef[k] = 0.0;
+  Func<double>** phi = new Func<double>*[n];
+  double error_squared = 0.0;
+  norm_squared = 0.0;
+
+  // the first pass assembles the projection, the second one evaluates its error
+  for (int pass = 0; pass < 2; pass++)
+  {
+    for (int s = 0; s < num_parts; s++)
+    {
+      fu.set_active_element(e);
+      fu.reset_transform();
+      if (trfs[s] >= 0) fu.push_transform(trfs[s]);
+      rm.set_active_element(e);
+      rm.force_transform(fu.get_transform(), fu.get_ctm());
+      u->set_active_element(umesh->get_element(parts[s]->id));
+
+      int fo = 0;
+      for (int k = 0; k < n; k++) {
+        fu.set_active_shape(shapes[k]);
+        fo = std::max(fo, fu.get_fn_order());
+      }
+      int o = 2 * std::max(fo, u->get_fn_order()) + rm.get_inv_ref_order();
+      if (type == 1) o += 2;
+      limit_order_nowarn(o);
+
+      double3* pt = quad->get_points(o);
+      int np = quad->get_num_points(o);
+      double* jac = rm.get_jacobian(o);
+      double* jwt = new double[np];
+      for (int i = 0; i < np; i++)
+        jwt[i] = pt[i][2] * jac[i];
+
+      Func<scalar>* v = init_fn(u, &rm, o);
+      for (int k = 0; k < n; k++) {
+        fu.set_active_shape(shapes[k]);
+        phi[k] = init_fn(&fu, &rm, o);
+      }
+
+      if (pass == 0) {
+        norm_squared += coarsen_norm_squared(norm, np, jwt, v);
+        for (int k = 0; k < n; k++) {
+          for (int l = 0; l < n; l++)
+            mat[k][l] += coarsen_product(norm, np, jwt, phi[k], phi[l]);
+          coef[k] += coarsen_product(norm, np, jwt, phi[k], v);
+        }
+      }
+      else {
+        for (int k = 0; k < n; k++)
+          coarsen_subtract(v, coef[k], phi[k], np);
+        error_squared += coarsen_norm_squared(norm, np, jwt, v);
+      }
+
+      for (int k = 0; k < n; k++) {
+        phi[k]->free_fn(); delete phi[k];
+      }
+      v->free_fn(); delete v;
+      delete [] jwt;
+    }
+
+    if (pass == 0) {
+      choldc(mat, n, diag);
+      cholsl(mat, n, diag, coef, coef);
+    }
+  }
+
+  delete [] phi;
+  delete [] coef;
+  delete [] diag;
+  delete [] mat;
+  return error_squared;
+}
+
+int Adapt::coarsen(double thr, const Mesh* base_mesh)
+{
+  error_if(!have_solutions, "A (coarse) solution is not set, see set_solutions().");
+  TimePeriod cpu_time;
+
+  // evaluate all candidates first, since the meshes of components may be shared
+  Mesh* meshes[H2D_MAX_COMPONENTS];
+  std::vector<double> merge_errors[H2D_MAX_COMPONENTS], lower_errors[H2D_MAX_COMPONENTS];
+  double budget[H2D_MAX_COMPONENTS];
+  for (int i = 0; i < num_comps; i++)
+  {
+    Space* space = this->ls->spaces[i];
+    meshes[i] = space->get_mesh();
+    Mesh* umesh = sln[i]->get_mesh();
+    error_if(space->get_type() == 2, "Coarsening of Hdiv spaces is not supported.");
+    int norm = (space->get_type() == 1) ? 2 : (space->get_type() == 3) ? 0 : 1;
+    sln[i]->set_quad_2d(&g_quad_2d_std);
+
+    // order lowering of active elements, which also gives the norm of the solution
+    int max_id = meshes[i]->get_max_element_id();
+    lower_errors[i].assign(max_id, -1.0);
+    merge_errors[i].assign(max_id, -1.0);
+    double norm_squared = 0.0;
+    int num_active = 0;
+    Element* e;
+    for_all_active_elements_fast(e, meshes[i])
+    {
+      error_if(e->id >= umesh->get_max_element_id() || !umesh->get_element(e->id)->used || !umesh->get_element(e->id)->active,
+               "The solution of the component %d is not defined on the mesh of its space.", i);
+      int order = space->get_element_order(e->id);
+      int lowered = coarsen_lower_order(e, order);
+      double elem_norm_squared;
+      double error_squared = eval_coarsening_error(i, e, lowered, norm, elem_norm_squared);
+      if (lowered != order)
+        lower_errors[i][e->id] = error_squared;
+      norm_squared += elem_norm_squared;
+      num_active++;
+    }
+    budget[i] = sqr(thr) * norm_squared / num_active;
+
+    // merging of sons, which gets the maximum order of the sons
+    for_all_inactive_elements(e, meshes[i])
+    {
+      if (base_mesh != NULL && e->id < base_mesh->get_max_element_id()
+          && base_mesh->get_element(e->id)->used && !base_mesh->get_element(e->id)->active)
+        continue;
+      bool found = true;
+      int order_h = 0, order_v = 0;
+      for (int s = 0; s < H2D_MAX_ELEMENT_SONS; s++)
+        if (e->sons[s] != NULL)
+        {
+          if (!e->sons[s]->active) { found = false; break; }
+          int order = space->get_element_order(e->sons[s]->id);
+          order_h = std::max(order_h, H2D_GET_H_ORDER(order));
+          order_v = std::max(order_v, H2D_GET_V_ORDER(order));
+        }
+      if (!found) continue;
+      int order = e->is_triangle() ? order_h : H2D_MAKE_QUAD_ORDER(order_h, order_v);
+      double elem_norm_squared;
+      merge_errors[i][e->id] = eval_coarsening_error(i, e, order, norm, elem_norm_squared);
+    }
+  }
+
+  // unrefine sons accepted by all components which share the mesh
+  int num_merged = 0, num_lowered = 0;
+  std::vector<bool> merged[H2D_MAX_COMPONENTS];
+  for (int i = 0; i < num_comps; i++)
+  {
+    int owner = 0;
+    while (meshes[owner] != meshes[i]) owner++;
+    if (owner < i) continue;
+
+    std::vector<int> list;
+    Element* e;
+    for_all_inactive_elements(e, meshes[i])
+    {
+      bool accepted = true;
+      for (int j = i; j < num_comps && accepted; j++)
+        if (meshes[j] == meshes[i] && (merge_errors[j][e->id] < 0.0 || merge_errors[j][e->id] >= budget[j]))
+          accepted = false;
+      if (accepted) list.push_back(e->id);
+    }
+
+    merged[i].assign(meshes[i]->get_max_element_id(), false);
+    for (unsigned int l = 0; l < list.size(); l++)
+    {
+      e = meshes[i]->get_element(list[l]);
+      int orders[H2D_MAX_COMPONENTS];
+      for (int j = i; j < num_comps; j++)
+        if (meshes[j] == meshes[i])
+        {
+          int order_h = 0, order_v = 0;
+          for (int s = 0; s < H2D_MAX_ELEMENT_SONS; s++)
+            if (e->sons[s] != NULL)
+            {
+              int order = this->ls->spaces[j]->get_element_order(e->sons[s]->id);
+              order_h = std::max(order_h, H2D_GET_H_ORDER(order));
+              order_v = std::max(order_v, H2D_GET_V_ORDER(order));
+              merged[i][e->sons[s]->id] = true;
+            }
+          orders[j] = e->is_triangle() ? order_h : H2D_MAKE_QUAD_ORDER(order_h, order_v);
+        }
+
+      meshes[i]->unrefine_element(e->id);
+      for (int j = i; j < num_comps; j++)
+        if (meshes[j] == meshes[i])
+          this->ls->spaces[j]->set_element_order_internal(e->id, orders[j]);
+      num_merged++;
+    }
+  }
+
+  // lower orders of the elements which were not merged
+  for (int i = 0; i < num_comps; i++)
+  {
+    int owner = 0;
+    while (meshes[owner] != meshes[i]) owner++;
+    for (int id = 0; id < (int) lower_errors[i].size(); id++)
+    {
+      if (lower_errors[i][id] < 0.0 || lower_errors[i][id] >= budget[i] || merged[owner][id]) continue;
+      Space* space = this->ls->spaces[i];
+      space->set_element_order_internal(id, coarsen_lower_order(meshes[i]->get_element(id), space->get_element_order(id)));
+      num_lowered++;
+    }
+  }
+
+  verbose("Unrefined elements: %d, elements with lowered order: %d", num_merged, num_lowered);
+  report_time("Coarsened meshes in: %g s", cpu_time.tick().last());
+  have_errors = false;
+
+  // transfer the solutions onto the new spaces
+  if (num_merged + num_lowered > 0)
+  {
+    Tuple<MeshFunction*> source;
+    Tuple<Solution*> target;
+    for (int i = 0; i < num_comps; i++) {
+      source.push_back(sln[i]);
+      target.push_back(sln[i]);
+    }
+    this->ls->project_local(source, target);
+  }
+
+  return num_merged + num_lowered;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void Adapt::set_error_form(int i, int j, jacform_val_t bi_form, jacform_ord_t bi_ord)
@@ -672,7 +1025,7 @@ double Adapt::calc_error(unsigned int error_flags) {
       double norm_squared = norms_squared[i];
       double* errors_squared_comp = errors_squared[i];
       Element* e;
-      for_all_active_elements(e, meshes[i]) {
+      for_all_active_elements_fast(e, meshes[i]) {
         errors_squared_comp[e->id] /= norm_squared;
         errors_squared_sum += errors_squared_comp[e->id];
       }
@@ -714,7 +1067,7 @@ void Adapt::fill_regular_queue(Mesh** meshes, Mesh** ref_meshes) {
   Element* e;
   vector<ElementReference>::iterator elem_info = regular_queue.begin();
   for (int i = 0; i < num_comps; i++)
-    for_all_active_elements(e, meshes[i])
+    for_all_active_elements_fast(e, meshes[i])
       regular_queue.push_back(ElementReference(e->id, i));
 
   //sort
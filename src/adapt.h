@@ -120,6 +120,24 @@ public:
    *  \param[in] thr A stop condition relative error threshold. */
   void unrefine(double thr);
 
+  /// Coarsens the meshes and spaces in place where the (coarse) solution can be represented by fewer DOFs.
+  /** Intended for time-dependent adaptivity, where the meshes can follow moving features instead of being
+   *  rebuilt from a base mesh in every time step. The (coarse) solutions given by set_solutions() are
+   *  projected onto the candidates: a group of active sons onto their parent with the maximum order of the sons,
+   *  and an active element onto the order lowered by one. A candidate is accepted if the squared error of
+   *  the projection is below thr^2 * |u|^2 / N, where |u| is the norm of the solution of the component
+   *  (H1, Hcurl or L2, according to the space) and N is the number of its active elements, i.e., the total
+   *  relative error added by one call does not exceed thr. A mesh shared by several components is unrefined
+   *  only if all the components accept the candidate. Reference solutions and calc_error() are not needed.
+   *
+   *  If anything changed, DOFs are assigned and the solutions are replaced by their projection-based
+   *  interpolation (LinSystem::project_local()) onto the new spaces, which also defines the solution
+   *  vector of the LinSystem.
+   *  \param[in] thr A relative error threshold.
+   *  \param[in] base_mesh A mesh whose elements are never unrefined, usually the mesh the meshes of the components were copied from. If NULL, any sons can be merged.
+   *  \return The number of unrefined elements plus the number of elements with a lowered order. */
+  int coarsen(double thr, const Mesh* base_mesh = NULL);
+
   /// A reference to an element.
   struct ElementReference {
     int id; ///< An element ID. Invalid if below 0.
@@ -241,6 +259,15 @@ protected: //forms and error evaluation
   virtual scalar eval_norm(jacform_val_t bi_fn, jacform_ord_t bi_ord,
                    MeshFunction *rsln1, MeshFunction *rsln2, RefMap *rrv1, RefMap *rrv2);
 
+  /// Evaluates a squared error of the projection of a (coarse) solution onto polynomials on an element. Used by coarsen().
+  /** \param[in] comp A component index.
+   *  \param[in] e An element of the mesh of the space. If inactive, all its sons have to be active and the solution is integrated over them.
+   *  \param[in] order An order of the polynomials (encoded for quads).
+   *  \param[in] norm A norm of the projection: 0 = L2, 1 = H1, 2 = Hcurl.
+   *  \param[out] norm_squared A squared norm of the solution on the element.
+   *  \return A squared error of the projection. */
+  double eval_coarsening_error(int comp, Element* e, int order, int norm, double& norm_squared);
+
   /// Builds an ordered queue of elements that are be examined.
   /** The method fills Adapt::standard_queue by elements sorted accordin to their error descending.
    *  The method assumes that Adapt::errors_squared contains valid values.
@@ -820,7 +820,7 @@ double L2OrthoHP::calc_error_n(int n, ...)
   Element* e;
   k = 0;
   for (i = 0; i < num; i++)
-    for_all_active_elements(e, meshes[i]) {
+    for_all_active_elements_fast(e, meshes[i]) {
       esort[k][0] = e->id;
       esort[k++][1] = i;
       errors[i][e->id] /= norms[i];
@@ -40,16 +40,27 @@ public:
     idx = dof = NULL;
     coef = NULL;
     cnt = cap = 0;
+    own_idx = own_dof = NULL;
+    own_coef = NULL;
+    own_cap = 0;
+    borrowed = false;
   }
 
   ~AsmList()
   {
+    cnt = 0;
+    if (borrowed) release();
     free(idx);
     free(dof);
     free(coef);
   }
 
-  void clear() { cnt = 0; }
+  void clear() { cnt = 0; if (borrowed) release(); }
+
+  /// Internal. Makes the list refer to external (read-only) arrays, e.g. the
+  /// assembly list cache of Space, instead of copying them. The list gets its
+  /// own arrays back when it is cleared or when a triplet is added.
+  void set_view(int cnt, int* idx, int* dof, scalar* coef);
 
   inline void add_triplet(int i, int d, scalar c)
   {
@@ -61,8 +72,16 @@ public:
 
 protected:
 
-  // this is the only non-inline method; defined in space.cpp
+  // the non-inline methods are defined in space.cpp
   void enlarge();
+  void release();
+
+  // own arrays saved while the list refers to external ones
+  int* own_idx;
+  int* own_dof;
+  scalar* own_coef;
+  int own_cap;
+  bool borrowed;
 
 };
 
@@ -43,32 +43,76 @@ static Trf ctm;
 
 //// NURBS //////////////////////////////////////////////////////////////////////////////////////////
 
-// recursive calculation of the basis function N_i,k
-double nurbs_basis_fn(int i, int k, double t, double* knot)
+// maximum degree of NURBS curves supported by nurbs_edge()
+#define H2D_MAX_NURBS_DEGREE 30
+
+// index of the knot span [knot[span], knot[span+1]) containing t; for t at the end of
+// the curve the last non-empty span is returned
+static int nurbs_find_span(int np, int degree, double t, double* knot)
 {
-  if (k == 0)
+  int n = np - 1;
+  if (t >= knot[n+1]) return n;
+  if (t <= knot[degree]) return degree;
+
+  int lo = degree, hi = n + 1, mid = (lo + hi) / 2;
+  while (t < knot[mid] || t >= knot[mid+1])
   {
-    return (t >= knot[i] && t <= knot[i+1] && knot[i] < knot[i+1]) ? 1.0 : 0.0;
+    if (t < knot[mid]) hi = mid; else lo = mid;
+    mid = (lo + hi) / 2;
   }
-  else
-  {
-    double N1 = nurbs_basis_fn(i, k-1, t, knot);
-    double N2 = nurbs_basis_fn(i+1, k-1, t, knot);
+  return mid;
+}
 
-    double result = 0.0;
-    if (knot[i+k] != knot[i])
-    {
-      result += ((t - knot[i]) / (knot[i+k] - knot[i])) * N1;
-    }
-    if (knot[i+k+1] != knot[i+1])
+// values of the degree+1 basis functions N_{span-degree,degree} ... N_{span,degree}
+// which are nonzero in the knot span 'span' (the triangular scheme, see The NURBS Book,
+// Piegl & Tiller, algorithm A2.2)
+static void nurbs_basis_fns(int span, int degree, double t, double* knot, double* N)
+{
+  double left[H2D_MAX_NURBS_DEGREE+1], right[H2D_MAX_NURBS_DEGREE+1];
+  N[0] = 1.0;
+  for (int j = 1; j <= degree; j++)
+  {
+    left[j]  = t - knot[span+1-j];
+    right[j] = knot[span+j] - t;
+    double saved = 0.0;
+    for (int r = 0; r < j; r++)
     {
-      result += ((knot[i+k+1] - t) / (knot[i+k+1] - knot[i+1])) * N2;
+      double tmp = N[r] / (right[r+1] + left[j-r]);
+      N[r] = saved + right[r+1] * tmp;
+      saved = left[j-r] * tmp;
     }
-    return result;
+    N[j] = saved;
   }
 }
 
 
+// point of the nurbs curve, t goes from 0 to 1
+static void nurbs_point(Nurbs* nurbs, double t, double& x, double& y)
+{
+  int p = nurbs->degree;
+  if (p > H2D_MAX_NURBS_DEGREE) error("NURBS curves of degree higher than %d are not supported.", H2D_MAX_NURBS_DEGREE);
+
+  double N[H2D_MAX_NURBS_DEGREE+1];
+  int span = nurbs_find_span(nurbs->np, p, t, nurbs->kv);
+  nurbs_basis_fns(span, p, t, nurbs->kv, N);
+
+  double3* cp = nurbs->pt + span - p;
+  x = y = 0.0;
+  double sum = 0.0;  // sum of basis fns and weights
+  for (int i = 0; i <= p; i++)
+  {
+    double wb = cp[i][2] * N[i];
+    sum += wb;
+    x   += wb * cp[i][0];
+    y   += wb * cp[i][1];
+  }
+
+  sum = 1.0 / sum;
+  x *= sum;
+  y *= sum;
+}
+
+
 // nurbs curve: t goes from -1 to 1, function returns x, y coordinates in plane
 void nurbs_edge(Element* e, Nurbs* nurbs, int edge, double t, double& x, double& y)
 {
@@ -82,23 +126,24 @@ void nurbs_edge(Element* e, Nurbs* nurbs, int edge, double t, double& x, double&
     y = e->vn[edge]->y + t * v[1];
   }
   else
-  {
-    double3* cp = nurbs->pt;
-    x = y = 0.0;
-    double sum = 0.0;  // sum of basis fns and weights
+    nurbs_point(nurbs, t, x, y);
+}
 
-    for (int i = 0; i < nurbs->np; i++)
-    {
-      double basis = nurbs_basis_fn(i, nurbs->degree, t, nurbs->kv);
-      sum += cp[i][2] * basis;
-      x   += cp[i][2] * basis * cp[i][0];
-      y   += cp[i][2] * basis * cp[i][1];
-    }
 
-    sum = 1.0 / sum;
-    x *= sum;
-    y *= sum;
+// points of the nurbs curve at the integration points of the maximum order used in
+// calc_edge_projection(); calculated on the first use and kept with the curve
+static double2* nurbs_edge_samples(Nurbs* nurbs)
+{
+  if (nurbs->samples == NULL)
+  {
+    int mo1 = quad1d.get_max_order();
+    int np = quad1d.get_num_points(mo1);
+    double2* pt = quad1d.get_points(mo1);
+    nurbs->samples = new double2[np];
+    for (int j = 0; j < np; j++)
+      nurbs_point(nurbs, (pt[j][0] + 1) / 2.0, nurbs->samples[j][0], nurbs->samples[j][1]);
   }
+  return nurbs->samples;
 }
 
 
@@ -361,13 +406,25 @@ static void calc_edge_projection(Element* e, int edge, Nurbs** nurbs, int order,
   calc_ref_map(e, nurbs, a_1, a_2, fa);
   calc_ref_map(e, nurbs, b_1, b_2, fb);
 
+  // on a curved edge of a base element (i.e., with no sub-element transformation),
+  // the reference map coincides with the curve
   double2* pt = quad1d.get_points(mo1);
+  bool identity = (ctm.m[0] == 1.0 && ctm.m[1] == 1.0 && ctm.t[0] == 0.0 && ctm.t[1] == 0.0);
+  double2* samples = (identity && nurbs[edge] != NULL) ? nurbs_edge_samples(nurbs[edge]) : NULL;
   for (j = 0; j < np; j++) // over all integration points
   {
     double2 x, v;
     double t = pt[j][0];
-    edge_coord(e, edge, t, x, v);
-    calc_ref_map(e, nurbs, x[0], x[1], fn[j]);
+    if (samples != NULL)
+    {
+      fn[j][0] = samples[j][0];
+      fn[j][1] = samples[j][1];
+    }
+    else
+    {
+      edge_coord(e, edge, t, x, v);
+      calc_ref_map(e, nurbs, x[0], x[1], fn[j]);
+    }
 
     for (k = 0; k < 2; k++)
       fn[j][k] = fn[j][k] - (fa[k] + (t+1)/2.0 * (fb[k] - fa[k]));
@@ -521,6 +578,120 @@ static void ref_map_projection(Element* e, Nurbs** nurbs, int order, double2* pr
 }
 
 
+//// cache of projected coefficients of refined elements ///////////////////////////////////////////
+
+// Refined curved elements are re-created (and their reference maps re-projected)
+// every time a mesh is copied and refined, e.g., in each step of adaptivity. The
+// projection only depends on the geometry of the base element, on the sub-element
+// transformation and on the order, so the results are stored with the curves
+// of the base element and reused. The number of entries per base element is
+// bounded, a full cache is flushed (the entries of old meshes are not needed any more).
+
+static const unsigned int H2D_CURV_COEF_CACHE_SIZE = 1024;
+
+struct CurvCoefKey
+{
+  Nurbs* nurbs[4];     // curves of the base element
+  double pvert[4][2];  // vertices of the base element
+  double vert[4][2];   // vertices of the refined element
+  uint64_t part;       // sub-element transformation
+  int pnvert, nvert, mode, order;
+};
+
+struct CurvCoefCompare
+{
+  bool operator()(const CurvCoefKey& a, const CurvCoefKey& b) const
+  {
+    if (a.part != b.part) return a.part < b.part;
+    if (a.order != b.order) return a.order < b.order;
+    if (a.mode != b.mode) return a.mode < b.mode;
+    if (a.nvert != b.nvert) return a.nvert < b.nvert;
+    if (a.pnvert != b.pnvert) return a.pnvert < b.pnvert;
+    for (int i = 0; i < 4; i++)
+      if (a.nurbs[i] != b.nurbs[i]) return std::less<Nurbs*>()(a.nurbs[i], b.nurbs[i]);
+    for (int i = 0; i < a.pnvert; i++)
+      for (int j = 0; j < 2; j++)
+        if (a.pvert[i][j] != b.pvert[i][j]) return a.pvert[i][j] < b.pvert[i][j];
+    for (int i = 0; i < a.nvert; i++)
+      for (int j = 0; j < 2; j++)
+        if (a.vert[i][j] != b.vert[i][j]) return a.vert[i][j] < b.vert[i][j];
+    return false;
+  }
+};
+
+struct CurvCoefCache
+{
+  CurvCoefCache() { ref = 0; }
+  ~CurvCoefCache() { clear(); }
+
+  void clear()
+  {
+    for (std::map<CurvCoefKey, double2*, CurvCoefCompare>::iterator it = coefs.begin(); it != coefs.end(); ++it)
+      delete [] it->second;
+    coefs.clear();
+  }
+
+  int ref; // number of Nurbs pointing to this cache
+  std::map<CurvCoefKey, double2*, CurvCoefCompare> coefs;
+};
+
+
+static void make_coef_key(Element* e, Element* parent, uint64_t part, int order, CurvCoefKey& key)
+{
+  memset(&key, 0, sizeof(CurvCoefKey));
+  for (int i = 0; i < 4; i++)
+    key.nurbs[i] = parent->cm->nurbs[i];
+  for (unsigned int i = 0; i < parent->nvert; i++)
+  {
+    key.pvert[i][0] = parent->vn[i]->x;
+    key.pvert[i][1] = parent->vn[i]->y;
+  }
+  for (unsigned int i = 0; i < e->nvert; i++)
+  {
+    key.vert[i][0] = e->vn[i]->x;
+    key.vert[i][1] = e->vn[i]->y;
+  }
+  key.part = part;
+  key.pnvert = parent->nvert;
+  key.nvert = e->nvert;
+  key.mode = e->get_mode();
+  key.order = order;
+}
+
+
+// Returns the cache shared by all curves of a base element. All non-NULL curves
+// of the element have to point to the same cache, since the cache is flushed
+// when any of them is deleted (keys store the pointers). Returns NULL if the
+// curves are already attached to different caches.
+static CurvCoefCache* get_coef_cache(Nurbs** nurbs)
+{
+  CurvCoefCache* cache = NULL;
+  bool curved = false;
+  for (int i = 0; i < 4; i++)
+  {
+    if (nurbs[i] == NULL) continue;
+    curved = true;
+    if (nurbs[i]->coef_cache == NULL) continue;
+    if (cache != NULL && cache != nurbs[i]->coef_cache) return NULL;
+    cache = nurbs[i]->coef_cache;
+  }
+  if (!curved) return NULL;
+
+  if (cache == NULL) cache = new CurvCoefCache;
+  for (int i = 0; i < 4; i++)
+  {
+    if (nurbs[i] != NULL && nurbs[i]->coef_cache == NULL)
+    {
+      nurbs[i]->coef_cache = cache;
+      cache->ref++;
+    }
+  }
+  return cache;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void CurvMap::update_refmap_coefs(Element* e)
 {
   ref_map_pss.set_quad_2d(&quad2d);
@@ -538,16 +709,31 @@ void CurvMap::update_refmap_coefs(Element* e)
   int ne = order - 1;
   int qo = e->is_quad() ? H2D_MAKE_QUAD_ORDER(order, order) : order;
   int nb = ref_map_shapeset.get_num_bubbles(qo);
+  int old_nc = nc;
   nc = nv + nv*ne + nb;
-  if (coefs != NULL) delete [] coefs;
-  coefs = new double2[nc];
+  if (coefs != NULL && nc != old_nc) { delete [] coefs; coefs = NULL; }
+  if (coefs == NULL) coefs = new double2[nc];
 
   // WARNING: do not change the format of the array 'coefs'. If it changes,
   // RefMap::set_active_element() has to be changed too.
 
   Nurbs** nurbs;
+  CurvCoefCache* cache = NULL;
+  CurvCoefKey key;
   if (toplevel == false)
   {
+    cache = get_coef_cache(parent->cm->nurbs);
+    if (cache != NULL)
+    {
+      make_coef_key(e, parent, part, order, key);
+      std::map<CurvCoefKey, double2*, CurvCoefCompare>::iterator it = cache->coefs.find(key);
+      if (it != cache->coefs.end())
+      {
+        memcpy(coefs, it->second, sizeof(double2) * nc);
+        return;
+      }
+    }
+
     ref_map_pss.set_active_element(e);
     ref_map_pss.set_transform(part);
     nurbs = parent->cm->nurbs;
@@ -562,6 +748,14 @@ void CurvMap::update_refmap_coefs(Element* e)
 
   // calculation of new projection coefficients
   ref_map_projection(e, nurbs, order, coefs);
+
+  if (cache != NULL)
+  {
+    if (cache->coefs.size() >= H2D_CURV_COEF_CACHE_SIZE) cache->clear();
+    double2* copy = new double2[nc];
+    memcpy(copy, coefs, sizeof(double2) * nc);
+    cache->coefs[key] = copy;
+  }
 }
 
 
@@ -595,6 +789,13 @@ void Nurbs::unref()
   {
     delete [] pt;
     delete [] kv;
+    delete [] samples;
+    if (coef_cache != NULL)
+    {
+      // the keys refer to this curve, which is going away
+      coef_cache->clear();
+      if (!--coef_cache->ref) delete coef_cache;
+    }
     delete this;
   }
 }
@@ -19,6 +19,7 @@
 #include "common.h"
 
 struct Element;
+struct CurvCoefCache;
 
 
 /// \brief Represents one NURBS curve.
@@ -32,7 +33,7 @@ struct Element;
 ///
 struct Nurbs
 {
-  Nurbs() { ref = 0; twin = false; };
+  Nurbs() { ref = 0; twin = false; samples = NULL; coef_cache = NULL; };
   void unref();
 
   int degree;  ///< curve degree (2=quadratic, etc.)
@@ -44,6 +45,8 @@ struct Nurbs
   bool twin;   ///< true on internal curved edges for the second (artificial) Nurbs
   bool arc;     ///< true if this is in fact a circular arc
   double angle; ///< arc angle
+  double2* samples; ///< points of the curve at the 1D integration points used in ref. map projections
+  CurvCoefCache* coef_cache; ///< projected ref. map coefficients of refined elements, shared by the curves of one base element
 };
 
 
@@ -53,7 +56,7 @@ struct Nurbs
 ///
 struct CurvMap
 {
-  CurvMap() { coefs = NULL; };
+  CurvMap() { coefs = NULL; nc = 0; };
   CurvMap(CurvMap* cm);
   ~CurvMap();
 
@@ -85,8 +88,9 @@ struct CurvMap
   // this is called for every curvilinear element when it is created
   // or when it is necessary to re-calculate coefficients for another
   // order: 'e' is a pointer to the element to which this CurvMap
-  // belongs to. First, old "coefs" are removed if they are not NULL,
-  // then new coefficients are projected.
+  // belongs to. New coefficients are projected into "coefs" (which is
+  // reallocated if their number changes); for refined elements, they are
+  // taken from the cache of the base element curves if available.
   void update_refmap_coefs(Element* e);
 
   void get_mid_edge_points(Element* e, double2* pt, int n);
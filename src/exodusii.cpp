@@ -18,7 +18,8 @@
 #include <string.h>
 #include "exodusii.h"
 #include "mesh.h"
-#include <map>
+#include <vector>
+#include <algorithm>
 
 #ifdef WITH_EXODUSII
 #include <exodusII.h>
@@ -36,25 +37,59 @@ ExodusIIReader::~ExodusIIReader()
 {
 }
 
-struct Vertex
+#ifdef WITH_EXODUSII
+
+// orders nodes by their coordinates (and by their index for equal coordinates)
+struct NodeCompare
 {
-  double x, y;
+  const double *x, *y;
+  NodeCompare(const double *x, const double *y) : x(x), y(y) { }
+  bool operator()(int a, int b) const
+  {
+    if (x[a] != x[b]) return x[a] < x[b];
+    if (y[a] != y[b]) return y[a] < y[b];
+    return a < b;
+  }
 };
 
-// needed for comparison of vertices inside std::map
-struct VCompare
+// Removes nodes with identical coordinates. On return, vmap[i] is the new index
+// of the node i (0-based) and vtx contains the unique vertices. The vertices are
+// numbered in the order of their first occurrence.
+static int remove_duplicate_vertices(int n_nodes, const double *x, const double *y,
+                                     std::vector<int> &vmap, double2 *&vtx)
 {
-  bool operator()(Vertex a, Vertex b) const
+  // sort node indices by coordinates, duplicates end up next to each other
+  std::vector<int> perm(n_nodes);
+  for (int i = 0; i < n_nodes; i++) perm[i] = i;
+  std::sort(perm.begin(), perm.end(), NodeCompare(x, y));
+
+  // the first node (with the lowest index) of each group of duplicates represents the group
+  std::vector<int> rep(n_nodes);
+  for (int i = 0; i < n_nodes; i++)
   {
-    if (a.x < b.x) return true;
-    else if (a.x > b.x) return false;
+    int k = perm[i];
+    if (i > 0 && x[k] == x[perm[i-1]] && y[k] == y[perm[i-1]])
+      rep[k] = rep[perm[i-1]];
     else
+      rep[k] = k;
+  }
+
+  vmap.resize(n_nodes);
+  int n_vtx = 0;
+  for (int i = 0; i < n_nodes; i++)
+    vmap[i] = (rep[i] == i) ? n_vtx++ : vmap[rep[i]];
+
+  vtx = new double2 [n_vtx];
+  for (int i = 0; i < n_nodes; i++)
+    if (rep[i] == i)
     {
-      if (a.y < b.y) return true;
-      return false;
+      vtx[vmap[i]][0] = x[i];
+      vtx[vmap[i]][1] = y[i];
     }
-  }
-};
+  return n_vtx;
+}
+
+#endif
 
 bool ExodusIIReader::load(const char *file_name, Mesh *mesh)
 {
@@ -81,38 +116,15 @@ bool ExodusIIReader::load(const char *file_name, Mesh *mesh)
   err = ex_get_coord(exoid, x, y, NULL);
 
   // remove duplicate vertices and build renumbering map
-  std::map<Vertex, int, VCompare> vtx_list;				// map for eliminating duplicities
-  std::map<int, int> vmap;								// reindexing map
-  std::vector<Vertex> vtx_arr;							// vertex array
-  int vid = 0;
-  for (int i = 0; i < n_nodes; i++)
-  {
-    int k;
-    Vertex v = { x[i], y[i] };
-    if (vtx_list.count(v) == 0)
-    {
-      vtx_arr.push_back(v);
-      k = vid++;
-      vtx_list[v] = k;
-    }
-    else
-      k = vtx_list[v];
-
-    vmap[i + 1] = k;
-  }
+  std::vector<int> vmap;		// reindexing map (0-based node index -> vertex index)
+  double2 *vtx;
+  int n_vtx = remove_duplicate_vertices(n_nodes, x, y, vmap, vtx);
   delete [] x;
   delete [] y;
 
-  int n_vtx = vtx_arr.size();
-  double2 *vtx = new double2 [n_vtx];
-  for (int i = 0; i < n_vtx; i++)
-  {
-    vtx[i][0] = vtx_arr[i].x;
-    vtx[i][1] = vtx_arr[i].y;
-  }
-
   int n_tri = 0;		// number of triangles
   int n_quad = 0;		// number of quads
+  int max_conn = 0;		// size of the largest connectivity array
 
   // get info about element blocks
   int *eid_blocks = new int [n_eblocks];
@@ -133,6 +145,7 @@ bool ExodusIIReader::load(const char *file_name, Mesh *mesh)
       error("Unknown type of element");
       return false;
     }
+    max_conn = std::max(max_conn, n_elem_nodes * n_elems_in_blk);
   }
   int4 *tri = n_tri > 0 ? new int4 [n_tri] : NULL;		// triangles
   int5 *quad = n_quad > 0 ? new int5 [n_quad] : NULL;		// quads
@@ -140,6 +153,8 @@ bool ExodusIIReader::load(const char *file_name, Mesh *mesh)
   int **els = n_els > 0 ? new int * [n_els] : NULL;		// elements
   int *el_nv = n_els > 0 ? new int [n_els] : NULL;		// number of vertices for each element
 
+  // read connectivity arrays block by block into one buffer and renumber the vertices
+  int *connect = new int [std::max(max_conn, 1)];
   int it = 0, iq = 0, iel = 0;
   for (int i = 0; i < n_eblocks; i++)
   {
@@ -151,41 +166,43 @@ bool ExodusIIReader::load(const char *file_name, Mesh *mesh)
     err = ex_get_elem_block(exoid, id, elem_type, &n_elems_in_blk, &n_elem_nodes, &n_attrs);
 
     // read connectivity array
-    int *connect = new int [n_elem_nodes * n_elems_in_blk];
+    int n_conn = n_elem_nodes * n_elems_in_blk;
     err = ex_get_elem_conn(exoid, id, connect);
+    for (int j = 0; j < n_conn; j++)
+    {
+      if (connect[j] < 1 || connect[j] > n_nodes)
+        error("Invalid node index %d in element block %d of '%s'", connect[j], id, file_name);
+      connect[j] = vmap[connect[j] - 1];
+    }
 
-    int ic = 0;
-    for (int j = 0; j < n_elems_in_blk; j++)
+    int *c = connect;
+    if (n_elem_nodes == 3)
     {
-      el_nv[iel] = n_elem_nodes;
-      if (n_elem_nodes == 3)
+      for (int j = 0; j < n_elems_in_blk; j++, c += 3, it++, iel++)
       {
-        tri[it][0] = vmap[connect[ic++]];
-        tri[it][1] = vmap[connect[ic++]];
-        tri[it][2] = vmap[connect[ic++]];
+        tri[it][0] = c[0];
+        tri[it][1] = c[1];
+        tri[it][2] = c[2];
         tri[it][3] = id;
+        el_nv[iel] = 3;
         els[iel] = tri[it];
-        it++;
       }
-      else if (n_elem_nodes == 4)
+    }
+    else
+    {
+      for (int j = 0; j < n_elems_in_blk; j++, c += 4, iq++, iel++)
       {
-        quad[iq][0] = vmap[connect[ic++]];
-        quad[iq][1] = vmap[connect[ic++]];
-        quad[iq][2] = vmap[connect[ic++]];
-        quad[iq][3] = vmap[connect[ic++]];
+        quad[iq][0] = c[0];
+        quad[iq][1] = c[1];
+        quad[iq][2] = c[2];
+        quad[iq][3] = c[3];
         quad[iq][4] = id;
+        el_nv[iel] = 4;
         els[iel] = quad[iq];
-        iq++;
       }
-      else
-      {
-        error("Unknown type of element");
-        return false;
-      }
-      iel++;
     }
-    delete [] connect;
   }
+  delete [] connect;
   delete [] eid_blocks;
 
   // query number of side sets
@@ -194,40 +211,41 @@ bool ExodusIIReader::load(const char *file_name, Mesh *mesh)
 
   // go over the sidesets
   int n_mark = 0;		// number of markers
+  int max_sides = 0;	// size of the largest side set
   for (int i = 0; i < n_sidesets; i++)
   {
     int sid = sid_blocks[i];
     int n_sides_in_set, n_df_in_set;
     err = ex_get_side_set_param(exoid, sid, &n_sides_in_set, &n_df_in_set);
     n_mark += n_sides_in_set;
+    max_sides = std::max(max_sides, n_sides_in_set);
   }
   int3 *marks = new int3 [n_mark];
 
+  int *elem_list = new int [std::max(max_sides, 1)];
+  int *side_list = new int [std::max(max_sides, 1)];
   int im = 0;
   for (int i = 0; i < n_sidesets; i++)
   {
     int sid = sid_blocks[i];
     int n_sides_in_set, n_df_in_set;
     err = ex_get_side_set_param(exoid, sid, &n_sides_in_set, &n_df_in_set);
-    int num_elem_in_set = n_sides_in_set;
-
-    int *elem_list = new int [num_elem_in_set];
-    int *side_list = new int [n_sides_in_set];
     err = ex_get_side_set(exoid, sid, elem_list, side_list);
 
-    for (int j = 0; j < num_elem_in_set; j++)
+    for (int j = 0; j < n_sides_in_set; j++, im++)
     {
-      int nv = el_nv[side_list[j] - 1];			// # of vertices of the element
+      if (elem_list[j] < 1 || elem_list[j] > n_els)
+        error("Invalid element index %d in side set %d of '%s'", elem_list[j], sid, file_name);
+      int *el = els[elem_list[j] - 1];
+      int nv = el_nv[elem_list[j] - 1];			// # of vertices of the element
       int vt = side_list[j] - 1;
-      marks[im][0] = els[elem_list[j] - 1][vt];
-      marks[im][1] = els[elem_list[j] - 1][(vt + 1) % nv];
+      marks[im][0] = el[vt];
+      marks[im][1] = el[(vt + 1) % nv];
       marks[im][2] = sid;
-      im++;
     }
-
-    delete [] elem_list;
-    delete [] side_list;
   }
+  delete [] elem_list;
+  delete [] side_list;
   delete [] sid_blocks;
 
   // we are done
@@ -15,6 +15,7 @@
 
 #include "common.h"
 #include "limit_order.h"
+#include "weakform_parser.h"
 #include "feproblem.h"
 #include "traverse.h"
 #include "space.h"
@@ -174,11 +175,7 @@ void FeProblem::create(SparseMatrix* mat)
 
           // pretend assembling of the element stiffness matrix
           // register nonzero elements
-          for (int i = 0; i < am->cnt; i++)
-            if (am->dof[i] >= 0)
-              for (int j = 0; j < an->cnt; j++)
-                if (an->dof[j] >= 0)
-                  mat->pre_add_ij(am->dof[i], an->dof[j]);
+          mat->pre_add_block(am->cnt, am->dof, an->cnt, an->dof);
         }
   }
 
@@ -301,6 +298,7 @@ void FeProblem::assemble(const _Vector *x, _Vector *rhs, _Matrix *jac)
           n = bfv->j;  fu = pss[n];   an = &al[n];
           bool tra = (m != n) && (bfv->sym != 0);
           bool sym = (m == n) && (bfv->sym == 1);
+          scalar gc = wf->get_group_coef(bfv->group);
 
           // assemble the local stiffness matrix for the form bfv
           scalar bi, **mat = get_matrix_buffer(std::max(am->cnt, an->cnt));
@@ -313,7 +311,7 @@ void FeProblem::assemble(const _Vector *x, _Vector *rhs, _Matrix *jac)
             {
               for (int j = 0; j < an->cnt; j++) {
                 fu->set_active_shape(an->idx[j]);
-                bi = eval_form(bfv, slns, fu, fv, refmap+n, refmap+m) * an->coef[j] * am->coef[i];
+                bi = gc * eval_form(bfv, slns, fu, fv, refmap+n, refmap+m) * an->coef[j] * am->coef[i];
                 if (an->dof[j] >= 0) mat[i][j] = bi;
               }
             }
@@ -322,7 +320,7 @@ void FeProblem::assemble(const _Vector *x, _Vector *rhs, _Matrix *jac)
               for (int j = 0; j < an->cnt; j++) {
                 if (j < i && an->dof[j] >= 0) continue;
                 fu->set_active_shape(an->idx[j]);
-                bi = eval_form(bfv, slns, fu, fv, refmap+n, refmap+m) * an->coef[j] * am->coef[i];
+                bi = gc * eval_form(bfv, slns, fu, fv, refmap+n, refmap+m) * an->coef[j] * am->coef[i];
                 if (an->dof[j] >= 0) mat[i][j] = mat[j][i] = bi;
               }
             }
@@ -389,7 +387,7 @@ void FeProblem::assemble(const _Vector *x, _Vector *rhs, _Matrix *jac)
             ep[edge].space_v = spaces[m];
             ep[edge].space_u = spaces[n];
 
-            scalar bi, **mat = get_matrix_buffer(std::max(am->cnt, an->cnt));
+            scalar bi, gc = wf->get_group_coef(bfs->group), **mat = get_matrix_buffer(std::max(am->cnt, an->cnt));
             for (int i = 0; i < am->cnt; i++)
             {
               if ((k = am->dof[i]) < 0) continue;
@@ -397,7 +395,7 @@ void FeProblem::assemble(const _Vector *x, _Vector *rhs, _Matrix *jac)
               for (int j = 0; j < an->cnt; j++)
               {
                 fu->set_active_shape(an->idx[j]);
-                bi = eval_form(bfs, slns, fu, fv, refmap+n, refmap+m, ep+edge) * an->coef[j] * am->coef[i];
+                bi = gc * eval_form(bfs, slns, fu, fv, refmap+n, refmap+m, ep+edge) * an->coef[j] * am->coef[i];
                 if (an->dof[j] >= 0) mat[i][j] = bi;
               }
             }
@@ -526,9 +524,11 @@ scalar FeProblem::eval_form(WeakForm::JacFormVol *bf, Solution *sln[], PrecalcSh
 
   double fake_wt = 1.0;
   Geom<Ord>* fake_e = init_geom_ord();
-  Ord o = bf->ord(1, &fake_wt, oi, ou, ov, fake_e, fake_ext);
+  Ord o = bf->prog ? bf->prog->eval_ord(ou, ov, fake_e)
+                   : bf->ord(1, &fake_wt, oi, ou, ov, fake_e, fake_ext);
   int order = ru->get_inv_ref_order();
-  order += o.get_order();
+  order += o.get_order() + bf->ord_offset;
+  if (order < 0) order = 0;
   limit_order_nowarn(order);
 
   for (int i = 0; i < wf->neq; i++) {  oi[i]->free_ord(); delete oi[i]; }
@@ -561,7 +561,8 @@ scalar FeProblem::eval_form(WeakForm::JacFormVol *bf, Solution *sln[], PrecalcSh
   Func<double>* v = get_fn(fv, rv, order);
   ExtData<scalar>* ext = init_ext_fns(bf->ext, rv, order);
 
-  scalar res = bf->fn(np, jwt, prev, u, v, e, ext);
+  scalar res = bf->prog ? bf->prog->eval(np, jwt, u, v, e)
+                        : bf->fn(np, jwt, prev, u, v, e, ext);
 
   for (int i = 0; i < wf->neq; i++) {  prev[i]->free_fn(); delete prev[i]; }
   ext->free(); delete ext;
@@ -581,9 +582,11 @@ scalar FeProblem::eval_form(WeakForm::ResFormVol *lf, Solution *sln[], PrecalcSh
 
   double fake_wt = 1.0;
   Geom<Ord>* fake_e = init_geom_ord();
-  Ord o = lf->ord(1, &fake_wt, oi, ov, fake_e, fake_ext);
+  Ord o = lf->prog ? lf->prog->eval_ord(NULL, ov, fake_e)
+                   : lf->ord(1, &fake_wt, oi, ov, fake_e, fake_ext);
   int order = rv->get_inv_ref_order();
-  order += o.get_order();
+  order += o.get_order() + lf->ord_offset;
+  if (order < 0) order = 0;
   limit_order_nowarn(order);
 
   for (int i = 0; i < wf->neq; i++) {  oi[i]->free_ord(); delete oi[i]; }
@@ -614,7 +617,8 @@ scalar FeProblem::eval_form(WeakForm::ResFormVol *lf, Solution *sln[], PrecalcSh
   Func<double>* v = get_fn(fv, rv, order);
   ExtData<scalar>* ext = init_ext_fns(lf->ext, rv, order);
 
-  scalar res = lf->fn(np, jwt, prev, v, e, ext);
+  scalar res = lf->prog ? lf->prog->eval(np, jwt, NULL, v, e)
+                        : lf->fn(np, jwt, prev, v, e, ext);
 
   for (int i = 0; i < wf->neq; i++) {  prev[i]->free_fn(); delete prev[i]; }
   ext->free(); delete ext;
@@ -651,7 +655,8 @@ scalar FeProblem::eval_form(WeakForm::JacFormSurf *bf, Solution *sln[], PrecalcS
   Func<double>* v = get_fn(fv, rv, eo);
   ExtData<scalar>* ext = init_ext_fns(bf->ext, rv, eo);
 
-  scalar res = bf->fn(np, jwt, prev, u, v, e, ext);
+  scalar res = bf->prog ? bf->prog->eval(np, jwt, u, v, e)
+                        : bf->fn(np, jwt, prev, u, v, e, ext);
 
   for (int i = 0; i < wf->neq; i++) {  prev[i]->free_fn(); delete prev[i]; }
   ext->free(); delete ext;
@@ -686,7 +691,8 @@ scalar FeProblem::eval_form(WeakForm::ResFormSurf *lf, Solution *sln[], PrecalcS
   Func<double>* v = get_fn(fv, rv, eo);
   ExtData<scalar>* ext = init_ext_fns(lf->ext, rv, eo);
 
-  scalar res = lf->fn(np, jwt, prev, v, e, ext);
+  scalar res = lf->prog ? lf->prog->eval(np, jwt, NULL, v, e)
+                        : lf->fn(np, jwt, prev, v, e, ext);
 
   for (int i = 0; i < wf->neq; i++) {  prev[i]->free_fn(); delete prev[i]; }
   ext->free(); delete ext;
@@ -42,8 +42,10 @@
 #include "refmap.h"
 #include "traverse.h"
 #include "trans.h"
+#include "partition.h"
 
 #include "weakform.h"
+#include "weakform_parser.h"
 #include "linsystem.h"
 #include "feproblem.h"
 #include "nonlinsystem.h"
@@ -54,11 +56,13 @@
 #include "solver_epetra.h"
 #include "solver_aztecoo.h"
 #include "solver_nox.h"
+#include "solver_mpi.h"
 
 // preconditioners
 #include "precond.h"
 #include "precond_ifpack.h"
 #include "precond_ml.h"
+#include "precond_mg.h"
 
 #include "integrals_h1.h"
 #include "integrals_hcurl.h"
@@ -75,9 +79,11 @@
 #include "views/mesh_view.h"
 #include "views/order_view.h"
 #include "views/scalar_view.h"
+#include "views/stream_tracer.h"
 #include "views/stream_view.h"
 #include "views/vector_base_view.h"
 #include "views/vector_view.h"
+#include "views/offscreen_view.h"
 
 #include "refinement_type.h"
 #include "element_to_refine.h"
@@ -148,7 +154,10 @@ curvilinear mapping is defined by adding edge and bubble shape functions to the
 reference mapping.
 
 Throughout the code, the macros for_all_active_elements(), for_all_vertex_nodes(), etc. (see mesh.h),
-are used to iterate through elements and nodes of the mesh.
+are used to iterate through elements and nodes of the mesh. The mesh also keeps a dense index
+of its active elements, ordered by id (Mesh::get_active_elements()). Loops which do not change
+the mesh, such as assembly, norms or linearization, iterate through it with
+for_all_active_elements_fast(), which skips the slots of inactive and unused elements.
 
 A commented example .mesh file can be found <a href="../data/example.mesh">here</a>.
 
@@ -19,10 +19,13 @@
 
 //// the following integrals can be used in both volume and surface forms //////////////////////////////////////////////////////////////////////////////
 
+// All operands of these integrals are of the type Real, so the sum is kept in Real as well and
+// converted to Scalar on return.
+
 template<typename Real, typename Scalar>
 Scalar int_v(int n, double *wt, Func<Real> *v)
 {
-  Scalar result = 0;
+  Real result = 0;
   for (int i = 0; i < n; i++)
     result += wt[i] * (v->val[i]);
   return result;
@@ -31,7 +34,7 @@ Scalar int_v(int n, double *wt, Func<Real> *v)
 template<typename Real, typename Scalar>
 Scalar int_u_v(int n, double *wt, Func<Real> *u, Func<Real> *v)
 {
-  Scalar result = 0;
+  Real result = 0;
   for (int i = 0; i < n; i++)
     result += wt[i] * (u->val[i] * v->val[i]);
   return result;
@@ -40,7 +43,7 @@ Scalar int_u_v(int n, double *wt, Func<Real> *u, Func<Real> *v)
 template<typename Real, typename Scalar>
 Scalar int_F_v(int n, double *wt, Real (*F)(Real x, Real y), Func<Real> *v, Geom<Real> *e)
 {
-  Scalar result = 0;
+  Real result = 0;
   for (int i = 0; i < n; i++)
     result += wt[i] * ((*F)(e->x[i], e->y[i]) * v->val[i]);
   return result;
@@ -49,7 +52,7 @@ Scalar int_F_v(int n, double *wt, Real (*F)(Real x, Real y), Func<Real> *v, Geom
 template<typename Real, typename Scalar>
 Scalar int_grad_u_grad_v(int n, double *wt, Func<Real> *u, Func<Real> *v)
 {
-  Scalar result = 0;
+  Real result = 0;
   for (int i = 0; i < n; i++)
     result += wt[i] * (u->dx[i] * v->dx[i] + u->dy[i] * v->dy[i]);
   return result;
@@ -58,7 +61,7 @@ Scalar int_grad_u_grad_v(int n, double *wt, Func<Real> *u, Func<Real> *v)
 template<typename Real, typename Scalar>
 Scalar int_dudx_v(int n, double *wt, Func<Real> *u, Func<Real> *v)
 {
-  Scalar result = 0;
+  Real result = 0;
   for (int i = 0; i < n; i++)
     result += wt[i] * (u->dx[i] * v->val[i]);
   return result;
@@ -67,7 +70,7 @@ Scalar int_dudx_v(int n, double *wt, Func<Real> *u, Func<Real> *v)
 template<typename Real, typename Scalar>
 Scalar int_dudy_v(int n, double *wt, Func<Real> *u, Func<Real> *v)
 {
-  Scalar result = 0;
+  Real result = 0;
   for (int i = 0; i < n; i++)
     result += wt[i] * (u->dy[i] * v->val[i]);
   return result;
@@ -76,7 +79,7 @@ Scalar int_dudy_v(int n, double *wt, Func<Real> *u, Func<Real> *v)
 template<typename Real, typename Scalar>
 Scalar int_u_dvdx(int n, double *wt, Func<Real> *u, Func<Real> *v)
 {
-  Scalar result = 0;
+  Real result = 0;
   for (int i = 0; i < n; i++)
     result += wt[i] * (v->dx[i] * u->val[i]);
   return result;
@@ -85,7 +88,7 @@ Scalar int_u_dvdx(int n, double *wt, Func<Real> *u, Func<Real> *v)
 template<typename Real, typename Scalar>
 Scalar int_u_dvdy(int n, double *wt, Func<Real> *u, Func<Real> *v)
 {
-  Scalar result = 0;
+  Real result = 0;
   for (int i = 0; i < n; i++)
     result += wt[i] * (v->dy[i] * u->val[i]);
   return result;
@@ -94,7 +97,7 @@ Scalar int_u_dvdy(int n, double *wt, Func<Real> *u, Func<Real> *v)
 template<typename Real, typename Scalar>
 Scalar int_dudx_dvdx(int n, double *wt, Func<Real> *u, Func<Real> *v)
 {
-  Scalar result = 0;
+  Real result = 0;
   for (int i = 0; i < n; i++)
     result += wt[i] * (u->dx[i] * v->dx[i]);
   return result;
@@ -103,7 +106,7 @@ Scalar int_dudx_dvdx(int n, double *wt, Func<Real> *u, Func<Real> *v)
 template<typename Real, typename Scalar>
 Scalar int_dudy_dvdy(int n, double *wt, Func<Real> *u, Func<Real> *v)
 {
-  Scalar result = 0;
+  Real result = 0;
   for (int i = 0; i < n; i++)
     result += wt[i] * (u->dy[i] * v->dy[i]);
   return result;
@@ -112,7 +115,7 @@ Scalar int_dudy_dvdy(int n, double *wt, Func<Real> *u, Func<Real> *v)
 template<typename Real, typename Scalar>
 Scalar int_dudx_dvdy(int n, double *wt, Func<Real> *u, Func<Real> *v)
 {
-  Scalar result = 0;
+  Real result = 0;
   for (int i = 0; i < n; i++)
     result += wt[i] * (u->dx[i] * v->dy[i]);
   return result;
@@ -121,7 +124,7 @@ Scalar int_dudx_dvdy(int n, double *wt, Func<Real> *u, Func<Real> *v)
 template<typename Real, typename Scalar>
 Scalar int_dudy_dvdx(int n, double *wt, Func<Real> *u, Func<Real> *v)
 {
-  Scalar result = 0;
+  Real result = 0;
   for (int i = 0; i < n; i++)
     result += wt[i] * (v->dx[i] * u->dy[i]);
   return result;
@@ -130,7 +133,7 @@ Scalar int_dudy_dvdx(int n, double *wt, Func<Real> *u, Func<Real> *v)
 template<typename Real, typename Scalar>
 Scalar int_w_nabla_u_v(int n, double *wt, Func<Real> *w1, Func<Real> *w2, Func<Real> *u, Func<Real> *v)
 {
-  Scalar result = 0;
+  Real result = 0;
   for (int i = 0; i < n; i++)
     result += wt[i] * (w1->val[i] * u->dx[i] + w2->val[i] * u->dy[i]) * v->val[i];
   return result;
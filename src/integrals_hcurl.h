@@ -23,7 +23,7 @@
 template<typename Real, typename Scalar>
 Scalar int_e_f(int n, double *wt, Func<Real> *u, Func<Real> *v)
 {
-  Scalar result = 0;
+  Real result = 0;
   for (int i = 0; i < n; i++)
     result += wt[i] * (u->val0[i] * conj(v->val0[i]) + u->val1[i] * conj(v->val1[i]));
   return result;
@@ -32,7 +32,7 @@ Scalar int_e_f(int n, double *wt, Func<Real> *u, Func<Real> *v)
 template<typename Real, typename Scalar>
 Scalar int_curl_e_curl_f(int n, double *wt, Func<Real> *u, Func<Real> *v)
 {
-  Scalar result = 0;
+  Real result = 0;
   for (int i = 0; i < n; i++)
     result += wt[i] * (u->curl[i] * conj(v->curl[i]));
   return result;
@@ -41,7 +41,7 @@ Scalar int_curl_e_curl_f(int n, double *wt, Func<Real> *u, Func<Real> *v)
 template<typename Real, typename Scalar>
 Scalar int_v1(int n, double *wt, Func<Real> *v)
 {
-  Scalar result = 0;
+  Real result = 0;
   for (int i = 0; i < n; i++)
     result += wt[i] * (v->val1[i]);
   return result;
@@ -50,7 +50,7 @@ Scalar int_v1(int n, double *wt, Func<Real> *v)
 template<typename Real, typename Scalar>
 Scalar int_F_e_f(int n, double *wt, double (*F)(int marker, Real x, Real y), Func<Real> *u, Func<Real> *v, Geom<Real> *e)
 {
-  Scalar result = 0;
+  Real result = 0;
   for (int i = 0; i < n; i++)
     result += wt[i] * (*F)(e->marker, e->x[i], e->y[i]) * (u->val0[i] * conj(v->val0[i]) + u->val1[i] * conj(v->val1[i]));
   return result;
@@ -59,7 +59,7 @@ Scalar int_F_e_f(int n, double *wt, double (*F)(int marker, Real x, Real y), Fun
 template<typename Real, typename Scalar>
 Scalar int_e_tau_f_tau(int n, double *wt, Func<Real> *u, Func<Real> *v, Geom<Real> *e)
 {
-  Scalar result = 0;
+  Real result = 0;
   for (int i = 0; i < n; i++)
     result += wt[i] * (    (u->val0[i] * e->tx[i] + u->val1[i] * e->ty[i]) *
                        conj(v->val0[i] * e->tx[i] + v->val1[i] * e->ty[i]));
@@ -719,7 +719,7 @@ void Linearizer::process_solution(MeshFunction* sln, int item, double eps, doubl
 
   // obtain the solution in vertices, estimate the maximum solution value
   Element* e;
-  for_all_active_elements(e, mesh)
+  for_all_active_elements_fast(e, mesh)
   {
     sln->set_active_element(e);
     sln->set_quad_order(0, item);
@@ -753,7 +753,7 @@ void Linearizer::process_solution(MeshFunction* sln, int item, double eps, doubl
   }
 
   // process all elements of the mesh
-  for_all_active_elements(e, mesh)
+  for_all_active_elements_fast(e, mesh)
   {
     sln->set_active_element(e);
     sln->set_quad_order(0, item);
@@ -112,7 +112,7 @@ void Orderizer::process_solution(Space* space)
 
   // make a mesh illustrating the distribution of polynomial orders over the space
   Element* e;
-  for_all_active_elements(e, mesh)
+  for_all_active_elements_fast(e, mesh)
   {
     oo = o[4] = o[5] = space->get_element_order(e->id);
     for (unsigned int k = 0; k < e->nvert; k++)
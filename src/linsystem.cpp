@@ -24,6 +24,7 @@
 #include "solution.h"
 #include "config.h"
 #include "limit_order.h"
+#include "weakform_parser.h"
 #include <algorithm>
 
 #include "solvers.h"
@@ -54,6 +55,8 @@ void LinSystem::init_lin(WeakForm* wf_, CommonSolver* solver_)
   this->struct_changed = true;
   this->have_spaces = false;
   this->want_dir_contrib = true;
+  this->part_rank = -1;
+  this->grp_valid = false;
 
   this->set_linearity();
 }
@@ -373,6 +376,7 @@ void LinSystem::free()
   free_matrix();
   free_vectors();
   free_spaces();
+  free_group_blocks();
 
   this->struct_changed = this->values_changed = true;
   memset(this->sp_seq, -1, sizeof(int) * this->wf->neq);
@@ -426,6 +430,9 @@ void LinSystem::create_matrix(bool rhsonly)
   else if (rhsonly)
     error("Cannot reassemble RHS only: spaces have changed.");
 
+  // the blocks of the time-invariant forms have to be integrated again
+  this->free_group_blocks();
+
   // spaces have changed: create the matrix from scratch
   this->free_matrix();
   trace("Creating matrix sparse structure...");
@@ -498,6 +505,7 @@ void LinSystem::assemble(bool rhsonly)
   AsmList* am, * an;
   bool bnd[4];
   std::vector<bool> nat(wf->neq), isempty(wf->neq);
+  std::vector<Element*> ael(wf->neq);
   EdgePos ep[4];
   reset_warn_order();
 
@@ -507,6 +515,16 @@ void LinSystem::assemble(bool rhsonly)
   // create the sparse structure
   create_matrix(rhsonly);
 
+  if (rhsonly)
+  {
+    // the bilinear forms are not evaluated, but the essential BC values may have changed
+    if (dir_bc_seq.size() == (unsigned) wf->neq)
+      for (int i = 0; i < wf->neq; i++)
+        if (spaces[i]->get_bc_seq() != dir_bc_seq[i]) { update_dir_lift(); break; }
+  }
+  else
+    remove_dir_couplings(grp_valid);
+
   trace("Assembling stiffness matrix...");
   TimePeriod cpu_time;
 
@@ -531,6 +549,16 @@ void LinSystem::assemble(bool rhsonly)
   std::vector<WeakForm::Stage> stages;
   wf->get_stages(spaces, stages, rhsonly);
 
+  // the time-invariant forms are integrated only if their blocks are not cached
+  std::vector<CooMatrix*> grp_blocks;
+  if (!rhsonly && !grp_valid)
+    for (int g = 0; g < wf->get_num_groups(); g++)
+#ifdef H2D_COMPLEX
+      grp_blocks.push_back(new CooMatrix(ndof, true));
+#else
+      grp_blocks.push_back(new CooMatrix(ndof));
+#endif
+
   // Loop through all assembling stages -- the purpose of this is increased performance
   // in multi-mesh calculations, where, e.g., only the right hand side uses two meshes.
   // In such a case, the bilinear forms are assembled over one mesh, and only the rhs
@@ -540,6 +568,18 @@ void LinSystem::assemble(bool rhsonly)
   for (unsigned int ss = 0; ss < stages.size(); ss++)
   {
     WeakForm::Stage* s = &stages[ss];
+
+    // skip the stage if all its forms are cached
+    if (grp_valid && s->rfvol.empty() && s->rfsurf.empty())
+    {
+      bool cached = true;
+      for (unsigned int ww = 0; ww < s->jfvol.size(); ww++)
+        if (s->jfvol[ww]->group < 0) cached = false;
+      for (unsigned int ww = 0; ww < s->jfsurf.size(); ww++)
+        if (s->jfsurf[ww]->group < 0) cached = false;
+      if (cached) continue;
+    }
+
     for (unsigned int i = 0; i < s->idx.size(); i++)
       s->fns[i] = pss[s->idx[i]];
     for (unsigned int i = 0; i < s->ext.size(); i++)
@@ -550,6 +590,9 @@ void LinSystem::assemble(bool rhsonly)
     Element** e;
     while ((e = trav.get_next_state(bnd, ep)) != NULL)
     {
+      // skip elements of other parts
+      if (!part.empty() && part[trav.get_base()->id] != part_rank) continue;
+
       // find a non-NULL e[i]
       Element* e0 = NULL;
       for (unsigned int i = 0; i < s->idx.size(); i++)
@@ -567,6 +610,7 @@ void LinSystem::assemble(bool rhsonly)
         if (e[i] == NULL) { isempty[j] = true; continue; }
         spaces[j]->get_element_assembly_list(e[i], &al[j]);
         /** \todo Do not retrieve assembly list again if the element has not changed */
+        ael[j] = e[i];
 
         spss[j]->set_active_element(e[i]);
         spss[j]->set_master_transform();
@@ -582,16 +626,19 @@ void LinSystem::assemble(bool rhsonly)
         WeakForm::JacFormVol* jfv = s->jfvol[ww];
         if (isempty[jfv->i] || isempty[jfv->j]) continue;
         if (jfv->area != H2D_ANY && !wf->is_in_area(marker, jfv->area)) continue;
+        int g = jfv->group;
+        if (g >= 0 && grp_valid) continue;
         m = jfv->i;  fv = spss[m];  am = &al[m];
         n = jfv->j;  fu = pss[n];   an = &al[n];
         bool tra = (m != n) && (jfv->sym != 0);
         bool sym = (m == n) && (jfv->sym == 1);
 
         // assemble the local stiffness matrix for the form jfv
-        scalar bi, **mat = get_matrix_buffer(std::max(am->cnt, an->cnt));
+        scalar fval, bi, **mat = get_matrix_buffer(std::max(am->cnt, an->cnt));
         for (int i = 0; i < am->cnt; i++)
         {
-          if (!tra && (k = am->dof[i]) < 0) continue;
+          k = am->dof[i];
+          if (!tra && k < 0) continue;
           fv->set_active_shape(am->idx[i]);
 
           if (!sym) // unsymmetric block
@@ -600,10 +647,18 @@ void LinSystem::assemble(bool rhsonly)
               fu->set_active_shape(an->idx[j]);
               // FIXME - the NULL on the following line is temporary, an array of solutions 
               // should be passed there.
-              bi = eval_form(jfv, NULL, fu, fv, &refmap[n], &refmap[m]) * an->coef[j] * am->coef[i];
-              if (an->dof[j] < 0) Dir[k] -= bi; 
+              fval = eval_form(jfv, NULL, fu, fv, &refmap[n], &refmap[m]);
+              bi = fval * an->coef[j] * am->coef[i];
+              if (an->dof[j] < 0) {
+                if (k >= 0) {
+                  if (g < 0) Dir[k] -= bi;
+                  add_dir_coupling(n, ael[n], -1, g, k, j, fval * am->coef[i]);
+                }
+              }
               else {
                 mat[i][j] = bi;
+                // Dirichlet row of the transposed block, see below
+                if (k < 0) add_dir_coupling(m, ael[m], -1, g, an->dof[j], i, (jfv->sym < 0 ? -fval : fval) * an->coef[j]);
                 //if (an->dof[j] == 15 && an->dof[i] == 15) printf("%d %d %g\n", i, j, bi);
               }
             }
@@ -615,8 +670,12 @@ void LinSystem::assemble(bool rhsonly)
               fu->set_active_shape(an->idx[j]);
               // FIXME - the NULL on the following line is temporary, an array of solutions 
               // should be passed there.
-              bi = eval_form(jfv, NULL, fu, fv, &refmap[n], &refmap[m]) * an->coef[j] * am->coef[i];
-              if (an->dof[j] < 0) Dir[k] -= bi; 
+              fval = eval_form(jfv, NULL, fu, fv, &refmap[n], &refmap[m]);
+              bi = fval * an->coef[j] * am->coef[i];
+              if (an->dof[j] < 0) {
+                if (g < 0) Dir[k] -= bi;
+                add_dir_coupling(n, ael[n], -1, g, k, j, fval * am->coef[i]);
+              }
               else {
                 mat[i][j] = mat[j][i] = bi;
                 //if (an->dof[j] == 15 && an->dof[i] == 15) printf("%d %d %g\n", i, j, bi);
@@ -625,19 +684,21 @@ void LinSystem::assemble(bool rhsonly)
           }
         }
 
-        // insert the local stiffness matrix into the global one
-        insert_block(mat, am->dof, an->dof, am->cnt, an->cnt);
+        // insert the local stiffness matrix into the global one (or into the group block)
+        if (g >= 0) grp_blocks[g]->add_block(am->dof, am->cnt, an->dof, an->cnt, mat);
+        else insert_block(mat, am->dof, an->dof, am->cnt, an->cnt);
 
         // insert also the off-diagonal (anti-)symmetric block, if required
         if (tra)
         {
           if (jfv->sym < 0) chsgn(mat, am->cnt, an->cnt);
           transpose(mat, am->cnt, an->cnt);
-          insert_block(mat, an->dof, am->dof, an->cnt, am->cnt);
+          if (g >= 0) grp_blocks[g]->add_block(an->dof, an->cnt, am->dof, am->cnt, mat);
+          else insert_block(mat, an->dof, am->dof, an->cnt, am->cnt);
 
-          // we also need to take care of the RHS...
+          // we also need to take care of the RHS (the lift of group forms is added later)...
           for (int j = 0; j < am->cnt; j++)
-            if (am->dof[j] < 0)
+            if (g < 0 && am->dof[j] < 0)
               for (int i = 0; i < an->cnt; i++)
                 if (an->dof[i] >= 0) {
                   Dir[an->dof[i]] -= mat[i][j];
@@ -687,6 +748,8 @@ void LinSystem::assemble(bool rhsonly)
           WeakForm::JacFormSurf* jfs = s->jfsurf[ww];
           if (isempty[jfs->i] || isempty[jfs->j]) continue;
           if (jfs->area != H2D_ANY && !wf->is_in_area(marker, jfs->area)) continue;
+          int g = jfs->group;
+          if (g >= 0 && grp_valid) continue;
           m = jfs->i;  fv = spss[m];  am = &al[m];
           n = jfs->j;  fu = pss[n];   an = &al[n];
 
@@ -695,7 +758,7 @@ void LinSystem::assemble(bool rhsonly)
           ep[edge].space_v = spaces[m];
           ep[edge].space_u = spaces[n];
 
-          scalar bi, **mat = get_matrix_buffer(std::max(am->cnt, an->cnt));
+          scalar fval, bi, **mat = get_matrix_buffer(std::max(am->cnt, an->cnt));
           for (int i = 0; i < am->cnt; i++)
           {
             if ((k = am->dof[i]) < 0) continue;
@@ -705,12 +768,18 @@ void LinSystem::assemble(bool rhsonly)
               fu->set_active_shape(an->idx[j]);
               // FIXME - the NULL on the following line is temporary, an array of solutions 
               // should be passed there.
-              bi = eval_form(jfs, NULL, fu, fv, &refmap[n], &refmap[m], &(ep[edge])) * an->coef[j] * am->coef[i];
-              if (an->dof[j] >= 0) mat[i][j] = bi; else Dir[k] -= bi;
+              fval = eval_form(jfs, NULL, fu, fv, &refmap[n], &refmap[m], &(ep[edge]));
+              bi = fval * an->coef[j] * am->coef[i];
+              if (an->dof[j] >= 0) mat[i][j] = bi;
+              else {
+                if (g < 0) Dir[k] -= bi;
+                add_dir_coupling(n, ael[n], edge, g, k, j, fval * am->coef[i]);
+              }
               //printf("%d %d %g\n", i, j, bi);
             }
           }
-          insert_block(mat, am->dof, an->dof, am->cnt, an->cnt);
+          if (g >= 0) grp_blocks[g]->add_block(am->dof, am->cnt, an->dof, an->cnt, mat);
+          else insert_block(mat, am->dof, an->dof, am->cnt, an->cnt);
         }
 
         // assemble surface linear forms /////////////////////////////////////
@@ -742,6 +811,21 @@ void LinSystem::assemble(bool rhsonly)
     trav.finish();
   }
 
+  if (!rhsonly)
+  {
+    // add the time-invariant forms multiplied by their group coefficients
+    if (!grp_blocks.empty()) build_group_blocks(grp_blocks);
+    if (grp_valid)
+    {
+      add_group_blocks();
+      add_dir_lift(true);
+    }
+
+    dir_bc_seq.resize(wf->neq);
+    for (int i = 0; i < wf->neq; i++)
+      dir_bc_seq[i] = spaces[i]->get_bc_seq();
+  }
+
   // add to RHS the dirichlet contributions
   if (want_dir_contrib) {
     for (int i = 0; i < ndof; i++) {
@@ -759,6 +843,163 @@ void LinSystem::assemble(bool rhsonly)
   //this->A->print();
 }
 
+void LinSystem::add_dir_coupling(int i, Element* e, int edge, int group, int k, int j, scalar val)
+{
+  if (dir_blocks.empty() || dir_blocks.back().i != i || dir_blocks.back().e_id != e->id
+      || dir_blocks.back().edge != edge || dir_blocks.back().group != group)
+  {
+    DirBlock b = { i, e->id, edge, group, dir_coup.size() };
+    dir_blocks.push_back(b);
+  }
+  DirCoupling c = { k, j, val };
+  dir_coup.push_back(c);
+}
+
+void LinSystem::add_dir_lift(bool groups_only)
+{
+  // the assembly lists are cheap to obtain and they carry the new essential BC values
+  // in the coefficients of the Dirichlet shape functions, so the lift is just a product
+  // of the stored couplings with these coefficients
+  AsmList al;
+  for (unsigned int b = 0; b < dir_blocks.size(); b++)
+  {
+    DirBlock* db = &dir_blocks[b];
+    if (groups_only && db->group < 0) continue;
+    Space* space = spaces[db->i];
+    Element* e = space->get_mesh()->get_element(db->e_id);
+    if (db->edge < 0) space->get_element_assembly_list(e, &al);
+    else space->get_edge_assembly_list(e, db->edge, &al);
+
+    scalar gc = wf->get_group_coef(db->group);
+    int end = (b+1 < dir_blocks.size()) ? dir_blocks[b+1].first : dir_coup.size();
+    for (int c = db->first; c < end; c++)
+      Dir[dir_coup[c].k] -= gc * dir_coup[c].val * al.coef[dir_coup[c].j];
+  }
+}
+
+void LinSystem::update_dir_lift()
+{
+  memset(Dir, 0, sizeof(scalar) * Dir_length);
+  add_dir_lift(false);
+
+  for (int i = 0; i < wf->neq; i++)
+    dir_bc_seq[i] = spaces[i]->get_bc_seq();
+  verbose("Dirichlet lift updated (%d couplings)", dir_coup.size());
+}
+
+void LinSystem::remove_dir_couplings(bool keep_groups)
+{
+  if (!keep_groups)
+  {
+    dir_blocks.clear();
+    dir_coup.clear();
+    return;
+  }
+
+  // keep the couplings of the cached time-invariant forms
+  unsigned int nb = 0, nc = 0;
+  for (unsigned int b = 0; b < dir_blocks.size(); b++)
+  {
+    if (dir_blocks[b].group < 0) continue;
+    int end = (b+1 < dir_blocks.size()) ? dir_blocks[b+1].first : dir_coup.size();
+    DirBlock db = dir_blocks[b];
+    db.first = nc;
+    for (int c = dir_blocks[b].first; c < end; c++)
+      dir_coup[nc++] = dir_coup[c];
+    dir_blocks[nb++] = db;
+  }
+  dir_blocks.resize(nb);
+  dir_coup.resize(nc);
+}
+
+//// time-invariant form groups ////////////////////////////////////////////////////////////////////
+
+void LinSystem::free_group_blocks()
+{
+  grp_Ap.clear();
+  grp_Ai.clear();
+  grp_Ax.clear();
+  grp_valid = false;
+}
+
+static inline const std::map<size_t, std::map<size_t, scalar> >& get_entries(CooMatrix* m)
+{
+#ifdef H2D_COMPLEX
+  return m->get_entries_cplx();
+#else
+  return m->get_entries();
+#endif
+}
+
+void LinSystem::build_group_blocks(std::vector<CooMatrix*>& blocks)
+{
+  typedef std::map<size_t, std::map<size_t, scalar> > Entries;
+  int ng = blocks.size(), ndof = get_num_dofs(), g, r;
+
+  // the common pattern is the union of the patterns of the groups
+  std::vector<Entries::const_iterator> row(ng);
+  for (g = 0; g < ng; g++)
+    row[g] = get_entries(blocks[g]).begin();
+
+  grp_Ap.assign(ndof + 1, 0);
+  grp_Ai.clear();
+  std::vector<int> cols;
+  for (r = 0; r < ndof; r++)
+  {
+    cols.clear();
+    for (g = 0; g < ng; g++)
+      if (row[g] != get_entries(blocks[g]).end() && (int) row[g]->first == r)
+      {
+        for (std::map<size_t, scalar>::const_iterator it = row[g]->second.begin(); it != row[g]->second.end(); ++it)
+          cols.push_back(it->first);
+        ++row[g];
+      }
+    std::sort(cols.begin(), cols.end());
+    cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+    grp_Ai.insert(grp_Ai.end(), cols.begin(), cols.end());
+    grp_Ap[r+1] = grp_Ai.size();
+  }
+
+  // values of each group on the common pattern
+  grp_Ax.assign(ng, std::vector<scalar>(grp_Ai.size(), 0.0));
+  for (g = 0; g < ng; g++)
+  {
+    const Entries& entries = get_entries(blocks[g]);
+    for (Entries::const_iterator it_row = entries.begin(); it_row != entries.end(); ++it_row)
+    {
+      r = it_row->first;
+      int* first = &grp_Ai[0] + grp_Ap[r];
+      int* last = &grp_Ai[0] + grp_Ap[r+1];
+      for (std::map<size_t, scalar>::const_iterator it = it_row->second.begin(); it != it_row->second.end(); ++it)
+        grp_Ax[g][std::lower_bound(first, last, (int) it->first) - &grp_Ai[0]] = it->second;
+    }
+    delete blocks[g];
+  }
+  blocks.clear();
+
+  grp_valid = true;
+  verbose("Time-invariant matrix forms assembled (groups: %d, nnz: %d)", ng, grp_Ai.size());
+}
+
+void LinSystem::add_group_blocks()
+{
+  int ng = grp_Ax.size();
+  std::vector<scalar> gc(ng);
+  for (int g = 0; g < ng; g++)
+    gc[g] = wf->get_group_coef(g);
+
+  // one pass over the common pattern combines the values of all groups
+  int ndof = grp_Ap.size() - 1;
+  for (int r = 0; r < ndof; r++)
+    for (int k = grp_Ap[r]; k < grp_Ap[r+1]; k++)
+    {
+      scalar val = 0.0;
+      for (int g = 0; g < ng; g++)
+        val += gc[g] * grp_Ax[g][k];
+      A->add(r, grp_Ai[k], val);
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // Initialize integration order for external functions
@@ -851,9 +1092,11 @@ scalar LinSystem::eval_form(WeakForm::JacFormVol *jfv, Solution *sln[], PrecalcS
 
   double fake_wt = 1.0;
   Geom<Ord>* fake_e = init_geom_ord();
-  Ord o = jfv->ord(1, &fake_wt, oi, ou, ov, fake_e, fake_ext);
+  Ord o = jfv->prog ? jfv->prog->eval_ord(ou, ov, fake_e)
+                    : jfv->ord(1, &fake_wt, oi, ou, ov, fake_e, fake_ext);
   int order = ru->get_inv_ref_order();
-  order += o.get_order();
+  order += o.get_order() + jfv->ord_offset;
+  if (order < 0) order = 0;
   limit_order_nowarn(order);
 
   for (int i = 0; i < wf->neq; i++) {  
@@ -902,7 +1145,8 @@ scalar LinSystem::eval_form(WeakForm::JacFormVol *jfv, Solution *sln[], PrecalcS
   Func<double>* v = get_fn(fv, rv, order);
   ExtData<scalar>* ext = init_ext_fns(jfv->ext, rv, order);
 
-  scalar res = jfv->fn(np, jwt, prev, u, v, e, ext);
+  scalar res = jfv->prog ? jfv->prog->eval(np, jwt, u, v, e)
+                         : jfv->fn(np, jwt, prev, u, v, e, ext);
 
   for (int i = 0; i < wf->neq; i++) {  
     if (prev[i] != NULL) prev[i]->free_fn(); delete prev[i]; 
@@ -933,9 +1177,11 @@ scalar LinSystem::eval_form(WeakForm::ResFormVol *rfv, Solution *sln[], PrecalcS
 
   double fake_wt = 1.0;
   Geom<Ord>* fake_e = init_geom_ord();
-  Ord o = rfv->ord(1, &fake_wt, oi, ov, fake_e, fake_ext);
+  Ord o = rfv->prog ? rfv->prog->eval_ord(NULL, ov, fake_e)
+                    : rfv->ord(1, &fake_wt, oi, ov, fake_e, fake_ext);
   int order = rv->get_inv_ref_order();
-  order += o.get_order();
+  order += o.get_order() + rfv->ord_offset;
+  if (order < 0) order = 0;
   limit_order_nowarn(order);
 
   for (int i = 0; i < wf->neq; i++) { 
@@ -980,7 +1226,8 @@ scalar LinSystem::eval_form(WeakForm::ResFormVol *rfv, Solution *sln[], PrecalcS
   Func<double>* v = get_fn(fv, rv, order);
   ExtData<scalar>* ext = init_ext_fns(rfv->ext, rv, order);
 
-  scalar res = rfv->fn(np, jwt, prev, v, e, ext);
+  scalar res = rfv->prog ? rfv->prog->eval(np, jwt, NULL, v, e)
+                         : rfv->fn(np, jwt, prev, v, e, ext);
 
   for (int i = 0; i < wf->neq; i++) { 
     if (prev[i] != NULL) {
@@ -1031,7 +1278,8 @@ scalar LinSystem::eval_form(WeakForm::JacFormSurf *jfs, Solution *sln[], Precalc
   Func<double>* v = get_fn(fv, rv, eo);
   ExtData<scalar>* ext = init_ext_fns(jfs->ext, rv, eo);
 
-  scalar res = jfs->fn(np, jwt, prev, u, v, e, ext);
+  scalar res = jfs->prog ? jfs->prog->eval(np, jwt, u, v, e)
+                         : jfs->fn(np, jwt, prev, u, v, e, ext);
 
   for (int i = 0; i < wf->neq; i++) { 
     if (prev[i] != NULL) {
@@ -1083,7 +1331,8 @@ scalar LinSystem::eval_form(WeakForm::ResFormSurf *rfs, Solution *sln[], Precalc
   Func<double>* v = get_fn(fv, rv, eo);
   ExtData<scalar>* ext = init_ext_fns(rfs->ext, rv, eo);
 
-  scalar res = rfs->fn(np, jwt, prev, v, e, ext);
+  scalar res = rfs->prog ? rfs->prog->eval(np, jwt, NULL, v, e)
+                         : rfs->fn(np, jwt, prev, v, e, ext);
 
   for (int i = 0; i < wf->neq; i++) {  
     if (prev[i] != NULL) {prev[i]->free_fn(); delete prev[i]; }
@@ -1096,6 +1345,166 @@ scalar LinSystem::eval_form(WeakForm::ResFormSurf *rfs, Solution *sln[], Precalc
 
 
 
+//// integration order calibration ////////////////////////////////////////////////////////////
+
+// values of the form jfv (or rfv, if jfv is NULL) for all (pairs of) shape functions on 'e'
+void LinSystem::eval_form_all(WeakForm::JacFormVol *jfv, WeakForm::ResFormVol *rfv, Element* e, std::vector<scalar>& values)
+{
+  int m = jfv ? jfv->i : rfv->i;
+  int n = jfv ? jfv->j : m;
+  std::vector<MeshFunction*>& ext = jfv ? jfv->ext : rfv->ext;
+
+  update_limit_table(e->get_mode());
+  AsmList am, an;
+  spaces[m]->get_element_assembly_list(e, &am);
+  spaces[n]->get_element_assembly_list(e, &an);
+
+  PrecalcShapeset* fu = pss[n];
+  PrecalcShapeset fv(pss[m]);
+  fu->set_quad_2d(&g_quad_2d_std);
+  fv.set_quad_2d(&g_quad_2d_std);
+  fu->set_active_element(e);
+  fu->reset_transform();
+  fv.set_active_element(e);
+  fv.set_master_transform();
+  RefMap rm;
+  rm.set_quad_2d(&g_quad_2d_std);
+  rm.set_active_element(e);
+  rm.reset_transform();
+  for (unsigned int k = 0; k < ext.size(); k++)
+  {
+    ext[k]->set_quad_2d(&g_quad_2d_std);
+    ext[k]->set_active_element(e);
+    ext[k]->reset_transform();
+  }
+
+  init_cache();
+  values.clear();
+  for (int i = 0; i < am.cnt; i++)
+  {
+    fv.set_active_shape(am.idx[i]);
+    if (jfv == NULL)
+    {
+      values.push_back(eval_form(rfv, NULL, &fv, &rm));
+      continue;
+    }
+    for (int j = 0; j < an.cnt; j++)
+    {
+      fu->set_active_shape(an.idx[j]);
+      values.push_back(eval_form(jfv, NULL, fu, &fv, &rm, &rm));
+    }
+  }
+  delete_cache();
+}
+
+// maximum difference from the reference values, relative to 'scale', at the current offset
+double LinSystem::calib_error(WeakForm::JacFormVol *jfv, WeakForm::ResFormVol *rfv, std::vector<Element*>& samples,
+                              std::vector<std::vector<scalar> >& ref, double scale)
+{
+  std::vector<scalar> values;
+  double err = 0.0;
+  for (unsigned int s = 0; s < samples.size(); s++)
+  {
+    eval_form_all(jfv, rfv, samples[s], values);
+    for (unsigned int k = 0; k < values.size(); k++)
+      err = std::max(err, (double) std::abs(values[k] - ref[s][k]));
+  }
+  return err / scale;
+}
+
+// returns the smallest offset of the automatic order meeting the tolerance
+int LinSystem::calibrate_form(WeakForm::JacFormVol *jfv, WeakForm::ResFormVol *rfv, int num_samples, double tol)
+{
+  const int max_up = 10, max_down = 64;
+  int m = jfv ? jfv->i : rfv->i;
+  int n = jfv ? jfv->j : m;
+  int area = jfv ? jfv->area : rfv->area;
+  std::vector<MeshFunction*>& ext = jfv ? jfv->ext : rfv->ext;
+  int& offset = jfv ? jfv->ord_offset : rfv->ord_offset;
+
+  // only forms whose functions all live on one mesh can be sampled element by element
+  Mesh* mesh = spaces[m]->get_mesh();
+  bool single_mesh = (spaces[n]->get_mesh() == mesh);
+  for (unsigned int k = 0; k < ext.size(); k++)
+    if (ext[k]->get_mesh() != mesh) single_mesh = false;
+  if (!single_mesh)
+  {
+    warn("Multi-mesh forms cannot be calibrated, the integration order is left unchanged.");
+    return offset;
+  }
+
+  // sample elements, evenly spread over the active elements of the form's area
+  std::vector<Element*> elems, samples;
+  Element* e;
+  for_all_active_elements_fast(e, mesh)
+    if (area == H2D_ANY || wf->is_in_area(e->marker, area))
+      elems.push_back(e);
+  if (elems.empty()) return offset;
+  int ns = std::min(num_samples, (int) elems.size());
+  for (int s = 0; s < ns; s++)
+    samples.push_back(elems[(long) s * elems.size() / ns]);
+
+  // reference values at the maximum order
+  int old_offset = offset;
+  offset = g_max_quad;
+  std::vector<std::vector<scalar> > ref(samples.size());
+  double scale = 0.0;
+  for (unsigned int s = 0; s < samples.size(); s++)
+  {
+    eval_form_all(jfv, rfv, samples[s], ref[s]);
+    for (unsigned int k = 0; k < ref[s].size(); k++)
+      scale = std::max(scale, (double) std::abs(ref[s][k]));
+  }
+  if (scale == 0.0) { offset = old_offset; return offset; }
+
+  // if the automatic order is accurate enough, bisect for the lowest accurate one
+  // (the error decreases with the order for smooth integrands), otherwise go up
+  offset = 0;
+  if (calib_error(jfv, rfv, samples, ref, scale) > tol)
+  {
+    int shift = 0;
+    while (shift < max_up)
+    {
+      offset = ++shift;
+      if (calib_error(jfv, rfv, samples, ref, scale) <= tol) break;
+    }
+    return offset;
+  }
+  int lo = -max_down, hi = 0;
+  offset = lo;
+  if (calib_error(jfv, rfv, samples, ref, scale) <= tol) return offset;
+  while (hi - lo > 1)
+  {
+    int mid = (lo + hi) / 2;
+    offset = mid;
+    if (calib_error(jfv, rfv, samples, ref, scale) <= tol) hi = mid;
+    else lo = mid;
+  }
+  offset = hi;
+  return offset;
+}
+
+void LinSystem::calibrate_orders(double tol, int num_samples)
+{
+  if (this->have_spaces == false)
+    error("Before calibrate_orders(), you need to initialize spaces.");
+  if (num_samples < 1) error("At least one sample element is needed in calibrate_orders().");
+  this->assign_dofs();
+
+  for (unsigned int k = 0; k < wf->jfvol.size(); k++)
+  {
+    int offset = calibrate_form(&wf->jfvol[k], NULL, num_samples, tol);
+    verbose("Matrix form %d: integration order offset %d.", k, offset);
+  }
+  for (unsigned int k = 0; k < wf->rfvol.size(); k++)
+  {
+    int offset = calibrate_form(NULL, &wf->rfvol[k], num_samples, tol);
+    verbose("Vector form %d: integration order offset %d.", k, offset);
+  }
+}
+
+
+
 //// solve /////////////////////////////////////////////////////////////////////////////////////////
 
 bool LinSystem::solve(Tuple<Solution*> sln)
@@ -1475,6 +1884,519 @@ void LinSystem::project_global( Tuple<MeshFunction*> source, Tuple<Solution*> ta
   wf_seq = -1;
 }
 
+// projection-based interpolation
+
+// Inner product of two transformed functions in the norm used for the element
+// interiors in project_local(). Shape functions are real, so no conjugation is needed.
+template<typename Scalar>
+static Scalar pbi_product(int norm, int n, double* jwt, Func<double>* u, Func<Scalar>* v)
+{
+  Scalar result = 0;
+  if (u->nc == 1)
+  {
+    for (int i = 0; i < n; i++)
+      result += jwt[i] * (u->val[i] * v->val[i]);
+    if (norm == 1)
+      for (int i = 0; i < n; i++)
+        result += jwt[i] * (u->dx[i] * v->dx[i] + u->dy[i] * v->dy[i]);
+  }
+  else
+  {
+    for (int i = 0; i < n; i++)
+      result += jwt[i] * (u->val0[i] * v->val0[i] + u->val1[i] * v->val1[i]);
+    if (norm == 2)
+      for (int i = 0; i < n; i++)
+        result += jwt[i] * (u->curl[i] * v->curl[i]);
+  }
+  return result;
+}
+
+// Integration weights multiplied by the jacobian of the current (sub)element.
+static double* pbi_jwt(Quad2D* quad, RefMap* rm, int o)
+{
+  double3* pt = quad->get_points(o);
+  int np = quad->get_num_points(o);
+  double* jwt = new double[np];
+  if (rm->is_jacobian_const())
+  {
+    double jac = rm->get_const_jacobian();
+    for (int i = 0; i < np; i++) jwt[i] = pt[i][2] * jac;
+  }
+  else
+  {
+    double* jac = rm->get_jacobian(o);
+    for (int i = 0; i < np; i++) jwt[i] = pt[i][2] * jac[i];
+  }
+  return jwt;
+}
+
+// Tests whether edge 'edge' of the current sub-element (given by ctm) lies on the same edge
+// of the element e. If so, returns the portion (s0, s1) of the edge parameter (-1, 1) it covers.
+static bool pbi_sub_edge(Shapeset* ss, Trf* ctm, int edge, int nvert, double& s0, double& s1)
+{
+  double2* a = ss->get_ref_vertex(edge);
+  double2* b = ss->get_ref_vertex((edge + 1) % nvert);
+  double dx = (*b)[0] - (*a)[0], dy = (*b)[1] - (*a)[1];
+  double len2 = sqr(dx) + sqr(dy);
+
+  double s[2];
+  double2* v[2] = { a, b };
+  for (int k = 0; k < 2; k++)
+  {
+    double x = ctm->m[0] * (*v[k])[0] + ctm->t[0] - (*a)[0];
+    double y = ctm->m[1] * (*v[k])[1] + ctm->t[1] - (*a)[1];
+    if (fabs(x*dy - y*dx) > 1e-12 * len2) return false;
+    s[k] = 2.0 * (x*dx + y*dy) / len2 - 1.0;
+  }
+  s0 = s[0]; s1 = s[1];
+  return s1 > s0;
+}
+
+// Value of the assembly list entry 'k' if it is already known, otherwise returns false.
+static bool pbi_known_value(AsmList* al, int k, scalar* vec, std::vector<bool>& known, scalar& value)
+{
+  if (al->dof[k] < 0) { value = al->coef[k]; return true; }
+  if (!known[al->dof[k]]) return false;
+  value = vec[al->dof[k]] * al->coef[k];
+  return true;
+}
+
+void LinSystem::project_local(Tuple<MeshFunction*> source, Tuple<Solution*> target, Tuple<int> proj_norms)
+{
+  // sanity checks
+  int n = source.size();
+  if (this->spaces == NULL) error("this->spaces == NULL in LinSystem::project_local().");
+  for (int i=0; i<n; i++) if(this->spaces[i] == NULL)
+			    error("this->spaces[%d] == NULL in LinSystem::project_local().", i);
+  if (n != target.size())
+    error("Mismatched numbers of projected functions and solutions in LinSystem::project_local().");
+  if (proj_norms != Tuple<int>()) {
+    if (n != proj_norms.size())
+      error("Mismatched numbers of projected functions and projection norms in LinSystem::project_local().");
+  }
+  if (wf != NULL) {
+    if (n != wf->neq)
+      error("Wrong number of functions in LinSystem::project_local().");
+  }
+  if (!have_spaces)
+    error("You have to init_spaces() before using LinSystem::project_local().");
+
+  // this is needed since spaces may have their DOFs enumerated only locally
+  // when they come here.
+  int ndof = this->assign_dofs();
+  if (ndof == 0) error("ndof = 0 in LinSystem::project_local().");
+  this->realloc_and_zero_vectors();
+
+  // time measurement
+  TimePeriod cpu_time;
+
+  std::vector<bool> known(ndof, false);
+  for (int i = 0; i < n; i++)
+  {
+    int norm;
+    int type = this->spaces[i]->get_type();
+    if (proj_norms != Tuple<int>()) norm = proj_norms[i];
+    else norm = (type == 1) ? 2 : (type == 3) ? 0 : H2D_DEFAULT_PROJ_NORM;
+
+    if (type == 2)
+      error("Projection-based interpolation is not implemented for Hdiv spaces.");
+    if (type == 1 ? (norm != 0 && norm != 2) : (norm != 0 && norm != 1)) {
+      printf("index of component: %d\n", i);
+      error("Wrong projection norm in LinSystem::project_local().");
+    }
+    if (type == 3 && norm == 1)
+      error("Only the L2 norm can be used for L2 spaces in LinSystem::project_local().");
+
+    project_local_component(i, source[i], norm, known);
+  }
+  report_time("Projection-based interpolation done in %g s", cpu_time.tick().last());
+
+  for (int i = 0; i < n; i++)
+    target[i]->set_fe_solution(this->spaces[i], this->pss[i], this->Vec);
+}
+
+void LinSystem::project_local_component(int i, MeshFunction* src, int norm, std::vector<bool>& known)
+{
+  Space* space = this->spaces[i];
+  Shapeset* ss = space->get_shapeset();
+  Mesh* mesh = space->get_mesh();
+  PrecalcShapeset* fu = this->pss[i];
+  int type = space->get_type();
+
+  Quad2D* quad = &g_quad_2d_std;
+  src->set_quad_2d(quad);
+  fu->set_quad_2d(quad);
+  RefMap rm;
+  rm.set_quad_2d(quad);
+
+  AsmList al, ael;
+  Element* e;
+  int max_id = mesh->get_max_element_id();
+
+  // 1. Vertex dofs (H1 only) are the values of the source at the vertices. This must be done
+  // before the traversal below, since point evaluation changes the active element of src.
+  if (type == 0)
+  {
+    for_all_active_elements_fast(e, mesh)
+    {
+      space->get_element_assembly_list(e, &al);
+      for (unsigned int j = 0; j < e->nvert; j++)
+      {
+        int vidx = ss->get_vertex_index(j), cnt = 0, k = -1;
+        for (int l = 0; l < al.cnt; l++)
+          if (al.idx[l] == vidx) { cnt++; k = l; }
+
+        // constrained vertices have more items in the assembly list
+        if (cnt != 1 || al.dof[k] < 0 || al.coef[k] != 1.0 || known[al.dof[k]]) continue;
+        this->Vec[al.dof[k]] = src->get_pt_value(e->vn[j]->x, e->vn[j]->y);
+        known[al.dof[k]] = true;
+      }
+    }
+  }
+
+  // Each unconstrained edge with dofs is processed in the first active element that contains it.
+  // Its edge functions are the last items of the edge assembly list.
+  std::vector<int> owner(mesh->get_max_node_id(), -1);
+  std::vector<std::vector<int> > edge_fns(4 * max_id);
+  std::vector<std::vector<scalar> > edge_mom(4 * max_id);
+  std::vector<std::vector<scalar> > bubble_mom(max_id);
+  if (type != 3)
+  {
+    for_all_active_elements_fast(e, mesh)
+    {
+      for (unsigned int j = 0; j < e->nvert; j++)
+      {
+        if (owner[e->en[j]->id] >= 0) continue;
+        owner[e->en[j]->id] = e->id;
+
+        int order = space->get_edge_order(e, j);
+        int ne = (type == 0) ? order - 1 : order + 1;
+        space->get_edge_assembly_list(e, j, &ael);
+        if (ne <= 0 || ael.cnt < ne) continue;
+
+        std::vector<int>& fns = edge_fns[4*e->id + j];
+        for (int k = ael.cnt - ne; k < ael.cnt; k++)
+        {
+          // Dirichlet or constrained edge
+          if (ael.dof[k] < 0 || ael.idx[k] < 0) { fns.clear(); break; }
+          fns.push_back(ael.idx[k]);
+        }
+        edge_mom[4*e->id + j].assign(fns.size(), 0.0);
+      }
+    }
+  }
+
+  // 2. Edge and bubble moments of the source. The source may live on a different mesh
+  // (e.g. a reference solution), so the moments are accumulated over the union mesh.
+  Mesh* meshes[2] = { mesh, src->get_mesh() };
+  Transformable* tr[2] = { fu, src };
+  Traverse trav;
+  trav.begin(2, meshes, tr);
+
+  Element** ee;
+  Element* last = NULL;
+  int nb = 0;
+  while ((ee = trav.get_next_state(NULL, NULL)) != NULL)
+  {
+    e = ee[0];
+    update_limit_table(e->get_mode());
+    if (e != last)
+    {
+      space->get_element_assembly_list(e, &al);
+      nb = ss->get_num_bubbles(space->get_element_order(e->id));
+      if (bubble_mom[e->id].empty()) bubble_mom[e->id].assign(nb, 0.0);
+      last = e;
+    }
+    rm.set_active_element(e);
+    rm.force_transform(fu->get_transform(), fu->get_ctm());
+
+    // edge moments: integrals of the (tangential component of the) source times the
+    // edge functions along the edge, in the parameter of the edge of e
+    for (unsigned int j = 0; j < e->nvert; j++)
+    {
+      std::vector<int>& fns = edge_fns[4*e->id + j];
+      double s0, s1;
+      if (fns.empty() || !pbi_sub_edge(ss, fu->get_ctm(), j, e->nvert, s0, s1)) continue;
+
+      double ratio = 0.5 * (s1 - s0);
+      int eo = quad->get_edge_points(j);
+      int np = quad->get_num_points(eo);
+      double3* pt = quad->get_points(eo);
+      src->set_quad_order(eo);
+
+      scalar* g = new scalar[np];
+      if (type == 0)
+        memcpy(g, src->get_fn_values(), np * sizeof(scalar));
+      else
+      {
+        // covariant component: f . dx/ds, where dx/ds is the physical edge tangent
+        // with respect to the parameter of the whole edge
+        double3* tan = rm.get_tangent(j);
+        scalar *f0 = src->get_fn_values(0), *f1 = src->get_fn_values(1);
+        for (int q = 0; q < np; q++)
+          g[q] = (f0[q] * tan[q][0] + f1[q] * tan[q][1]) * tan[q][2] / (2.0 * ratio);
+      }
+
+      double2* a = ss->get_ref_vertex(j);
+      double2* b = ss->get_ref_vertex(e->next_vert(j));
+      double tx = 0.5 * ((*b)[0] - (*a)[0]), ty = 0.5 * ((*b)[1] - (*a)[1]);
+      for (unsigned int k = 0; k < fns.size(); k++)
+      {
+        fu->set_active_shape(fns[k]);
+        fu->set_quad_order(eo);
+        double *phi0 = fu->get_fn_values(0), *phi1 = (type == 0) ? NULL : fu->get_fn_values(1);
+        scalar res = 0.0;
+        for (int q = 0; q < np; q++)
+          res += pt[q][2] * g[q] * ((type == 0) ? phi0[q] : phi0[q] * tx + phi1[q] * ty);
+        edge_mom[4*e->id + j][k] += ratio * res;
+      }
+      delete [] g;
+    }
+
+    // bubble moments
+    if (nb > 0)
+    {
+      int fo = 0;
+      for (int k = al.cnt - nb; k < al.cnt; k++)
+      {
+        fu->set_active_shape(al.idx[k]);
+        fo = std::max(fo, fu->get_fn_order());
+      }
+      int o = fo + src->get_fn_order() + rm.get_inv_ref_order();
+      if (type == 1) o += 2;
+      limit_order_nowarn(o);
+
+      double* jwt = pbi_jwt(quad, &rm, o);
+      int np = quad->get_num_points(o);
+      Func<scalar>* v = init_fn(src, &rm, o);
+      for (int k = 0; k < nb; k++)
+      {
+        fu->set_active_shape(al.idx[al.cnt - nb + k]);
+        Func<double>* u = init_fn(fu, &rm, o);
+        bubble_mom[e->id][k] += pbi_product(norm, np, jwt, u, v);
+        u->free_fn(); delete u;
+      }
+      v->free_fn(); delete v;
+      delete [] jwt;
+    }
+  }
+  trav.finish();
+
+  // 3. Edge dofs: one-dimensional L2 projections of what is left after subtracting the vertex
+  // part. An edge may depend on other edges through constrained vertices, hence the sweeps.
+  bool progress = true, pending = true;
+  while (pending && progress)
+  {
+    pending = progress = false;
+    for_all_active_elements_fast(e, mesh)
+    {
+      for (unsigned int j = 0; j < e->nvert; j++)
+      {
+        std::vector<int>& fns = edge_fns[4*e->id + j];
+        int ne = fns.size();
+        if (!ne) continue;
+
+        space->get_edge_assembly_list(e, j, &ael);
+        if (known[ael.dof[ael.cnt - 1]]) continue;
+
+        scalar* coupled = new scalar[ael.cnt];
+        bool ready = true;
+        for (int k = 0; k < ael.cnt - ne && ready; k++)
+          ready = pbi_known_value(&ael, k, this->Vec, known, coupled[k]);
+        if (!ready) { delete [] coupled; pending = true; continue; }
+
+        fu->set_active_element(e);
+        fu->reset_transform();
+        int eo = quad->get_edge_points(j);
+        int np = quad->get_num_points(eo);
+        double3* pt = quad->get_points(eo);
+
+        double2* a = ss->get_ref_vertex(j);
+        double2* b = ss->get_ref_vertex(e->next_vert(j));
+        double tx = 0.5 * ((*b)[0] - (*a)[0]), ty = 0.5 * ((*b)[1] - (*a)[1]);
+        double** val = new_matrix<double>(ael.cnt, np);
+        for (int k = 0; k < ael.cnt; k++)
+        {
+          fu->set_active_shape(ael.idx[k]);
+          fu->set_quad_order(eo);
+          double* phi0 = fu->get_fn_values(0);
+          double* phi1 = (type == 0) ? NULL : fu->get_fn_values(1);
+          for (int q = 0; q < np; q++)
+            val[k][q] = (type == 0) ? phi0[q] : phi0[q] * tx + phi1[q] * ty;
+        }
+
+        double** mat = new_matrix<double>(ne, ne);
+        double* p = new double[ne];
+        scalar* rhs = new scalar[ne];
+        for (int s = 0; s < ne; s++)
+        {
+          double* vs = val[ael.cnt - ne + s];
+          for (int t = 0; t < ne; t++)
+          {
+            double* vt = val[ael.cnt - ne + t];
+            for (int q = 0; q < np; q++) mat[s][t] += pt[q][2] * vs[q] * vt[q];
+          }
+          rhs[s] = edge_mom[4*e->id + j][s];
+          for (int k = 0; k < ael.cnt - ne; k++)
+          {
+            double m = 0.0;
+            for (int q = 0; q < np; q++) m += pt[q][2] * vs[q] * val[k][q];
+            rhs[s] -= m * coupled[k];
+          }
+        }
+        choldc(mat, ne, p);
+        cholsl(mat, ne, p, rhs, rhs);
+        for (int s = 0; s < ne; s++)
+        {
+          int k = ael.cnt - ne + s;
+          this->Vec[ael.dof[k]] = rhs[s] / ael.coef[k];
+          known[ael.dof[k]] = true;
+        }
+        progress = true;
+
+        delete [] rhs;
+        delete [] p;
+        delete [] mat;
+        delete [] val;
+        delete [] coupled;
+      }
+    }
+  }
+  if (pending) error("Cyclic edge constraints in LinSystem::project_local().");
+
+  // 4. Bubble dofs: local projections of the source minus the already known part.
+  for_all_active_elements_fast(e, mesh)
+  {
+    space->get_element_assembly_list(e, &al);
+    nb = ss->get_num_bubbles(space->get_element_order(e->id));
+    if (nb == 0) continue;
+    update_limit_table(e->get_mode());
+
+    int nk = al.cnt - nb;
+    scalar* coupled = new scalar[nk + 1];
+    for (int k = 0; k < nk; k++)
+      if (!pbi_known_value(&al, k, this->Vec, known, coupled[k]))
+        error("Unresolved dof %d in LinSystem::project_local().", al.dof[k]);
+
+    fu->set_active_element(e);
+    fu->reset_transform();
+    rm.set_active_element(e);
+    // the ref. map keeps the sub-element transform of the traversal if e was its last element
+    rm.force_transform(fu->get_transform(), fu->get_ctm());
+    int fo = 0;
+    for (int k = 0; k < al.cnt; k++)
+    {
+      fu->set_active_shape(al.idx[k]);
+      fo = std::max(fo, fu->get_fn_order());
+    }
+    int o = 2 * fo + rm.get_inv_ref_order();
+    if (type == 1) o += 2;
+    limit_order_nowarn(o);
+    double* jwt = pbi_jwt(quad, &rm, o);
+    int np = quad->get_num_points(o);
+
+    Func<double>** u = new Func<double>*[al.cnt];
+    for (int k = 0; k < al.cnt; k++)
+    {
+      fu->set_active_shape(al.idx[k]);
+      u[k] = init_fn(fu, &rm, o);
+    }
+
+    double** mat = new_matrix<double>(nb, nb);
+    double* p = new double[nb];
+    scalar* rhs = new scalar[nb];
+    for (int s = 0; s < nb; s++)
+    {
+      for (int t = 0; t < nb; t++)
+        mat[s][t] = pbi_product(norm, np, jwt, u[nk + s], u[nk + t]);
+      rhs[s] = bubble_mom[e->id][s];
+      for (int k = 0; k < nk; k++)
+        rhs[s] -= pbi_product(norm, np, jwt, u[nk + s], u[k]) * coupled[k];
+    }
+    choldc(mat, nb, p);
+    cholsl(mat, nb, p, rhs, rhs);
+    for (int s = 0; s < nb; s++)
+    {
+      this->Vec[al.dof[nk + s]] = rhs[s];
+      known[al.dof[nk + s]] = true;
+    }
+
+    for (int k = 0; k < al.cnt; k++) { u[k]->free_fn(); delete u[k]; }
+    delete [] u;
+    delete [] rhs;
+    delete [] p;
+    delete [] mat;
+    delete [] jwt;
+    delete [] coupled;
+  }
+}
+
+// Returns true if the mesh of the space is a refinement of the mesh of sln and the polynomial
+// degrees of the elements of the space are not lower than those of sln, i.e., if sln lies
+// in the space (up to Dirichlet lifts).
+static bool is_nested(Space* space, PrecalcShapeset* fu, Solution* sln)
+{
+  Mesh* meshes[2] = { space->get_mesh(), sln->get_mesh() };
+  Transformable* tr[2] = { fu, sln };
+  Traverse trav;
+  trav.begin(2, meshes, tr);
+
+  // the traversal is not interrupted, Traverse relies on the transforms it has set
+  bool nested = true;
+  Element** ee;
+  while ((ee = trav.get_next_state(NULL, NULL)) != NULL)
+  {
+    if (!nested) continue;
+
+    // the element of the space must not be split
+    if (fu->get_transform() != 0) { nested = false; continue; }
+
+    // the same measure of the order as in Solution::set_fe_solution()
+    Element* e = ee[0];
+    int o = space->get_element_order(e->id);
+    o = std::max(H2D_GET_H_ORDER(o), H2D_GET_V_ORDER(o));
+    for (unsigned int k = 0; k < e->nvert; k++)
+      o = std::max(o, space->get_edge_order(e, k));
+    if (space->get_shapeset()->get_num_components() == 2) o++;
+
+    if (sln->get_fn_order() > o) nested = false;
+  }
+  trav.finish();
+  return nested;
+}
+
+void LinSystem::prolong(Tuple<Solution*> source, Tuple<Solution*> target)
+{
+  int n = source.size();
+  if (this->spaces == NULL) error("this->spaces == NULL in LinSystem::prolong().");
+  if (!have_spaces)
+    error("You have to init_spaces() before using LinSystem::prolong().");
+  if (n != target.size())
+    error("Mismatched numbers of prolonged functions and solutions in LinSystem::prolong().");
+
+  this->assign_dofs();
+
+  Tuple<MeshFunction*> mf;
+  Tuple<int> proj_norms;
+  bool nested = true;
+  for (int i = 0; i < n; i++)
+  {
+    if (!is_nested(this->spaces[i], this->pss[i], source[i])) nested = false;
+    mf.push_back(source[i]);
+
+    // the source is reproduced for any norm, so take the cheapest one
+    proj_norms.push_back(0);
+  }
+
+  if (nested)
+    this->project_local(mf, target, proj_norms);
+  else
+  {
+    warn("The meshes in LinSystem::prolong() are not nested, using global projection.");
+    this->project_global(mf, target);
+  }
+}
+
 int LinSystem::get_num_dofs()
 {
   // sanity checks
@@ -90,7 +90,10 @@ public:
   virtual bool set_linearity() { this->linear = true; }
 
   /// Assembles the stiffness matrix and load vector. Vectors Vec, Dir and
-  /// RHS must be allocated when assemble() is called.
+  /// RHS must be allocated when assemble() is called. If only the RHS is
+  /// assembled and the essential BC values have changed in the meantime,
+  /// the Dirichlet lift is recomputed from the couplings stored during the
+  /// last full assembly, without evaluating the bilinear forms again.
   virtual void assemble(bool rhsonly = false);
   void assemble_rhs_only() { assemble(true); }
 
@@ -113,6 +116,11 @@ public:
   /// Frees the stiffness matrix, coefficient vectors, and matrix solver data.
   virtual void free();
 
+  /// Frees the cached blocks of the time-invariant matrix forms (see WeakForm::add_matrix_form()),
+  /// so that they are integrated again in the next assembly. This is done automatically when
+  /// the spaces or the weak form change, call it if the forms depend on data that changed.
+  void free_group_blocks();
+
   /// Saves the stiffness matrix in various formats.
   void save_matrix_matlab(const char* filename, const char* varname = "A");
   void save_rhs_matlab(const char* filename, const char* varname = "b");
@@ -121,6 +129,24 @@ public:
 
   void enable_dir_contrib(bool enable = true) {  want_dir_contrib = enable;  }
 
+  /// Restricts the assembly to the base elements with part[id] == rank, see
+  /// partition_base_elements(). The matrix and the right-hand side then contain only the
+  /// contributions of these elements, their sum over all ranks is the global system (this
+  /// is what MpiCGSolver expects). The matrix keeps the global size and the DOF numbering
+  /// of the (replicated) Space. An empty vector switches back to the full assembly.
+  void set_partition(const std::vector<int>& part, int rank)
+    { this->part = part; this->part_rank = rank; free_group_blocks(); }
+
+  /// Calibrates the integration orders of the volume forms. The orders obtained from the
+  /// 'ord' callbacks are often far too high (e.g., any sin() or log() yields the maximum order).
+  /// Each form is evaluated for all pairs of shape functions on 'num_samples' sample elements
+  /// at the automatic order shifted down (or up, if the automatic order is not accurate
+  /// enough), and compared with the values at the maximum order. The smallest shift for which
+  /// the difference relative to the largest value is below 'tol' is stored in the form and
+  /// used in all subsequent assemblies, see also WeakForm::save_order_offsets().
+  /// External functions of the forms are evaluated as they are at the time of the call.
+  void calibrate_orders(double tol = 1e-10, int num_samples = 10);
+
   scalar* get_solution_vector() { return Vec; }
   int get_num_dofs();
   int get_num_dofs(int i) {
@@ -225,15 +251,72 @@ public:
     this->project_global(Tuple<MeshFunction*>(&sln), Tuple<Solution*>(target), Tuple<int>(proj_norm));
   };
 
-  /// Projection-based interpolation of an exact function. This is faster than the
-  /// global projection since no global matrix problem is solved.
+  /// Projection-based interpolation of multiple solution components. This is faster than
+  /// the global projection since no global matrix problem is solved: vertex values are
+  /// interpolated, edge functions are obtained from 1D L2 projections along the edges
+  /// (tangential components for Hcurl) and bubbles from local projections on each element
+  /// in the norm proj_norm (0 = L2, 1 = H1, 2 = Hcurl). By default, H1 spaces use
+  /// H2D_DEFAULT_PROJ_NORM, Hcurl spaces the Hcurl norm and L2 spaces the L2 norm.
+  /// Hdiv spaces are not supported. Defines the entire coefficient vector Vec.
+  /// Calls assign_dofs() at the beginning.
+  void project_local(Tuple<MeshFunction*> source, Tuple<Solution*> target, Tuple<int> proj_norms = Tuple<int>());
+
+  /// Projection-based interpolation of one MeshFunction.
+  void project_local(MeshFunction* source, Solution* target, int proj_norm = H2D_DEFAULT_PROJ_NORM)
+  {
+    if (this->wf->neq != 1)
+      error("Number of projected functions must be one if there is only one equation, in LinSystem::project_local().");
+    this->project_local(Tuple<MeshFunction*>(source), Tuple<Solution*>(target), Tuple<int>(proj_norm));
+  };
+
+  /// Projection-based interpolation of one scalar ExactFunction.
+  void project_local(ExactFunction source, Solution* target, int proj_norm = H2D_DEFAULT_PROJ_NORM)
+  {
+    Mesh *mesh = this->get_mesh(0);
+    if (mesh == NULL) error("Mesh is NULL in project_local().");
+    this->project_local(source, mesh, target, proj_norm);
+  };
+
+  /// Projection-based interpolation of one vector-valued ExactFunction.
+  void project_local(ExactFunction2 source, Solution* target)
+  {
+    if (this->wf->neq != 1)
+      error("Number of projected functions must be one if there is only one equation, in LinSystem::project_local().");
+    int proj_norm = 2; // Hcurl
+    Mesh *mesh = this->get_mesh(0);
+    if (mesh == NULL) error("Mesh is NULL in project_local().");
+    Solution sln;
+    sln.set_exact(mesh, source);
+    this->project_local(Tuple<MeshFunction*>(&sln), Tuple<Solution*>(target), Tuple<int>(proj_norm));
+  };
+
+  /// Projection-based interpolation of an exact function given on the mesh 'mesh'.
   void project_local(ExactFunction exactfn, Mesh* mesh,
                      Solution* result, int proj_norm = H2D_DEFAULT_PROJ_NORM)
   {
-    /// TODO
+    if (this->wf->neq != 1)
+      error("Number of projected functions must be one if there is only one equation, in LinSystem::project_local().");
+    if (proj_norm != 0 && proj_norm != 1) error("Wrong norm used in projection-based interpolation (scalar case).");
+    Solution sln;
+    sln.set_exact(mesh, exactfn);
+    this->project_local(Tuple<MeshFunction*>(&sln), Tuple<Solution*>(result), Tuple<int>(proj_norm));
   }
 
-  /// Needed for problems where BC depend on time.
+  /// Transfers solutions (e.g. from the previous time level or from the coarse mesh) onto the
+  /// spaces of this system. If the meshes of the spaces are refinements of the meshes of the
+  /// sources and the element orders did not decrease, the sources lie in the spaces and are
+  /// reproduced exactly by project_local(), i.e., without assembling and solving a global
+  /// problem. Otherwise falls back to project_global().
+  void prolong(Tuple<Solution*> source, Tuple<Solution*> target);
+
+  /// Transfer of one Solution, see above.
+  void prolong(Solution* source, Solution* target)
+  {
+    this->prolong(Tuple<Solution*>(source), Tuple<Solution*>(target));
+  };
+
+  /// Needed for problems where BC depend on time. Call assemble(true)
+  /// afterwards to obtain the RHS with the new Dirichlet lift.
   void update_essential_bc_values();
 
   /// Frees spaces. Called automatically on destruction.
@@ -261,6 +344,7 @@ protected:
   bool linear;
 
   void create_matrix(bool rhsonly);
+  void project_local_component(int i, MeshFunction* source, int proj_norm, std::vector<bool>& known);
   void insert_block(scalar** mat, int* iidx, int* jidx, int ilen, int jlen);
 
   ExtData<Ord>* init_ext_fns_ord(std::vector<MeshFunction *> &ext);
@@ -322,6 +406,12 @@ protected:
   scalar eval_form(WeakForm::JacFormSurf *bf, Solution *sln[], PrecalcShapeset *fu, PrecalcShapeset *fv, RefMap *ru, RefMap *rv, EdgePos* ep);
   scalar eval_form(WeakForm::ResFormSurf *lf, Solution *sln[], PrecalcShapeset *fv, RefMap *rv, EdgePos* ep);
 
+  // order calibration, see calibrate_orders()
+  void eval_form_all(WeakForm::JacFormVol *jfv, WeakForm::ResFormVol *rfv, Element* e, std::vector<scalar>& values);
+  double calib_error(WeakForm::JacFormVol *jfv, WeakForm::ResFormVol *rfv, std::vector<Element*>& samples,
+                     std::vector<std::vector<scalar> >& ref, double scale);
+  int calibrate_form(WeakForm::JacFormVol *jfv, WeakForm::ResFormVol *rfv, int num_samples, double tol);
+
 
 
 
@@ -343,7 +433,40 @@ protected:
   bool want_dir_contrib;
   bool have_spaces;
 
+  std::vector<int> part; ///< parts of base elements, see set_partition()
+  int part_rank;
+
+  // Dirichlet lift couplings recorded during the full assembly: 'val' is the value
+  // of the bilinear form times the coefficient of the test function, i.e., without
+  // the coefficient of the Dirichlet shape function which is at the position 'j' of
+  // the assembly list of the block. The lift is then Dir[k] -= val * al.coef[j].
+  struct DirCoupling { int k; int j; scalar val; };
+  // a sequence of couplings sharing the assembly list of the element 'e_id' of the
+  // space 'i' ('edge' >= 0 for edge assembly lists); ends where the next one starts.
+  // 'group' >= 0 for the couplings of time-invariant forms, which are scaled by the
+  // group coefficient and kept as long as the group blocks are valid
+  struct DirBlock { int i; int e_id; int edge; int group; int first; };
+  std::vector<DirBlock> dir_blocks;
+  std::vector<DirCoupling> dir_coup;
+  std::vector<int> dir_bc_seq;
+
+  void add_dir_coupling(int i, Element* e, int edge, int group, int k, int j, scalar val);
+  void add_dir_lift(bool groups_only);
+  void update_dir_lift();
+  void remove_dir_couplings(bool keep_groups);
+
+  // Blocks of the time-invariant matrix form groups (without the group coefficients) on
+  // a common sparse pattern in the CSR format: the values of the group g in the row r are
+  // grp_Ax[g][grp_Ap[r] .. grp_Ap[r+1]-1], in the columns grp_Ai[grp_Ap[r] .. grp_Ap[r+1]-1].
+  std::vector<int> grp_Ap, grp_Ai;
+  std::vector<std::vector<scalar> > grp_Ax;
+  bool grp_valid;
+
+  void build_group_blocks(std::vector<CooMatrix*>& blocks);
+  void add_group_blocks();
+
   friend class RefSystem;
+  friend class MultigridPrecond;
 
 };
 
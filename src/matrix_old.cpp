@@ -142,6 +142,15 @@ void SparseMatrix::pre_add_ij(int row, int col)
   pages[col]->idx[pages[col]->count++] = row;
 }
 
+void SparseMatrix::pre_add_block(int m, int *rows, int n, int *cols)
+{
+  for (int i = 0; i < m; i++)
+    if (rows[i] >= 0)
+      for (int j = 0; j < n; j++)
+        if (cols[j] >= 0)
+          pre_add_ij(rows[i], cols[j]);
+}
+
 int SparseMatrix::sort_and_store_indices(Page *page, int *buffer, int *max)
 {
   // gather all pages in the buffer, deleting them along the way
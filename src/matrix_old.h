@@ -294,6 +294,15 @@ public:
   /// @param[in] col  - column index
   virtual void pre_add_ij(int row, int col);
 
+  /// add indices of a dense block of nonzero matrix elements (all pairs
+  /// rows[i], cols[j]); negative indices (Dirichlet DOFs) are skipped
+  ///
+  /// @param[in] m    - number of rows
+  /// @param[in] rows - array with row indexes
+  /// @param[in] n    - number of columns
+  /// @param[in] cols - array with column indexes
+  virtual void pre_add_block(int m, int *rows, int n, int *cols);
+
   virtual void finish() { }
 
   virtual int get_size() { return size; }
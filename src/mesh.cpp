@@ -129,10 +129,26 @@ unsigned g_mesh_seq = 0;
 Mesh::Mesh() : HashTable()
 {
   nbase = nactive = ntopvert = ninitial = 0;
+  active_valid = false;
   seq = g_mesh_seq++;
 }
 
 
+void Mesh::update_active_elements() const
+{
+  active_elems.clear();
+  active_elems.reserve(nactive);
+  for (int id = 0, max = elements.get_size(); id < max; id++)
+  {
+    Element* e = &(elements[id]);
+    if (e->used && e->active)
+      active_elems.push_back(e);
+  }
+  assert((int) active_elems.size() == nactive);
+  active_valid = true;
+}
+
+
 Element* Mesh::get_element(int id) const
 {
   if (id < 0 || id >= elements.get_size())
@@ -244,6 +260,7 @@ Element* Mesh::create_triangle(int marker, Node* v0, Node* v1, Node* v2, CurvMap
   // create a new element
   Element* e = elements.add();
   e->active = 1;
+  active_valid = false;
   e->marker = marker;
   e->userdata = 0;
   e->nvert = 3;
@@ -270,6 +287,7 @@ Element* Mesh::create_quad(int marker, Node* v0, Node* v1, Node* v2, Node* v3, C
   // create a new element
   Element* e = elements.add();
   e->active = 1;
+  active_valid = false;
   e->marker = marker;
   e->userdata = 0;
   e->nvert = 4;
@@ -562,6 +580,7 @@ void Mesh::unrefine_element_internal(Element* e)
   e->ref_all_nodes();
   e->active = 1;
   nactive++;
+  active_valid = false;
 
   // restore edge node markers and bnds
   for (i = 0; i < e->nvert; i++)
@@ -723,6 +742,8 @@ Nurbs* Mesh::reverse_nurbs(Nurbs* nurbs)
   Nurbs* rev = new Nurbs;
   *rev = *nurbs;
   rev->twin = true;
+  rev->samples = NULL;
+  rev->coef_cache = NULL;
 
   rev->pt = new double3[nurbs->np];
   for (int i = 0; i < nurbs->np; i++)
@@ -942,6 +963,15 @@ void Mesh::copy(const Mesh* mesh)
   ntopvert = mesh->ntopvert;
   ninitial = mesh->ninitial;
   seq = mesh->seq;
+
+  // the element ids are kept, so the index of active elements can be copied too
+  if (mesh->active_valid)
+  {
+    active_elems.resize(nactive);
+    for (i = 0; i < nactive; i++)
+      active_elems[i] = &elements[mesh->active_elems[i]->id];
+    active_valid = true;
+  }
 }
 
 
@@ -1017,6 +1047,7 @@ void Mesh::free()
 
   elements.free();
   HashTable::free();
+  active_valid = false;
 }
 
 void Mesh::copy_converted(Mesh* mesh)
@@ -1877,5 +1908,6 @@ void Mesh::load_raw(FILE* f)
         n->elem[j] = get_element((int) (long) n->elem[j]);
 
   #undef input
+  active_valid = false;
   seq++;
 }
@@ -193,6 +193,20 @@ public:
   /// Returns the maximum node id number plus one.
   int get_max_element_id() const { return elements.get_size(); }
 
+  /// Returns the active elements ordered by their id numbers. The array has
+  /// get_num_active_elements() items and stays valid until the mesh is changed.
+  /// The index is invalidated by refinements, unrefinements, copying and loading
+  /// and rebuilt on the next call, so a sequence of refinements costs only one
+  /// pass over the element slots. Call this function before starting threads that
+  /// partition the list, since the rebuild itself is not thread-safe.
+  Element* const* get_active_elements() const
+  {
+    if (!active_valid) update_active_elements();
+    return nactive > 0 ? &active_elems[0] : NULL;
+  }
+  /// Returns the i-th active element in the order of get_active_elements().
+  Element* get_active_element(int i) const { return get_active_elements()[i]; }
+
   /// Refines an element.
   /// \param id [in] Element id number.
   /// \param refinement [in] Ignored for triangles. If the element
@@ -278,6 +292,11 @@ protected:
   int nactive, ninitial;
   unsigned seq;
 
+  H2D_API_USED_STL_VECTOR(Element*);
+  mutable std::vector<Element*> active_elems; ///< dense index of active elements, see get_active_elements()
+  mutable bool active_valid;
+  void update_active_elements() const;
+
   Element* create_triangle(int marker, Node* v0, Node* v1, Node* v2, CurvMap* cm);
   Element* create_quad(int marker, Node* v0, Node* v1, Node* v2, Node* v3, CurvMap* cm);
 
@@ -321,6 +340,13 @@ protected:
           if (((e) = (mesh)->get_element_fast(_id))->used) \
             if ((e)->active)
 
+// iterates through the dense index of active elements; unlike for_all_active_elements,
+// the loop body must not refine or unrefine the mesh
+#define for_all_active_elements_fast(e, mesh) \
+        for (Element* const* _pe = (mesh)->get_active_elements(), \
+             * const* _pend = _pe + (mesh)->get_num_active_elements(); _pe < _pend; _pe++) \
+          if (((e) = *_pe) != NULL)
+
 #define for_all_inactive_elements(e, mesh) \
         for (int _id = 0, _max = (mesh)->get_max_element_id(); _id < _max; _id++) \
           if (((e) = (mesh)->get_element_fast(_id))->used) \
@@ -63,7 +63,7 @@ double calc_norm(double (*fn)(MeshFunction*, RefMap*), MeshFunction* sln)
   Element* e;
   Mesh* mesh = sln->get_mesh();
 
-  for_all_active_elements(e, mesh)
+  for_all_active_elements_fast(e, mesh)
   {
     // set maximum integration order for use in integrals, see limit_order()
     update_limit_table(e->get_mode());
@@ -77,6 +77,102 @@ double calc_norm(double (*fn)(MeshFunction*, RefMap*), MeshFunction* sln)
 }
 
 
+/// Neumaier's variant of the compensated summation. The contributions of the elements
+/// may differ by many orders of magnitude on adaptively refined meshes.
+class CompensatedSum
+{
+public:
+  CompensatedSum() : sum(0.0), c(0.0) {}
+
+  void add(double x)
+  {
+    double t = sum + x;
+    if (fabs(sum) >= fabs(x)) c += (sum - t) + x;
+    else c += (x - t) + sum;
+    sum = t;
+  }
+
+  double get() const { return sum + c; }
+
+protected:
+  double sum, c;
+};
+
+
+void calc_norms(Tuple<MeshFunction*> slns, const std::vector<NormIntegrand>& items,
+                double* results, double** elem_values)
+{
+  int n = slns.size(), ni = items.size();
+  if (n < 1) error("No functions passed to calc_norms().");
+
+  Quad2D* quad = &g_quad_2d_std;
+  AUTOLA_OR(Mesh*, meshes, n);
+  AUTOLA_OR(Transformable*, tr, n);
+  for (int i = 0; i < n; i++)
+  {
+    slns[i]->set_quad_2d(quad);
+    meshes[i] = slns[i]->get_mesh();
+    tr[i] = slns[i];
+  }
+
+  for (int k = 0; k < ni; k++)
+  {
+    const NormIntegrand* it = &items[k];
+    if (it->i < 0 || it->i >= n || (it->error_fn != NULL && (it->j < 0 || it->j >= n)))
+      error("Invalid function index in the integrand %d in calc_norms().", k);
+    if (elem_values != NULL && elem_values[k] != NULL)
+      memset(elem_values[k], 0, sizeof(double) * meshes[it->i]->get_max_element_id());
+  }
+
+  // all integrands are evaluated on each element of the union mesh at once, so that
+  // the values of the functions precalculated by the first one are reused by the others
+  std::vector<CompensatedSum> sums(ni);
+  Traverse trav;
+  trav.begin(n, meshes, tr);
+  Element** ee;
+  while ((ee = trav.get_next_state(NULL, NULL)) != NULL)
+  {
+    update_limit_table(ee[0]->get_mode());
+
+    for (int k = 0; k < ni; k++)
+    {
+      const NormIntegrand* it = &items[k];
+      MeshFunction* u = slns[it->i];
+      double val;
+      if (it->error_fn != NULL)
+      {
+        MeshFunction* v = slns[it->j];
+        val = it->error_fn(u, v, u->get_refmap(), v->get_refmap());
+      }
+      else
+        val = it->norm_fn(u, u->get_refmap());
+
+      sums[k].add(val);
+      if (elem_values != NULL && elem_values[k] != NULL)
+        elem_values[k][ee[it->i]->id] += val;
+    }
+  }
+  trav.finish();
+
+  for (int k = 0; k < ni; k++)
+    results[k] = sqrt(sums[k].get());
+}
+
+
+/// Relative error of sln1 with respect to sln2, both evaluated in one traversal.
+static double calc_rel_error(double (*error_fn)(MeshFunction*, MeshFunction*, RefMap*, RefMap*),
+                             double (*norm_fn)(MeshFunction*, RefMap*),
+                             MeshFunction* sln1, MeshFunction* sln2)
+{
+  std::vector<NormIntegrand> items;
+  items.push_back(NormIntegrand(error_fn, 0, 1));
+  items.push_back(NormIntegrand(norm_fn, 1));
+  double res[2];
+  calc_norms(Tuple<MeshFunction*>(sln1, sln2), items, res);
+  return res[0] / res[1];
+}
+
+
 //// H1 space //////////////////////////////////////////////////////////////////////////////////////
 
 // function used to calculate error in H1 norm
@@ -124,9 +220,7 @@ double norm_fn_h1(MeshFunction* sln, RefMap* ru)
 
 double h1_error(MeshFunction* sln1, MeshFunction* sln2)
 {
-  double error = calc_error(error_fn_h1, sln1, sln2);
-  double norm = calc_norm(norm_fn_h1, sln2);
-  return error/norm;
+  return calc_rel_error(error_fn_h1, norm_fn_h1, sln1, sln2);
 }
 
 double h1_norm(MeshFunction* sln)
@@ -176,9 +270,7 @@ double norm_fn_l2(MeshFunction* sln, RefMap* ru)
 
 double l2_error(MeshFunction* sln1, MeshFunction* sln2)
 {
-  double error = calc_error(error_fn_l2, sln1, sln2);
-  double norm = calc_norm(norm_fn_l2, sln2);
-  return error/norm;
+  return calc_rel_error(error_fn_l2, norm_fn_l2, sln1, sln2);
 }
 
 double l2_norm(MeshFunction* sln)
@@ -236,9 +328,7 @@ double norm_fn_hc(MeshFunction* sln, RefMap* ru)
 
 double hcurl_error(MeshFunction* sln1, MeshFunction* sln2)
 {
-  double error = calc_error(error_fn_hc, sln1, sln2);
-  double norm = calc_norm(norm_fn_hc, sln2);
-  return error / norm;
+  return calc_rel_error(error_fn_hc, norm_fn_hc, sln1, sln2);
 }
 
 
@@ -291,9 +381,7 @@ double norm_fn_hcl2(MeshFunction* sln, RefMap* ru)
 
 double hcurl_l2error(MeshFunction* sln1, MeshFunction* sln2)
 {
-  double error = calc_error(error_fn_hcl2, sln1, sln2);
-  double norm = calc_norm(norm_fn_hcl2, sln2);
-  return error / norm;
+  return calc_rel_error(error_fn_hcl2, norm_fn_hcl2, sln1, sln2);
 }
 
 
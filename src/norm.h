@@ -22,6 +22,28 @@
 extern H2D_API double calc_error(double (*fn)(MeshFunction*, MeshFunction*, RefMap*, RefMap*), MeshFunction* sln1, MeshFunction* sln2);
 extern H2D_API double calc_norm(double (*fn)(MeshFunction*, RefMap*), MeshFunction* sln);
 
+/// One of the quantities evaluated by calc_norms(): either the error 'error_fn' between
+/// the functions 'i' and 'j', or the norm 'norm_fn' of the function 'i'.
+struct H2D_API NormIntegrand
+{
+  double (*error_fn)(MeshFunction*, MeshFunction*, RefMap*, RefMap*);
+  double (*norm_fn)(MeshFunction*, RefMap*);
+  int i, j;
+
+  NormIntegrand(double (*fn)(MeshFunction*, MeshFunction*, RefMap*, RefMap*), int i, int j)
+    : error_fn(fn), norm_fn(NULL), i(i), j(j) {}
+  NormIntegrand(double (*fn)(MeshFunction*, RefMap*), int i)
+    : error_fn(NULL), norm_fn(fn), i(i), j(-1) {}
+};
+
+/// Evaluates several errors and norms of the functions 'slns' in a single traversal
+/// of their meshes; results[k] receives the value of items[k]. If 'elem_values' is not
+/// NULL and elem_values[k] is not NULL, elem_values[k] has to have the size of
+/// get_max_element_id() of the mesh of the function items[k].i and it receives the
+/// squares of the contributions of the active elements of this mesh.
+extern H2D_API void calc_norms(Tuple<MeshFunction*> slns, const std::vector<NormIntegrand>& items,
+                               double* results, double** elem_values = NULL);
+
 extern H2D_API double error_fn_l2(MeshFunction* sln1, MeshFunction* sln2, RefMap* ru, RefMap* rv);
 extern H2D_API double norm_fn_l2(MeshFunction* sln, RefMap* ru);
 extern H2D_API double l2_error(MeshFunction* sln1, MeshFunction* sln2);
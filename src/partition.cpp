@@ -0,0 +1,133 @@
+// This file is part of Hermes2D.
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "common.h"
+#include "partition.h"
+#include "mesh.h"
+#include "space.h"
+#include <algorithm>
+
+
+// work of an element subtree: number of active elements or of their shape functions
+static double element_weight(Element* e, Space* space)
+{
+  if (!e->active)
+  {
+    double w = 0.0;
+    for (int i = 0; i < 4; i++)
+      if (e->sons[i] != NULL) w += element_weight(e->sons[i], space);
+    return w;
+  }
+  if (space == NULL) return 1.0;
+
+  int o = space->get_element_order(e->id);
+  if (e->is_triangle()) return (o + 1) * (o + 2) / 2;
+  return (H2D_GET_H_ORDER(o) + 1) * (H2D_GET_V_ORDER(o) + 1);
+}
+
+
+struct BaseElem
+{
+  int id;
+  double x[2];
+  double w;
+};
+
+static int rcb_axis;
+static bool rcb_compare(const BaseElem& a, const BaseElem& b)
+{
+  if (a.x[rcb_axis] != b.x[rcb_axis]) return a.x[rcb_axis] < b.x[rcb_axis];
+  return a.id < b.id;
+}
+
+// assigns the parts first .. first+nparts-1 to the elements in [begin, end)
+static void rcb(std::vector<BaseElem>& el, int begin, int end, int nparts, int first, std::vector<int>& part)
+{
+  if (nparts == 1 || end - begin <= 1)
+  {
+    for (int i = begin; i < end; i++)
+      part[el[i].id] = first;
+    return;
+  }
+
+  // split along the longer side of the bounding box of the centers
+  double lo[2] = { 1e100, 1e100 }, hi[2] = { -1e100, -1e100 };
+  double total = 0.0;
+  for (int i = begin; i < end; i++)
+  {
+    for (int k = 0; k < 2; k++)
+    {
+      lo[k] = std::min(lo[k], el[i].x[k]);
+      hi[k] = std::max(hi[k], el[i].x[k]);
+    }
+    total += el[i].w;
+  }
+  rcb_axis = (hi[0] - lo[0] >= hi[1] - lo[1]) ? 0 : 1;
+  std::sort(el.begin() + begin, el.begin() + end, rcb_compare);
+
+  // the first half gets the share of work proportional to its number of parts
+  int n1 = nparts / 2;
+  double target = total * n1 / nparts;
+  double sum = 0.0;
+  int mid = begin;
+  while (mid < end && sum + el[mid].w / 2 < target)
+    sum += el[mid++].w;
+
+  // keep at least one element for each part if possible
+  mid = std::max(mid, begin + std::min(n1, (end - begin) / 2));
+  mid = std::min(mid, end - std::min(nparts - n1, end - begin - 1));
+  mid = std::max(mid, begin + 1);
+
+  rcb(el, begin, mid, n1, first, part);
+  rcb(el, mid, end, nparts - n1, first + n1, part);
+}
+
+
+void partition_base_elements(Mesh* mesh, int nparts, std::vector<int>& part, Space* space)
+{
+  if (nparts < 1) error("Invalid number of parts in partition_base_elements().");
+
+  std::vector<BaseElem> el;
+  Element* e;
+  for_all_base_elements(e, mesh)
+  {
+    BaseElem b;
+    b.id = e->id;
+    b.x[0] = b.x[1] = 0.0;
+    for (unsigned int i = 0; i < e->nvert; i++)
+    {
+      b.x[0] += e->vn[i]->x / e->nvert;
+      b.x[1] += e->vn[i]->y / e->nvert;
+    }
+    b.w = element_weight(e, space);
+    el.push_back(b);
+  }
+  if ((int) el.size() < nparts)
+    warn("The mesh has fewer base elements than parts, some parts will be empty.");
+
+  part.assign(mesh->get_num_base_elements(), -1);
+  rcb(el, 0, el.size(), nparts, 0, part);
+}
+
+
+void get_partition_weights(Mesh* mesh, const std::vector<int>& part, int nparts,
+                           std::vector<double>& weights, Space* space)
+{
+  weights.assign(nparts, 0.0);
+  Element* e;
+  for_all_base_elements(e, mesh)
+    if (part[e->id] >= 0)
+      weights[part[e->id]] += element_weight(e, space);
+}
@@ -0,0 +1,40 @@
+// This file is part of Hermes2D.
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __H2D_PARTITION_H
+#define __H2D_PARTITION_H
+
+#include "common.h"
+
+class Mesh;
+class Space;
+
+/// Splits the base elements of 'mesh' into 'nparts' parts of approximately equal work by
+/// recursive coordinate bisection of the base element centers. The work of a base element
+/// is the number of its active descendants, or, if 'space' is given, the number of shape
+/// functions on its active descendants (so that the parts are balanced also in hp-meshes).
+/// On return, part[id] is the part (0 .. nparts-1) of the base element 'id'; unused base
+/// elements get -1. All parts are nonempty if there are at least 'nparts' base elements.
+///
+/// The result can be passed to LinSystem::set_partition(), see also MpiCGSolver. The
+/// mesh itself is not split, every part still needs the whole mesh.
+///
+H2D_API void partition_base_elements(Mesh* mesh, int nparts, std::vector<int>& part, Space* space = NULL);
+
+/// Returns the work of each part of the partition (as defined above).
+H2D_API void get_partition_weights(Mesh* mesh, const std::vector<int>& part, int nparts,
+                                   std::vector<double>& weights, Space* space = NULL);
+
+#endif
@@ -134,6 +134,15 @@ void PrecalcShapeset::precalculate(int order, int mask)
   int newmask = mask | oldmask;
   Node* node = new_node(newmask, np);
 
+  // transform the integration points to the current sub-element
+  AUTOLA_OR(double, x, np);
+  AUTOLA_OR(double, y, np);
+  for (i = 0; i < np; i++)
+  {
+    x[i] = ctm->m[0] * pt[i][0] + ctm->t[0];
+    y[i] = ctm->m[1] * pt[i][1] + ctm->t[1];
+  }
+
   // precalculate all required tables
   for (j = 0; j < num_components; j++)
   {
@@ -143,9 +152,7 @@ void PrecalcShapeset::precalculate(int order, int mask)
         if (oldmask & idx2mask[k][j])
           memcpy(node->values[j][k], cur_node->values[j][k], np * sizeof(double));
         else
-          for (i = 0; i < np; i++)
-            node->values[j][k][i] = shapeset->get_value(k, index, ctm->m[0] * pt[i][0] + ctm->t[0],
-                                                                  ctm->m[1] * pt[i][1] + ctm->t[1], j);
+          shapeset->get_values(k, index, np, x, y, j, node->values[j][k]);
     }
   }
 
@@ -27,6 +27,17 @@
 ///
 
 
+/// Policies for reusing a preconditioner over a sequence of similar matrices
+/// (Newton iterations, time steps), see Precond::set_reuse_policy().
+///
+/// @ingroup preconds
+enum EPrecondReuse {
+	PC_REUSE_NONE,			///< rebuild the preconditioner from scratch every time (default)
+	PC_REUSE_STRUCTURE,		///< keep the structure (ML aggregates, Ifpack symbolic phase), recompute the values
+	PC_REUSE_LAGGED			///< keep the whole preconditioner until the linear solver slows down
+};
+
+
 /// Abstract class to define interface for preconditioners
 ///
 /// @ingroup preconds
@@ -36,10 +47,47 @@ class Precond
 #endif
 {
 public:
+	Precond() {
+		reuse = PC_REUSE_NONE;
+		reuse_growth = 2.0;
+		reuse_max_age = 10;
+		age = 0;
+		base_iters = last_iters = -1;
+		n_builds = n_refreshes = n_skips = 0;
+	}
+
 	virtual void create(_Matrix *mat) = 0;
 	virtual void destroy() = 0;
 	virtual void compute() = 0;
 
+	/// Sets the policy for reusing the preconditioner when create() and compute()
+	/// are called for a matrix with the same sparsity structure.
+	/// @param[in] policy - see EPrecondReuse
+	/// @param[in] growth - PC_REUSE_LAGGED: the values are recomputed when the number of
+	///                     linear iterations exceeds 'growth' times the number of iterations
+	///                     right after the last recomputation
+	/// @param[in] max_age - PC_REUSE_LAGGED: the values are recomputed after at most
+	///                      'max_age' reuses
+	void set_reuse_policy(EPrecondReuse policy, double growth = 2.0, int max_age = 10) {
+		reuse = policy;
+		reuse_growth = growth;
+		reuse_max_age = max_age;
+	}
+	EPrecondReuse get_reuse_policy() const { return reuse; }
+
+	/// Reports the number of iterations of the last linear solve done with this
+	/// preconditioner (drives PC_REUSE_LAGGED).
+	void report_iters(int iters) {
+		last_iters = iters;
+		if (base_iters < 0) base_iters = iters;
+	}
+
+	/// Statistics
+	int get_num_builds() const { return n_builds; }			///< full setups
+	int get_num_refreshes() const { return n_refreshes; }	///< recomputations of the values only
+	int get_num_skips() const { return n_skips; }			///< compute() calls that reused the preconditioner
+	int get_last_iters() const { return last_iters; }
+
 #ifdef HAVE_EPETRA
 	virtual Epetra_Operator *get_obj() = 0;
 
@@ -55,6 +103,38 @@ public:
 	virtual const Epetra_Map &OperatorDomainMap() const = 0;
 	virtual const Epetra_Map &OperatorRangeMap() const = 0;
 #endif
+
+protected:
+	EPrecondReuse reuse;
+	double reuse_growth;
+	int reuse_max_age;
+	int age;				// number of reuses since the last recomputation
+	int base_iters;			// linear iterations right after the last recomputation
+	int last_iters;
+	int n_builds, n_refreshes, n_skips;
+
+	enum EPrecondUpdate { PC_UPDATE_BUILD, PC_UPDATE_VALUES, PC_UPDATE_NONE };
+
+	/// Decides (and counts) what compute() has to do according to the reuse policy.
+	/// @param[in] built - the preconditioner has already been set up for the current structure
+	EPrecondUpdate begin_update(bool built) {
+		EPrecondUpdate upd;
+		if (!built || reuse == PC_REUSE_NONE) upd = PC_UPDATE_BUILD;
+		else if (reuse == PC_REUSE_STRUCTURE) upd = PC_UPDATE_VALUES;
+		else if (age < reuse_max_age && (base_iters < 0 || last_iters <= reuse_growth * base_iters)) upd = PC_UPDATE_NONE;
+		else upd = PC_UPDATE_VALUES;
+
+		if (upd == PC_UPDATE_NONE) {
+			age++;
+			n_skips++;
+		}
+		else {
+			if (upd == PC_UPDATE_BUILD) n_builds++; else n_refreshes++;
+			age = 0;
+			base_iters = -1;		// the next reported count becomes the reference
+		}
+		return upd;
+	}
 };
 
 #endif /* _PRECOND_H_ */
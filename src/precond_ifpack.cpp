@@ -35,7 +35,9 @@ IfpackPrecond::IfpackPrecond(const char *cls, const char *type)
 #ifdef HAVE_IFPACK
 	this->prec = NULL;
 	this->owner = true;
+	this->computed = false;
 	this->mat = NULL;
+	this->mat_seq = 0;
 
 	this->cls = cls;
 	this->type = type;
@@ -49,7 +51,9 @@ IfpackPrecond::IfpackPrecond(const char *cls, const char *type, int overlap)
 #ifdef HAVE_IFPACK
 	this->prec = NULL;
 	this->owner = true;
+	this->computed = false;
 	this->mat = NULL;
+	this->mat_seq = 0;
 
 	this->cls = cls;
 	this->type = type;
@@ -64,7 +68,9 @@ IfpackPrecond::IfpackPrecond(Ifpack_Preconditioner *ipc)
 {
 	this->prec = ipc;
 	this->owner = false;
+	this->computed = false;
 	this->mat = NULL;		// FIXME: take the matrix from ipc
+	this->mat_seq = 0;
 }
 #endif
 
@@ -106,7 +112,17 @@ void IfpackPrecond::create(_Matrix *m)
 #ifdef HAVE_IFPACK
 	EpetraMatrix *mt = dynamic_cast<EpetraMatrix *>(m);
 	assert(mt != NULL);
+	// keep the object together with its symbolic phase, unless the Epetra matrix
+	// has been reallocated (e.g. by prealloc()) and the old one is gone
+	if (reuse != PC_REUSE_NONE && prec != NULL && mt == mat &&
+	    mt->get_structure_seq() == mat_seq) return;
+
 	mat = mt;
+	mat_seq = mt->get_structure_seq();
+	if (owner) delete prec;
+	prec = NULL;
+	owner = true;
+	computed = false;
 	if (strcmp(cls, "point-relax") == 0) {
 		create_point_relax(mat, type);
 		apply_params();
@@ -191,7 +207,10 @@ void IfpackPrecond::compute()
 
 #ifdef HAVE_IFPACK
 	assert(prec != NULL);
-	prec->Compute();
+	if (begin_update(computed) != PC_UPDATE_NONE) {
+		prec->Compute();
+		computed = true;
+	}
 #endif
 }
 
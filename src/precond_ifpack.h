@@ -47,8 +47,11 @@ public:
 	virtual Epetra_Operator *get_obj() { return prec; }
 #endif
 
+	/// With a reuse policy set, the existing object (and its symbolic phase done in
+	/// Initialize()) is kept when called again for the same matrix.
 	virtual void create(_Matrix *mat);
 	virtual void destroy() { }
+	/// Computes the numeric phase (Compute()), possibly skipped by the reuse policy.
 	virtual void compute();
 
 	void set_param(const char *name, const char *value);
@@ -73,8 +76,10 @@ protected:
 	Ifpack_Preconditioner *prec;
 	Teuchos::ParameterList ilist;
 	EpetraMatrix *mat;
+	unsigned mat_seq;			// mat->get_structure_seq() at the time prec was created
 #endif
 	unsigned owner:1;
+	unsigned computed:1;		// Compute() has been called for the current matrix
 	const char *cls;			// class of the preconditioner
 	const char *type;
 	int overlap;
@@ -0,0 +1,492 @@
+// This file is part of Hermes2D
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "common.h"
+#include "precond_mg.h"
+#include "linsystem.h"
+#include "space.h"
+#include "precalc.h"
+#include "traverse.h"
+#include "matrix_old.h"
+#include "limit_order.h"
+#include "quad_all.h"
+#include <algorithm>
+
+
+/// One level of the hierarchy: the space, its matrix in CSR format and
+/// the prolongation from the next coarser level.
+struct MultigridPrecond::Level
+{
+	Space *space;
+	Mesh *mesh;      ///< owned mesh (h-levels only), NULL otherwise
+	bool own_space;
+
+	int n;
+	std::vector<int> Ap, Ai;
+	std::vector<double> Ax;
+	std::vector<double> dinv;  ///< inverse of the diagonal
+
+	// prolongation from the next level, n x n_coarse, CSR
+	std::vector<int> Pp, Pi;
+	std::vector<double> Px;
+
+	// work vectors of the V-cycle
+	std::vector<double> r, rc, xc, tmp;
+
+	Level() : space(NULL), mesh(NULL), own_space(false), n(0) {}
+};
+
+
+typedef std::vector< std::map<int, double> > SparseRows;
+
+static void rows_to_csr(SparseRows &rows, std::vector<int> &Ap, std::vector<int> &Ai, std::vector<double> &Ax)
+{
+	Ap.resize(rows.size() + 1);
+	Ap[0] = 0;
+	for (unsigned i = 0; i < rows.size(); i++)
+		Ap[i + 1] = Ap[i] + rows[i].size();
+	Ai.resize(Ap[rows.size()]);
+	Ax.resize(Ap[rows.size()]);
+	for (unsigned i = 0, k = 0; i < rows.size(); i++)
+		for (std::map<int, double>::iterator it = rows[i].begin(); it != rows[i].end(); ++it, k++)
+		{
+			Ai[k] = it->first;
+			Ax[k] = it->second;
+		}
+}
+
+
+#ifndef H2D_COMPLEX
+
+/// Computes the rows of the prolongation from 'coarse' to 'fine'. The mesh of 'fine'
+/// has to be a refinement of the mesh of 'coarse' and the orders must not decrease.
+/// On every fine element, the coarse basis functions are expanded in the complete
+/// hierarchic basis of the element (reference-domain L2 projection, which is exact
+/// for nested spaces). The rows of the fine unknowns are taken from an element where
+/// the unknown is not constrained.
+static void build_prolongation(Space *fine, Space *coarse, SparseRows &P)
+{
+	Shapeset *ss = fine->get_shapeset();
+	PrecalcShapeset fpss(ss), cpss(coarse->get_shapeset());
+	Quad2D *quad = &g_quad_2d_std;
+	fpss.set_quad_2d(quad);
+	cpss.set_quad_2d(quad);
+
+	P.clear();
+	P.resize(fine->get_num_dofs());
+	std::vector<bool> done(fine->get_num_dofs(), false);
+
+	Mesh *meshes[2] = { fine->get_mesh(), coarse->get_mesh() };
+	Transformable *tr[2] = { &fpss, &cpss };
+	Traverse trav;
+	trav.begin(2, meshes, tr);
+
+	AsmList fal, cal;
+	std::vector<int> shapes, rows;
+	Element **ee;
+	while ((ee = trav.get_next_state(NULL, NULL)) != NULL)
+	{
+		Element *e = ee[0];
+		if (fpss.get_transform() != 0)
+			error("The meshes of the multigrid levels are not nested.");
+
+		// fine unknowns that are not constrained on this element
+		fine->get_element_assembly_list(e, &fal);
+		rows.clear();
+		for (int k = 0; k < fal.cnt; k++)
+		{
+			if (fal.idx[k] < 0 || fal.dof[k] < 0 || fal.coef[k] != 1.0 || done[fal.dof[k]]) continue;
+			int cnt = 0;
+			for (int m = 0; m < fal.cnt; m++)
+				if (fal.idx[m] == fal.idx[k]) cnt++;
+			if (cnt == 1) rows.push_back(k);
+		}
+		if (rows.empty()) continue;
+
+		// complete local basis of the fine element
+		int o = fine->get_element_order(e->id);
+		int ho = H2D_GET_H_ORDER(o), vo = e->is_triangle() ? ho : H2D_GET_V_ORDER(o);
+		shapes.clear();
+		for (unsigned int i = 0; i < e->nvert; i++)
+			shapes.push_back(ss->get_vertex_index(i));
+		for (unsigned int i = 0; i < e->nvert; i++)
+		{
+			int ori = (e->vn[i]->id < e->vn[e->next_vert(i)]->id) ? 0 : 1;
+			int eo = (e->is_triangle() || (i & 1) == 0) ? ho : vo;
+			for (int j = 2; j <= eo; j++)
+				shapes.push_back(ss->get_edge_index(i, ori, j));
+		}
+		int *bi = ss->get_bubble_indices(o);
+		for (int j = 0, nb = ss->get_num_bubbles(o); j < nb; j++)
+			shapes.push_back(bi[j]);
+		int nl = shapes.size();
+
+		coarse->get_element_assembly_list(ee[1], &cal);
+		int co = coarse->get_element_order(ee[1]->id);
+		co = std::max(H2D_GET_H_ORDER(co), H2D_GET_V_ORDER(co));
+		int fo = std::max(ho, vo);
+		int qo = fo + std::max(fo, co);
+		update_limit_table(e->get_mode());
+		limit_order_nowarn(qo);
+		double3 *pt = quad->get_points(qo);
+		int np = quad->get_num_points(qo);
+
+		// Gram matrix of the local basis on the reference domain
+		double **phi = new_matrix<double>(nl, np);
+		for (int i = 0; i < nl; i++)
+		{
+			fpss.set_active_shape(shapes[i]);
+			fpss.set_quad_order(qo, H2D_FN_VAL);
+			memcpy(phi[i], fpss.get_fn_values(), np * sizeof(double));
+		}
+		double **mat = new_matrix<double>(nl, nl);
+		for (int i = 0; i < nl; i++)
+			for (int j = 0; j <= i; j++)
+			{
+				double s = 0.0;
+				for (int q = 0; q < np; q++)
+					s += pt[q][2] * phi[i][q] * phi[j][q];
+				mat[i][j] = mat[j][i] = s;
+			}
+		double *p = new double[nl];
+		double *rhs = new double[nl];
+		choldc(mat, nl, p);
+
+		// expand the coarse basis functions
+		for (int k = 0; k < cal.cnt; k++)
+		{
+			if (cal.dof[k] < 0) continue;
+			cpss.set_active_shape(cal.idx[k]);
+			cpss.set_quad_order(qo, H2D_FN_VAL);
+			double *val = cpss.get_fn_values();
+			for (int i = 0; i < nl; i++)
+			{
+				double s = 0.0;
+				for (int q = 0; q < np; q++)
+					s += pt[q][2] * phi[i][q] * val[q];
+				rhs[i] = s;
+			}
+			cholsl(mat, nl, p, rhs, rhs);
+
+			for (unsigned r = 0; r < rows.size(); r++)
+			{
+				int i = std::find(shapes.begin(), shapes.end(), fal.idx[rows[r]]) - shapes.begin();
+				if (i == nl) error("Shape function %d not found in the local basis.", fal.idx[rows[r]]);
+				double v = cal.coef[k] * rhs[i];
+				if (fabs(v) > 1e-14) P[fal.dof[rows[r]]][cal.dof[k]] += v;
+			}
+		}
+		for (unsigned r = 0; r < rows.size(); r++)
+			done[fal.dof[rows[r]]] = true;
+
+		delete [] phi;
+		delete [] mat;
+		delete [] p;
+		delete [] rhs;
+	}
+	trav.finish();
+}
+
+#endif
+
+
+MultigridPrecond::MultigridPrecond()
+{
+	nu = 2;
+	omega = 2.0 / 3.0;
+	coarse_size = 200;
+	num_threads = 1;
+	max_direct_size = 2000;
+	coarse_sweeps = 20;
+	lu = NULL;
+	lu_idx = NULL;
+}
+
+MultigridPrecond::~MultigridPrecond()
+{
+	destroy();
+}
+
+void MultigridPrecond::destroy()
+{
+	for (unsigned l = 0; l < levels.size(); l++)
+	{
+		if (levels[l]->own_space) delete levels[l]->space;
+		if (levels[l]->mesh != NULL) delete levels[l]->mesh;
+		delete levels[l];
+	}
+	levels.clear();
+
+	if (lu != NULL) { delete [] lu; lu = NULL; }
+	if (lu_idx != NULL) { delete [] lu_idx; lu_idx = NULL; }
+}
+
+int MultigridPrecond::get_num_dofs(int level) const
+{
+	return levels[level]->n;
+}
+
+void MultigridPrecond::create(LinSystem *ls)
+{
+#ifdef H2D_COMPLEX
+	error("MultigridPrecond is not available in the complex version.");
+#else
+	if (ls->get_num_spaces() != 1)
+		error("MultigridPrecond supports only systems with one equation.");
+	Space *space = ls->spaces[0];
+	if (space->get_type() != 0)
+		error("MultigridPrecond supports only H1 spaces.");
+	if (ls->A == NULL || ls->A->get_size() != space->get_num_dofs())
+		error("The matrix has to be assembled before MultigridPrecond::create().");
+
+	destroy();
+	TimePeriod cpu_time;
+
+	// finest level: the matrix of the system
+	Level *fine = new Level;
+	fine->space = space;
+	fine->n = space->get_num_dofs();
+	CSRMatrix csr(ls->A);
+	fine->Ap.assign(csr.get_Ap(), csr.get_Ap() + fine->n + 1);
+	fine->Ai.assign(csr.get_Ai(), csr.get_Ai() + csr.get_nnz());
+	fine->Ax.assign(csr.get_Ax(), csr.get_Ax() + csr.get_nnz());
+	levels.push_back(fine);
+
+	while (fine->n > coarse_size)
+	{
+		// next coarser space: first lower the orders, then merge elements
+		Element *e;
+		int pmax = 1;
+		for_all_active_elements_fast(e, fine->space->get_mesh())
+		{
+			int o = fine->space->get_element_order(e->id);
+			pmax = std::max(pmax, std::max(H2D_GET_H_ORDER(o), H2D_GET_V_ORDER(o)));
+		}
+
+		Level *coarse = new Level;
+		coarse->own_space = true;
+		if (pmax > 1)
+		{
+			coarse->space = fine->space->dup(fine->space->get_mesh());
+			coarse->space->copy_orders(fine->space, -(pmax / 2));
+		}
+		else
+		{
+			Mesh *mesh = new Mesh;
+			mesh->copy(fine->space->get_mesh());
+			int na = mesh->get_num_active_elements();
+			mesh->unrefine_all_elements(false);
+			if (mesh->get_num_active_elements() == na) { delete mesh; delete coarse; break; }
+			coarse->mesh = mesh;
+			coarse->space = fine->space->dup(mesh);
+			coarse->space->set_uniform_order(1);
+		}
+		coarse->n = coarse->space->get_num_dofs();
+		if (coarse->n >= fine->n || coarse->n == 0)
+		{
+			delete coarse->space;
+			if (coarse->mesh != NULL) delete coarse->mesh;
+			delete coarse;
+			break;
+		}
+
+		// prolongation and the Galerkin product Ac = P^T A P
+		SparseRows P;
+		build_prolongation(fine->space, coarse->space, P);
+		rows_to_csr(P, fine->Pp, fine->Pi, fine->Px);
+
+		SparseRows Ac(coarse->n);
+		std::map<int, double> ap;
+		for (int i = 0; i < fine->n; i++)
+		{
+			if (P[i].empty()) continue;
+			// row i of A*P
+			ap.clear();
+			for (int k = fine->Ap[i]; k < fine->Ap[i + 1]; k++)
+			{
+				int j = fine->Ai[k];
+				for (int m = fine->Pp[j]; m < fine->Pp[j + 1]; m++)
+					ap[fine->Pi[m]] += fine->Ax[k] * fine->Px[m];
+			}
+			for (std::map<int, double>::iterator it = P[i].begin(); it != P[i].end(); ++it)
+				for (std::map<int, double>::iterator jt = ap.begin(); jt != ap.end(); ++jt)
+					Ac[it->first][jt->first] += it->second * jt->second;
+		}
+		rows_to_csr(Ac, coarse->Ap, coarse->Ai, coarse->Ax);
+
+		levels.push_back(coarse);
+		fine = coarse;
+	}
+
+	// diagonals and work vectors
+	for (unsigned l = 0; l < levels.size(); l++)
+	{
+		Level *lev = levels[l];
+		lev->dinv.assign(lev->n, 0.0);
+		for (int i = 0; i < lev->n; i++)
+			for (int k = lev->Ap[i]; k < lev->Ap[i + 1]; k++)
+				if (lev->Ai[k] == i && lev->Ax[k] != 0.0) lev->dinv[i] += lev->Ax[k];
+		for (int i = 0; i < lev->n; i++)
+			if (lev->dinv[i] != 0.0) lev->dinv[i] = 1.0 / lev->dinv[i];
+		lev->r.resize(lev->n);
+		lev->tmp.resize(lev->n);
+		if (l + 1 < levels.size())
+		{
+			lev->rc.resize(levels[l + 1]->n);
+			lev->xc.resize(levels[l + 1]->n);
+		}
+	}
+
+	Level *last = levels.back();
+	if (last->n > coarse_size)
+		warn("Multigrid coarsening stopped at %d unknowns on level %d (coarse size %d).",
+		     last->n, levels.size() - 1, coarse_size);
+	if (last->n > max_direct_size)
+	{
+		warn("The coarsest multigrid level is too large for a direct solve, using %d Jacobi sweeps.",
+		     coarse_sweeps);
+	}
+	else
+	{
+		// factorize the coarsest matrix
+		lu = new_matrix<double>(last->n, last->n);
+		memset(lu[0], 0, sizeof(double) * last->n * last->n);
+		for (int i = 0; i < last->n; i++)
+			for (int k = last->Ap[i]; k < last->Ap[i + 1]; k++)
+				lu[i][last->Ai[k]] += last->Ax[k];
+		lu_idx = new int[last->n];
+		double d;
+		ludcmp(lu, last->n, lu_idx, &d);
+	}
+
+	verbose("Multigrid hierarchy with %d levels, %d unknowns on the coarsest level.", levels.size(), last->n);
+	report_time("MultigridPrecond created in %g s", cpu_time.tick().last());
+#endif
+}
+
+
+//// smoothing /////////////////////////////////////////////////////////////////////////////////////
+
+struct MgTask
+{
+	MultigridPrecond::Level *lev;
+	double *b, *x, *out;
+	double omega;
+	int first, last;
+	bool jacobi;
+};
+
+// out = b - A x, or for the smoother out = x + omega * D^-1 (b - A x), on rows [first, last)
+static void *mg_task(void *arg)
+{
+	MgTask *t = (MgTask *) arg;
+	MultigridPrecond::Level *lev = t->lev;
+	for (int i = t->first; i < t->last; i++)
+	{
+		double s = t->b[i];
+		for (int k = lev->Ap[i]; k < lev->Ap[i + 1]; k++)
+			s -= lev->Ax[k] * t->x[lev->Ai[k]];
+		t->out[i] = t->jacobi ? t->x[i] + t->omega * lev->dinv[i] * s : s;
+	}
+	return NULL;
+}
+
+static void mg_run(MultigridPrecond::Level *lev, double *b, double *x, double *out,
+                   double omega, bool jacobi, int num_threads)
+{
+	int nt = std::min(num_threads, std::max(1, lev->n / 1000));
+	std::vector<MgTask> tasks(nt);
+	std::vector<pthread_t> threads(nt);
+	for (int t = 0; t < nt; t++)
+	{
+		MgTask &task = tasks[t];
+		task.lev = lev; task.b = b; task.x = x; task.out = out;
+		task.omega = omega; task.jacobi = jacobi;
+		task.first = (int) ((long) lev->n * t / nt);
+		task.last = (int) ((long) lev->n * (t + 1) / nt);
+	}
+
+	if (nt == 1) { mg_task(&tasks[0]); return; }
+	for (int t = 1; t < nt; t++)
+		if (pthread_create(&threads[t], NULL, mg_task, &tasks[t]) != 0)
+			error("Could not create a smoother thread.");
+	mg_task(&tasks[0]);
+	for (int t = 1; t < nt; t++)
+		pthread_join(threads[t], NULL);
+}
+
+void MultigridPrecond::smooth(Level *lev, double *b, double *x)
+{
+	for (int s = 0; s < nu; s++)
+	{
+		mg_run(lev, b, x, &lev->tmp[0], omega, true, num_threads);
+		memcpy(x, &lev->tmp[0], lev->n * sizeof(double));
+	}
+}
+
+void MultigridPrecond::residual(Level *lev, double *b, double *x, double *r)
+{
+	mg_run(lev, b, x, r, 0.0, false, num_threads);
+}
+
+
+//// V-cycle ///////////////////////////////////////////////////////////////////////////////////////
+
+void MultigridPrecond::cycle(int l, double *b, double *x)
+{
+	Level *lev = levels[l];
+	if (l == (int) levels.size() - 1)
+	{
+		if (lu != NULL)
+		{
+			memcpy(x, b, lev->n * sizeof(double));
+			lubksb(lu, lev->n, lu_idx, x);
+			return;
+		}
+		// a fixed number of sweeps from zero keeps the V-cycle symmetric
+		memset(x, 0, lev->n * sizeof(double));
+		for (int s = 0; s < coarse_sweeps; s++)
+		{
+			mg_run(lev, b, x, &lev->tmp[0], omega, true, num_threads);
+			memcpy(x, &lev->tmp[0], lev->n * sizeof(double));
+		}
+		return;
+	}
+
+	memset(x, 0, lev->n * sizeof(double));
+	smooth(lev, b, x);
+
+	// restriction of the residual, rc = P^T r
+	residual(lev, b, x, &lev->r[0]);
+	std::fill(lev->rc.begin(), lev->rc.end(), 0.0);
+	for (int i = 0; i < lev->n; i++)
+		for (int k = lev->Pp[i]; k < lev->Pp[i + 1]; k++)
+			lev->rc[lev->Pi[k]] += lev->Px[k] * lev->r[i];
+
+	cycle(l + 1, &lev->rc[0], &lev->xc[0]);
+
+	// coarse grid correction, x += P xc
+	for (int i = 0; i < lev->n; i++)
+		for (int k = lev->Pp[i]; k < lev->Pp[i + 1]; k++)
+			x[i] += lev->Px[k] * lev->xc[lev->Pi[k]];
+
+	smooth(lev, b, x);
+}
+
+void MultigridPrecond::apply(double *r, double *z)
+{
+	if (levels.empty()) error("MultigridPrecond::create() has not been called.");
+	cycle(0, r, z);
+}
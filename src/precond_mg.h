@@ -0,0 +1,104 @@
+// This file is part of Hermes2D
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef __H2D_PRECOND_MG_H_
+#define __H2D_PRECOND_MG_H_
+
+#include "common.h"
+#include "matrix.h"
+#include "solvers.h"
+
+class LinSystem;
+class Space;
+class Mesh;
+
+/// Geometric hp-multigrid preconditioner for scalar H1 problems.
+///
+/// The hierarchy is built from the space of a LinSystem. While the polynomial
+/// degree is larger than one, the next coarser level halves the element orders
+/// (p-coarsening via Space::copy_orders()). Then the elements are merged along
+/// the refinement tree of the mesh (h-coarsening via Mesh::unrefine_all_elements()),
+/// until the number of unknowns drops below the coarse size. The prolongation
+/// between two levels is computed exactly from the hierarchic shape functions,
+/// the coarse matrices are the Galerkin products P^T A P and the coarsest problem
+/// is solved by a dense LU decomposition. If the coarsening stops early (the mesh
+/// cannot be unrefined any more) and the coarsest level is too large for a dense
+/// factorization, it is only approximated by a fixed number of Jacobi sweeps.
+///
+/// One application of the preconditioner is one symmetric V-cycle with damped
+/// Jacobi smoothing, so it can be used with CommonSolverCG::set_precond().
+/// The smoother and the residual evaluation can be split among several threads.
+///
+/// Usage:
+///   CommonSolverCG cg;
+///   LinSystem ls(&wf, &cg, &space);
+///   ls.assemble();
+///   MultigridPrecond mg;
+///   mg.create(&ls);
+///   cg.set_precond(&mg);
+///   ls.solve(&sln);
+///
+/// @ingroup preconds
+class H2D_API MultigridPrecond : public CommonPrecond {
+public:
+	MultigridPrecond();
+	virtual ~MultigridPrecond();
+
+	/// Builds the hierarchy for the assembled matrix of 'ls'. Must be called
+	/// again whenever the matrix or the space changes.
+	void create(LinSystem *ls);
+	/// Frees all levels
+	void destroy();
+
+	/// @param[in] nu - number of pre- and post-smoothing steps
+	/// @param[in] omega - damping parameter of the Jacobi smoother
+	void set_smoothing(int nu, double omega = 2.0 / 3.0) { this->nu = nu; this->omega = omega; }
+	/// Levels with at most 'size' unknowns are solved directly
+	void set_coarse_size(int size) { this->coarse_size = size; }
+	/// The coarsest level is factorized only if it has at most 'size' unknowns (the
+	/// dense factor takes size^2 doubles), otherwise 'sweeps' damped Jacobi sweeps are
+	/// applied to it in each V-cycle
+	void set_max_direct_size(int size, int sweeps = 20) { this->max_direct_size = size; this->coarse_sweeps = sweeps; }
+	/// Number of threads used by the smoother
+	void set_num_threads(int n) { this->num_threads = std::max(1, n); }
+
+	int get_num_levels() const { return levels.size(); }
+	int get_num_dofs(int level) const;
+
+	/// z = one V-cycle applied to r (with a zero initial guess)
+	virtual void apply(double *r, double *z);
+
+	struct Level;
+
+protected:
+	std::vector<Level *> levels;
+	int nu;
+	double omega;
+	int coarse_size;
+	int num_threads;
+	int max_direct_size;
+	int coarse_sweeps;
+
+	// dense LU factorization of the coarsest matrix (NULL if it is smoothed only)
+	double **lu;
+	int *lu_idx;
+
+	void cycle(int l, double *b, double *x);
+	void smooth(Level *lev, double *b, double *x);
+	void residual(Level *lev, double *b, double *x, double *r);
+};
+
+#endif /* __H2D_PRECOND_MG_H_ */
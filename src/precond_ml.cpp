@@ -23,7 +23,9 @@ MlPrecond::MlPrecond(const char *type)
 #ifdef HAVE_ML
 	this->prec = NULL;
 	this->owner = true;
+	this->computed = false;
 	this->mat = NULL;
+	this->mat_seq = 0;
 
 	if (strcmp(type, "sa") == 0) ML_Epetra::SetDefaults("SA", mlist);
 	else if (strcmp(type, "dd") == 0) ML_Epetra::SetDefaults("DD", mlist);
@@ -37,7 +39,9 @@ MlPrecond::MlPrecond(ML_Epetra::MultiLevelPreconditioner *mpc)
 {
 	this->prec = mpc;
 	this->owner = false;
+	this->computed = false;
 	this->mat = NULL;			// FIXME: get the matrix from mpc
+	this->mat_seq = 0;
 }
 #endif
 
@@ -74,9 +78,18 @@ void MlPrecond::create(_Matrix *m)
 #ifdef HAVE_ML
 	EpetraMatrix *mt = dynamic_cast<EpetraMatrix *>(m);
 	assert(mt != NULL);
+	// keep the hierarchy, compute() updates it for the new values, unless the Epetra matrix
+	// has been reallocated (e.g. by prealloc()) and the old one is gone
+	if (reuse != PC_REUSE_NONE && prec != NULL && mt == mat &&
+	    mt->get_structure_seq() == mat_seq) return;
+
 	mat = mt;
+	mat_seq = mt->get_structure_seq();
 	delete prec;
+	// ReComputePreconditioner() needs the information from the setup phase
+	if (reuse != PC_REUSE_NONE) mlist.set("reuse: enable", true);
 	prec = new ML_Epetra::MultiLevelPreconditioner(*mat->mat, mlist, false);
+	computed = false;
 #endif
 }
 
@@ -85,6 +98,7 @@ void MlPrecond::destroy()
 #ifdef HAVE_ML
 	assert(prec != NULL);
 	prec->DestroyPreconditioner();
+	computed = false;
 #endif
 }
 
@@ -92,7 +106,17 @@ void MlPrecond::compute()
 {
 #ifdef HAVE_ML
 	assert(prec != NULL);
-	prec->ComputePreconditioner();
+	switch (begin_update(computed)) {
+		case PC_UPDATE_BUILD:
+			prec->ComputePreconditioner();
+			computed = true;
+			break;
+		case PC_UPDATE_VALUES:
+			prec->ReComputePreconditioner();
+			break;
+		case PC_UPDATE_NONE:
+			break;
+	}
 #endif
 }
 
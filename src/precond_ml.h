@@ -43,10 +43,13 @@ public:
 #endif
 
 	/// @param[in] a
+	/// With a reuse policy set, the existing hierarchy is kept when called again
+	/// for the same matrix.
 	virtual void create(_Matrix *mat);
 	/// Destroy the preconditioner object
 	virtual void destroy();
-	/// Compute the preconditioner
+	/// Compute the preconditioner (according to the reuse policy, the aggregates
+	/// can be kept and only the level operators and smoothers recomputed)
 	virtual void compute();
 
 	void set_param(const char *name, const char *value);
@@ -68,8 +71,10 @@ protected:
 	ML_Epetra::MultiLevelPreconditioner *prec;
 	Teuchos::ParameterList mlist;
 	EpetraMatrix *mat;
+	unsigned mat_seq;			// mat->get_structure_seq() at the time prec was created
 #endif
 	unsigned owner:1;
+	unsigned computed:1;		// the hierarchy has been computed for the current matrix
 
 	friend class AztecOOSolver;
 };
@@ -282,5 +282,12 @@ namespace RefinementSelectors {
     }
     return total_error_squared;
   }
+
+  int H1ProjBasedSelector::get_ref_expansion_coefs(const ElemSubTrf& sub_trf, double* coefs) {
+    coefs[H2D_H1FE_VALUE] = 1.0;
+    coefs[H2D_H1FE_DX] = sub_trf.coef_mx;
+    coefs[H2D_H1FE_DY] = sub_trf.coef_my;
+    return H2D_H1FE_NUM;
+  }
 }
 
@@ -302,6 +302,13 @@ namespace RefinementSelectors {
     }
     return total_error_squared;
   }
+
+  int HcurlProjBasedSelector::get_ref_expansion_coefs(const ElemSubTrf& sub_trf, double* coefs) {
+    coefs[H2D_HCFE_VALUE0] = sub_trf.coef_mx;
+    coefs[H2D_HCFE_VALUE1] = sub_trf.coef_my;
+    coefs[H2D_HCFE_CURL] = std::abs(sub_trf.coef_mx * sub_trf.coef_my);
+    return H2D_HCFE_NUM;
+  }
 }
 
 #endif
@@ -82,6 +82,10 @@ namespace RefinementSelectors {
     /**  Overriden function. For details, see ProjBasedSelector::evaluate_error_squared_subdomain(). */
     virtual double evaluate_error_squared_subdomain(Element* sub_elem, const ElemGIP& sub_gip, const ElemSubTrf& sub_trf, const ElemProj& elem_proj);
 
+    /// Returns coefficients of function expansions of the reference solution.
+    /**  Overriden function. For details, see ProjBasedSelector::get_ref_expansion_coefs(). */
+    virtual int get_ref_expansion_coefs(const ElemSubTrf& sub_trf, double* coefs);
+
   protected: //defaults
     static HcurlShapeset default_shapeset; ///< A default shapeset.
   };
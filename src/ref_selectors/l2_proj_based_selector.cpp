@@ -233,5 +233,10 @@ namespace RefinementSelectors {
     }
     return total_error_squared;
   }
+
+  int L2ProjBasedSelector::get_ref_expansion_coefs(const ElemSubTrf& sub_trf, double* coefs) {
+    coefs[H2D_L2FE_VALUE] = 1.0;
+    return H2D_L2FE_NUM;
+  }
 }
 
@@ -76,6 +76,8 @@ namespace RefinementSelectors {
     //build shape indices
     build_shape_indices(H2D_MODE_TRIANGLE, vertex_order, edge_bubble_order);
     build_shape_indices(H2D_MODE_QUAD, vertex_order, edge_bubble_order);
+    build_order_shape_inxs(H2D_MODE_TRIANGLE);
+    build_order_shape_inxs(H2D_MODE_QUAD);
   }
 
   void OptimumSelector::add_bubble_shape_index(int order_h, int order_v, std::map<int, bool>& used_shape_index, std::vector<ShapeInx>& indices) {
@@ -197,6 +199,20 @@ namespace RefinementSelectors {
     }
   }
 
+  void OptimumSelector::build_order_shape_inxs(const int mode) {
+    std::vector<ShapeInx>& shapes = shape_indices[mode];
+    for(int order_h = 0; order_h <= H2DRS_MAX_ORDER+1; order_h++) {
+      for(int order_v = 0; order_v <= H2DRS_MAX_ORDER+1; order_v++) {
+        std::vector<int>& inxs = order_shape_inxs[mode][order_h][order_v];
+        inxs.clear();
+        for(unsigned int i = 0; i < shapes.size(); i++) {
+          if (shapes[i].order_h <= order_h && shapes[i].order_v <= order_v)
+            inxs.push_back(shapes[i].inx);
+        }
+      }
+    }
+  }
+
   int OptimumSelector::calc_num_shapes(int mode, int order_h, int order_v, int allowed_type_mask) {
     //test whether the evaluation is necessary
     bool full_eval = false;
@@ -346,6 +362,25 @@ namespace RefinementSelectors {
     }
   }
 
+  void OptimumSelector::fetch_candidates(Element* e, Solution* rsln, int quad_order, int max_ha_quad_order, int max_p_quad_order) {
+    CandTableKey key;
+    key.mode = e->get_mode();
+    key.quad_order = quad_order;
+    key.min_order = current_min_order;
+    key.max_ha_quad_order = max_ha_quad_order;
+    key.max_p_quad_order = max_p_quad_order;
+    key.aniso = !e->is_triangle() && e->iro_cache < 8; //the same condition as in create_candidates()
+
+    std::map<CandTableKey, std::vector<Cand> >::const_iterator table = cand_tables.find(key);
+    if (table != cand_tables.end())
+      candidates = table->second;
+    else {
+      create_candidates(e, quad_order, max_ha_quad_order, max_p_quad_order);
+      evaluate_cands_dof(e, rsln);
+      cand_tables[key] = candidates;
+    }
+  }
+
   void OptimumSelector::update_cands_info(CandsInfo& info_h, CandsInfo& info_p, CandsInfo& info_aniso) const {
     std::vector<Cand>::const_iterator cand = candidates.begin();
     while (cand != candidates.end()) {
@@ -446,7 +481,6 @@ namespace RefinementSelectors {
 
   void OptimumSelector::evaluate_candidates(Element* e, Solution* rsln, double* avg_error, double* dev_error) {
     evaluate_cands_error(e, rsln, avg_error, dev_error);
-    evaluate_cands_dof(e, rsln);
     evaluate_cands_score(e);
   }
 
@@ -535,7 +569,7 @@ namespace RefinementSelectors {
 
     //build candidates
     int inx_cand, inx_h_cand;
-    create_candidates(element, quad_order
+    fetch_candidates(element, rsln, quad_order
       , H2D_MAKE_QUAD_ORDER(current_max_order, current_max_order)
       , H2D_MAKE_QUAD_ORDER(current_max_order, current_max_order));
     if (candidates.size() > 1) { //there are candidates to choose from
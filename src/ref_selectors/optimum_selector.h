@@ -160,6 +160,42 @@ namespace RefinementSelectors {
 	  double conv_exp; ///< Convergence power. Modifies difference between DOFs before they are used to calculate the score.
     std::vector<Cand> candidates; ///< A vector of candidates. The first candidate has to be equal to the original element with a refinement ::H2D_REFINEMENT_P.
 
+    /// A key of a table of candidates.
+    /** Candidates and their DOFs depend just on the parameters stored in the key, not on the element itself. */
+    struct CandTableKey {
+      int mode; ///< A mode (ElementMode).
+      int quad_order; ///< An encoded order of the element.
+      int min_order; ///< OptimumSelector::current_min_order.
+      int max_ha_quad_order; ///< A maximum encoded order of an element of a H-candidate or an ANISO-candidate.
+      int max_p_quad_order; ///< A maximum encoded order of an element of a P-candidate.
+      bool aniso; ///< True if ANISO-candidates are allowed for the element.
+
+      /// Compares keys lexicographically.
+      bool operator<(const CandTableKey& other) const {
+        if (mode != other.mode) return mode < other.mode;
+        if (quad_order != other.quad_order) return quad_order < other.quad_order;
+        if (min_order != other.min_order) return min_order < other.min_order;
+        if (max_ha_quad_order != other.max_ha_quad_order) return max_ha_quad_order < other.max_ha_quad_order;
+        if (max_p_quad_order != other.max_p_quad_order) return max_p_quad_order < other.max_p_quad_order;
+        return aniso < other.aniso;
+      };
+    };
+
+    /// Tables of candidates with evaluated DOFs.
+    /** A table is built by create_candidates() and evaluate_cands_dof() when a key is encountered for the first time.
+     *  The tables are never modified afterwards, see fetch_candidates(). */
+    std::map<CandTableKey, std::vector<Cand> > cand_tables;
+
+    /// Fills the list OptimumSelector::candidates from a table of candidates.
+    /** The table is generated through create_candidates() and evaluate_cands_dof() if it does not exist yet.
+     *  Therefore, if one of these methods is overriden, its result should depend just on the parameters in CandTableKey.
+     *  \param[in] e An element that is being refined.
+     *  \param[in] rsln A reference solution.
+     *  \param[in] quad_order An encoded order of the element. If triangle, the vertical order is equal to the horizontal order.
+     *  \param[in] max_ha_quad_order A maximum encoded order of an element of a H-candidate or an ANISO-candidate.
+     *  \param[in] max_p_quad_order A maximum encoded order of an element of a P-candidate. */
+    void fetch_candidates(Element* e, Solution* rsln, int quad_order, int max_ha_quad_order, int max_p_quad_order);
+
     /// Updates information about candidates. Initial information is provided.
     /** \param[in,out] info_h Information about all H-candidates.
      *  \param[in,out] info_p Information about all P-candidates.
@@ -185,8 +221,9 @@ namespace RefinementSelectors {
      *  \param[in] max_p_quad_order A maximum encoded order of an element of a P-candidate. */
     virtual void create_candidates(Element* e, int quad_order, int max_ha_quad_order, int max_p_quad_order);
 
-    /// Calculates error, dofs, and score of candidates.
-    /** \param[in] e An element that is being refined.
+    /// Calculates error and score of candidates.
+    /** DOFs are already available from the table of candidates, see fetch_candidates().
+     *  \param[in] e An element that is being refined.
      *  \param[in] rsln A reference solution which is used to calculate the error.
      *  \param[out] avg_error An average of \f$\log_{10} e\f$ where \f$e\f$ is an error of a candidate. It cannot be NULL.
      *  \param[out] dev_error A deviation of \f$\log_{10} e\f$ where \f$e\f$ is an error of a candidate. It cannot be NULL. */
@@ -281,6 +318,7 @@ namespace RefinementSelectors {
 
     std::vector<ShapeInx> shape_indices[H2D_NUM_MODES]; ///< Shape indices. The first index is a mode (ElementMode).
     int max_shape_inx[H2D_NUM_MODES]; ///< A maximum index of a shape function. The first index is a mode (ElementMode).
+    std::vector<int> order_shape_inxs[H2D_NUM_MODES][H2DRS_MAX_ORDER+2][H2DRS_MAX_ORDER+2]; ///< Indices of shape functions of an element of a given order. The first index is a mode (ElementMode), the second and the third index is the horizontal and the vertical order respectively. The order of shapes is the same as in OptimumSelector::shape_indices.
     int next_order_shape[H2D_NUM_MODES][H2DRS_MAX_ORDER+1]; ///< An index to the array OptimumSelector::shape_indices of a shape function of the next uniform order. The first index is a mode (ElementMode), the second index is an order.
     bool has_vertex_shape[H2D_NUM_MODES]; ///< True if the shapeset OptimumSelector::shapeset contains vertex functions. The index is a mode (ElementMode).
     bool has_edge_shape[H2D_NUM_MODES]; ///< True if the shapeset OptimumSelector::shapeset contains edge functions. The index is a mode (ElementMode).
@@ -306,6 +344,11 @@ namespace RefinementSelectors {
      *  \param[in] edge_bubble_order A range of order in which to search for edge and bubble functions. */
     void build_shape_indices(const int mode, const Range<int>& vertex_order, const Range<int>& edge_bubble_order);
 
+    /// Builds lists of shape indices for all orders OptimumSelector::order_shape_inxs.
+    /** The method is called by the constructor after build_shape_indices().
+     *  \param[in] mode A mode (ElementMode). */
+    void build_order_shape_inxs(const int mode);
+
     /// Returns a number of shapes that may be contained in an element of a given order.
     /** \param[in] mode A mode (ElementMode).
      *  \param[in] order_h A horizontal order of the element. If ::H2DRS_ORDER_ANY, any order is allowed.
@@ -7,6 +7,15 @@
 #include "proj_based_selector.h"
 
 namespace RefinementSelectors {
+
+  /// A relative tolerance of a squared error evaluated through the norm of the projection. If lower, the error is evaluated directly.
+#define H2DRS_BATCH_ERR_REL_TOL 1E-8
+
+  /// Returns a real part of a product of two values.
+  static inline double real_product(double a, double b) { return a * b; }
+#ifdef H2D_COMPLEX
+  static inline double real_product(cplx a, cplx b) { return (std::conj(a) * b).real(); }
+#endif
   
   ProjBasedSelector::ProjBasedSelector(CandList cand_list, double conv_exp, int max_order, Shapeset* shapeset, const Range<int>& vertex_order, const Range<int>& edge_bubble_order)
     : OptimumSelector(cand_list, conv_exp, max_order, shapeset, vertex_order, edge_bubble_order)
@@ -18,9 +27,11 @@ namespace RefinementSelectors {
 
     //clear matrix cache
     for(int m = 0; m < H2D_NUM_MODES; m++)
-      for(int i = 0; i < H2DRS_MAX_ORDER+1; i++)
-        for(int k = 0; k < H2DRS_MAX_ORDER+1; k++)
+      for(int i = 0; i < H2DRS_MAX_ORDER+2; i++)
+        for(int k = 0; k < H2DRS_MAX_ORDER+2; k++) {
           proj_matrix_cache[m][i][k] = NULL;
+          proj_pivot_cache[m][i][k] = NULL;
+        }
 
     //allocate caches
     int max_inx = max_shape_inx[0];
@@ -33,10 +44,12 @@ namespace RefinementSelectors {
   ProjBasedSelector::~ProjBasedSelector() {
     //delete matrix cache
     for(int m = 0; m < H2D_NUM_MODES; m++)
-      for(int i = 0; i < H2DRS_MAX_ORDER+1; i++)
-        for(int k = 0; k < H2DRS_MAX_ORDER+1; k++) {
+      for(int i = 0; i < H2DRS_MAX_ORDER+2; i++)
+        for(int k = 0; k < H2DRS_MAX_ORDER+2; k++) {
           if (proj_matrix_cache[m][i][k] != NULL)
             delete[] proj_matrix_cache[m][i][k];
+          if (proj_pivot_cache[m][i][k] != NULL)
+            delete[] proj_pivot_cache[m][i][k];
         }
   }
 
@@ -260,12 +273,9 @@ namespace RefinementSelectors {
     //allocate space
     int max_num_shapes = next_order_shape[mode][current_max_order];
     scalar* right_side = new scalar[max_num_shapes];
-    int* shape_inxs = new int[max_num_shapes];
-    int* indx = new int[max_num_shapes]; //solver data
-    double* d = new double[max_num_shapes]; //solver data
-    double** proj_matrix = new_matrix<double>(max_num_shapes, max_num_shapes);
+    scalar* right_side_orig = new scalar[max_num_shapes];
     ProjMatrixCache& proj_matrices = proj_matrix_cache[mode];
-    std::vector<ShapeInx>& full_shape_indices = shape_indices[mode];
+    ProjPivotCache& proj_pivots = proj_pivot_cache[mode];
 
     //check whether ortho-svals are available
     bool ortho_svals_available = true;
@@ -277,26 +287,52 @@ namespace RefinementSelectors {
       nonortho_rhs_cache[i] = ValueCacheItem<scalar>();
       ortho_rhs_cache[i] = ValueCacheItem<scalar>();
     }
+    double sub_area_corr_coef = 1.0 / num_sub;
+
+    //check whether the batched evaluation is possible: coefficients of expansions are known and shapes are precalculated
+    double sub_coefs[H2D_MAX_ELEMENT_SONS][H2DRS_MAX_REF_EXPANSIONS];
+    int num_exp = 0;
+    bool batched = true;
+    for(int i = 0; i < num_sub && batched; i++) {
+      ElemSubTrf this_sub_trf = { sub_trfs[i], 1 / sub_trfs[i]->m[0], 1 / sub_trfs[i]->m[1] };
+      num_exp = get_ref_expansion_coefs(this_sub_trf, sub_coefs[i]);
+      batched = num_exp > 0 && !sub_nonortho_svals[i]->empty();
+    }
+
+    //weighted values of the reference solution and its squared norm
+    scalar** wrvals = NULL;
+    double ref_norm_squared = 0;
+    bool rhs_batch_done[2] = { false, false }; //index: use_ortho
+    if (batched) {
+      assert_msg(num_exp <= H2DRS_MAX_REF_EXPANSIONS, "Too many function expansions (%d)", num_exp);
+      wrvals = new_matrix<scalar>(num_sub * num_exp, num_gip_points);
+      for(int inx_sub = 0; inx_sub < num_sub; inx_sub++) {
+        for(int k = 0; k < num_exp; k++) {
+          const double coef = sub_coefs[inx_sub][k];
+          const scalar* rvals = sub_rvals[inx_sub][k];
+          scalar* wrow = wrvals[inx_sub * num_exp + k];
+          double sum = 0;
+          for(int j = 0; j < num_gip_points; j++) {
+            wrow[j] = (coef * gip_points[j][H2D_GIP2D_W]) * rvals[j];
+            sum += gip_points[j][H2D_GIP2D_W] * sqr(rvals[j]);
+          }
+          ref_norm_squared += sqr(coef) * sum;
+        }
+      }
+      ref_norm_squared *= sub_area_corr_coef;
+    }
 
     //calculate for all orders
-    double sub_area_corr_coef = 1.0 / num_sub;
     OrderPermutator order_perm(info.min_quad_order, info.max_quad_order, mode == H2D_MODE_TRIANGLE || info.uniform_orders);
     do {
       int quad_order = order_perm.get_quad_order();
       int order_h = H2D_GET_H_ORDER(quad_order), order_v = H2D_GET_V_ORDER(quad_order);
 
-      //build a list of shape indices from the full list
-      int num_shapes = 0;
-      unsigned int inx_shape = 0;
-      while (inx_shape < full_shape_indices.size()) {
-        ShapeInx& shape = full_shape_indices[inx_shape];
-        if (order_h >= shape.order_h && order_v >= shape.order_v) {
-          assert_msg(num_shapes < max_num_shapes, "more shapes than predicted, possible incosistency");
-          shape_inxs[num_shapes] = shape.inx;
-          num_shapes++;
-        }
-        inx_shape++;
-      }
+      //retrieve a list of shape indices
+      std::vector<int>& order_shapes = order_shape_inxs[mode][order_h][order_v];
+      int num_shapes = (int)order_shapes.size();
+      assert_msg(num_shapes <= max_num_shapes, "more shapes than predicted, possible incosistency");
+      int* shape_inxs = order_shapes.empty() ? NULL : &order_shapes[0];
 
       //continue only if there are shapes to process
       if (num_shapes > 0) {
@@ -307,12 +343,23 @@ namespace RefinementSelectors {
         std::vector< ValueCacheItem<scalar> >& rhs_cache = use_ortho ? ortho_rhs_cache : nonortho_rhs_cache;
         std::vector<TrfShapeExp>** sub_svals = use_ortho ? sub_ortho_svals : sub_nonortho_svals;
 
-        //calculate projection matrix iff no ortho is used
+        //calculate and decompose projection matrix iff no ortho is used
         if (!use_ortho) {
           //error_if(!use_ortho, "Non-ortho"); //DEBUG
-          if (proj_matrices[order_h][order_v] == NULL)
-            proj_matrices[order_h][order_v] = build_projection_matrix(gip_points, num_gip_points, shape_inxs, num_shapes);
-          copy_matrix(proj_matrix, proj_matrices[order_h][order_v], num_shapes, num_shapes); //copy projection matrix because original matrix will be modified
+          if (proj_matrices[order_h][order_v] == NULL) {
+            double** proj_matrix = build_projection_matrix(gip_points, num_gip_points, shape_inxs, num_shapes);
+            int* indx = new int[num_shapes];
+            double d;
+            ludcmp(proj_matrix, num_shapes, indx, &d);
+            proj_matrices[order_h][order_v] = proj_matrix;
+            proj_pivots[order_h][order_v] = indx;
+          }
+        }
+
+        //calculate right side of all shapes at once
+        if (batched && !rhs_batch_done[use_ortho ? 1 : 0]) {
+          calc_rhs_batch(mode, num_gip_points, num_sub, num_exp, wrvals, sub_svals, info.max_quad_order, rhs_cache);
+          rhs_batch_done[use_ortho ? 1 : 0] = true;
         }
 
         //build right side (fill cache values that are missing)
@@ -337,36 +384,67 @@ namespace RefinementSelectors {
         for(int k = 0; k < num_shapes; k++) {
           ValueCacheItem<scalar>& rhs_cache_value = rhs_cache[shape_inxs[k]];
           right_side[k] = sub_area_corr_coef * rhs_cache_value.get();
+          right_side_orig[k] = right_side[k];
           rhs_cache_value.mark();
         }
 
         //solve iff no ortho is used
         if (!use_ortho) {
           //error_if(!use_ortho, "Non-ortho"); //DEBUG
-          ludcmp(proj_matrix, num_shapes, indx, d);
-          lubksb<scalar>(proj_matrix, num_shapes, indx, right_side);
+          lubksb<scalar>(proj_matrices[order_h][order_v], num_shapes, proj_pivots[order_h][order_v], right_side);
         }
 
-        //calculate error
-        double error_squared = 0;
-        for(int inx_sub = 0; inx_sub < num_sub; inx_sub++) {
-          Element* this_sub_domain = sub_domains[inx_sub];
-          ElemSubTrf this_sub_trf = { sub_trfs[inx_sub], 1 / sub_trfs[inx_sub]->m[0], 1 / sub_trfs[inx_sub]->m[1] };
-          ElemGIP this_sub_gip = { gip_points, num_gip_points, sub_rvals[inx_sub] };
-          ElemProj elem_proj = { shape_inxs, num_shapes, *(sub_svals[inx_sub]), right_side, quad_order };
-
-          error_squared += evaluate_error_squared_subdomain(this_sub_domain, this_sub_gip, this_sub_trf, elem_proj);
+        //calculate error: since the projection is orthogonal, ||u - Pu||^2 = ||u||^2 - b^T c
+        double error_squared = -1;
+        if (batched) {
+          double proj_norm_squared = 0;
+          for(int k = 0; k < num_shapes; k++)
+            proj_norm_squared += real_product(right_side_orig[k], right_side[k]);
+          error_squared = ref_norm_squared - proj_norm_squared;
+          if (error_squared < H2DRS_BATCH_ERR_REL_TOL * ref_norm_squared) //the difference is affected by a cancellation, evaluate it directly
+            error_squared = -1;
         }
-        errors_squared[order_h][order_v] = error_squared * sub_area_corr_coef; //apply area correction coefficient
+        if (error_squared < 0) {
+          error_squared = 0;
+          for(int inx_sub = 0; inx_sub < num_sub; inx_sub++) {
+            Element* this_sub_domain = sub_domains[inx_sub];
+            ElemSubTrf this_sub_trf = { sub_trfs[inx_sub], 1 / sub_trfs[inx_sub]->m[0], 1 / sub_trfs[inx_sub]->m[1] };
+            ElemGIP this_sub_gip = { gip_points, num_gip_points, sub_rvals[inx_sub] };
+            ElemProj elem_proj = { shape_inxs, num_shapes, *(sub_svals[inx_sub]), right_side, quad_order };
+
+            error_squared += evaluate_error_squared_subdomain(this_sub_domain, this_sub_gip, this_sub_trf, elem_proj);
+          }
+          error_squared *= sub_area_corr_coef; //apply area correction coefficient
+        }
+        errors_squared[order_h][order_v] = error_squared;
       }
     } while (order_perm.next());
 
     //clenaup
-    delete[] proj_matrix;
+    delete[] wrvals;
     delete[] right_side;
-    delete[] shape_inxs;
-    delete[] indx;
-    delete[] d;
+    delete[] right_side_orig;
+  }
+
+  void ProjBasedSelector::calc_rhs_batch(const int mode, int num_gip_points, const int num_sub, const int num_exp, scalar** wrvals, std::vector<TrfShapeExp>** sub_svals, int max_quad_order, std::vector< ValueCacheItem<scalar> >& rhs_cache) {
+    std::vector<int>& shapes = order_shape_inxs[mode][H2D_GET_H_ORDER(max_quad_order)][H2D_GET_V_ORDER(max_quad_order)];
+    for(unsigned int i = 0; i < shapes.size(); i++) {
+      const int shape_inx = shapes[i];
+
+      //dot product of a row of the shape table with the weighted reference values, all subdomains and expansions
+      scalar value = 0;
+      for(int inx_sub = 0; inx_sub < num_sub; inx_sub++) {
+        TrfShapeExp& shape_vals = (*sub_svals[inx_sub])[shape_inx];
+        for(int k = 0; k < num_exp; k++) {
+          const double* svals = shape_vals[k];
+          const scalar* wrow = wrvals[inx_sub * num_exp + k];
+          for(int j = 0; j < num_gip_points; j++)
+            value += svals[j] * wrow[j];
+        }
+      }
+      rhs_cache[shape_inx].set(value);
+      rhs_cache[shape_inx].mark();
+    }
   }
 
 }
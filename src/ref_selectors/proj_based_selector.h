@@ -213,14 +213,21 @@ namespace RefinementSelectors {
     /** Defines a cache of projection matrices for all possible permutations of orders. */
     typedef double** ProjMatrixCache[H2DRS_MAX_ORDER+2][H2DRS_MAX_ORDER+2];
 
-    /// An array of projection matrices.
+    /// A cache type of pivots of LU decompositions of projection matrices.
+    typedef int* ProjPivotCache[H2DRS_MAX_ORDER+2][H2DRS_MAX_ORDER+2];
+
+    /// An array of LU decompositions of projection matrices.
     /** The first index is the mode (see the enum ElementMode). The second and the third index
      *  is the horizontal and the vertical order respectively.
      *
      *  All matrices are square dense matrices and they have to be created through the function new_matrix().
-     *  If record is NULL, the corresponding matrix has to be calculated. */
+     *  A matrix is decomposed by ludcmp() right after it is built, therefore, a projection of an element
+     *  of a candidate requires just a back substitution. If record is NULL, the corresponding matrix has to be calculated. */
     ProjMatrixCache proj_matrix_cache[H2D_NUM_MODES];
 
+    /// An array of pivots of LU decompositions stored in ProjBasedSelector::proj_matrix_cache. Indices are the same.
+    ProjPivotCache proj_pivot_cache[H2D_NUM_MODES];
+
     /// An array of cached right-hand side values.
     /** The first index is an index of the shape function.
      *
@@ -271,6 +278,21 @@ namespace RefinementSelectors {
      *  \param[out] errors_squared Calculated squared errors for all orders specified through \a info. */
     void calc_error_cand_element(const int mode, double3* gip_points, int num_gip_points, const int num_sub, Element** sub_domains, Trf** sub_trfs, scalar*** sub_rvals, std::vector<TrfShapeExp>** sub_nonortho_svals, std::vector<TrfShapeExp>** sub_ortho_svals, const CandsInfo& info, CandElemProjError errors_squared);
 
+    /// Calculates the right-hand side of all shapes up to a given order at once.
+    /** Used by calc_error_cand_element() if the selector provides get_ref_expansion_coefs().
+     *  The right-hand side of all shapes is a product of a table of shape values with the weighted
+     *  reference values, i.e., a single sweep over the precalculated values without any virtual call per shape.
+     *  Values are stored to \a rhs_cache and marked as valid. Area correction coefficient is not applied.
+     *  \param[in] mode A mode (enum ElementMode).
+     *  \param[in] num_gip_points A number of integration points.
+     *  \param[in] num_sub A number of subdomains.
+     *  \param[in] num_exp A number of function expansions.
+     *  \param[in] wrvals Weighted values of the reference solution. The first index is (an index of the subdomain) * \a num_exp + (an index of the expansion), the second index is an index of the integration point.
+     *  \param[in] sub_svals Precalculated values of shapes. The first index is an index of the subdomain.
+     *  \param[in] max_quad_order A maximum encoded order of shapes.
+     *  \param[out] rhs_cache A cache of right-hand side values. */
+    void calc_rhs_batch(const int mode, int num_gip_points, const int num_sub, const int num_exp, scalar** wrvals, std::vector<TrfShapeExp>** sub_svals, int max_quad_order, std::vector< ValueCacheItem<scalar> >& rhs_cache);
+
   protected: //projection
     /// Projection of an element of a candidate.
     struct ElemProj {
@@ -343,6 +365,19 @@ namespace RefinementSelectors {
      *  \param[in] elem_proj A projection of an element of a candidate on subdomains.
      *  \return A squared error of an element of a candidate. */
     virtual double evaluate_error_squared_subdomain(Element* sub_elem, const ElemGIP& sub_gip, const ElemSubTrf& sub_trf, const ElemProj& elem_proj) = 0;
+
+#define H2DRS_MAX_REF_EXPANSIONS 4 ///< A maximum number of function expansions returned by ProjBasedSelector::get_ref_expansion_coefs(). \ingroup g_selectors
+    /// Returns coefficients of function expansions of the reference solution in the inner product.
+    /** Override to enable a batched evaluation of candidates. The batched evaluation is possible if
+     *  the inner product is a sum of products of function expansions, i.e., \f$(u,v) = \sum_k \int (c_k u_k) v_k\f$,
+     *  where \f$u_k\f$ is ElemGIP::rvals[k] and \f$c_k u_k\f$ is the value of the expansion used by evaluate_rhs_subdomain()
+     *  and evaluate_error_squared_subdomain(). Expansions of shape functions have to be precalculated in the same order. In such a case, a right-hand side of all shapes is calculated
+     *  at once (see calc_rhs_batch()) and a squared error is evaluated as \f$\|u\|^2 - b^T c\f$ without evaluating
+     *  the projection at integration points.
+     *  \param[in] sub_trf A transformation from a reference domain of a subdomain to the reference domain of an element of a candidate.
+     *  \param[out] coefs Coefficients \f$c_k\f$. The array has ::H2DRS_MAX_REF_EXPANSIONS items.
+     *  \return A number of function expansions. Zero if the batched evaluation is not supported. In such a case, evaluate_rhs_subdomain() and evaluate_error_squared_subdomain() are used. */
+    virtual int get_ref_expansion_coefs(const ElemSubTrf& sub_trf, double* coefs) { return 0; };
   };
 }
 
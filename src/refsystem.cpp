@@ -101,7 +101,7 @@ void RefSystem::global_refinement()
     if (refinement == -1)
     {
       Element* re;
-      for_all_active_elements(re, meshes[i])
+      for_all_active_elements_fast(re, meshes[i])
       {
         Mesh* mesh = this->base->spaces[i]->get_mesh();
         Element* e = mesh->get_element(re->id);
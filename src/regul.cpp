@@ -260,6 +260,7 @@ void Mesh::flatten()
 
   elements.copy(new_elements);
   nbase = nactive = elements.get_num_items();
+  active_valid = false;
 
   for_all_edge_nodes(node, this)
   {
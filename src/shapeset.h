@@ -37,6 +37,16 @@ enum FunctionExpansionIndex {
   H2D_FEI_DXY = 5 ///< Index of df/dxdy.
 };
 
+/// Describes a quad shape function (or one component of a vector one) as a product
+/// coef * f(x) * g(y) of one-dimensional Lobatto or Legendre functions, see shapeset_tensor.h.
+/// 'coef' is 1, -1, or 0 for a component which is identically zero.
+struct TensorShapeFn
+{
+  signed char coef;
+  unsigned char fx, fy;
+};
+
+
 /// \brief Defines a set of shape functions.
 ///
 /// This class stores mainly the definitions of the polynomials for all shape functions,
@@ -73,6 +83,7 @@ class H2D_API Shapeset
 {
 public:
 
+  Shapeset() : quad_tensor_size(0) { quad_tensor[0] = quad_tensor[1] = NULL; }
   ~Shapeset() { free_constrained_edge_combinations(); }
 
   /// Selects H2D_MODE_TRIANGLE or H2D_MODE_QUAD.
@@ -167,6 +178,8 @@ public:
         warned_mode = mode; warned_index = index; warned_n = n;
         return 0;
       }
+      else if (mode == H2D_MODE_QUAD && index < quad_tensor_size)
+        return get_tensor_value(n, index, x, y, component);
       else
         return shape_expansion[component][index](x, y);
     }
@@ -181,6 +194,12 @@ public:
   inline double get_dyy_value(int index, double x, double y, int component) { return get_value(4, index, x, y, component); }
   inline double get_dxy_value(int index, double x, double y, int component) { return get_value(5, index, x, y, component); }
 
+  /// Evaluates the expansion 'n' (see get_value()) of a shape function at 'np' points
+  /// (x[i], y[i]) of the reference domain and stores the results in 'values'. Quad functions
+  /// of the shapesets built from Lobatto and Legendre polynomials are evaluated by
+  /// recurrences, without calling a generated function for each point.
+  void get_values(int n, int index, int np, const double* x, const double* y, int component, double* values);
+
 
   /// Returns the coordinates of the reference domain vertices.
   double2* get_ref_vertex(int vertex)
@@ -226,6 +245,14 @@ protected:
 
   double get_constrained_value(int n, int index, double x, double y, int component);
 
+  /// Tensor-product descriptions of the quad shape functions, one table per component,
+  /// indexed like shape_table. Set by shapesets whose quad functions are products of
+  /// Lobatto and Legendre polynomials; the generated quad tables are then not used.
+  TensorShapeFn* quad_tensor[2];
+  int quad_tensor_size;
+
+  double get_tensor_value(int n, int index, double x, double y, int component);
+
 };
 
 // TODO : promyslet moznost ulozeni shapesetu jako tabulky monomialnich koeficientu
@@ -16,6 +16,7 @@
 #include "common.h"
 #include "shapeset_common.h"
 #include "shapeset_h1_all.h"
+#include "shapeset_tensor.h"
 
 
 // Shape functions based on integrated Jacobi polynomials (by Sven Beuchler). Implementation 
@@ -4236,6 +4237,8 @@ H1ShapesetJacobi::H1ShapesetJacobi()
   bubble_indices = jacobi_bubble_indices;
   bubble_count = jacobi_bubble_count;
   index_to_order = jacobi_index_to_order;
+  quad_tensor[0] = tensor_h1_quad;
+  quad_tensor_size = tensor_h1_quad_size;
 
   ref_vert[0][0][0] = -1.0;
   ref_vert[0][0][1] = -1.0;
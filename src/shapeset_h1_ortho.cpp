@@ -16,6 +16,7 @@
 #include "common.h"
 #include "shapeset_common.h"
 #include "shapeset_h1_all.h"
+#include "shapeset_tensor.h"
 
 
 //// triangle ortho2 shapeset /////////////////////////////////////////////////////////////////////
@@ -17015,6 +17016,8 @@ H1ShapesetOrtho::H1ShapesetOrtho()
   bubble_indices = ortho2_bubble_indices;
   bubble_count = ortho2_bubble_count;
   index_to_order = ortho2_index_to_order;
+  quad_tensor[0] = tensor_h1_quad;
+  quad_tensor_size = tensor_h1_quad_size;
 
   ref_vert[0][0][0] = -1.0;
   ref_vert[0][0][1] = -1.0;
@@ -16,6 +16,7 @@
 #include "common.h"
 #include "shapeset_common.h"
 #include "shapeset_hc_all.h"
+#include "shapeset_tensor.h"
 
 //#ifdef H2D_COMPLEX
 
@@ -15854,6 +15855,9 @@ HcurlShapesetGradLeg::HcurlShapesetGradLeg()
   bubble_indices = gradleg_bubble_indices;
   bubble_count = gradleg_bubble_count;
   index_to_order = gradleg_index_to_order;
+  quad_tensor[0] = tensor_hc_gradleg_quad_a;
+  quad_tensor[1] = tensor_hc_gradleg_quad_b;
+  quad_tensor_size = tensor_hc_gradleg_quad_size;
 
   ref_vert[0][0][0] = -1.0;
   ref_vert[0][0][1] = -1.0;
@@ -16,6 +16,7 @@
 #include "common.h"
 #include "shapeset_common.h"
 #include "shapeset_hc_all.h"
+#include "shapeset_tensor.h"
 
 //#ifdef H2D_COMPLEX
 
@@ -16802,6 +16803,9 @@ HcurlShapesetLegendre::HcurlShapesetLegendre()
   bubble_indices = leg_bubble_indices;
   bubble_count = leg_bubble_count;
   index_to_order = leg_index_to_order;
+  quad_tensor[0] = tensor_hc_leg_quad_a;
+  quad_tensor[1] = tensor_hc_leg_quad_b;
+  quad_tensor_size = tensor_hc_leg_quad_size;
 
   ref_vert[0][0][0] = -1.0;
   ref_vert[0][0][1] = -1.0;
@@ -16,6 +16,7 @@
 #include "common.h"
 #include "shapeset_common.h"
 #include "shapeset_hd_all.h"
+#include "shapeset_tensor.h"
 
 //#ifdef H2D_COMPLEX
 
@@ -8711,6 +8712,9 @@ HdivShapesetLegendre::HdivShapesetLegendre()
   bubble_indices = hdiv_leg_bubble_indices;
   bubble_count = hdiv_leg_bubble_count;
   index_to_order = hdiv_leg_index_to_order;
+  quad_tensor[0] = tensor_hd_leg_quad_a;
+  quad_tensor[1] = tensor_hd_leg_quad_b;
+  quad_tensor_size = tensor_hd_leg_quad_size;
 
   ref_vert[0][0][0] = -1.0;
   ref_vert[0][0][1] = -1.0;
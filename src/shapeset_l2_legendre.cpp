@@ -17,6 +17,7 @@
 #include "shapeset.h"
 #include "shapeset_common.h"
 #include "shapeset_l2_all.h"
+#include "shapeset_tensor.h"
 
 //// quad legendre shapeset /////////////////////////////////////////////////////////////////
 
@@ -5592,6 +5593,8 @@ L2ShapesetLegendre::L2ShapesetLegendre()
   bubble_indices = leg_bubble_indices;
   bubble_count = leg_bubble_count;
   index_to_order = leg_index_to_order;
+  quad_tensor[0] = tensor_l2_leg_quad;
+  quad_tensor_size = tensor_l2_leg_quad_size;
 
   ref_vert[0][0][0] = -1.0;
   ref_vert[0][0][1] = -1.0;
@@ -0,0 +1,700 @@
+// This file is part of Hermes2D.
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "common.h"
+#include "shapeset_tensor.h"
+
+
+//// one-dimensional functions /////////////////////////////////////////////////////////////////////
+
+#define LOB(k)   (k)
+#define LEG(k)   (0x40 | (k))
+#define DLOB(k)  (0x10 | LOB(k))
+#define DLEG(k)  (0x10 | LEG(k))
+
+
+// Fills p[0..n] with the m-th derivatives of the Legendre polynomials P_0..P_n at x.
+// The values follow from (k+1) P_{k+1} = (2k+1) x P_k - k P_{k-1}, the derivatives
+// from P'_{k+1} = P'_{k-1} + (2k+1) P_k applied to the next lower derivative.
+static void legendre_row(int n, int m, double x, double* p)
+{
+  double tab[4][H2D_TENSOR_MAX_DEGREE + 1];
+  assert(n <= H2D_TENSOR_MAX_DEGREE && m <= 3);
+
+  int j, l;
+  tab[0][0] = 1.0;
+  if (n > 0) tab[0][1] = x;
+  for (j = 1; j < n; j++)
+    tab[0][j+1] = ((2*j + 1) * x * tab[0][j] - j * tab[0][j-1]) / (j + 1);
+
+  for (l = 1; l <= m; l++)
+  {
+    tab[l][0] = 0.0;
+    if (n > 0) tab[l][1] = (l == 1) ? 1.0 : 0.0;
+    for (j = 1; j < n; j++)
+      tab[l][j+1] = tab[l][j-1] + (2*j + 1) * tab[l-1][j];
+  }
+
+  memcpy(p, tab[m], (n + 1) * sizeof(double));
+}
+
+
+double tensor_fn_1d(int f, int d, double x)
+{
+  int k = f & 15;
+  d += (f >> 4) & 3;
+  double p[H2D_TENSOR_MAX_DEGREE + 1];
+
+  if (f & 0x40) // Legendre polynomial
+  {
+    legendre_row(k, d, x, p);
+    return p[k];
+  }
+
+  // Lobatto shape function
+  if (k < 2)
+  {
+    if (d > 1) return 0.0;
+    double s = k ? 0.5 : -0.5;
+    return d ? s : 0.5 + s * x;
+  }
+  if (d == 0)
+  {
+    legendre_row(k, 0, x, p);
+    return (p[k] - p[k-2]) / sqrt(2.0 * (2*k - 1));
+  }
+  legendre_row(k - 1, d - 1, x, p);
+  return sqrt((2*k - 1) / 2.0) * p[k-1];
+}
+
+
+//// evaluation of tensor-product shape functions //////////////////////////////////////////////////
+
+// derivatives in x and y for the expansions n = 0..5 of Shapeset::get_value()
+static const int tensor_dx[6] = { 0, 1, 0, 2, 0, 1 };
+static const int tensor_dy[6] = { 0, 0, 1, 0, 2, 1 };
+
+
+double Shapeset::get_tensor_value(int n, int index, double x, double y, int component)
+{
+  TensorShapeFn* fn = quad_tensor[component] + index;
+  if (!fn->coef) return 0.0;
+  return fn->coef * tensor_fn_1d(fn->fx, tensor_dx[n], x) * tensor_fn_1d(fn->fy, tensor_dy[n], y);
+}
+
+
+void Shapeset::get_values(int n, int index, int np, const double* x, const double* y, int component,
+                          double* values)
+{
+  int i;
+  if (index < 0 || mode != H2D_MODE_QUAD || index >= quad_tensor_size || shape_table[n][mode] == NULL)
+  {
+    for (i = 0; i < np; i++)
+      values[i] = get_value(n, index, x[i], y[i], component);
+    return;
+  }
+
+  TensorShapeFn* fn = quad_tensor[component] + index;
+  if (!fn->coef)
+  {
+    memset(values, 0, np * sizeof(double));
+    return;
+  }
+
+  // both factors are evaluated point by point from the recurrence, with no function
+  // pointer dispatch; the quadrature points are not a tensor grid in general
+  for (i = 0; i < np; i++)
+    values[i] = fn->coef * tensor_fn_1d(fn->fx, tensor_dx[n], x[i]) * tensor_fn_1d(fn->fy, tensor_dy[n], y[i]);
+}
+
+
+//// tables ////////////////////////////////////////////////////////////////////////////////////////
+
+// The quad functions of the H1, L2, Hcurl and Hdiv shapesets below are products of Lobatto and
+// Legendre functions. The tables describe them in the order of the generated function tables
+// (shapeset_h1_quad.cpp, shapeset_l2_legendre.cpp, shapeset_hc_legendre.cpp,
+// shapeset_hc_gradleg.cpp, shapeset_hd_legendre.cpp), so the index layout is unchanged.
+
+TensorShapeFn tensor_h1_quad[137] =
+{
+  {  1, LOB(0), LOB(0) }, {  1, LOB(0), LOB(1) }, {  1, LOB(0), LOB(2) }, { -1, LOB(0), LOB(3) },
+  {  1, LOB(0), LOB(3) }, {  1, LOB(0), LOB(4) }, { -1, LOB(0), LOB(5) }, {  1, LOB(0), LOB(5) },
+  {  1, LOB(0), LOB(6) }, { -1, LOB(0), LOB(7) }, {  1, LOB(0), LOB(7) }, {  1, LOB(0), LOB(8) },
+  { -1, LOB(0), LOB(9) }, {  1, LOB(0), LOB(9) }, {  1, LOB(0), LOB(10) }, {  1, LOB(1), LOB(0) },
+  {  1, LOB(1), LOB(1) }, {  1, LOB(1), LOB(2) }, {  1, LOB(1), LOB(3) }, { -1, LOB(1), LOB(3) },
+  {  1, LOB(1), LOB(4) }, {  1, LOB(1), LOB(5) }, { -1, LOB(1), LOB(5) }, {  1, LOB(1), LOB(6) },
+  {  1, LOB(1), LOB(7) }, { -1, LOB(1), LOB(7) }, {  1, LOB(1), LOB(8) }, {  1, LOB(1), LOB(9) },
+  { -1, LOB(1), LOB(9) }, {  1, LOB(1), LOB(10) }, {  1, LOB(2), LOB(0) }, {  1, LOB(2), LOB(1) },
+  {  1, LOB(2), LOB(2) }, {  1, LOB(2), LOB(3) }, {  1, LOB(2), LOB(4) }, {  1, LOB(2), LOB(5) },
+  {  1, LOB(2), LOB(6) }, {  1, LOB(2), LOB(7) }, {  1, LOB(2), LOB(8) }, {  1, LOB(2), LOB(9) },
+  {  1, LOB(2), LOB(10) }, {  1, LOB(3), LOB(0) }, { -1, LOB(3), LOB(0) }, { -1, LOB(3), LOB(1) },
+  {  1, LOB(3), LOB(1) }, {  1, LOB(3), LOB(2) }, {  1, LOB(3), LOB(3) }, {  1, LOB(3), LOB(4) },
+  {  1, LOB(3), LOB(5) }, {  1, LOB(3), LOB(6) }, {  1, LOB(3), LOB(7) }, {  1, LOB(3), LOB(8) },
+  {  1, LOB(3), LOB(9) }, {  1, LOB(3), LOB(10) }, {  1, LOB(4), LOB(0) }, {  1, LOB(4), LOB(1) },
+  {  1, LOB(4), LOB(2) }, {  1, LOB(4), LOB(3) }, {  1, LOB(4), LOB(4) }, {  1, LOB(4), LOB(5) },
+  {  1, LOB(4), LOB(6) }, {  1, LOB(4), LOB(7) }, {  1, LOB(4), LOB(8) }, {  1, LOB(4), LOB(9) },
+  {  1, LOB(4), LOB(10) }, {  1, LOB(5), LOB(0) }, { -1, LOB(5), LOB(0) }, { -1, LOB(5), LOB(1) },
+  {  1, LOB(5), LOB(1) }, {  1, LOB(5), LOB(2) }, {  1, LOB(5), LOB(3) }, {  1, LOB(5), LOB(4) },
+  {  1, LOB(5), LOB(5) }, {  1, LOB(5), LOB(6) }, {  1, LOB(5), LOB(7) }, {  1, LOB(5), LOB(8) },
+  {  1, LOB(5), LOB(9) }, {  1, LOB(5), LOB(10) }, {  1, LOB(6), LOB(0) }, {  1, LOB(6), LOB(1) },
+  {  1, LOB(6), LOB(2) }, {  1, LOB(6), LOB(3) }, {  1, LOB(6), LOB(4) }, {  1, LOB(6), LOB(5) },
+  {  1, LOB(6), LOB(6) }, {  1, LOB(6), LOB(7) }, {  1, LOB(6), LOB(8) }, {  1, LOB(6), LOB(9) },
+  {  1, LOB(6), LOB(10) }, {  1, LOB(7), LOB(0) }, { -1, LOB(7), LOB(0) }, { -1, LOB(7), LOB(1) },
+  {  1, LOB(7), LOB(1) }, {  1, LOB(7), LOB(2) }, {  1, LOB(7), LOB(3) }, {  1, LOB(7), LOB(4) },
+  {  1, LOB(7), LOB(5) }, {  1, LOB(7), LOB(6) }, {  1, LOB(7), LOB(7) }, {  1, LOB(7), LOB(8) },
+  {  1, LOB(7), LOB(9) }, {  1, LOB(7), LOB(10) }, {  1, LOB(8), LOB(0) }, {  1, LOB(8), LOB(1) },
+  {  1, LOB(8), LOB(2) }, {  1, LOB(8), LOB(3) }, {  1, LOB(8), LOB(4) }, {  1, LOB(8), LOB(5) },
+  {  1, LOB(8), LOB(6) }, {  1, LOB(8), LOB(7) }, {  1, LOB(8), LOB(8) }, {  1, LOB(8), LOB(9) },
+  {  1, LOB(8), LOB(10) }, {  1, LOB(9), LOB(0) }, { -1, LOB(9), LOB(0) }, { -1, LOB(9), LOB(1) },
+  {  1, LOB(9), LOB(1) }, {  1, LOB(9), LOB(2) }, {  1, LOB(9), LOB(3) }, {  1, LOB(9), LOB(4) },
+  {  1, LOB(9), LOB(5) }, {  1, LOB(9), LOB(6) }, {  1, LOB(9), LOB(7) }, {  1, LOB(9), LOB(8) },
+  {  1, LOB(9), LOB(9) }, {  1, LOB(9), LOB(10) }, {  1, LOB(10), LOB(0) }, {  1, LOB(10), LOB(1) },
+  {  1, LOB(10), LOB(2) }, {  1, LOB(10), LOB(3) }, {  1, LOB(10), LOB(4) }, {  1, LOB(10), LOB(5) },
+  {  1, LOB(10), LOB(6) }, {  1, LOB(10), LOB(7) }, {  1, LOB(10), LOB(8) }, {  1, LOB(10), LOB(9) },
+  {  1, LOB(10), LOB(10) }
+};
+int tensor_h1_quad_size = 137;
+
+
+TensorShapeFn tensor_l2_leg_quad[121] =
+{
+  {  1, LEG(0), LEG(0) }, {  1, LEG(0), LEG(1) }, {  1, LEG(0), LEG(2) }, {  1, LEG(0), LEG(3) },
+  {  1, LEG(0), LEG(4) }, {  1, LEG(0), LEG(5) }, {  1, LEG(0), LEG(6) }, {  1, LEG(0), LEG(7) },
+  {  1, LEG(0), LEG(8) }, {  1, LEG(0), LEG(9) }, {  1, LEG(0), LEG(10) }, {  1, LEG(1), LEG(0) },
+  {  1, LEG(1), LEG(1) }, {  1, LEG(1), LEG(2) }, {  1, LEG(1), LEG(3) }, {  1, LEG(1), LEG(4) },
+  {  1, LEG(1), LEG(5) }, {  1, LEG(1), LEG(6) }, {  1, LEG(1), LEG(7) }, {  1, LEG(1), LEG(8) },
+  {  1, LEG(1), LEG(9) }, {  1, LEG(1), LEG(10) }, {  1, LEG(2), LEG(0) }, {  1, LEG(2), LEG(1) },
+  {  1, LEG(2), LEG(2) }, {  1, LEG(2), LEG(3) }, {  1, LEG(2), LEG(4) }, {  1, LEG(2), LEG(5) },
+  {  1, LEG(2), LEG(6) }, {  1, LEG(2), LEG(7) }, {  1, LEG(2), LEG(8) }, {  1, LEG(2), LEG(9) },
+  {  1, LEG(2), LEG(10) }, {  1, LEG(3), LEG(0) }, {  1, LEG(3), LEG(1) }, {  1, LEG(3), LEG(2) },
+  {  1, LEG(3), LEG(3) }, {  1, LEG(3), LEG(4) }, {  1, LEG(3), LEG(5) }, {  1, LEG(3), LEG(6) },
+  {  1, LEG(3), LEG(7) }, {  1, LEG(3), LEG(8) }, {  1, LEG(3), LEG(9) }, {  1, LEG(3), LEG(10) },
+  {  1, LEG(4), LEG(0) }, {  1, LEG(4), LEG(1) }, {  1, LEG(4), LEG(2) }, {  1, LEG(4), LEG(3) },
+  {  1, LEG(4), LEG(4) }, {  1, LEG(4), LEG(5) }, {  1, LEG(4), LEG(6) }, {  1, LEG(4), LEG(7) },
+  {  1, LEG(4), LEG(8) }, {  1, LEG(4), LEG(9) }, {  1, LEG(4), LEG(10) }, {  1, LEG(5), LEG(0) },
+  {  1, LEG(5), LEG(1) }, {  1, LEG(5), LEG(2) }, {  1, LEG(5), LEG(3) }, {  1, LEG(5), LEG(4) },
+  {  1, LEG(5), LEG(5) }, {  1, LEG(5), LEG(6) }, {  1, LEG(5), LEG(7) }, {  1, LEG(5), LEG(8) },
+  {  1, LEG(5), LEG(9) }, {  1, LEG(5), LEG(10) }, {  1, LEG(6), LEG(0) }, {  1, LEG(6), LEG(1) },
+  {  1, LEG(6), LEG(2) }, {  1, LEG(6), LEG(3) }, {  1, LEG(6), LEG(4) }, {  1, LEG(6), LEG(5) },
+  {  1, LEG(6), LEG(6) }, {  1, LEG(6), LEG(7) }, {  1, LEG(6), LEG(8) }, {  1, LEG(6), LEG(9) },
+  {  1, LEG(6), LEG(10) }, {  1, LEG(7), LEG(0) }, {  1, LEG(7), LEG(1) }, {  1, LEG(7), LEG(2) },
+  {  1, LEG(7), LEG(3) }, {  1, LEG(7), LEG(4) }, {  1, LEG(7), LEG(5) }, {  1, LEG(7), LEG(6) },
+  {  1, LEG(7), LEG(7) }, {  1, LEG(7), LEG(8) }, {  1, LEG(7), LEG(9) }, {  1, LEG(7), LEG(10) },
+  {  1, LEG(8), LEG(0) }, {  1, LEG(8), LEG(1) }, {  1, LEG(8), LEG(2) }, {  1, LEG(8), LEG(3) },
+  {  1, LEG(8), LEG(4) }, {  1, LEG(8), LEG(5) }, {  1, LEG(8), LEG(6) }, {  1, LEG(8), LEG(7) },
+  {  1, LEG(8), LEG(8) }, {  1, LEG(8), LEG(9) }, {  1, LEG(8), LEG(10) }, {  1, LEG(9), LEG(0) },
+  {  1, LEG(9), LEG(1) }, {  1, LEG(9), LEG(2) }, {  1, LEG(9), LEG(3) }, {  1, LEG(9), LEG(4) },
+  {  1, LEG(9), LEG(5) }, {  1, LEG(9), LEG(6) }, {  1, LEG(9), LEG(7) }, {  1, LEG(9), LEG(8) },
+  {  1, LEG(9), LEG(9) }, {  1, LEG(9), LEG(10) }, {  1, LEG(10), LEG(0) }, {  1, LEG(10), LEG(1) },
+  {  1, LEG(10), LEG(2) }, {  1, LEG(10), LEG(3) }, {  1, LEG(10), LEG(4) }, {  1, LEG(10), LEG(5) },
+  {  1, LEG(10), LEG(6) }, {  1, LEG(10), LEG(7) }, {  1, LEG(10), LEG(8) }, {  1, LEG(10), LEG(9) },
+  {  1, LEG(10), LEG(10) }
+};
+int tensor_l2_leg_quad_size = 121;
+
+
+TensorShapeFn tensor_hc_leg_quad_a[308] =
+{
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(0), LOB(0) }, { -1, LEG(0), LOB(0) }, { -1, LEG(0), LOB(1) }, {  1, LEG(0), LOB(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(1), LOB(0) }, {  1, LEG(1), LOB(0) }, {  1, LEG(1), LOB(1) }, {  1, LEG(1), LOB(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(2), LOB(0) }, { -1, LEG(2), LOB(0) }, { -1, LEG(2), LOB(1) }, {  1, LEG(2), LOB(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(3), LOB(0) }, {  1, LEG(3), LOB(0) }, {  1, LEG(3), LOB(1) }, {  1, LEG(3), LOB(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(4), LOB(0) }, { -1, LEG(4), LOB(0) }, { -1, LEG(4), LOB(1) }, {  1, LEG(4), LOB(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(5), LOB(0) }, {  1, LEG(5), LOB(0) }, {  1, LEG(5), LOB(1) }, {  1, LEG(5), LOB(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(6), LOB(0) }, { -1, LEG(6), LOB(0) }, { -1, LEG(6), LOB(1) }, {  1, LEG(6), LOB(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(7), LOB(0) }, {  1, LEG(7), LOB(0) }, {  1, LEG(7), LOB(1) }, {  1, LEG(7), LOB(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(8), LOB(0) }, { -1, LEG(8), LOB(0) }, { -1, LEG(8), LOB(1) }, {  1, LEG(8), LOB(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(9), LOB(0) }, {  1, LEG(9), LOB(0) }, {  1, LEG(9), LOB(1) }, {  1, LEG(9), LOB(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(10), LOB(0) }, { -1, LEG(10), LOB(0) }, { -1, LEG(10), LOB(1) }, {  1, LEG(10), LOB(1) },
+  {  1, LEG(0), LOB(2) }, {  1, LEG(0), LOB(3) }, {  1, LEG(0), LOB(4) }, {  1, LEG(0), LOB(5) },
+  {  1, LEG(0), LOB(6) }, {  1, LEG(0), LOB(7) }, {  1, LEG(0), LOB(8) }, {  1, LEG(0), LOB(9) },
+  {  1, LEG(0), LOB(10) }, {  1, LEG(0), LOB(11) }, {  1, LEG(1), LOB(2) }, {  1, LEG(1), LOB(3) },
+  {  1, LEG(1), LOB(4) }, {  1, LEG(1), LOB(5) }, {  1, LEG(1), LOB(6) }, {  1, LEG(1), LOB(7) },
+  {  1, LEG(1), LOB(8) }, {  1, LEG(1), LOB(9) }, {  1, LEG(1), LOB(10) }, {  1, LEG(1), LOB(11) },
+  {  1, LEG(2), LOB(2) }, {  1, LEG(2), LOB(3) }, {  1, LEG(2), LOB(4) }, {  1, LEG(2), LOB(5) },
+  {  1, LEG(2), LOB(6) }, {  1, LEG(2), LOB(7) }, {  1, LEG(2), LOB(8) }, {  1, LEG(2), LOB(9) },
+  {  1, LEG(2), LOB(10) }, {  1, LEG(2), LOB(11) }, {  1, LEG(3), LOB(2) }, {  1, LEG(3), LOB(3) },
+  {  1, LEG(3), LOB(4) }, {  1, LEG(3), LOB(5) }, {  1, LEG(3), LOB(6) }, {  1, LEG(3), LOB(7) },
+  {  1, LEG(3), LOB(8) }, {  1, LEG(3), LOB(9) }, {  1, LEG(3), LOB(10) }, {  1, LEG(3), LOB(11) },
+  {  1, LEG(4), LOB(2) }, {  1, LEG(4), LOB(3) }, {  1, LEG(4), LOB(4) }, {  1, LEG(4), LOB(5) },
+  {  1, LEG(4), LOB(6) }, {  1, LEG(4), LOB(7) }, {  1, LEG(4), LOB(8) }, {  1, LEG(4), LOB(9) },
+  {  1, LEG(4), LOB(10) }, {  1, LEG(4), LOB(11) }, {  1, LEG(5), LOB(2) }, {  1, LEG(5), LOB(3) },
+  {  1, LEG(5), LOB(4) }, {  1, LEG(5), LOB(5) }, {  1, LEG(5), LOB(6) }, {  1, LEG(5), LOB(7) },
+  {  1, LEG(5), LOB(8) }, {  1, LEG(5), LOB(9) }, {  1, LEG(5), LOB(10) }, {  1, LEG(5), LOB(11) },
+  {  1, LEG(6), LOB(2) }, {  1, LEG(6), LOB(3) }, {  1, LEG(6), LOB(4) }, {  1, LEG(6), LOB(5) },
+  {  1, LEG(6), LOB(6) }, {  1, LEG(6), LOB(7) }, {  1, LEG(6), LOB(8) }, {  1, LEG(6), LOB(9) },
+  {  1, LEG(6), LOB(10) }, {  1, LEG(6), LOB(11) }, {  1, LEG(7), LOB(2) }, {  1, LEG(7), LOB(3) },
+  {  1, LEG(7), LOB(4) }, {  1, LEG(7), LOB(5) }, {  1, LEG(7), LOB(6) }, {  1, LEG(7), LOB(7) },
+  {  1, LEG(7), LOB(8) }, {  1, LEG(7), LOB(9) }, {  1, LEG(7), LOB(10) }, {  1, LEG(7), LOB(11) },
+  {  1, LEG(8), LOB(2) }, {  1, LEG(8), LOB(3) }, {  1, LEG(8), LOB(4) }, {  1, LEG(8), LOB(5) },
+  {  1, LEG(8), LOB(6) }, {  1, LEG(8), LOB(7) }, {  1, LEG(8), LOB(8) }, {  1, LEG(8), LOB(9) },
+  {  1, LEG(8), LOB(10) }, {  1, LEG(8), LOB(11) }, {  1, LEG(9), LOB(2) }, {  1, LEG(9), LOB(3) },
+  {  1, LEG(9), LOB(4) }, {  1, LEG(9), LOB(5) }, {  1, LEG(9), LOB(6) }, {  1, LEG(9), LOB(7) },
+  {  1, LEG(9), LOB(8) }, {  1, LEG(9), LOB(9) }, {  1, LEG(9), LOB(10) }, {  1, LEG(9), LOB(11) },
+  {  1, LEG(10), LOB(2) }, {  1, LEG(10), LOB(3) }, {  1, LEG(10), LOB(4) }, {  1, LEG(10), LOB(5) },
+  {  1, LEG(10), LOB(6) }, {  1, LEG(10), LOB(7) }, {  1, LEG(10), LOB(8) }, {  1, LEG(10), LOB(9) },
+  {  1, LEG(10), LOB(10) }, {  1, LEG(10), LOB(11) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }
+};
+
+
+TensorShapeFn tensor_hc_leg_quad_b[308] =
+{
+  { -1, LOB(0), LEG(0) }, {  1, LOB(0), LEG(0) }, {  1, LOB(1), LEG(0) }, { -1, LOB(1), LEG(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LOB(0), LEG(1) }, {  1, LOB(0), LEG(1) }, {  1, LOB(1), LEG(1) }, {  1, LOB(1), LEG(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  { -1, LOB(0), LEG(2) }, {  1, LOB(0), LEG(2) }, {  1, LOB(1), LEG(2) }, { -1, LOB(1), LEG(2) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LOB(0), LEG(3) }, {  1, LOB(0), LEG(3) }, {  1, LOB(1), LEG(3) }, {  1, LOB(1), LEG(3) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  { -1, LOB(0), LEG(4) }, {  1, LOB(0), LEG(4) }, {  1, LOB(1), LEG(4) }, { -1, LOB(1), LEG(4) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LOB(0), LEG(5) }, {  1, LOB(0), LEG(5) }, {  1, LOB(1), LEG(5) }, {  1, LOB(1), LEG(5) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  { -1, LOB(0), LEG(6) }, {  1, LOB(0), LEG(6) }, {  1, LOB(1), LEG(6) }, { -1, LOB(1), LEG(6) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LOB(0), LEG(7) }, {  1, LOB(0), LEG(7) }, {  1, LOB(1), LEG(7) }, {  1, LOB(1), LEG(7) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  { -1, LOB(0), LEG(8) }, {  1, LOB(0), LEG(8) }, {  1, LOB(1), LEG(8) }, { -1, LOB(1), LEG(8) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LOB(0), LEG(9) }, {  1, LOB(0), LEG(9) }, {  1, LOB(1), LEG(9) }, {  1, LOB(1), LEG(9) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  { -1, LOB(0), LEG(10) }, {  1, LOB(0), LEG(10) }, {  1, LOB(1), LEG(10) }, { -1, LOB(1), LEG(10) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  1, LOB(2), LEG(0) }, {  1, LOB(2), LEG(1) },
+  {  1, LOB(2), LEG(2) }, {  1, LOB(2), LEG(3) }, {  1, LOB(2), LEG(4) }, {  1, LOB(2), LEG(5) },
+  {  1, LOB(2), LEG(6) }, {  1, LOB(2), LEG(7) }, {  1, LOB(2), LEG(8) }, {  1, LOB(2), LEG(9) },
+  {  1, LOB(2), LEG(10) }, {  1, LOB(3), LEG(0) }, {  1, LOB(3), LEG(1) }, {  1, LOB(3), LEG(2) },
+  {  1, LOB(3), LEG(3) }, {  1, LOB(3), LEG(4) }, {  1, LOB(3), LEG(5) }, {  1, LOB(3), LEG(6) },
+  {  1, LOB(3), LEG(7) }, {  1, LOB(3), LEG(8) }, {  1, LOB(3), LEG(9) }, {  1, LOB(3), LEG(10) },
+  {  1, LOB(4), LEG(0) }, {  1, LOB(4), LEG(1) }, {  1, LOB(4), LEG(2) }, {  1, LOB(4), LEG(3) },
+  {  1, LOB(4), LEG(4) }, {  1, LOB(4), LEG(5) }, {  1, LOB(4), LEG(6) }, {  1, LOB(4), LEG(7) },
+  {  1, LOB(4), LEG(8) }, {  1, LOB(4), LEG(9) }, {  1, LOB(4), LEG(10) }, {  1, LOB(5), LEG(0) },
+  {  1, LOB(5), LEG(1) }, {  1, LOB(5), LEG(2) }, {  1, LOB(5), LEG(3) }, {  1, LOB(5), LEG(4) },
+  {  1, LOB(5), LEG(5) }, {  1, LOB(5), LEG(6) }, {  1, LOB(5), LEG(7) }, {  1, LOB(5), LEG(8) },
+  {  1, LOB(5), LEG(9) }, {  1, LOB(5), LEG(10) }, {  1, LOB(6), LEG(0) }, {  1, LOB(6), LEG(1) },
+  {  1, LOB(6), LEG(2) }, {  1, LOB(6), LEG(3) }, {  1, LOB(6), LEG(4) }, {  1, LOB(6), LEG(5) },
+  {  1, LOB(6), LEG(6) }, {  1, LOB(6), LEG(7) }, {  1, LOB(6), LEG(8) }, {  1, LOB(6), LEG(9) },
+  {  1, LOB(6), LEG(10) }, {  1, LOB(7), LEG(0) }, {  1, LOB(7), LEG(1) }, {  1, LOB(7), LEG(2) },
+  {  1, LOB(7), LEG(3) }, {  1, LOB(7), LEG(4) }, {  1, LOB(7), LEG(5) }, {  1, LOB(7), LEG(6) },
+  {  1, LOB(7), LEG(7) }, {  1, LOB(7), LEG(8) }, {  1, LOB(7), LEG(9) }, {  1, LOB(7), LEG(10) },
+  {  1, LOB(8), LEG(0) }, {  1, LOB(8), LEG(1) }, {  1, LOB(8), LEG(2) }, {  1, LOB(8), LEG(3) },
+  {  1, LOB(8), LEG(4) }, {  1, LOB(8), LEG(5) }, {  1, LOB(8), LEG(6) }, {  1, LOB(8), LEG(7) },
+  {  1, LOB(8), LEG(8) }, {  1, LOB(8), LEG(9) }, {  1, LOB(8), LEG(10) }, {  1, LOB(9), LEG(0) },
+  {  1, LOB(9), LEG(1) }, {  1, LOB(9), LEG(2) }, {  1, LOB(9), LEG(3) }, {  1, LOB(9), LEG(4) },
+  {  1, LOB(9), LEG(5) }, {  1, LOB(9), LEG(6) }, {  1, LOB(9), LEG(7) }, {  1, LOB(9), LEG(8) },
+  {  1, LOB(9), LEG(9) }, {  1, LOB(9), LEG(10) }, {  1, LOB(10), LEG(0) }, {  1, LOB(10), LEG(1) },
+  {  1, LOB(10), LEG(2) }, {  1, LOB(10), LEG(3) }, {  1, LOB(10), LEG(4) }, {  1, LOB(10), LEG(5) },
+  {  1, LOB(10), LEG(6) }, {  1, LOB(10), LEG(7) }, {  1, LOB(10), LEG(8) }, {  1, LOB(10), LEG(9) },
+  {  1, LOB(10), LEG(10) }, {  1, LOB(11), LEG(0) }, {  1, LOB(11), LEG(1) }, {  1, LOB(11), LEG(2) },
+  {  1, LOB(11), LEG(3) }, {  1, LOB(11), LEG(4) }, {  1, LOB(11), LEG(5) }, {  1, LOB(11), LEG(6) },
+  {  1, LOB(11), LEG(7) }, {  1, LOB(11), LEG(8) }, {  1, LOB(11), LEG(9) }, {  1, LOB(11), LEG(10) }
+};
+int tensor_hc_leg_quad_size = 308;
+
+
+TensorShapeFn tensor_hc_gradleg_quad_a[308] =
+{
+  {  1, LEG(0), LOB(0) }, { -1, LEG(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  { -1, LEG(0), LOB(1) }, {  1, LEG(0), LOB(1) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, DLOB(2), LOB(0) }, {  1, DLOB(2), LOB(0) }, {  1, DLOB(1), LOB(2) }, {  1, DLOB(1), LOB(2) },
+  {  1, DLOB(2), LOB(1) }, {  1, DLOB(2), LOB(1) }, {  1, DLOB(0), LOB(2) }, {  1, DLOB(0), LOB(2) },
+  {  1, DLOB(3), LOB(0) }, { -1, DLOB(3), LOB(0) }, {  1, DLOB(1), LOB(3) }, { -1, DLOB(1), LOB(3) },
+  { -1, DLOB(3), LOB(1) }, {  1, DLOB(3), LOB(1) }, { -1, DLOB(0), LOB(3) }, {  1, DLOB(0), LOB(3) },
+  {  1, DLOB(4), LOB(0) }, {  1, DLOB(4), LOB(0) }, {  1, DLOB(1), LOB(4) }, {  1, DLOB(1), LOB(4) },
+  {  1, DLOB(4), LOB(1) }, {  1, DLOB(4), LOB(1) }, {  1, DLOB(0), LOB(4) }, {  1, DLOB(0), LOB(4) },
+  {  1, DLOB(5), LOB(0) }, { -1, DLOB(5), LOB(0) }, {  1, DLOB(1), LOB(5) }, { -1, DLOB(1), LOB(5) },
+  { -1, DLOB(5), LOB(1) }, {  1, DLOB(5), LOB(1) }, { -1, DLOB(0), LOB(5) }, {  1, DLOB(0), LOB(5) },
+  {  1, DLOB(6), LOB(0) }, {  1, DLOB(6), LOB(0) }, {  1, DLOB(1), LOB(6) }, {  1, DLOB(1), LOB(6) },
+  {  1, DLOB(6), LOB(1) }, {  1, DLOB(6), LOB(1) }, {  1, DLOB(0), LOB(6) }, {  1, DLOB(0), LOB(6) },
+  {  1, DLOB(7), LOB(0) }, { -1, DLOB(7), LOB(0) }, {  1, DLOB(1), LOB(7) }, { -1, DLOB(1), LOB(7) },
+  { -1, DLOB(7), LOB(1) }, {  1, DLOB(7), LOB(1) }, { -1, DLOB(0), LOB(7) }, {  1, DLOB(0), LOB(7) },
+  {  1, DLOB(8), LOB(0) }, {  1, DLOB(8), LOB(0) }, {  1, DLOB(1), LOB(8) }, {  1, DLOB(1), LOB(8) },
+  {  1, DLOB(8), LOB(1) }, {  1, DLOB(8), LOB(1) }, {  1, DLOB(0), LOB(8) }, {  1, DLOB(0), LOB(8) },
+  {  1, DLOB(9), LOB(0) }, { -1, DLOB(9), LOB(0) }, {  1, DLOB(1), LOB(9) }, { -1, DLOB(1), LOB(9) },
+  { -1, DLOB(9), LOB(1) }, {  1, DLOB(9), LOB(1) }, { -1, DLOB(0), LOB(9) }, {  1, DLOB(0), LOB(9) },
+  {  1, DLOB(10), LOB(0) }, {  1, DLOB(10), LOB(0) }, {  1, DLOB(1), LOB(10) }, {  1, DLOB(1), LOB(10) },
+  {  1, DLOB(10), LOB(1) }, {  1, DLOB(10), LOB(1) }, {  1, DLOB(0), LOB(10) }, {  1, DLOB(0), LOB(10) },
+  {  1, DLOB(11), LOB(0) }, { -1, DLOB(11), LOB(0) }, {  1, DLOB(1), LOB(11) }, { -1, DLOB(1), LOB(11) },
+  { -1, DLOB(11), LOB(1) }, {  1, DLOB(11), LOB(1) }, { -1, DLOB(0), LOB(11) }, {  1, DLOB(0), LOB(11) },
+  {  1, LEG(0), LOB(2) }, {  1, LEG(0), LOB(3) }, {  1, LEG(0), LOB(4) }, {  1, LEG(0), LOB(5) },
+  {  1, LEG(0), LOB(6) }, {  1, LEG(0), LOB(7) }, {  1, LEG(0), LOB(8) }, {  1, LEG(0), LOB(9) },
+  {  1, LEG(0), LOB(10) }, {  1, LEG(0), LOB(11) }, {  1, LEG(1), LOB(2) }, {  1, LEG(1), LOB(3) },
+  {  1, LEG(1), LOB(4) }, {  1, LEG(1), LOB(5) }, {  1, LEG(1), LOB(6) }, {  1, LEG(1), LOB(7) },
+  {  1, LEG(1), LOB(8) }, {  1, LEG(1), LOB(9) }, {  1, LEG(1), LOB(10) }, {  1, LEG(1), LOB(11) },
+  {  1, LEG(2), LOB(2) }, {  1, LEG(2), LOB(3) }, {  1, LEG(2), LOB(4) }, {  1, LEG(2), LOB(5) },
+  {  1, LEG(2), LOB(6) }, {  1, LEG(2), LOB(7) }, {  1, LEG(2), LOB(8) }, {  1, LEG(2), LOB(9) },
+  {  1, LEG(2), LOB(10) }, {  1, LEG(2), LOB(11) }, {  1, LEG(3), LOB(2) }, {  1, LEG(3), LOB(3) },
+  {  1, LEG(3), LOB(4) }, {  1, LEG(3), LOB(5) }, {  1, LEG(3), LOB(6) }, {  1, LEG(3), LOB(7) },
+  {  1, LEG(3), LOB(8) }, {  1, LEG(3), LOB(9) }, {  1, LEG(3), LOB(10) }, {  1, LEG(3), LOB(11) },
+  {  1, LEG(4), LOB(2) }, {  1, LEG(4), LOB(3) }, {  1, LEG(4), LOB(4) }, {  1, LEG(4), LOB(5) },
+  {  1, LEG(4), LOB(6) }, {  1, LEG(4), LOB(7) }, {  1, LEG(4), LOB(8) }, {  1, LEG(4), LOB(9) },
+  {  1, LEG(4), LOB(10) }, {  1, LEG(4), LOB(11) }, {  1, LEG(5), LOB(2) }, {  1, LEG(5), LOB(3) },
+  {  1, LEG(5), LOB(4) }, {  1, LEG(5), LOB(5) }, {  1, LEG(5), LOB(6) }, {  1, LEG(5), LOB(7) },
+  {  1, LEG(5), LOB(8) }, {  1, LEG(5), LOB(9) }, {  1, LEG(5), LOB(10) }, {  1, LEG(5), LOB(11) },
+  {  1, LEG(6), LOB(2) }, {  1, LEG(6), LOB(3) }, {  1, LEG(6), LOB(4) }, {  1, LEG(6), LOB(5) },
+  {  1, LEG(6), LOB(6) }, {  1, LEG(6), LOB(7) }, {  1, LEG(6), LOB(8) }, {  1, LEG(6), LOB(9) },
+  {  1, LEG(6), LOB(10) }, {  1, LEG(6), LOB(11) }, {  1, LEG(7), LOB(2) }, {  1, LEG(7), LOB(3) },
+  {  1, LEG(7), LOB(4) }, {  1, LEG(7), LOB(5) }, {  1, LEG(7), LOB(6) }, {  1, LEG(7), LOB(7) },
+  {  1, LEG(7), LOB(8) }, {  1, LEG(7), LOB(9) }, {  1, LEG(7), LOB(10) }, {  1, LEG(7), LOB(11) },
+  {  1, LEG(8), LOB(2) }, {  1, LEG(8), LOB(3) }, {  1, LEG(8), LOB(4) }, {  1, LEG(8), LOB(5) },
+  {  1, LEG(8), LOB(6) }, {  1, LEG(8), LOB(7) }, {  1, LEG(8), LOB(8) }, {  1, LEG(8), LOB(9) },
+  {  1, LEG(8), LOB(10) }, {  1, LEG(8), LOB(11) }, {  1, LEG(9), LOB(2) }, {  1, LEG(9), LOB(3) },
+  {  1, LEG(9), LOB(4) }, {  1, LEG(9), LOB(5) }, {  1, LEG(9), LOB(6) }, {  1, LEG(9), LOB(7) },
+  {  1, LEG(9), LOB(8) }, {  1, LEG(9), LOB(9) }, {  1, LEG(9), LOB(10) }, {  1, LEG(9), LOB(11) },
+  {  1, LEG(10), LOB(2) }, {  1, LEG(10), LOB(3) }, {  1, LEG(10), LOB(4) }, {  1, LEG(10), LOB(5) },
+  {  1, LEG(10), LOB(6) }, {  1, LEG(10), LOB(7) }, {  1, LEG(10), LOB(8) }, {  1, LEG(10), LOB(9) },
+  {  1, LEG(10), LOB(10) }, {  1, LEG(10), LOB(11) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }
+};
+
+
+TensorShapeFn tensor_hc_gradleg_quad_b[308] =
+{
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  1, LOB(1), LEG(0) }, { -1, LOB(1), LEG(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, { -1, LOB(0), LEG(0) }, {  1, LOB(0), LEG(0) },
+  {  1, LOB(2), DLOB(0) }, {  1, LOB(2), DLOB(0) }, {  1, LOB(1), DLOB(2) }, {  1, LOB(1), DLOB(2) },
+  {  1, LOB(2), DLOB(1) }, {  1, LOB(2), DLOB(1) }, {  1, LOB(0), DLOB(2) }, {  1, LOB(0), DLOB(2) },
+  {  1, LOB(3), DLOB(0) }, { -1, LOB(3), DLOB(0) }, {  1, LOB(1), DLOB(3) }, { -1, LOB(1), DLOB(3) },
+  { -1, LOB(3), DLOB(1) }, {  1, LOB(3), DLOB(1) }, { -1, LOB(0), DLOB(3) }, {  1, LOB(0), DLOB(3) },
+  {  1, LOB(4), DLOB(0) }, {  1, LOB(4), DLOB(0) }, {  1, LOB(1), DLOB(4) }, {  1, LOB(1), DLOB(4) },
+  {  1, LOB(4), DLOB(1) }, {  1, LOB(4), DLOB(1) }, {  1, LOB(0), DLOB(4) }, {  1, LOB(0), DLOB(4) },
+  {  1, LOB(5), DLOB(0) }, { -1, LOB(5), DLOB(0) }, {  1, LOB(1), DLOB(5) }, { -1, LOB(1), DLOB(5) },
+  { -1, LOB(5), DLOB(1) }, {  1, LOB(5), DLOB(1) }, { -1, LOB(0), DLOB(5) }, {  1, LOB(0), DLOB(5) },
+  {  1, LOB(6), DLOB(0) }, {  1, LOB(6), DLOB(0) }, {  1, LOB(1), DLOB(6) }, {  1, LOB(1), DLOB(6) },
+  {  1, LOB(6), DLOB(1) }, {  1, LOB(6), DLOB(1) }, {  1, LOB(0), DLOB(6) }, {  1, LOB(0), DLOB(6) },
+  {  1, LOB(7), DLOB(0) }, { -1, LOB(7), DLOB(0) }, {  1, LOB(1), DLOB(7) }, { -1, LOB(1), DLOB(7) },
+  { -1, LOB(7), DLOB(1) }, {  1, LOB(7), DLOB(1) }, { -1, LOB(0), DLOB(7) }, {  1, LOB(0), DLOB(7) },
+  {  1, LOB(8), DLOB(0) }, {  1, LOB(8), DLOB(0) }, {  1, LOB(1), DLOB(8) }, {  1, LOB(1), DLOB(8) },
+  {  1, LOB(8), DLOB(1) }, {  1, LOB(8), DLOB(1) }, {  1, LOB(0), DLOB(8) }, {  1, LOB(0), DLOB(8) },
+  {  1, LOB(9), DLOB(0) }, { -1, LOB(9), DLOB(0) }, {  1, LOB(1), DLOB(9) }, { -1, LOB(1), DLOB(9) },
+  { -1, LOB(9), DLOB(1) }, {  1, LOB(9), DLOB(1) }, { -1, LOB(0), DLOB(9) }, {  1, LOB(0), DLOB(9) },
+  {  1, LOB(10), DLOB(0) }, {  1, LOB(10), DLOB(0) }, {  1, LOB(1), DLOB(10) }, {  1, LOB(1), DLOB(10) },
+  {  1, LOB(10), DLOB(1) }, {  1, LOB(10), DLOB(1) }, {  1, LOB(0), DLOB(10) }, {  1, LOB(0), DLOB(10) },
+  {  1, LOB(11), DLOB(0) }, { -1, LOB(11), DLOB(0) }, {  1, LOB(1), DLOB(11) }, { -1, LOB(1), DLOB(11) },
+  { -1, LOB(11), DLOB(1) }, {  1, LOB(11), DLOB(1) }, { -1, LOB(0), DLOB(11) }, {  1, LOB(0), DLOB(11) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  1, LOB(2), LEG(0) }, {  1, LOB(2), LEG(1) },
+  {  1, LOB(2), LEG(2) }, {  1, LOB(2), LEG(3) }, {  1, LOB(2), LEG(4) }, {  1, LOB(2), LEG(5) },
+  {  1, LOB(2), LEG(6) }, {  1, LOB(2), LEG(7) }, {  1, LOB(2), LEG(8) }, {  1, LOB(2), LEG(9) },
+  {  1, LOB(2), LEG(10) }, {  1, LOB(3), LEG(0) }, {  1, LOB(3), LEG(1) }, {  1, LOB(3), LEG(2) },
+  {  1, LOB(3), LEG(3) }, {  1, LOB(3), LEG(4) }, {  1, LOB(3), LEG(5) }, {  1, LOB(3), LEG(6) },
+  {  1, LOB(3), LEG(7) }, {  1, LOB(3), LEG(8) }, {  1, LOB(3), LEG(9) }, {  1, LOB(3), LEG(10) },
+  {  1, LOB(4), LEG(0) }, {  1, LOB(4), LEG(1) }, {  1, LOB(4), LEG(2) }, {  1, LOB(4), LEG(3) },
+  {  1, LOB(4), LEG(4) }, {  1, LOB(4), LEG(5) }, {  1, LOB(4), LEG(6) }, {  1, LOB(4), LEG(7) },
+  {  1, LOB(4), LEG(8) }, {  1, LOB(4), LEG(9) }, {  1, LOB(4), LEG(10) }, {  1, LOB(5), LEG(0) },
+  {  1, LOB(5), LEG(1) }, {  1, LOB(5), LEG(2) }, {  1, LOB(5), LEG(3) }, {  1, LOB(5), LEG(4) },
+  {  1, LOB(5), LEG(5) }, {  1, LOB(5), LEG(6) }, {  1, LOB(5), LEG(7) }, {  1, LOB(5), LEG(8) },
+  {  1, LOB(5), LEG(9) }, {  1, LOB(5), LEG(10) }, {  1, LOB(6), LEG(0) }, {  1, LOB(6), LEG(1) },
+  {  1, LOB(6), LEG(2) }, {  1, LOB(6), LEG(3) }, {  1, LOB(6), LEG(4) }, {  1, LOB(6), LEG(5) },
+  {  1, LOB(6), LEG(6) }, {  1, LOB(6), LEG(7) }, {  1, LOB(6), LEG(8) }, {  1, LOB(6), LEG(9) },
+  {  1, LOB(6), LEG(10) }, {  1, LOB(7), LEG(0) }, {  1, LOB(7), LEG(1) }, {  1, LOB(7), LEG(2) },
+  {  1, LOB(7), LEG(3) }, {  1, LOB(7), LEG(4) }, {  1, LOB(7), LEG(5) }, {  1, LOB(7), LEG(6) },
+  {  1, LOB(7), LEG(7) }, {  1, LOB(7), LEG(8) }, {  1, LOB(7), LEG(9) }, {  1, LOB(7), LEG(10) },
+  {  1, LOB(8), LEG(0) }, {  1, LOB(8), LEG(1) }, {  1, LOB(8), LEG(2) }, {  1, LOB(8), LEG(3) },
+  {  1, LOB(8), LEG(4) }, {  1, LOB(8), LEG(5) }, {  1, LOB(8), LEG(6) }, {  1, LOB(8), LEG(7) },
+  {  1, LOB(8), LEG(8) }, {  1, LOB(8), LEG(9) }, {  1, LOB(8), LEG(10) }, {  1, LOB(9), LEG(0) },
+  {  1, LOB(9), LEG(1) }, {  1, LOB(9), LEG(2) }, {  1, LOB(9), LEG(3) }, {  1, LOB(9), LEG(4) },
+  {  1, LOB(9), LEG(5) }, {  1, LOB(9), LEG(6) }, {  1, LOB(9), LEG(7) }, {  1, LOB(9), LEG(8) },
+  {  1, LOB(9), LEG(9) }, {  1, LOB(9), LEG(10) }, {  1, LOB(10), LEG(0) }, {  1, LOB(10), LEG(1) },
+  {  1, LOB(10), LEG(2) }, {  1, LOB(10), LEG(3) }, {  1, LOB(10), LEG(4) }, {  1, LOB(10), LEG(5) },
+  {  1, LOB(10), LEG(6) }, {  1, LOB(10), LEG(7) }, {  1, LOB(10), LEG(8) }, {  1, LOB(10), LEG(9) },
+  {  1, LOB(10), LEG(10) }, {  1, LOB(11), LEG(0) }, {  1, LOB(11), LEG(1) }, {  1, LOB(11), LEG(2) },
+  {  1, LOB(11), LEG(3) }, {  1, LOB(11), LEG(4) }, {  1, LOB(11), LEG(5) }, {  1, LOB(11), LEG(6) },
+  {  1, LOB(11), LEG(7) }, {  1, LOB(11), LEG(8) }, {  1, LOB(11), LEG(9) }, {  1, LOB(11), LEG(10) }
+};
+int tensor_hc_gradleg_quad_size = 308;
+
+
+TensorShapeFn tensor_hd_leg_quad_a[308] =
+{
+  {  1, LOB(0), LEG(0) }, { -1, LOB(0), LEG(0) }, { -1, LOB(1), LEG(0) }, {  1, LOB(1), LEG(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  { -1, LOB(0), LEG(1) }, { -1, LOB(0), LEG(1) }, { -1, LOB(1), LEG(1) }, { -1, LOB(1), LEG(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LOB(0), LEG(2) }, { -1, LOB(0), LEG(2) }, { -1, LOB(1), LEG(2) }, {  1, LOB(1), LEG(2) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  { -1, LOB(0), LEG(3) }, { -1, LOB(0), LEG(3) }, { -1, LOB(1), LEG(3) }, { -1, LOB(1), LEG(3) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LOB(0), LEG(4) }, { -1, LOB(0), LEG(4) }, { -1, LOB(1), LEG(4) }, {  1, LOB(1), LEG(4) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  { -1, LOB(0), LEG(5) }, { -1, LOB(0), LEG(5) }, { -1, LOB(1), LEG(5) }, { -1, LOB(1), LEG(5) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LOB(0), LEG(6) }, { -1, LOB(0), LEG(6) }, { -1, LOB(1), LEG(6) }, {  1, LOB(1), LEG(6) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  { -1, LOB(0), LEG(7) }, { -1, LOB(0), LEG(7) }, { -1, LOB(1), LEG(7) }, { -1, LOB(1), LEG(7) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LOB(0), LEG(8) }, { -1, LOB(0), LEG(8) }, { -1, LOB(1), LEG(8) }, {  1, LOB(1), LEG(8) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  { -1, LOB(0), LEG(9) }, { -1, LOB(0), LEG(9) }, { -1, LOB(1), LEG(9) }, { -1, LOB(1), LEG(9) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LOB(0), LEG(10) }, { -1, LOB(0), LEG(10) }, { -1, LOB(1), LEG(10) }, {  1, LOB(1), LEG(10) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, { -1, LOB(2), LEG(0) }, { -1, LOB(2), LEG(1) },
+  { -1, LOB(2), LEG(2) }, { -1, LOB(2), LEG(3) }, { -1, LOB(2), LEG(4) }, { -1, LOB(2), LEG(5) },
+  { -1, LOB(2), LEG(6) }, { -1, LOB(2), LEG(7) }, { -1, LOB(2), LEG(8) }, { -1, LOB(2), LEG(9) },
+  { -1, LOB(2), LEG(10) }, { -1, LOB(3), LEG(0) }, { -1, LOB(3), LEG(1) }, { -1, LOB(3), LEG(2) },
+  { -1, LOB(3), LEG(3) }, { -1, LOB(3), LEG(4) }, { -1, LOB(3), LEG(5) }, { -1, LOB(3), LEG(6) },
+  { -1, LOB(3), LEG(7) }, { -1, LOB(3), LEG(8) }, { -1, LOB(3), LEG(9) }, { -1, LOB(3), LEG(10) },
+  { -1, LOB(4), LEG(0) }, { -1, LOB(4), LEG(1) }, { -1, LOB(4), LEG(2) }, { -1, LOB(4), LEG(3) },
+  { -1, LOB(4), LEG(4) }, { -1, LOB(4), LEG(5) }, { -1, LOB(4), LEG(6) }, { -1, LOB(4), LEG(7) },
+  { -1, LOB(4), LEG(8) }, { -1, LOB(4), LEG(9) }, { -1, LOB(4), LEG(10) }, { -1, LOB(5), LEG(0) },
+  { -1, LOB(5), LEG(1) }, { -1, LOB(5), LEG(2) }, { -1, LOB(5), LEG(3) }, { -1, LOB(5), LEG(4) },
+  { -1, LOB(5), LEG(5) }, { -1, LOB(5), LEG(6) }, { -1, LOB(5), LEG(7) }, { -1, LOB(5), LEG(8) },
+  { -1, LOB(5), LEG(9) }, { -1, LOB(5), LEG(10) }, { -1, LOB(6), LEG(0) }, { -1, LOB(6), LEG(1) },
+  { -1, LOB(6), LEG(2) }, { -1, LOB(6), LEG(3) }, { -1, LOB(6), LEG(4) }, { -1, LOB(6), LEG(5) },
+  { -1, LOB(6), LEG(6) }, { -1, LOB(6), LEG(7) }, { -1, LOB(6), LEG(8) }, { -1, LOB(6), LEG(9) },
+  { -1, LOB(6), LEG(10) }, { -1, LOB(7), LEG(0) }, { -1, LOB(7), LEG(1) }, { -1, LOB(7), LEG(2) },
+  { -1, LOB(7), LEG(3) }, { -1, LOB(7), LEG(4) }, { -1, LOB(7), LEG(5) }, { -1, LOB(7), LEG(6) },
+  { -1, LOB(7), LEG(7) }, { -1, LOB(7), LEG(8) }, { -1, LOB(7), LEG(9) }, { -1, LOB(7), LEG(10) },
+  { -1, LOB(8), LEG(0) }, { -1, LOB(8), LEG(1) }, { -1, LOB(8), LEG(2) }, { -1, LOB(8), LEG(3) },
+  { -1, LOB(8), LEG(4) }, { -1, LOB(8), LEG(5) }, { -1, LOB(8), LEG(6) }, { -1, LOB(8), LEG(7) },
+  { -1, LOB(8), LEG(8) }, { -1, LOB(8), LEG(9) }, { -1, LOB(8), LEG(10) }, { -1, LOB(9), LEG(0) },
+  { -1, LOB(9), LEG(1) }, { -1, LOB(9), LEG(2) }, { -1, LOB(9), LEG(3) }, { -1, LOB(9), LEG(4) },
+  { -1, LOB(9), LEG(5) }, { -1, LOB(9), LEG(6) }, { -1, LOB(9), LEG(7) }, { -1, LOB(9), LEG(8) },
+  { -1, LOB(9), LEG(9) }, { -1, LOB(9), LEG(10) }, { -1, LOB(10), LEG(0) }, { -1, LOB(10), LEG(1) },
+  { -1, LOB(10), LEG(2) }, { -1, LOB(10), LEG(3) }, { -1, LOB(10), LEG(4) }, { -1, LOB(10), LEG(5) },
+  { -1, LOB(10), LEG(6) }, { -1, LOB(10), LEG(7) }, { -1, LOB(10), LEG(8) }, { -1, LOB(10), LEG(9) },
+  { -1, LOB(10), LEG(10) }, { -1, LOB(11), LEG(0) }, { -1, LOB(11), LEG(1) }, { -1, LOB(11), LEG(2) },
+  { -1, LOB(11), LEG(3) }, { -1, LOB(11), LEG(4) }, { -1, LOB(11), LEG(5) }, { -1, LOB(11), LEG(6) },
+  { -1, LOB(11), LEG(7) }, { -1, LOB(11), LEG(8) }, { -1, LOB(11), LEG(9) }, { -1, LOB(11), LEG(10) }
+};
+
+
+TensorShapeFn tensor_hd_leg_quad_b[308] =
+{
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(0), LOB(0) }, { -1, LEG(0), LOB(0) }, { -1, LEG(0), LOB(1) }, {  1, LEG(0), LOB(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(1), LOB(0) }, {  1, LEG(1), LOB(0) }, {  1, LEG(1), LOB(1) }, {  1, LEG(1), LOB(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(2), LOB(0) }, { -1, LEG(2), LOB(0) }, { -1, LEG(2), LOB(1) }, {  1, LEG(2), LOB(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(3), LOB(0) }, {  1, LEG(3), LOB(0) }, {  1, LEG(3), LOB(1) }, {  1, LEG(3), LOB(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(4), LOB(0) }, { -1, LEG(4), LOB(0) }, { -1, LEG(4), LOB(1) }, {  1, LEG(4), LOB(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(5), LOB(0) }, {  1, LEG(5), LOB(0) }, {  1, LEG(5), LOB(1) }, {  1, LEG(5), LOB(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(6), LOB(0) }, { -1, LEG(6), LOB(0) }, { -1, LEG(6), LOB(1) }, {  1, LEG(6), LOB(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(7), LOB(0) }, {  1, LEG(7), LOB(0) }, {  1, LEG(7), LOB(1) }, {  1, LEG(7), LOB(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(8), LOB(0) }, { -1, LEG(8), LOB(0) }, { -1, LEG(8), LOB(1) }, {  1, LEG(8), LOB(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(9), LOB(0) }, {  1, LEG(9), LOB(0) }, {  1, LEG(9), LOB(1) }, {  1, LEG(9), LOB(1) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  1, LEG(10), LOB(0) }, { -1, LEG(10), LOB(0) }, { -1, LEG(10), LOB(1) }, {  1, LEG(10), LOB(1) },
+  {  1, LEG(0), LOB(2) }, {  1, LEG(0), LOB(3) }, {  1, LEG(0), LOB(4) }, {  1, LEG(0), LOB(5) },
+  {  1, LEG(0), LOB(6) }, {  1, LEG(0), LOB(7) }, {  1, LEG(0), LOB(8) }, {  1, LEG(0), LOB(9) },
+  {  1, LEG(0), LOB(10) }, {  1, LEG(0), LOB(11) }, {  1, LEG(1), LOB(2) }, {  1, LEG(1), LOB(3) },
+  {  1, LEG(1), LOB(4) }, {  1, LEG(1), LOB(5) }, {  1, LEG(1), LOB(6) }, {  1, LEG(1), LOB(7) },
+  {  1, LEG(1), LOB(8) }, {  1, LEG(1), LOB(9) }, {  1, LEG(1), LOB(10) }, {  1, LEG(1), LOB(11) },
+  {  1, LEG(2), LOB(2) }, {  1, LEG(2), LOB(3) }, {  1, LEG(2), LOB(4) }, {  1, LEG(2), LOB(5) },
+  {  1, LEG(2), LOB(6) }, {  1, LEG(2), LOB(7) }, {  1, LEG(2), LOB(8) }, {  1, LEG(2), LOB(9) },
+  {  1, LEG(2), LOB(10) }, {  1, LEG(2), LOB(11) }, {  1, LEG(3), LOB(2) }, {  1, LEG(3), LOB(3) },
+  {  1, LEG(3), LOB(4) }, {  1, LEG(3), LOB(5) }, {  1, LEG(3), LOB(6) }, {  1, LEG(3), LOB(7) },
+  {  1, LEG(3), LOB(8) }, {  1, LEG(3), LOB(9) }, {  1, LEG(3), LOB(10) }, {  1, LEG(3), LOB(11) },
+  {  1, LEG(4), LOB(2) }, {  1, LEG(4), LOB(3) }, {  1, LEG(4), LOB(4) }, {  1, LEG(4), LOB(5) },
+  {  1, LEG(4), LOB(6) }, {  1, LEG(4), LOB(7) }, {  1, LEG(4), LOB(8) }, {  1, LEG(4), LOB(9) },
+  {  1, LEG(4), LOB(10) }, {  1, LEG(4), LOB(11) }, {  1, LEG(5), LOB(2) }, {  1, LEG(5), LOB(3) },
+  {  1, LEG(5), LOB(4) }, {  1, LEG(5), LOB(5) }, {  1, LEG(5), LOB(6) }, {  1, LEG(5), LOB(7) },
+  {  1, LEG(5), LOB(8) }, {  1, LEG(5), LOB(9) }, {  1, LEG(5), LOB(10) }, {  1, LEG(5), LOB(11) },
+  {  1, LEG(6), LOB(2) }, {  1, LEG(6), LOB(3) }, {  1, LEG(6), LOB(4) }, {  1, LEG(6), LOB(5) },
+  {  1, LEG(6), LOB(6) }, {  1, LEG(6), LOB(7) }, {  1, LEG(6), LOB(8) }, {  1, LEG(6), LOB(9) },
+  {  1, LEG(6), LOB(10) }, {  1, LEG(6), LOB(11) }, {  1, LEG(7), LOB(2) }, {  1, LEG(7), LOB(3) },
+  {  1, LEG(7), LOB(4) }, {  1, LEG(7), LOB(5) }, {  1, LEG(7), LOB(6) }, {  1, LEG(7), LOB(7) },
+  {  1, LEG(7), LOB(8) }, {  1, LEG(7), LOB(9) }, {  1, LEG(7), LOB(10) }, {  1, LEG(7), LOB(11) },
+  {  1, LEG(8), LOB(2) }, {  1, LEG(8), LOB(3) }, {  1, LEG(8), LOB(4) }, {  1, LEG(8), LOB(5) },
+  {  1, LEG(8), LOB(6) }, {  1, LEG(8), LOB(7) }, {  1, LEG(8), LOB(8) }, {  1, LEG(8), LOB(9) },
+  {  1, LEG(8), LOB(10) }, {  1, LEG(8), LOB(11) }, {  1, LEG(9), LOB(2) }, {  1, LEG(9), LOB(3) },
+  {  1, LEG(9), LOB(4) }, {  1, LEG(9), LOB(5) }, {  1, LEG(9), LOB(6) }, {  1, LEG(9), LOB(7) },
+  {  1, LEG(9), LOB(8) }, {  1, LEG(9), LOB(9) }, {  1, LEG(9), LOB(10) }, {  1, LEG(9), LOB(11) },
+  {  1, LEG(10), LOB(2) }, {  1, LEG(10), LOB(3) }, {  1, LEG(10), LOB(4) }, {  1, LEG(10), LOB(5) },
+  {  1, LEG(10), LOB(6) }, {  1, LEG(10), LOB(7) }, {  1, LEG(10), LOB(8) }, {  1, LEG(10), LOB(9) },
+  {  1, LEG(10), LOB(10) }, {  1, LEG(10), LOB(11) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) },
+  {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }, {  0, LOB(0), LOB(0) }
+};
+int tensor_hd_leg_quad_size = 308;
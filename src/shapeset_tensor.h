@@ -0,0 +1,47 @@
+// This file is part of Hermes2D.
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __H2D_SHAPESET_TENSOR_H
+#define __H2D_SHAPESET_TENSOR_H
+
+#include "shapeset.h"
+
+// Encoding of the one-dimensional factors in TensorShapeFn: bits 0-3 hold the degree,
+// bits 4-5 the order of a derivative applied to the function, bit 6 selects Legendre
+// polynomials instead of Lobatto shape functions.
+#define H2D_TENSOR_MAX_DEGREE 15
+
+/// Evaluates the d-th derivative of the one-dimensional function 'f' (encoded as above) at x.
+/// Lobatto functions are l_0 = (1-x)/2, l_1 = (1+x)/2 and l_k = (P_k - P_{k-2}) / sqrt(2(2k-1)),
+/// P_k being the Legendre polynomials, which are evaluated by the three-term recurrence.
+extern H2D_API double tensor_fn_1d(int f, int d, double x);
+
+// tensor-product descriptions of the quad functions, in the index layout of the generated tables
+extern TensorShapeFn tensor_h1_quad[];
+extern int tensor_h1_quad_size;
+extern TensorShapeFn tensor_l2_leg_quad[];
+extern int tensor_l2_leg_quad_size;
+extern TensorShapeFn tensor_hc_leg_quad_a[];
+extern TensorShapeFn tensor_hc_leg_quad_b[];
+extern int tensor_hc_leg_quad_size;
+extern TensorShapeFn tensor_hc_gradleg_quad_a[];
+extern TensorShapeFn tensor_hc_gradleg_quad_b[];
+extern int tensor_hc_gradleg_quad_size;
+extern TensorShapeFn tensor_hd_leg_quad_a[];
+extern TensorShapeFn tensor_hd_leg_quad_b[];
+extern int tensor_hd_leg_quad_size;
+
+
+#endif
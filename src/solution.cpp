@@ -162,6 +162,7 @@ Solution::Solution()
   dxdy_buffer = NULL;
   num_coefs = num_elems = 0;
   num_dofs = -1;
+  refs = NULL;
 
   set_quad_2d(&g_quad_2d_std);
 }
@@ -171,73 +172,124 @@ void Solution::assign(Solution* sln)
 {
   if (sln->type == UNDEF) error("Solution being assigned is uninitialized.");
   if (sln->type != SLN) { copy(sln); return; }
+  if (sln == this) return;
 
   free();
+  type = UNDEF;
+  swap(sln);
 
-  mesh = sln->mesh;
-  own_mesh = sln->own_mesh;
-  sln->own_mesh = false;
-
-  mono_coefs = sln->mono_coefs;        sln->mono_coefs = NULL;
-  elem_coefs[0] = sln->elem_coefs[0];  sln->elem_coefs[0] = NULL;
-  elem_coefs[1] = sln->elem_coefs[1];  sln->elem_coefs[1] = NULL;
-  elem_orders = sln->elem_orders;      sln->elem_orders = NULL;
-  dxdy_buffer = sln->dxdy_buffer;      sln->dxdy_buffer = NULL;
-  num_coefs = sln->num_coefs;          sln->num_coefs = 0;
-  num_elems = sln->num_elems;          sln->num_elems = 0;
-
-  type = sln->type;
-  space_type = sln->space_type;
-  num_components = sln->num_components;
-
-  sln->type = UNDEF;
-  memset(sln->tables, 0, sizeof(sln->tables));
+  // the mesh stays accessible through 'sln', as before the move
+  sln->mesh = mesh;
 }
 
 
 void Solution::copy(const Solution* sln)
 {
   if (sln->type == UNDEF) error("Solution being copied is uninitialized.");
+  if (sln == this) return;
 
   free();
 
-  mesh = new Mesh;
-  mesh->copy(sln->mesh);
-  own_mesh = true;
-
   type = sln->type;
   space_type = sln->space_type;
   num_components = sln->num_components;
   num_dofs = sln->num_dofs;
 
-  if (sln->type == SLN) // standard solution: copy coefficient arrays
+  if (sln->type == SLN) // standard solution: share the mesh and the coefficient arrays
   {
+    mesh = sln->mesh;
+    own_mesh = true;
+    refs = sln->refs;
+    (*refs)++;
+
     num_coefs = sln->num_coefs;
     num_elems = sln->num_elems;
-
-    mono_coefs = new scalar[num_coefs];
-    memcpy(mono_coefs, sln->mono_coefs, sizeof(scalar) * num_coefs);
-
-    for (int l = 0; l < num_components; l++) {
-      elem_coefs[l] = new int[num_elems];
-      memcpy(elem_coefs[l], sln->elem_coefs[l], sizeof(int) * num_elems);
-    }
-
-    elem_orders = new int[num_elems];
-    memcpy(elem_orders, sln->elem_orders, sizeof(int) * num_elems);
+    mono_coefs = sln->mono_coefs;
+    for (int l = 0; l < num_components; l++)
+      elem_coefs[l] = sln->elem_coefs[l];
+    elem_orders = sln->elem_orders;
 
     init_dxdy_buffer();
   }
   else // exact, const
   {
+    mesh = new Mesh;
+    mesh->copy(sln->mesh);
+    own_mesh = true;
+
     exactfn1 = sln->exactfn1;
     exactfn2 = sln->exactfn2;
     cnst[0] = sln->cnst[0];
     cnst[1] = sln->cnst[1];
+    exact_mult = sln->exact_mult;
   }
 }
 
 
+void Solution::swap(Solution* sln)
+{
+  if (sln == this) return;
+
+  // the precalculated tables belong to the elements of the old meshes
+  free_tables();
+  sln->free_tables();
+  e_last = sln->e_last = NULL;
+
+  std::swap(mesh, sln->mesh);
+  std::swap(own_mesh, sln->own_mesh);
+  std::swap(refs, sln->refs);
+  std::swap(type, sln->type);
+  std::swap(space_type, sln->space_type);
+  std::swap(num_components, sln->num_components);
+  std::swap(num_dofs, sln->num_dofs);
+
+  std::swap(mono_coefs, sln->mono_coefs);
+  std::swap(elem_coefs[0], sln->elem_coefs[0]);
+  std::swap(elem_coefs[1], sln->elem_coefs[1]);
+  std::swap(elem_orders, sln->elem_orders);
+  std::swap(num_coefs, sln->num_coefs);
+  std::swap(num_elems, sln->num_elems);
+  std::swap(dxdy_buffer, sln->dxdy_buffer);
+
+  std::swap(exactfn1, sln->exactfn1);
+  std::swap(exactfn2, sln->exactfn2);
+  std::swap(cnst[0], sln->cnst[0]);
+  std::swap(cnst[1], sln->cnst[1]);
+  std::swap(exact_mult, sln->exact_mult);
+}
+
+
+void Solution::make_unique()
+{
+  if (refs == NULL || *refs == 1) return;
+
+  // leave the shared data to the other copies
+  (*refs)--;
+  refs = new int(1);
+
+  Mesh* m = new Mesh;
+  m->copy(mesh);
+  mesh = m;
+
+  scalar* mc = new scalar[num_coefs];
+  memcpy(mc, mono_coefs, sizeof(scalar) * num_coefs);
+  mono_coefs = mc;
+
+  for (int l = 0; l < num_components; l++) {
+    int* ec = new int[num_elems];
+    memcpy(ec, elem_coefs[l], sizeof(int) * num_elems);
+    elem_coefs[l] = ec;
+  }
+
+  int* eo = new int[num_elems];
+  memcpy(eo, elem_orders, sizeof(int) * num_elems);
+  elem_orders = eo;
+
+  free_tables();
+  e_last = NULL;
+}
+
+
 void Solution::free_tables()
 {
   for (int i = 0; i < 4; i++)
@@ -248,6 +300,18 @@ void Solution::free_tables()
 
 void Solution::free()
 {
+  // the mesh and the coefficients may still be used by copies of this solution
+  if (refs != NULL && --(*refs) > 0)
+  {
+    mono_coefs = NULL;
+    elem_orders = NULL;
+    elem_coefs[0] = elem_coefs[1] = NULL;
+    own_mesh = false;
+  }
+  else if (refs != NULL)
+    delete refs;
+  refs = NULL;
+
   if (mono_coefs  != NULL) { delete [] mono_coefs;   mono_coefs = NULL;  }
   if (elem_orders != NULL) { delete [] elem_orders;  elem_orders = NULL; }
   if (dxdy_buffer != NULL) { delete [] dxdy_buffer;  dxdy_buffer = NULL; }
@@ -351,6 +415,7 @@ void Solution::set_fe_solution(Space* space, PrecalcShapeset* pss, scalar* vec,
   mesh = new Mesh;
   mesh->copy(space->get_mesh());
   own_mesh = true;
+  refs = new int(1);
 
   // allocate the coefficient arrays
   num_elems = mesh->get_max_element_id();
@@ -364,7 +429,7 @@ void Solution::set_fe_solution(Space* space, PrecalcShapeset* pss, scalar* vec,
   // obtain element orders, allocate mono_coefs
   Element* e;
   num_coefs = 0;
-  for_all_active_elements(e, mesh)
+  for_all_active_elements_fast(e, mesh)
   {
     mode = e->get_mode();
     o = space->get_element_order(e->id);
@@ -387,7 +452,7 @@ void Solution::set_fe_solution(Space* space, PrecalcShapeset* pss, scalar* vec,
   Quad2D* quad = &g_quad_2d_cheb;
   pss->set_quad_2d(quad);
   scalar* mono = mono_coefs;
-  for_all_active_elements(e, mesh)
+  for_all_active_elements_fast(e, mesh)
   {
     mode = e->get_mode();
     quad->set_mode(mode);
@@ -511,6 +576,7 @@ void Solution::multiply(scalar coef)
 {
   if (type == SLN)
   {
+    make_unique();
     for (int i = 0; i < num_coefs; i++)
       mono_coefs[i] *= coef;
   }
@@ -1062,6 +1128,7 @@ void Solution::load(const char* filename)
   mesh = new Mesh;
   mesh->load_raw(f);
   own_mesh = true;
+  refs = new int(1);
 
   if (compressed) pclose(f); else fclose(f);
 
@@ -1170,7 +1237,7 @@ scalar Solution::get_pt_value(double x, double y, int item)
   }
   else if (type == CNST)
   {
-    if (b = 0) return cnst[a];
+    if (b == 0) return cnst[a];
     return 0.0;
   }
   else if (type == UNDEF)
@@ -1203,7 +1270,7 @@ scalar Solution::get_pt_value(double x, double y, int item)
 
   // go through all elements
   Element *e;
-  for_all_active_elements(e, mesh)
+  for_all_active_elements_fast(e, mesh)
   {
     refmap->set_active_element(e);
     refmap->untransform(e, x, y, xi1, xi2);
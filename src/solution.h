@@ -88,10 +88,20 @@ public:
   virtual ~Solution();
   virtual void free();
 
+  /// Moves the data of 'sln' to this solution without copying them. 'sln' becomes
+  /// uninitialized (exact and constant solutions are copied instead).
   void assign(Solution* sln);
   Solution& operator = (Solution& sln) { assign(&sln); return *this; }
+
+  /// Makes this solution a copy of 'sln'. The mesh and the coefficients of a solution
+  /// obtained from a space are not duplicated: they are shared with 'sln' (and its other
+  /// copies) until one of them is changed, so the copy is cheap, e.g., when saving the
+  /// previous time level. Exact and constant solutions get a private copy of the mesh.
   void copy(const Solution* sln);
 
+  /// Exchanges the contents of this solution and 'sln' without copying any data.
+  void swap(Solution* sln);
+
   void set_exact(Mesh* mesh, ExactFunction exactfn);
   void set_exact(Mesh* mesh, ExactFunction2 exactfn);
 
@@ -145,6 +155,8 @@ public:
   int get_num_dofs() const { return num_dofs; };
 
   /// Multiplies the function represented by this class by the given coefficient.
+  /// If the coefficients are shared with copies of the solution, they are duplicated first
+  /// (together with the mesh, so get_mesh() returns a new mesh after the call).
   void multiply(scalar coef);
 
 
@@ -159,7 +171,7 @@ public:
 
 protected:
 
-  enum { SLN, EXACT, CNST, UNDEF } type;
+  enum SlnType { SLN, EXACT, CNST, UNDEF } type;
 
   bool own_mesh;
   bool transform;
@@ -174,6 +186,9 @@ protected:
   int num_coefs, num_elems;
   int num_dofs;
 
+  int* refs;           ///< number of solutions sharing the mesh and the coefficients, see copy()
+  void make_unique();
+
   int space_type;
   void transform_values(int order, Node* node, int newmask, int oldmask, int np);
 
@@ -71,6 +71,12 @@ void AztecOOSolver::set_precond(const char *name)
 #endif
 }
 
+void AztecOOSolver::set_precond_reuse(EPrecondReuse policy, double growth, int max_age)
+{
+	if (pc == NULL) error("No preconditioner set, call set_precond() first.");
+	pc->set_reuse_policy(policy, growth, max_age);
+}
+
 bool AztecOOSolver::solve()
 {
 #ifdef HAVE_AZTECOO
@@ -87,6 +93,11 @@ bool AztecOOSolver::solve()
 	aztec.SetLHS(&x);
 
 	if (pc != NULL) {
+		// with a reuse policy, the preconditioner decides what to recompute
+		if (pc->get_reuse_policy() != PC_REUSE_NONE) {
+			pc->create(&m);
+			pc->compute();
+		}
 		Epetra_Operator *op = pc->get_obj();
 		assert(op != NULL);		// can work only with Epetra_Operators
 		aztec.SetPrecOperator(op);
@@ -94,6 +105,7 @@ bool AztecOOSolver::solve()
 
 	// solve it
 	aztec.Iterate(max_iters, tolerance);
+	if (pc != NULL) pc->report_iters(aztec.NumIters());
 
 	delete [] sln;
 	sln = new scalar[m.size];
@@ -54,6 +54,17 @@ public:
 	/// @param[in] pc - IFPACK preconditioner
 	void set_precond(Precond *pc) { this->pc = pc; }
 
+	/// Set the reuse policy of the preconditioner set by set_precond(Precond *), see
+	/// Precond::set_reuse_policy(). With a policy other than PC_REUSE_NONE, solve()
+	/// updates the preconditioner for the current matrix itself, so the caller does
+	/// not need to call create() and compute() before every solve.
+	void set_precond_reuse(EPrecondReuse policy, double growth = 2.0, int max_age = 10);
+
+	/// Preconditioner statistics (see Precond)
+	int get_num_prec_builds() { return pc != NULL ? pc->get_num_builds() : 0; }
+	int get_num_prec_refreshes() { return pc != NULL ? pc->get_num_refreshes() : 0; }
+	int get_num_prec_skips() { return pc != NULL ? pc->get_num_skips() : 0; }
+
 protected:
 #ifdef WITH_TRILINOS
 	AztecOO aztec;					/// instance of aztec solver
@@ -25,6 +25,9 @@ static Epetra_SerialComm seq_comm;
 
 #define EPETRA_NOT_COMPILED "hermes2d was not built with Epetra support."
 
+// global, so that two matrices (possibly living at the same address) never share a number
+static unsigned epetra_structure_seq = 0;
+
 EpetraMatrix::EpetraMatrix()
 {
 #ifdef HAVE_EPETRA
@@ -41,6 +44,9 @@ EpetraMatrix::EpetraMatrix()
 #else
 	error(EPETRA_NOT_COMPILED);
 #endif
+	this->static_graph = false;
+	this->reuse_graph = false;
+	this->structure_seq = ++epetra_structure_seq;
 }
 
 #ifdef HAVE_EPETRA
@@ -54,19 +60,27 @@ EpetraMatrix::EpetraMatrix(Epetra_RowMatrix &op)
 
 	this->row_storage = true;
 	this->col_storage = false;
+	this->static_graph = false;
+	this->reuse_graph = false;
+	this->structure_seq = ++epetra_structure_seq;
 }
 #endif
 
 EpetraMatrix::~EpetraMatrix()
 {
 #ifdef HAVE_EPETRA
-	free();
+	destroy();
 #endif
 }
 
 void EpetraMatrix::prealloc(int n)
 {
 #ifdef HAVE_EPETRA
+	// keep the filled graph (and the matrix built on it) from the last time
+	reuse_graph = static_graph && mat != NULL && grph->Filled() && n == this->size;
+	if (reuse_graph) return;
+
+	destroy();
 	this->size = n;
 	// alloc trilinos structs
 	std_map = new Epetra_Map(n, 0, seq_comm);
@@ -77,10 +91,29 @@ void EpetraMatrix::prealloc(int n)
 void EpetraMatrix::pre_add_ij(int row, int col)
 {
 #ifdef HAVE_EPETRA
+	if (reuse_graph) return;
 	grph->InsertGlobalIndices(row, 1, &col);
 #endif
 }
 
+void EpetraMatrix::pre_add_block(int m, int *rows, int n, int *cols)
+{
+#ifdef HAVE_EPETRA
+	if (reuse_graph) return;
+
+	// one insertion per row, Dirichlet DOFs are skipped
+	if ((int) row_idx.size() < n) row_idx.resize(n);
+	int nc = 0;
+	for (int j = 0; j < n; j++)
+		if (cols[j] >= 0) row_idx[nc++] = cols[j];
+	if (nc == 0) return;
+
+	for (int i = 0; i < m; i++)
+		if (rows[i] >= 0)
+			grph->InsertGlobalIndices(rows[i], nc, &row_idx[0]);
+#endif
+}
+
 void EpetraMatrix::finish()
 {
 #ifdef HAVE_EPETRA
@@ -94,18 +127,32 @@ void EpetraMatrix::finish()
 void EpetraMatrix::alloc()
 {
 #ifdef HAVE_EPETRA
+	if (reuse_graph) {
+		zero();
+		return;
+	}
+
 	grph->FillComplete();
 	// create the matrix
 	mat = new Epetra_CrsMatrix(Copy, *grph);
 #ifdef H2D_COMPLEX
 	mat_im = new Epetra_CrsMatrix(Copy, *grph);
 #endif
+	structure_seq = ++epetra_structure_seq;
 #endif
 }
 
 void EpetraMatrix::free()
 {
 #ifdef HAVE_EPETRA
+	if (static_graph) return;	// kept for the next prealloc()
+	destroy();
+#endif
+}
+
+#ifdef HAVE_EPETRA
+void EpetraMatrix::destroy()
+{
 	if (owner) {
 		delete mat; mat = NULL;
 #ifdef H2D_COMPLEX
@@ -114,8 +161,9 @@ void EpetraMatrix::free()
 		delete grph; grph = NULL;
 		delete std_map; std_map = NULL;
 	}
-#endif
+	structure_seq = ++epetra_structure_seq;
 }
+#endif
 
 scalar EpetraMatrix::get(int m, int n)
 {
@@ -175,9 +223,36 @@ void EpetraMatrix::add(int m, int n, scalar v)
 void EpetraMatrix::add(int m, int n, scalar **mat, int *rows, int *cols)
 {
 #ifdef HAVE_EPETRA
-	for (int i = 0; i < m; i++)				// rows
-		for (int j = 0; j < n; j++)			// cols
-			add(rows[i], cols[j], mat[i][j]);
+	// columns of the block that are not Dirichlet DOFs
+	if ((int) row_idx.size() < n) {
+		row_idx.resize(n);
+		row_pos.resize(n);
+		row_vals.resize(n);
+	}
+	int nc = 0;
+	for (int j = 0; j < n; j++)
+		if (cols[j] >= 0) {
+			row_idx[nc] = cols[j];
+			row_pos[nc++] = j;
+		}
+	if (nc == 0) return;
+
+	// one call to SumIntoGlobalValues per row of the block
+	for (int i = 0; i < m; i++) {			// rows
+		if (rows[i] < 0) continue;			// ignore dirichlet DOFs
+#ifndef H2D_COMPLEX
+		for (int k = 0; k < nc; k++) row_vals[k] = mat[i][row_pos[k]];
+		int ierr = this->mat->SumIntoGlobalValues(rows[i], nc, &row_vals[0], &row_idx[0]);
+		assert(ierr == 0);
+#else
+		for (int k = 0; k < nc; k++) row_vals[k] = std::real(mat[i][row_pos[k]]);
+		int ierr = this->mat->SumIntoGlobalValues(rows[i], nc, &row_vals[0], &row_idx[0]);
+		assert(ierr == 0);
+		for (int k = 0; k < nc; k++) row_vals[k] = std::imag(mat[i][row_pos[k]]);
+		ierr = this->mat_im->SumIntoGlobalValues(rows[i], nc, &row_vals[0], &row_idx[0]);
+		assert(ierr == 0);
+#endif
+	}
 #endif
 }
 
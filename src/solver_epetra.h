@@ -40,6 +40,7 @@ public:
 
 	virtual void prealloc(int n);
 	virtual void pre_add_ij(int row, int col);
+	virtual void pre_add_block(int m, int *rows, int n, int *cols);
 	virtual void finish();
 
 	virtual void alloc();
@@ -53,6 +54,17 @@ public:
 	virtual bool dump(FILE *file, const char *var_name, EMatrixDumpFormat fmt = DF_MATLAB_SPARSE);
 	virtual int get_matrix_size() const;
 
+	/// Keeps the graph (sparsity structure) of the matrix when the matrix is freed and
+	/// preallocated again for the same number of unknowns, e.g., when a new FeProblem is
+	/// created in every time step. The structure is then not rebuilt, only the values are
+	/// zeroed. The caller is responsible for the sparsity pattern to be the same. Turn the
+	/// mode off before calling free() to really release the matrix.
+	void set_static_graph(bool keep) { static_graph = keep; }
+
+	/// Returns a number that changes whenever the underlying Epetra matrix is (re)allocated,
+	/// i.e., whenever objects built on top of the previous one (preconditioners) are stale.
+	unsigned get_structure_seq() const { return structure_seq; }
+
 protected:
 #ifdef HAVE_EPETRA
 	Epetra_BlockMap *std_map;
@@ -62,7 +74,16 @@ protected:
 	Epetra_CrsMatrix *mat_im;		// imaginary part of the matrix, mat holds the real part
 #endif
 	bool owner;
+
+	std::vector<int> row_idx;		// scratch buffers for block insertion
+	std::vector<int> row_pos;
+	std::vector<double> row_vals;
+
+	void destroy();
 #endif
+	bool static_graph;
+	bool reuse_graph;				// true if the graph from the previous prealloc() is being reused
+	unsigned structure_seq;			// see get_structure_seq()
 
 	friend class AmesosSolver;
 	friend class AztecOOSolver;
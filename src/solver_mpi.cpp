@@ -0,0 +1,109 @@
+// This file is part of Hermes2D
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "common.h"
+#include "solver_mpi.h"
+#ifdef WITH_MPI
+#include <mpi.h>
+#endif
+
+#define MPI_NOT_COMPILED "hermes2d was not built with MPI support."
+
+MpiCGSolver::MpiCGSolver(double tol, int maxiter)
+{
+	this->tol = tol;
+	this->maxiter = maxiter;
+	this->num_iters = 0;
+	this->residual = 0.0;
+}
+
+int MpiCGSolver::get_rank()
+{
+	int rank = 0;
+#ifdef WITH_MPI
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+	return rank;
+}
+
+int MpiCGSolver::get_size()
+{
+	int size = 1;
+#ifdef WITH_MPI
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+#endif
+	return size;
+}
+
+bool MpiCGSolver::_solve(Matrix *mat, double *x)
+{
+#ifdef WITH_MPI
+	int n = mat->get_size();
+	std::vector<double> b(n), r(n), z(n), p(n), q(n), dinv(n);
+
+	// sum the rank-local right-hand sides and diagonals
+	MPI_Allreduce(x, &b[0], n, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+	for (int i = 0; i < n; i++) q[i] = mat->get(i, i);
+	MPI_Allreduce(&q[0], &dinv[0], n, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+	for (int i = 0; i < n; i++)
+		dinv[i] = (dinv[i] != 0.0) ? 1.0 / dinv[i] : 1.0;
+
+	// all vectors are replicated, so the dot products need no communication
+	for (int i = 0; i < n; i++)
+	{
+		x[i] = 0.0;
+		r[i] = b[i];
+		p[i] = z[i] = dinv[i] * r[i];
+	}
+	double rz = vec_dot(&r[0], &z[0], n);
+	residual = sqrt(vec_dot(&r[0], &r[0], n));
+
+	num_iters = 0;
+	while (residual >= tol && num_iters < maxiter)
+	{
+		// q = A p, summed over all ranks (the full vector is reduced, see solver_mpi.h)
+		mat_dot(mat, &p[0], &z[0], n);
+		MPI_Allreduce(&z[0], &q[0], n, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+		double alpha = rz / vec_dot(&p[0], &q[0], n);
+		for (int i = 0; i < n; i++)
+		{
+			x[i] += alpha * p[i];
+			r[i] -= alpha * q[i];
+		}
+		num_iters++;
+		residual = sqrt(vec_dot(&r[0], &r[0], n));
+		if (residual < tol) break;
+
+		for (int i = 0; i < n; i++) z[i] = dinv[i] * r[i];
+		double rz_new = vec_dot(&r[0], &z[0], n);
+		double beta = rz_new / rz;
+		rz = rz_new;
+		for (int i = 0; i < n; i++) p[i] = z[i] + beta * p[i];
+	}
+
+	verbose("MpiCGSolver: %d iterations, residual %g", num_iters, residual);
+	return residual < tol;
+#else
+	error(MPI_NOT_COMPILED);
+	return false;
+#endif
+}
+
+bool MpiCGSolver::_solve(Matrix *mat, cplx *res)
+{
+	error("MpiCGSolver: complex systems are not supported.");
+	return false;
+}
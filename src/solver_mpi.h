@@ -0,0 +1,69 @@
+// This file is part of Hermes2D
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef __H2D_SOLVER_MPI_H_
+#define __H2D_SOLVER_MPI_H_
+
+#include "config.h"
+#include "matrix.h"
+#include "solvers.h"
+
+/// Conjugate gradient method for systems assembled by parts on several MPI ranks.
+///
+/// NOTE: this is a replicated-data prototype, not a distributed solver. Every rank holds
+/// the whole mesh and Space, the matrix and the right-hand side assembled over its own base
+/// elements only (LinSystem::set_partition()), but with the global size: the global system
+/// is the sum of the rank-local ones. Only the assembly work is split among the ranks. The
+/// matrix-vector product is the sum of the local products over all ranks, i.e., an
+/// MPI_Allreduce of a full-length vector in every iteration, and all vectors (including the
+/// solution, returned on all ranks) are replicated. Memory per rank and the communication
+/// volume therefore do not decrease with the number of ranks. A scalable version would need
+/// a rank-local DOF range with a ghost exchange. The iteration is preconditioned by the
+/// (summed) diagonal.
+///
+/// Typical use, run by "mpirun -np N":
+///   partition_base_elements(&mesh, size, part, &space);
+///   MpiCGSolver solver;
+///   LinSystem ls(&wf, &solver, &space);
+///   ls.set_partition(part, rank);
+///   ls.assemble();
+///   ls.solve(&sln);
+///
+class H2D_API MpiCGSolver : public CommonSolver
+{
+public:
+	/// @param[in] tol - tolerance for the norm of the residual
+	/// @param[in] maxiter - maximum number of iterations
+	MpiCGSolver(double tol = 1e-10, int maxiter = 10000);
+
+	virtual bool _solve(Matrix *mat, double *res);
+	virtual bool _solve(Matrix *mat, cplx *res);
+
+	int get_num_iters() const { return num_iters; }
+	double get_residual() const { return residual; }
+
+	/// Rank of this process and number of processes in MPI_COMM_WORLD
+	static int get_rank();
+	static int get_size();
+
+protected:
+	double tol;
+	int maxiter;
+	int num_iters;
+	double residual;
+};
+
+#endif
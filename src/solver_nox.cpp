@@ -68,6 +68,7 @@ public:
 
 	void prealloc_jacobian();
 
+	Teuchos::ParameterList *ls_pars;	// linear solver parameters of the running solve (for iteration counts)
 };
 
 
@@ -80,6 +81,7 @@ NoxProblemInterface::NoxProblemInterface(FeProblem &problem) :
 	if (!fep.is_matrix_free()) prealloc_jacobian();
 
 	precond = NULL;
+	ls_pars = NULL;
 }
 
 NoxProblemInterface::~NoxProblemInterface()
@@ -146,6 +148,12 @@ bool NoxProblemInterface::computePreconditioner(const Epetra_Vector &x, Epetra_O
 	fep.assemble(&xx, NULL, &jacobian);
 	jacobian.finish();
 
+	// iterations of the last linear solve drive the reuse of the preconditioner
+	if (ls_pars != NULL && ls_pars->isSublist("Output")) {
+		int iters = ls_pars->sublist("Output").get("Number of Linear Iterations", -1);
+		if (iters >= 0) precond->report_iters(iters);
+	}
+
 	precond->create(&jacobian);
 	precond->compute();
 	m = *precond->get_obj();
@@ -170,6 +178,10 @@ NoxSolver::NoxSolver(FeProblem *problem)
 	ls_sizeof_krylov_subspace = 50;
   precond_yes = false;
   precond_type = "None";
+  prec_reuse_set = false;
+  prec_reuse = PC_REUSE_NONE;
+  prec_growth = 2.0;
+  prec_max_age = 5;
 	// convergence test
 	conv.max_iters = 10;
 	conv.abs_resid = 1.0e-8;
@@ -218,6 +230,43 @@ void NoxSolver::set_precond(const char *pc)
 #endif
 }
 
+void NoxSolver::set_precond_reuse(EPrecondReuse policy, double growth, int max_age)
+{
+#ifdef HAVE_NOX
+  prec_reuse_set = true;
+  prec_reuse = policy;
+  prec_growth = growth;
+  prec_max_age = max_age;
+#endif
+}
+
+int NoxSolver::get_num_prec_builds()
+{
+#ifdef HAVE_NOX
+  Precond *precond = interface->get_precond();
+  if (precond != NULL) return precond->get_num_builds();
+#endif
+  return 0;
+}
+
+int NoxSolver::get_num_prec_refreshes()
+{
+#ifdef HAVE_NOX
+  Precond *precond = interface->get_precond();
+  if (precond != NULL) return precond->get_num_refreshes();
+#endif
+  return 0;
+}
+
+int NoxSolver::get_num_prec_skips()
+{
+#ifdef HAVE_NOX
+  Precond *precond = interface->get_precond();
+  if (precond != NULL) return precond->get_num_skips();
+#endif
+  return 0;
+}
+
 bool NoxSolver::set_init_sln(double *ic)
 {
 #ifdef HAVE_NOX
@@ -302,6 +351,20 @@ bool NoxSolver::solve()
       }
     }
 	ls_pars.set("Max Age Of Prec", 5);
+	if (prec_reuse_set) {
+		if (precond != NULL) {
+			// our preconditioner decides itself, NOX asks for it every time
+			precond->set_reuse_policy(prec_reuse, prec_growth, prec_max_age);
+			ls_pars.set("Preconditioner Reuse Policy", "Rebuild");
+		}
+		else {
+			if (prec_reuse == PC_REUSE_NONE) ls_pars.set("Preconditioner Reuse Policy", "Rebuild");
+			else if (prec_reuse == PC_REUSE_STRUCTURE) ls_pars.set("Preconditioner Reuse Policy", "Recompute");
+			else ls_pars.set("Preconditioner Reuse Policy", "Reuse");
+			ls_pars.set("Max Age Of Prec", prec_max_age);
+		}
+	}
+	interface->ls_pars = &ls_pars;
 
 	Teuchos::RCP<NOX::Epetra::Interface::Required> i_req = interface;
 	Teuchos::RCP<NOX::Epetra::Interface::Jacobian> i_jac;
@@ -372,6 +435,7 @@ bool NoxSolver::solve()
 	// Create the method
 	Teuchos::RCP<NOX::Solver::Generic> solver = NOX::Solver::buildSolver(grp, cmb, final_pars);
 	NOX::StatusTest::StatusType status = solver->solve();
+	interface->ls_pars = NULL;
 
 	if (!interface->fep.is_matrix_free())
 		jac_mat.release();	// release the ownership (we take care of jac_mat by ourselves)
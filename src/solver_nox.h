@@ -74,6 +74,18 @@ public:
 	void set_precond(Precond *pc);
   void set_precond(const char *pc);
 
+	/// Set the reuse policy of the preconditioner over the Newton iterations (see EPrecondReuse).
+	/// For a preconditioner set by set_precond(Precond *), the policy is applied by the
+	/// preconditioner itself, which is told the linear iteration counts. For the ML and Ifpack
+	/// preconditioners built by NOX, the policy maps to the NOX "Preconditioner Reuse Policy"
+	/// (Rebuild / Recompute / Reuse), where 'max_age' limits the reuse and 'growth' is ignored.
+	void set_precond_reuse(EPrecondReuse policy, double growth = 2.0, int max_age = 5);
+
+	/// Statistics of the preconditioner set by set_precond(Precond *) (see Precond)
+	int get_num_prec_builds();
+	int get_num_prec_refreshes();
+	int get_num_prec_skips();
+
 protected:
 #ifdef HAVE_NOX
 	Teuchos::RCP<NoxProblemInterface> interface;
@@ -92,6 +104,10 @@ protected:
 	int ls_sizeof_krylov_subspace;
   bool precond_yes;
   const char* precond_type;
+  bool prec_reuse_set;
+  EPrecondReuse prec_reuse;
+  double prec_growth;
+  int prec_max_age;
 	// convergence params
 	struct conv_t {
 		int max_iters;
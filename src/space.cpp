@@ -31,8 +31,14 @@ Space::Space(Mesh* mesh, Shapeset* shapeset, BCType (*bc_type_callback)(int),
   this->ndata_allocated = 0;
   this->mesh_seq = -1;
   this->seq = 0;
+  this->bc_seq = 0;
   this->was_assigned = false;
   this->ndof = 0;
+  this->al_start = this->al_cnt = NULL;
+  this->al_size = 0;
+  this->al_seq = -1;
+  this->al_valid = false;
+  this->al_enabled = true;
 
   this->set_bc_types_init(bc_type_callback);
   this->set_essential_bc_values(bc_value_callback_by_coord);
@@ -49,6 +55,8 @@ void Space::free()
   free_extra_data();
   if (nsize) { ::free(ndata); nsize = 0; }
   if (esize) { ::free(edata); esize = 0; }
+  if (al_size) { ::free(al_start); ::free(al_cnt); al_start = al_cnt = NULL; al_size = 0; }
+  al_valid = false;
 }
 
 
@@ -143,7 +151,7 @@ void Space::set_uniform_order_internal(int order, int marker)
   int quad_order = H2D_MAKE_QUAD_ORDER(order, order);
 
   Element* e;
-  for_all_active_elements(e, mesh)
+  for_all_active_elements_fast(e, mesh)
   {
     if (marker == H2D_ANY || e->marker == marker)
     {
@@ -181,7 +189,7 @@ void Space::copy_orders(Space* space, int inc)
 {
   Element* e;
   resize_tables();
-  for_all_active_elements(e, space->get_mesh())
+  for_all_active_elements_fast(e, space->get_mesh())
   {
     int oo = space->get_element_order(e->id);
     if (oo < 0) error("Source space has an uninitialized order (element id = %d)", e->id);
@@ -270,14 +278,14 @@ void Space::distribute_orders(Mesh* mesh, int* parents)
   int num = mesh->get_max_element_id();
   AUTOLA_OR(int, orders, num+1);
   Element* e;
-  for_all_active_elements(e, mesh)
+  for_all_active_elements_fast(e, mesh)
   {
     int p = get_element_order(parents[e->id]);
     if (e->is_triangle() && (H2D_GET_V_ORDER(p) != 0))
       p = std::max(H2D_GET_H_ORDER(p), H2D_GET_V_ORDER(p));
     orders[e->id] = p;
   }
-  for_all_active_elements(e, mesh)
+  for_all_active_elements_fast(e, mesh)
     set_element_order_internal(e->id, orders[e->id]);
 
 }
@@ -303,7 +311,7 @@ int Space::assign_dofs(int first_dof, int stride)
   //    propagate_zero_orders(e);
 
   //check validity of orders
-  for_all_active_elements(e, mesh) {
+  for_all_active_elements_fast(e, mesh) {
     if (e->id >= esize || edata[e->id].order < 0) {
       printf("e->id = %d\n", e->id);
       printf("esize = %d\n", esize);
@@ -321,13 +329,15 @@ int Space::assign_dofs(int first_dof, int stride)
   assign_bubble_dofs();
 
   free_extra_data();
-  update_essential_bc_values();
+  update_bc_projections();
   update_constraints();
   post_assign();
 
   mesh_seq = mesh->get_seq();
   was_assigned = true;
   this->ndof = (next_dof - first_dof) / stride;
+
+  build_assembly_list_cache();
   return this->ndof;
 }
 
@@ -345,7 +355,7 @@ void Space::reset_dof_assignment() {
   // next go through all boundary edge nodes constituting an essential BC and mark their
   // neighboring vertex nodes also as essential
   Element* e;
-  for_all_active_elements(e, mesh)
+  for_all_active_elements_fast(e, mesh)
   {
     for (unsigned int i = 0; i < e->nvert; i++)
     {
@@ -361,8 +371,37 @@ void Space::reset_dof_assignment() {
 
 //// assembly lists ///////////////////////////////////////////////////////////////////////////////
 
+void AsmList::set_view(int cnt, int* idx, int* dof, scalar* coef)
+{
+  if (!borrowed)
+  {
+    own_idx = this->idx; own_dof = this->dof; own_coef = this->coef;
+    own_cap = cap;
+    borrowed = true;
+  }
+  this->idx = idx; this->dof = dof; this->coef = coef;
+  this->cnt = cap = cnt; // adding a triplet makes a private copy first
+}
+
+
+void AsmList::release()
+{
+  int* ext_idx = idx; int* ext_dof = dof; scalar* ext_coef = coef;
+  idx = own_idx; dof = own_dof; coef = own_coef;
+  cap = own_cap;
+  borrowed = false;
+
+  // keep the current contents, as somebody may be appending to them
+  while (cap < cnt) enlarge();
+  memcpy(idx, ext_idx, sizeof(int) * cnt);
+  memcpy(dof, ext_dof, sizeof(int) * cnt);
+  memcpy(coef, ext_coef, sizeof(scalar) * cnt);
+}
+
+
 void AsmList::enlarge()
 {
+  if (borrowed) { release(); if (cnt < cap) return; }
   cap = !cap ? 256 : cap * 2;
   idx = (int*) realloc(idx, sizeof(int) * cap);
   dof = (int*) realloc(dof, sizeof(int) * cap);
@@ -370,6 +409,56 @@ void AsmList::enlarge()
 }
 
 
+void Space::set_assembly_list_cache(bool enable)
+{
+  al_enabled = enable;
+  if (!enable) al_valid = false;
+  else if (is_up_to_date()) build_assembly_list_cache();
+}
+
+
+void Space::build_assembly_list_cache()
+{
+  al_valid = false; // get_element_assembly_list() has to compute the lists now
+  if (!al_enabled) return;
+
+  if (al_size < mesh->get_max_element_id())
+  {
+    al_size = mesh->get_max_element_id();
+    al_start = (int*) realloc(al_start, sizeof(int) * al_size);
+    al_cnt = (int*) realloc(al_cnt, sizeof(int) * al_size);
+  }
+  for (int i = 0; i < al_size; i++)
+    al_cnt[i] = -1;
+
+  AsmList al;
+  Element* e;
+  al_cache.clear();
+  for_all_active_elements_fast(e, mesh)
+  {
+    get_element_assembly_list(e, &al);
+    al_start[e->id] = al_cache.cnt;
+    al_cnt[e->id] = al.cnt;
+    for (int i = 0; i < al.cnt; i++)
+      al_cache.add_triplet(al.idx[i], al.dof[i], al.coef[i]);
+  }
+
+  al_seq = seq;
+  al_valid = true;
+}
+
+
+bool Space::get_cached_assembly_list(Element* e, AsmList* al)
+{
+  if (!al_valid || al_seq != seq || e->id >= al_size || al_cnt[e->id] < 0)
+    return false;
+
+  int first = al_start[e->id];
+  al->set_view(al_cnt[e->id], al_cache.idx + first, al_cache.dof + first, al_cache.coef + first);
+  return true;
+}
+
+
 void Space::get_element_assembly_list(Element* e, AsmList* al)
 {
   // some checks
@@ -379,9 +468,11 @@ void Space::get_element_assembly_list(Element* e, AsmList* al)
     error("The space is out of date. You need to update it with assign_dofs()"
           " any time the mesh changes.");
 
+  shapeset->set_mode(e->get_mode());
+  if (get_cached_assembly_list(e, al)) return;
+
   // add vertex, edge and bubble functions to the assembly list
   al->clear();
-  shapeset->set_mode(e->get_mode());
   for (unsigned int i = 0; i < e->nvert; i++)
     get_vertex_assembly_list(e, i, al);
   for (unsigned int i = 0; i < e->nvert; i++)
@@ -474,7 +565,7 @@ void Space::copy_callbacks(const Space* space)
 }
 
 
-void Space::precalculate_projection_matrix(int nv, double**& mat, double*& p)
+void Space::precalculate_projection_matrix(int nv, double**& mat, double*& p, double**& fn)
 {
   int n = shapeset->get_max_order() + 1 - nv;
   mat = new_matrix<double>(n, n);
@@ -503,6 +594,17 @@ void Space::precalculate_projection_matrix(int nv, double**& mat, double*& p)
 
   p = new double[n];
   choldc(mat, n, p);
+
+  // the right-hand sides of the projections are always integrated with the highest order
+  int mo = quad1d.get_max_order(), np = quad1d.get_num_points(mo);
+  double2* pt = quad1d.get_points(mo);
+  fn = new_matrix<double>(n, np);
+  for (int i = 0; i < n; i++)
+  {
+    int ii = shapeset->get_edge_index(0, 0, i + nv);
+    for (int k = 0; k < np; k++)
+      fn[i][k] = pt[k][1] * shapeset->get_fn_value(ii, pt[k][0], -1.0, component);
+  }
 }
 
 
@@ -543,7 +645,7 @@ void Space::update_edge_bc(Element* e, EdgePos* ep)
 }
 
 
-void Space::update_essential_bc_values()
+void Space::update_bc_projections()
 {
   Element* e;
   for_all_base_elements(e, mesh)
@@ -558,6 +660,21 @@ void Space::update_essential_bc_values()
       }
     }
   }
+  bc_seq++;
+}
+
+
+void Space::update_essential_bc_values()
+{
+  // the projections are referenced from the node data and from the baselists
+  // of constrained vertices, all of which are rebuilt here; DOFs stay untouched
+  free_extra_data();
+  update_bc_projections();
+  update_constraints();
+  post_assign();
+
+  // the cached lists contain the old BC projections
+  build_assembly_list_cache();
 }
 
 
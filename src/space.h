@@ -184,8 +184,16 @@ public:
   /// Obtains an edge assembly list (contains shape functions that are nonzero on the specified edge).
   void get_edge_assembly_list(Element* e, int edge, AsmList* al);
 
+  /// Enables or disables the cache of element assembly lists (enabled by default).
+  /// The lists of all active elements are built in assign_dofs() and stored in one
+  /// contiguous table; get_element_assembly_list() then only points the AsmList into
+  /// the table. The cache is dropped whenever the orders, the mesh or the BCs change.
+  void set_assembly_list_cache(bool enable);
+
   /// Updates essential BC values. Typically used for time-dependent 
-  /// essnetial boundary conditions.
+  /// essnetial boundary conditions. The DOF assignment is kept, only the
+  /// projections of the boundary data (and the constraints referring to them)
+  /// are recalculated.
   void update_essential_bc_values();
 
 protected:
@@ -198,6 +206,7 @@ protected:
   int first_dof, next_dof;
   int stride;
   int seq, mesh_seq;
+  int bc_seq;
   bool was_assigned;
 
   struct BaseComponent
@@ -266,13 +275,25 @@ protected: //debugging support
   virtual void get_edge_assembly_list_internal(Element* e, int ie, AsmList* al) = 0;
   virtual void get_bubble_assembly_list(Element* e, AsmList* al);
 
+  AsmList al_cache;  ///< triplets of all cached element assembly lists
+  int* al_start;     ///< start of the list of each element in al_cache (indexed by element id)
+  int* al_cnt;       ///< length of the list of each element, -1 if not cached
+  int al_size;       ///< size of al_start and al_cnt
+  int al_seq;        ///< value of 'seq' when the cache was built
+  bool al_valid, al_enabled;
+
+  void build_assembly_list_cache();
+  bool get_cached_assembly_list(Element* e, AsmList* al);
+
   double** proj_mat;
   double*  chol_p;
+  double** proj_fn; ///< weighted values of edge functions at the 1D integration points
 
   void copy_callbacks(const Space* space);
-  void precalculate_projection_matrix(int nv, double**& mat, double*& p);
+  void precalculate_projection_matrix(int nv, double**& mat, double*& p, double**& fn);
   virtual scalar* get_bc_projection(EdgePos* ep, int order) = 0;
   void update_edge_bc(Element* e, EdgePos* ep);
+  void update_bc_projections();
 
   /// Called by Space to update constraining relationships between shape functions due
   /// to hanging nodes in the mesh. As this is space-specific, this function is reimplemented
@@ -297,7 +318,13 @@ public:
 
   /// Internal. Used by LinSystem to detect changes in the space.
   int get_seq() const { return seq; }
-  int set_seq(int seq_) { seq = seq_; }
+  void set_seq(int seq_)
+  {
+    if (al_valid && al_seq == seq) al_seq = seq_; // relabeling keeps the cache valid
+    seq = seq_;
+  }
+  /// Internal. Used by LinSystem to detect changes of the essential BC values.
+  int get_bc_seq() const { return bc_seq; }
 
   /// Internal. Return type of this space (H1 = 0, Hcurl = 1, Hdiv = 2, L2 = 3)
   virtual int get_type() const = 0;
@@ -21,6 +21,7 @@
 
 double** H1Space::h1_proj_mat = NULL;
 double*  H1Space::h1_chol_p   = NULL;
+double** H1Space::h1_proj_fn  = NULL;
 int      H1Space::h1_proj_ref = 0;
 
 H1Space::H1Space(Mesh* mesh, BCType (*bc_type_callback)(int), 
@@ -33,10 +34,11 @@ H1Space::H1Space(Mesh* mesh, BCType (*bc_type_callback)(int),
   if (!h1_proj_ref++)
   {
     // FIXME: separate projection matrices for different shapesets
-    precalculate_projection_matrix(2, h1_proj_mat, h1_chol_p);
+    precalculate_projection_matrix(2, h1_proj_mat, h1_chol_p, h1_proj_fn);
   }
   proj_mat = h1_proj_mat;
   chol_p   = h1_chol_p;
+  proj_fn  = h1_proj_fn;
 
   // set uniform poly order in elements
   if (p_init < 1) error("P_INIT must be >=  1 in an H1 space.");
@@ -53,6 +55,7 @@ H1Space::~H1Space()
   {
     delete [] h1_proj_mat;
     delete [] h1_chol_p;
+    delete [] h1_proj_fn;
   }
 }
 
@@ -78,7 +81,7 @@ void H1Space::assign_vertex_dofs()
 
   // loop through all elements and assign vertex, edge and bubble dofs
   Element* e;
-  for_all_active_elements(e, mesh)
+  for_all_active_elements_fast(e, mesh)
   {
     int order = get_element_order(e->id);
     if (order > 0)
@@ -229,22 +232,24 @@ scalar* H1Space::get_bc_projection(EdgePos* ep, int order)
   {
     Quad1DStd quad1d;
     scalar* rhs = proj + 2;
-    int mo = quad1d.get_max_order();
+    int mo = quad1d.get_max_order(), np = quad1d.get_num_points(mo);
     double2* pt = quad1d.get_points(mo);
 
-    // get boundary values at integration points, construct rhs
+    // get boundary values minus the linear part at integration points, each point only once
+    AUTOLA_OR(scalar, val, np);
+    for (int j = 0; j < np; j++)
+    {
+      double t = (pt[j][0] + 1) * 0.5, s = 1.0 - t;
+      ep->t = ep->lo * s + ep->hi * t;
+      val[j] = bc_value_callback_by_edge(ep) - (proj[0] * s + proj[1] * t);
+    }
+
+    // construct rhs using the precalculated weighted values of edge functions
     for (int i = 0; i < order; i++)
     {
       rhs[i] = 0.0;
-      int ii = shapeset->get_edge_index(0, 0, i+2);
-      for (int j = 0; j < quad1d.get_num_points(mo); j++)
-      {
-        double t = (pt[j][0] + 1) * 0.5, s = 1.0 - t;
-        scalar l = proj[0] * s + proj[1] * t;
-        ep->t = ep->lo * s + ep->hi * t;
-        rhs[i] += pt[j][1] * shapeset->get_fn_value(ii, pt[j][0], -1.0, 0)
-                           * (bc_value_callback_by_edge(ep) - l);
-      }
+      for (int j = 0; j < np; j++)
+        rhs[i] += proj_fn[i][j] * val[j];
     }
 
     // solve the system using a precalculated Cholesky decomposed projection matrix
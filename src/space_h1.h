@@ -55,6 +55,7 @@ protected:
 
   static double** h1_proj_mat;
   static double*  h1_chol_p;
+  static double** h1_proj_fn;
   static int      h1_proj_ref;
 
   virtual scalar* get_bc_projection(EdgePos* ep, int order);
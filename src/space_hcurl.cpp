@@ -22,6 +22,7 @@
 
 double** HcurlSpace::hcurl_proj_mat = NULL;
 double*  HcurlSpace::hcurl_chol_p   = NULL;
+double** HcurlSpace::hcurl_proj_fn  = NULL;
 int      HcurlSpace::hcurl_proj_ref = 0;
 
 HcurlSpace::HcurlSpace(Mesh* mesh, BCType (*bc_type_callback)(int), 
@@ -34,11 +35,12 @@ HcurlSpace::HcurlSpace(Mesh* mesh, BCType (*bc_type_callback)(int),
 
   if (!hcurl_proj_ref++)
   {
-    precalculate_projection_matrix(0, hcurl_proj_mat, hcurl_chol_p);
+    precalculate_projection_matrix(0, hcurl_proj_mat, hcurl_chol_p, hcurl_proj_fn);
   }
 
   proj_mat = hcurl_proj_mat;
   chol_p   = hcurl_chol_p;
+  proj_fn  = hcurl_proj_fn;
 
   // set uniform poly order in elements
   if (p_init < 0) error("P_INIT must be >= 0 in an Hcurl space.");
@@ -55,6 +57,7 @@ HcurlSpace::~HcurlSpace()
   {
     delete [] hcurl_proj_mat;
     delete [] hcurl_chol_p;
+    delete [] hcurl_proj_fn;
   }
 }
 
@@ -122,7 +125,7 @@ void HcurlSpace::assign_edge_dofs()
 void HcurlSpace::assign_bubble_dofs()
 {
   Element* e;
-  for_all_active_elements(e, mesh)
+  for_all_active_elements_fast(e, mesh)
   {
     shapeset->set_mode(e->get_mode());
     ElementData* ed = &edata[e->id];
@@ -174,7 +177,7 @@ scalar* HcurlSpace::get_bc_projection(EdgePos* ep, int order)
 
   Quad1DStd quad1d;
   scalar* rhs = proj;
-  int mo = quad1d.get_max_order();
+  int mo = quad1d.get_max_order(), np = quad1d.get_num_points(mo);
   double2* pt = quad1d.get_points(mo);
 
   Node* vn1 = mesh->get_node(ep->v1);
@@ -182,18 +185,21 @@ scalar* HcurlSpace::get_bc_projection(EdgePos* ep, int order)
   double el = sqrt(sqr(vn1->x - vn2->x) + sqr(vn1->y - vn2->y));
   el *= 0.5 * (ep->hi - ep->lo);
 
-  // get boundary values at integration points, construct rhs
+  // get boundary values at integration points, each point only once
+  AUTOLA_OR(scalar, val, np);
+  for (int j = 0; j < np; j++)
+  {
+    double t = (pt[j][0] + 1) * 0.5, s = 1.0 - t;
+    ep->t = ep->lo * s + ep->hi * t;
+    val[j] = bc_value_callback_by_edge(ep) * el;
+  }
+
+  // construct rhs using the precalculated weighted values of edge functions
   for (int i = 0; i <= order; i++)
   {
     rhs[i] = 0.0;
-    int ii = shapeset->get_edge_index(0, 0, i);
-    for (int j = 0; j < quad1d.get_num_points(mo); j++)
-    {
-      double t = (pt[j][0] + 1) * 0.5, s = 1.0 - t;
-      ep->t = ep->lo * s + ep->hi * t;
-      rhs[i] += pt[j][1] * shapeset->get_fn_value(ii, pt[j][0], -1.0, 0)
-                         * (bc_value_callback_by_edge(ep)) * el;
-    }
+    for (int j = 0; j < np; j++)
+      rhs[i] += proj_fn[i][j] * val[j];
   }
 
   // solve the system using a precalculated Cholesky decomposed projection matrix
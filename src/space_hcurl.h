@@ -55,6 +55,7 @@ protected:
 
   static double** hcurl_proj_mat;
   static double*  hcurl_chol_p;
+  static double** hcurl_proj_fn;
   static int      hcurl_proj_ref;
 
   virtual scalar* get_bc_projection(EdgePos* ep, int order);
@@ -49,6 +49,7 @@ protected:
 
   static double** hdiv_proj_mat;
   static double*  hdiv_chol_p;
+  static double** hdiv_proj_fn;
   static int      hdiv_proj_ref;
 
   virtual scalar* get_bc_projection(EdgePos* ep, int order);
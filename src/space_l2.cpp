@@ -66,7 +66,7 @@ void L2Space::resize_tables()
 void L2Space::assign_bubble_dofs()
 {
   Element* e;
-  for_all_active_elements(e, mesh)
+  for_all_active_elements_fast(e, mesh)
   {
     shapeset->set_mode(e->get_mode());
     ElementData* ed = &edata[e->id];
@@ -90,9 +90,11 @@ void L2Space::get_element_assembly_list(Element* e, AsmList* al)
     error("The space is out of date. You need to update it with assign_dofs()"
           " any time the mesh changes.");
 
+  shapeset->set_mode(e->get_mode());
+  if (get_cached_assembly_list(e, al)) return;
+
   // add vertex, edge and bubble functions to the assembly list
   al->clear();
-  shapeset->set_mode(e->get_mode());
   /*
   for (i = 0; i < e->nvert; i++)
     get_vertex_assembly_list(e, i, al);
@@ -58,7 +58,7 @@ void MeshView::show(Mesh* mesh)
   int active_element_cnt = 0;
   float min_error = -1, max_error = -1;
   Element* e;
-  for_all_active_elements(e, mesh)
+  for_all_active_elements_fast(e, mesh)
   {
     ObjInfo* oi = elems + e->id;
     oi->id = e->id;
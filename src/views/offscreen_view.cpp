@@ -0,0 +1,920 @@
+// This file is part of Hermes2D.
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef WIN32
+# include <unistd.h>
+#endif
+
+#include "../common.h"
+#include "../solution.h"
+#include "../space.h"
+#include "offscreen_view.h"
+
+#include "view_data.cpp"
+
+///////////////// private constants /////////////////
+#define H2DV_TILE_SIZE 64 ///< Size of a tile in pixels.
+#define H2DV_MAX_ORDER 10 ///< Orders above this value are drawn with the color of the maximum order.
+
+/// Colors of orders, the same as in OrderView.
+static int offscreen_order_palette[H2DV_MAX_ORDER + 1] =
+{
+  0x7f7f7f, 0x7f2aff, 0x2a2aff, 0x2a7fff, 0x00d4aa, 0x00aa44,
+  0xabc837, 0xffd42a, 0xc87137, 0xc83737, 0xff0000
+};
+
+static int pack_color(float r, float g, float b)
+{
+  int ir = (int) (r * 255.0f + 0.5f), ig = (int) (g * 255.0f + 0.5f), ib = (int) (b * 255.0f + 0.5f);
+  ir = std::max(0, std::min(255, ir));
+  ig = std::max(0, std::min(255, ig));
+  ib = std::max(0, std::min(255, ib));
+  return (ir << 16) | (ig << 8) | ib;
+}
+
+static inline void put_pixel(unsigned char* px, int color)
+{
+  px[0] = (unsigned char) (color >> 16);
+  px[1] = (unsigned char) ((color >> 8) & 0xff);
+  px[2] = (unsigned char) (color & 0xff);
+}
+
+static double my_ceil(double x)
+{
+  double y = ceil(x);
+  if (y > x) return y;
+  return y + 1.0;
+}
+
+
+///////////////// setup /////////////////
+
+OffscreenView::OffscreenView(int width, int height, int num_threads)
+  : width(width), height(height), num_threads(num_threads)
+{
+  if (width <= 0 || height <= 0)
+    error("Invalid size of the framebuffer (%d x %d).", width, height);
+
+  if (this->num_threads <= 0)
+  {
+#ifndef WIN32
+    this->num_threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (this->num_threads <= 0) this->num_threads = 1;
+  }
+
+  pixels = (unsigned char*) malloc(3 * width * height);
+  if (pixels == NULL)
+    error("Could not allocate memory for pixel data.");
+
+  pal_type = H2DV_PT_DEFAULT;
+  pal_steps = 50;
+  range_auto = true;
+  range_min = 0.0; range_max = 1.0;
+  contours = false;
+  edges = true;
+  cont_orig = 0.0; cont_step = 0.2;
+  arrow_spacing = 20.0; arrow_length = 1.0;
+  back_color = 0xffffff;
+  edges_color = pack_color(0.5f, 0.4f, 0.4f);
+  cont_color = pack_color(0.0f, 0.0f, 0.0f);
+  box_fixed = false;
+  scale = 1.0; trans_x = trans_y = 0.0;
+
+  tiles_x = (width + H2DV_TILE_SIZE - 1) / H2DV_TILE_SIZE;
+  tiles_y = (height + H2DV_TILE_SIZE - 1) / H2DV_TILE_SIZE;
+  tile_tris.resize(tiles_x * tiles_y);
+  tile_lines.resize(tiles_x * tiles_y);
+  pthread_mutex_init(&tile_mutex, NULL);
+
+  writes_pending = 0;
+  writer_started = writer_quit = false;
+  pthread_mutex_init(&write_mutex, NULL);
+  pthread_cond_init(&write_cond, NULL);
+  pthread_cond_init(&write_done, NULL);
+
+  for (int i = 0; i < width * height; i++)
+    put_pixel(pixels + 3*i, back_color);
+}
+
+
+OffscreenView::~OffscreenView()
+{
+  if (writer_started)
+  {
+    pthread_mutex_lock(&write_mutex);
+    writer_quit = true;
+    pthread_cond_signal(&write_cond);
+    pthread_mutex_unlock(&write_mutex);
+    pthread_join(writer, NULL);
+  }
+  pthread_cond_destroy(&write_done);
+  pthread_cond_destroy(&write_cond);
+  pthread_mutex_destroy(&write_mutex);
+  pthread_mutex_destroy(&tile_mutex);
+  ::free(pixels);
+}
+
+
+void OffscreenView::set_num_palette_steps(int num)
+{
+  if (num < 2) num = 2;
+  if (num > 256) num = 256;
+  pal_steps = num;
+}
+
+
+void OffscreenView::set_min_max_range(double min, double max)
+{
+  if (max < min) {
+    std::swap(min, max);
+    warn("Upper bound set below the lower bound: reversing to (%f,%f).", min, max);
+  }
+  range_auto = false;
+  range_min = min;
+  range_max = max;
+}
+
+
+void OffscreenView::show_contours(double step, double orig)
+{
+  if (step <= 0.0) error("Invalid contour step.");
+  contours = true;
+  cont_orig = orig;
+  cont_step = step;
+}
+
+
+void OffscreenView::set_arrow_spacing(double pixels, double length_coef)
+{
+  if (pixels < 2.0) error("Invalid arrow spacing.");
+  arrow_spacing = pixels;
+  arrow_length = length_coef;
+}
+
+
+void OffscreenView::set_background_color(float r, float g, float b) { back_color = pack_color(r, g, b); }
+void OffscreenView::set_edges_color(float r, float g, float b) { edges_color = pack_color(r, g, b); }
+void OffscreenView::set_contours_color(float r, float g, float b) { cont_color = pack_color(r, g, b); }
+
+
+void OffscreenView::set_bounding_box(double min_x, double max_x, double min_y, double max_y)
+{
+  if (max_x <= min_x || max_y <= min_y)
+    error("Invalid bounding box.");
+  box_fixed = true;
+  box_min_x = min_x; box_max_x = max_x;
+  box_min_y = min_y; box_max_y = max_y;
+}
+
+
+void OffscreenView::fit_view(double min_x, double max_x, double min_y, double max_y)
+{
+  if (box_fixed) {
+    min_x = box_min_x; max_x = box_max_x;
+    min_y = box_min_y; max_y = box_max_y;
+  }
+
+  // leave a margin of 5% on each side, keep the aspect ratio
+  double w = std::max(max_x - min_x, 1e-12), h = std::max(max_y - min_y, 1e-12);
+  scale = std::min(0.9 * width / w, 0.9 * height / h);
+  trans_x = 0.5 * width - scale * 0.5 * (min_x + max_x);
+  trans_y = 0.5 * height + scale * 0.5 * (min_y + max_y);
+}
+
+
+void OffscreenView::init_palette()
+{
+  // the same colors as the texture created by View::create_gl_palette()
+  for (int i = 0; i < pal_steps; i++)
+  {
+    double x = (double) i / pal_steps;
+    float c[3];
+    if (pal_type == H2DV_PT_HUESCALE || pal_type == H2DV_PT_DEFAULT) {
+      int n = (int) (x * num_pal_entries);
+      c[0] = palette_data[n][0]; c[1] = palette_data[n][1]; c[2] = palette_data[n][2];
+    }
+    else if (pal_type == H2DV_PT_GRAYSCALE)
+      c[0] = c[1] = c[2] = (float) x;
+    else if (pal_type == H2DV_PT_INVGRAYSCALE)
+      c[0] = c[1] = c[2] = (float) (1.0 - x);
+    else
+      c[0] = c[1] = c[2] = 1.0f;
+
+    palette[i][0] = (unsigned char) (c[0] * 255);
+    palette[i][1] = (unsigned char) (c[1] * 255);
+    palette[i][2] = (unsigned char) (c[2] * 255);
+  }
+}
+
+
+///////////////// geometry /////////////////
+
+void OffscreenView::add_triangle(const double* x, const double* y, const double* t, int color)
+{
+  double det = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+  if (fabs(det) < 1e-12) return; // covers no pixels
+
+  RasterTri rt;
+  for (int k = 0; k < 3; k++) { rt.x[k] = x[k]; rt.y[k] = y[k]; }
+  rt.color = color;
+  if (color < 0)
+  {
+    rt.ta = ((t[1] - t[0]) * (y[2] - y[0]) - (t[2] - t[0]) * (y[1] - y[0])) / det;
+    rt.tb = ((x[1] - x[0]) * (t[2] - t[0]) - (x[2] - x[0]) * (t[1] - t[0])) / det;
+    rt.tc = t[0] - rt.ta * x[0] - rt.tb * y[0];
+  }
+  else
+    rt.ta = rt.tb = rt.tc = 0.0;
+  tris.push_back(rt);
+}
+
+
+void OffscreenView::add_line(double x0, double y0, double x1, double y1, int color)
+{
+  RasterLine rl = { x0, y0, x1, y1, color };
+  lines.push_back(rl);
+}
+
+
+void OffscreenView::add_contours(double3* vert, int3& tri)
+{
+  // follows ScalarView::draw_tri_contours()
+  int i, idx[3];
+  memcpy(idx, tri, sizeof(idx));
+  for (i = 0; i < 2; i++)
+  {
+    if (vert[idx[0]][2] > vert[idx[1]][2]) std::swap(idx[0], idx[1]);
+    if (vert[idx[1]][2] > vert[idx[2]][2]) std::swap(idx[1], idx[2]);
+  }
+  if (fabs(vert[idx[0]][2] - vert[idx[2]][2]) < 1e-3 * fabs(cont_step)) return;
+
+  double val = vert[idx[0]][2];
+  val = my_ceil((val - cont_orig) / cont_step) * cont_step + cont_orig;
+
+  int l1 = 0, l2 = 1;
+  int r1 = 0, r2 = 2;
+  while (val < vert[idx[r2]][2])
+  {
+    double ld = vert[idx[l2]][2] - vert[idx[l1]][2];
+    double rd = vert[idx[r2]][2] - vert[idx[r1]][2];
+
+    while (val < vert[idx[l2]][2])
+    {
+      double lt = (val - vert[idx[l1]][2]) / ld;
+      double rt = (val - vert[idx[r1]][2]) / rd;
+
+      double x1 = (1.0 - lt) * vert[idx[l1]][0] + lt * vert[idx[l2]][0];
+      double y1 = (1.0 - lt) * vert[idx[l1]][1] + lt * vert[idx[l2]][1];
+      double x2 = (1.0 - rt) * vert[idx[r1]][0] + rt * vert[idx[r2]][0];
+      double y2 = (1.0 - rt) * vert[idx[r1]][1] + rt * vert[idx[r2]][1];
+      add_line(screen_x(x1), screen_y(y1), screen_x(x2), screen_y(y2), cont_color);
+
+      val += cont_step;
+    }
+    l1 = 1;
+    l2 = 2;
+  }
+}
+
+
+void OffscreenView::add_edges(const double* vert, int stride, int3* edge, int ne, bool all)
+{
+  for (int i = 0; i < ne; i++)
+  {
+    if (!all && !edges && edge[i][2] == 0) continue; // marker zero: internal edge
+    const double* a = vert + stride * edge[i][0];
+    const double* b = vert + stride * edge[i][1];
+    add_line(screen_x(a[0]), screen_y(a[1]), screen_x(b[0]), screen_y(b[1]), edges_color);
+  }
+}
+
+
+void OffscreenView::add_arrows(double4* vert, int3& tri, double max)
+{
+  double x[3], y[3];
+  for (int k = 0; k < 3; k++) {
+    x[k] = screen_x(vert[tri[k]][0]);
+    y[k] = screen_y(vert[tri[k]][1]);
+  }
+  double det = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+  if (fabs(det) < 1e-12) return;
+
+  // linear interpolation of both components
+  double a[2], b[2], c[2];
+  for (int m = 0; m < 2; m++)
+  {
+    double t0 = vert[tri[0]][2+m], t1 = vert[tri[1]][2+m], t2 = vert[tri[2]][2+m];
+    a[m] = ((t1 - t0) * (y[2] - y[0]) - (t2 - t0) * (y[1] - y[0])) / det;
+    b[m] = ((x[1] - x[0]) * (t2 - t0) - (x[2] - x[0]) * (t1 - t0)) / det;
+    c[m] = t0 - a[m] * x[0] - b[m] * y[0];
+  }
+
+  // visit the arrow grid points inside the triangle; the same half-open rule as
+  // in rasterize_tile() guarantees that each point belongs to exactly one triangle
+  double gs = arrow_spacing;
+  double miny = std::min(y[0], std::min(y[1], y[2])), maxy = std::max(y[0], std::max(y[1], y[2]));
+  miny = std::max(miny, 0.0);
+  maxy = std::min(maxy, (double) height);
+  for (int j = (int) ceil(miny / gs - 0.5); (j + 0.5) * gs < maxy; j++)
+  {
+    double py = (j + 0.5) * gs;
+    double xs[2]; int n = 0;
+    for (int k = 0; k < 3 && n < 2; k++)
+    {
+      int p = k, q = (k + 1) % 3;
+      if (y[p] == y[q]) continue;
+      if (y[p] > y[q]) std::swap(p, q);
+      if (py >= y[p] && py < y[q])
+        xs[n++] = x[p] + (py - y[p]) * (x[q] - x[p]) / (y[q] - y[p]);
+    }
+    if (n < 2) continue;
+    if (xs[0] > xs[1]) std::swap(xs[0], xs[1]);
+
+    xs[0] = std::max(xs[0], 0.0);
+    xs[1] = std::min(xs[1], (double) width);
+    for (int i = (int) ceil(xs[0] / gs - 0.5); (i + 0.5) * gs < xs[1]; i++)
+    {
+      double px = (i + 0.5) * gs;
+      double xval = a[0] * px + b[0] * py + c[0];
+      double yval = a[1] * px + b[1] * py + c[1];
+
+      // follows VectorView::plot_arrow()
+      double real_mag = sqrt(sqr(xval) + sqr(yval));
+      double mag = std::min(real_mag, max);
+      if (max <= 0.0 || mag / max < 1e-5)
+      {
+        double w = 0.1 * gs;
+        add_line(px - w, py - w, px + w, py - w, 0);
+        add_line(px + w, py - w, px + w, py + w, 0);
+        add_line(px + w, py + w, px - w, py + w, 0);
+        add_line(px - w, py + w, px - w, py - w, 0);
+        continue;
+      }
+
+      double length = mag / max * gs * arrow_length;
+      double dx = xval / real_mag, dy = -yval / real_mag;
+      double tx = px + dx * length, ty = py + dy * length;
+      add_line(px, py, tx, ty, 0);
+      double hl = 0.25 * length, hw = 0.1 * length;
+      add_line(tx, ty, tx - hl * dx - hw * dy, ty - hl * dy + hw * dx, 0);
+      add_line(tx, ty, tx - hl * dx + hw * dy, ty - hl * dy - hw * dx, 0);
+    }
+  }
+}
+
+
+///////////////// rendering /////////////////
+
+void OffscreenView::render_scalar(const Linearizer* lin)
+{
+  lin->lock_data();
+  double min_x, max_x, min_y, max_y;
+  lin->calc_vertices_aabb(&min_x, &max_x, &min_y, &max_y);
+  fit_view(min_x, max_x, min_y, max_y);
+
+  double vmin = range_auto ? lin->get_min_value() : range_min;
+  double vmax = range_auto ? lin->get_max_value() : range_max;
+  double irange = 1.0 / (vmax - vmin);
+  if (fabs(vmax - vmin) < 1e-8) irange = 1.0; // avoid division by zero, as ScalarView does
+
+  double3* vert = lin->get_vertices();
+  int3* tri = lin->get_triangles();
+  int nt = lin->get_num_triangles();
+  tris.clear();
+  lines.clear();
+  tris.reserve(nt);
+  for (int i = 0; i < nt; i++)
+  {
+    double x[3], y[3], t[3];
+    bool ok = true;
+    for (int k = 0; k < 3; k++)
+    {
+      double* v = vert[tri[i][k]];
+      if (!finite(v[2])) { ok = false; break; }
+      x[k] = screen_x(v[0]);
+      y[k] = screen_y(v[1]);
+      t[k] = (v[2] - vmin) * irange;
+    }
+    if (!ok) continue;
+    add_triangle(x, y, t, -1);
+    if (contours) add_contours(vert, tri[i]);
+  }
+  add_edges(&vert[0][0], 3, lin->get_edges(), lin->get_num_edges(), false);
+  lin->unlock_data();
+
+  init_palette();
+  rasterize();
+}
+
+
+void OffscreenView::render_orders(const Orderizer* ord)
+{
+  ord->lock_data();
+  double min_x, max_x, min_y, max_y;
+  ord->calc_vertices_aabb(&min_x, &max_x, &min_y, &max_y);
+  fit_view(min_x, max_x, min_y, max_y);
+
+  // colors of orders, cf. OrderView::init_order_palette()
+  init_palette();
+  int colors[H2DV_MAX_ORDER + 1];
+  for (int o = 0; o <= H2DV_MAX_ORDER; o++)
+  {
+    if (pal_type == H2DV_PT_DEFAULT)
+      colors[o] = offscreen_order_palette[o];
+    else {
+      int n = std::min(pal_steps - 1, (int) ((double) o / H2DV_MAX_ORDER * pal_steps));
+      colors[o] = (palette[n][0] << 16) | (palette[n][1] << 8) | palette[n][2];
+    }
+  }
+
+  double3* vert = ord->get_vertices();
+  int3* tri = ord->get_triangles();
+  int nt = ord->get_num_triangles();
+  tris.clear();
+  lines.clear();
+  tris.reserve(nt);
+  for (int i = 0; i < nt; i++)
+  {
+    double x[3], y[3];
+    for (int k = 0; k < 3; k++) {
+      x[k] = screen_x(vert[tri[i][k]][0]);
+      y[k] = screen_y(vert[tri[i][k]][1]);
+    }
+    int o = std::max(0, std::min(H2DV_MAX_ORDER, (int) vert[tri[i][0]][2]));
+    add_triangle(x, y, NULL, colors[o]);
+  }
+  add_edges(&vert[0][0], 3, ord->get_edges(), ord->get_num_edges(), true);
+  ord->unlock_data();
+
+  rasterize();
+}
+
+
+void OffscreenView::render_vectors(const Vectorizer* vec)
+{
+  vec->lock_data();
+  double min_x, max_x, min_y, max_y;
+  vec->calc_vertices_aabb(&min_x, &max_x, &min_y, &max_y);
+  fit_view(min_x, max_x, min_y, max_y);
+
+  double vmin = range_auto ? vec->get_min_value() : range_min;
+  double vmax = range_auto ? vec->get_max_value() : range_max;
+  double irange = 1.0 / (vmax - vmin);
+  if (fabs(vmax - vmin) < 1e-8) irange = 1.0;
+
+  // the background shows the magnitude, arrows show the direction
+  double4* vert = vec->get_vertices();
+  int3* tri = vec->get_triangles();
+  int nt = vec->get_num_triangles();
+  tris.clear();
+  lines.clear();
+  tris.reserve(nt);
+  for (int i = 0; i < nt; i++)
+  {
+    double x[3], y[3], t[3];
+    for (int k = 0; k < 3; k++)
+    {
+      double* v = vert[tri[i][k]];
+      x[k] = screen_x(v[0]);
+      y[k] = screen_y(v[1]);
+      t[k] = (sqrt(sqr(v[2]) + sqr(v[3])) - vmin) * irange;
+    }
+    add_triangle(x, y, t, -1);
+    add_arrows(vert, tri[i], vmax);
+  }
+  add_edges(&vert[0][0], 4, vec->get_edges(), vec->get_num_edges(), false);
+  vec->unlock_data();
+
+  init_palette();
+  rasterize();
+}
+
+
+void OffscreenView::show(MeshFunction* sln, double eps, int item)
+{
+  Linearizer lin;
+  lin.process_solution(sln, item, eps);
+  render_scalar(&lin);
+}
+
+
+void OffscreenView::show(Space* space)
+{
+  if (!space->is_up_to_date())
+    error("The space is not up to date.");
+
+  Orderizer ord;
+  ord.process_solution(space);
+  render_orders(&ord);
+}
+
+
+void OffscreenView::show(MeshFunction* xsln, MeshFunction* ysln, double eps, int xitem, int yitem)
+{
+  Vectorizer vec;
+  vec.process_solution(xsln, xitem, ysln, yitem, eps);
+  render_vectors(&vec);
+}
+
+
+///////////////// rasterization /////////////////
+
+void OffscreenView::rasterize()
+{
+  // bin the primitives into the tiles which their bounding boxes overlap
+  int ntiles = tiles_x * tiles_y, i, tx, ty;
+  for (i = 0; i < ntiles; i++) {
+    tile_tris[i].clear();
+    tile_lines[i].clear();
+  }
+
+  for (i = 0; i < (int) tris.size(); i++)
+  {
+    const RasterTri& rt = tris[i];
+    double x0 = std::min(rt.x[0], std::min(rt.x[1], rt.x[2])), x1 = std::max(rt.x[0], std::max(rt.x[1], rt.x[2]));
+    double y0 = std::min(rt.y[0], std::min(rt.y[1], rt.y[2])), y1 = std::max(rt.y[0], std::max(rt.y[1], rt.y[2]));
+    if (x1 < 0.0 || y1 < 0.0 || x0 >= width || y0 >= height) continue;
+    int tx0 = (int) std::max(x0, 0.0) / H2DV_TILE_SIZE, tx1 = (int) std::min(x1, width - 1.0) / H2DV_TILE_SIZE;
+    int ty0 = (int) std::max(y0, 0.0) / H2DV_TILE_SIZE, ty1 = (int) std::min(y1, height - 1.0) / H2DV_TILE_SIZE;
+    for (ty = ty0; ty <= ty1; ty++)
+      for (tx = tx0; tx <= tx1; tx++)
+        tile_tris[ty * tiles_x + tx].push_back(i);
+  }
+
+  for (i = 0; i < (int) lines.size(); i++)
+  {
+    const RasterLine& rl = lines[i];
+    double x0 = std::min(rl.x0, rl.x1), x1 = std::max(rl.x0, rl.x1);
+    double y0 = std::min(rl.y0, rl.y1), y1 = std::max(rl.y0, rl.y1);
+    if (x1 < 0.0 || y1 < 0.0 || x0 >= width || y0 >= height) continue;
+    int tx0 = (int) std::max(x0, 0.0) / H2DV_TILE_SIZE, tx1 = (int) std::min(x1, width - 1.0) / H2DV_TILE_SIZE;
+    int ty0 = (int) std::max(y0, 0.0) / H2DV_TILE_SIZE, ty1 = (int) std::min(y1, height - 1.0) / H2DV_TILE_SIZE;
+    for (ty = ty0; ty <= ty1; ty++)
+      for (tx = tx0; tx <= tx1; tx++)
+        tile_lines[ty * tiles_x + tx].push_back(i);
+  }
+
+  // the calling thread works on the tiles too
+  next_tile = 0;
+  int nthreads = std::min(num_threads, ntiles) - 1;
+  std::vector<pthread_t> threads(std::max(nthreads, 0));
+  int started = 0;
+  for (i = 0; i < nthreads; i++, started++)
+    if (pthread_create(&threads[i], NULL, raster_thread, this) != 0)
+      break;
+  raster_thread(this);
+  for (i = 0; i < started; i++)
+    pthread_join(threads[i], NULL);
+
+  tris.clear();
+  lines.clear();
+}
+
+
+void* OffscreenView::raster_thread(void* arg)
+{
+  OffscreenView* view = (OffscreenView*) arg;
+  int ntiles = view->tiles_x * view->tiles_y;
+  while (true)
+  {
+    pthread_mutex_lock(&view->tile_mutex);
+    int tile = view->next_tile++;
+    pthread_mutex_unlock(&view->tile_mutex);
+    if (tile >= ntiles) break;
+    view->rasterize_tile(tile);
+  }
+  return NULL;
+}
+
+
+void OffscreenView::rasterize_tile(int tile)
+{
+  int x_lo = (tile % tiles_x) * H2DV_TILE_SIZE, x_hi = std::min(width, x_lo + H2DV_TILE_SIZE);
+  int y_lo = (tile / tiles_x) * H2DV_TILE_SIZE, y_hi = std::min(height, y_lo + H2DV_TILE_SIZE);
+  int i, j, k;
+
+  for (j = y_lo; j < y_hi; j++)
+    for (i = x_lo; i < x_hi; i++)
+      put_pixel(pixels + 3 * (j * width + i), back_color);
+
+  // triangles: scanline conversion, a pixel is covered if its center lies in the
+  // half-open span [xl, xr) of the row; shared edges are evaluated identically by
+  // both neighbors, so there are neither gaps nor double hits
+  std::vector<int>& tt = tile_tris[tile];
+  for (unsigned n = 0; n < tt.size(); n++)
+  {
+    const RasterTri& rt = tris[tt[n]];
+    double miny = std::min(rt.y[0], std::min(rt.y[1], rt.y[2]));
+    double maxy = std::max(rt.y[0], std::max(rt.y[1], rt.y[2]));
+    int j0 = (int) std::max((double) y_lo, ceil(miny - 0.5));
+    int j1 = (int) std::min((double) y_hi, ceil(maxy - 0.5));
+    for (j = j0; j < j1; j++)
+    {
+      double yc = j + 0.5;
+      double xs[2]; int cnt = 0;
+      for (k = 0; k < 3 && cnt < 2; k++)
+      {
+        int p = k, q = (k + 1) % 3;
+        if (rt.y[p] == rt.y[q]) continue;
+        if (rt.y[p] > rt.y[q]) std::swap(p, q);
+        if (yc >= rt.y[p] && yc < rt.y[q])
+          xs[cnt++] = rt.x[p] + (yc - rt.y[p]) * (rt.x[q] - rt.x[p]) / (rt.y[q] - rt.y[p]);
+      }
+      if (cnt < 2) continue;
+      if (xs[0] > xs[1]) std::swap(xs[0], xs[1]);
+
+      int i0 = (int) std::max((double) x_lo, ceil(xs[0] - 0.5));
+      int i1 = (int) std::min((double) x_hi, ceil(xs[1] - 0.5));
+      unsigned char* px = pixels + 3 * (j * width + i0);
+      if (rt.color >= 0)
+      {
+        for (i = i0; i < i1; i++, px += 3)
+          put_pixel(px, rt.color);
+      }
+      else
+      {
+        double t = rt.ta * (i0 + 0.5) + rt.tb * yc + rt.tc;
+        for (i = i0; i < i1; i++, px += 3, t += rt.ta)
+        {
+          int idx = (int) floor(t * pal_steps);
+          if (idx < 0) idx = 0;
+          else if (idx >= pal_steps) idx = pal_steps - 1;
+          px[0] = palette[idx][0]; px[1] = palette[idx][1]; px[2] = palette[idx][2];
+        }
+      }
+    }
+  }
+
+  // lines: one pixel per column (row) along the major axis; the pixel positions do
+  // not depend on the tile, so lines crossing tile boundaries are continuous
+  std::vector<int>& tl = tile_lines[tile];
+  for (unsigned n = 0; n < tl.size(); n++)
+  {
+    const RasterLine& rl = lines[tl[n]];
+    double x0 = rl.x0, y0 = rl.y0, x1 = rl.x1, y1 = rl.y1;
+    bool steep = fabs(y1 - y0) > fabs(x1 - x0);
+    if (steep) { std::swap(x0, y0); std::swap(x1, y1); }
+    if (x0 > x1) { std::swap(x0, x1); std::swap(y0, y1); }
+
+    int a_lo = steep ? y_lo : x_lo, a_hi = steep ? y_hi : x_hi;
+    int b_lo = steep ? x_lo : y_lo, b_hi = steep ? x_hi : y_hi;
+    double m0 = ceil(x0 - 0.5), m1 = floor(x1 - 0.5);
+    double slope = (x1 > x0) ? (y1 - y0) / (x1 - x0) : 0.0;
+    if (m0 > m1) m0 = m1 = floor(0.5 * (x0 + x1)); // shorter than a pixel
+    m0 = std::max(m0, (double) a_lo);
+    m1 = std::min(m1, a_hi - 1.0);
+    for (int m = (int) m0; m <= (int) m1; m++)
+    {
+      double bf = floor(y0 + (m + 0.5 - x0) * slope);
+      if (bf < b_lo || bf >= b_hi) continue;
+      int b = (int) bf;
+      int pi = steep ? b : m, pj = steep ? m : b;
+      put_pixel(pixels + 3 * (pj * width + pi), rl.color);
+    }
+  }
+}
+
+
+///////////////// output /////////////////
+
+static void put_le16(unsigned char* p, unsigned v) { p[0] = v & 0xff; p[1] = (v >> 8) & 0xff; }
+static void put_le32(unsigned char* p, unsigned v) { put_le16(p, v & 0xffff); put_le16(p + 2, v >> 16); }
+static void put_be32(unsigned char* p, unsigned v)
+{
+  p[0] = (v >> 24) & 0xff; p[1] = (v >> 16) & 0xff; p[2] = (v >> 8) & 0xff; p[3] = v & 0xff;
+}
+
+
+bool OffscreenView::write_bmp(const char* filename, const unsigned char* rgb, int width, int height)
+{
+  FILE* file = fopen(filename, "wb");
+  if (file == NULL) return false;
+
+  // 24-bit uncompressed bitmap, rows are stored bottom-up and padded to 4 bytes
+  int stride = (3 * width + 3) & ~3;
+  unsigned char header[54];
+  memset(header, 0, sizeof(header));
+  header[0] = 'B'; header[1] = 'M';
+  put_le32(header + 2, 54 + stride * height);
+  put_le32(header + 10, 54);
+  put_le32(header + 14, 40);
+  put_le32(header + 18, width);
+  put_le32(header + 22, height);
+  put_le16(header + 26, 1);
+  put_le16(header + 28, 24);
+  put_le32(header + 34, stride * height);
+  put_le32(header + 38, 2835); // 72 dpi
+  put_le32(header + 42, 2835);
+
+  bool ok = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+  std::vector<unsigned char> row(stride, 0);
+  for (int j = height - 1; j >= 0 && ok; j--)
+  {
+    const unsigned char* src = rgb + 3 * j * width;
+    for (int i = 0; i < width; i++) {
+      row[3*i + 0] = src[3*i + 2];
+      row[3*i + 1] = src[3*i + 1];
+      row[3*i + 2] = src[3*i + 0];
+    }
+    ok = fwrite(&row[0], 1, stride, file) == (size_t) stride;
+  }
+  if (fclose(file) != 0) ok = false;
+  return ok;
+}
+
+
+static unsigned png_crc(const unsigned char* data, size_t len, unsigned crc = 0)
+{
+  static unsigned table[256];
+  static bool table_ready = false;
+  if (!table_ready)
+  {
+    for (unsigned n = 0; n < 256; n++) {
+      unsigned c = n;
+      for (int k = 0; k < 8; k++)
+        c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+      table[n] = c;
+    }
+    table_ready = true;
+  }
+  crc = ~crc;
+  for (size_t i = 0; i < len; i++)
+    crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+  return ~crc;
+}
+
+
+static bool png_chunk(FILE* file, const char* type, const unsigned char* data, size_t len)
+{
+  unsigned char buf[4];
+  put_be32(buf, (unsigned) len);
+  if (fwrite(buf, 1, 4, file) != 4) return false;
+  if (fwrite(type, 1, 4, file) != 4) return false;
+  if (len > 0 && fwrite(data, 1, len, file) != len) return false;
+  unsigned crc = png_crc((const unsigned char*) type, 4);
+  crc = png_crc(data, len, crc);
+  put_be32(buf, crc);
+  return fwrite(buf, 1, 4, file) == 4;
+}
+
+
+bool OffscreenView::write_png(const char* filename, const unsigned char* rgb, int width, int height)
+{
+  // raw scanlines, each preceded by the filter type 0 (none)
+  size_t row_len = 3 * width + 1;
+  size_t raw_len = row_len * height;
+
+  // zlib stream made of stored (uncompressed) deflate blocks, so that no external
+  // library is needed
+  size_t nblocks = (raw_len + 65534) / 65535;
+  std::vector<unsigned char> z(2 + raw_len + 5 * nblocks + 4);
+  unsigned char* zp = &z[0];
+  *zp++ = 0x78; *zp++ = 0x01;
+
+  unsigned s1 = 1, s2 = 0;
+  size_t left = raw_len, pos = 0;
+  while (left > 0)
+  {
+    unsigned len = (unsigned) std::min(left, (size_t) 65535);
+    *zp++ = (left == len) ? 1 : 0;
+    put_le16(zp, len); put_le16(zp + 2, ~len & 0xffff);
+    zp += 4;
+    for (unsigned k = 0; k < len; k++, pos++)
+    {
+      size_t j = pos / row_len, i = pos % row_len;
+      unsigned char b = (i == 0) ? 0 : rgb[3 * width * j + i - 1];
+      *zp++ = b;
+      s1 = (s1 + b) % 65521;
+      s2 = (s2 + s1) % 65521;
+    }
+    left -= len;
+  }
+  put_be32(zp, (s2 << 16) | s1);
+
+  FILE* file = fopen(filename, "wb");
+  if (file == NULL) return false;
+
+  static const unsigned char signature[8] = { 137, 'P', 'N', 'G', 13, 10, 26, 10 };
+  unsigned char ihdr[13];
+  put_be32(ihdr, width);
+  put_be32(ihdr + 4, height);
+  ihdr[8] = 8;  // bit depth
+  ihdr[9] = 2;  // truecolor
+  ihdr[10] = ihdr[11] = ihdr[12] = 0;
+
+  bool ok = fwrite(signature, 1, 8, file) == 8
+         && png_chunk(file, "IHDR", ihdr, 13)
+         && png_chunk(file, "IDAT", &z[0], z.size())
+         && png_chunk(file, "IEND", NULL, 0);
+  if (fclose(file) != 0) ok = false;
+  return ok;
+}
+
+
+static bool is_png_name(const char* filename)
+{
+  size_t len = strlen(filename);
+  if (len < 4) return false;
+  const char* ext = filename + len - 4;
+  return ext[0] == '.' && tolower(ext[1]) == 'p' && tolower(ext[2]) == 'n' && tolower(ext[3]) == 'g';
+}
+
+
+void OffscreenView::save_image(const char* filename, bool async)
+{
+  if (!async)
+  {
+    bool ok = is_png_name(filename) ? write_png(filename, pixels, width, height)
+                                    : write_bmp(filename, pixels, width, height);
+    if (!ok) error("Could not write image '%s'.", filename);
+    verbose("Image \"%s\" saved.", filename);
+    return;
+  }
+
+  WriteJob* job = new WriteJob;
+  job->filename = filename;
+  job->width = width;
+  job->height = height;
+  job->rgb = (unsigned char*) malloc(3 * width * height);
+  if (job->rgb == NULL)
+    error("Could not allocate memory for pixel data.");
+  memcpy(job->rgb, pixels, 3 * width * height);
+
+  start_writer();
+  pthread_mutex_lock(&write_mutex);
+  write_queue.push_back(job);
+  writes_pending++;
+  pthread_cond_signal(&write_cond);
+  pthread_mutex_unlock(&write_mutex);
+}
+
+
+void OffscreenView::save_numbered(const char* format, int number, bool async)
+{
+  char buffer[1000];
+  sprintf(buffer, format, number);
+  save_image(buffer, async);
+}
+
+
+void OffscreenView::wait_for_writes()
+{
+  pthread_mutex_lock(&write_mutex);
+  while (writes_pending > 0)
+    pthread_cond_wait(&write_done, &write_mutex);
+  pthread_mutex_unlock(&write_mutex);
+}
+
+
+void OffscreenView::start_writer()
+{
+  if (writer_started) return;
+  if (pthread_create(&writer, NULL, writer_thread, this) != 0)
+    error("Could not start the image writer thread.");
+  writer_started = true;
+}
+
+
+void* OffscreenView::writer_thread(void* arg)
+{
+  OffscreenView* view = (OffscreenView*) arg;
+  while (true)
+  {
+    pthread_mutex_lock(&view->write_mutex);
+    while (view->write_queue.empty() && !view->writer_quit)
+      pthread_cond_wait(&view->write_cond, &view->write_mutex);
+    if (view->write_queue.empty()) { // quitting and nothing left to write
+      pthread_mutex_unlock(&view->write_mutex);
+      break;
+    }
+    WriteJob* job = view->write_queue.front();
+    view->write_queue.pop_front();
+    pthread_mutex_unlock(&view->write_mutex);
+
+    const char* name = job->filename.c_str();
+    bool ok = is_png_name(name) ? write_png(name, job->rgb, job->width, job->height)
+                                : write_bmp(name, job->rgb, job->width, job->height);
+    if (!ok) fprintf(stderr, "Could not write image '%s'.\n", name);
+    ::free(job->rgb);
+    delete job;
+
+    pthread_mutex_lock(&view->write_mutex);
+    if (--view->writes_pending == 0)
+      pthread_cond_broadcast(&view->write_done);
+    pthread_mutex_unlock(&view->write_mutex);
+  }
+  return NULL;
+}
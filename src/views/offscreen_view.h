@@ -0,0 +1,163 @@
+// This file is part of Hermes2D.
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __H2D_OFFSCREEN_VIEW_H
+#define __H2D_OFFSCREEN_VIEW_H
+
+#include <deque>
+#include <vector>
+#include "view.h"
+
+/// \brief Renders linearized solutions into a memory framebuffer.
+///
+/// OffscreenView is a software replacement of ScalarView, OrderView and VectorView
+/// for machines without a display (batch nodes, NOGLUT builds). It takes the output
+/// of Linearizer, Orderizer or Vectorizer and rasterizes the triangles, contours,
+/// mesh edges and arrows into an RGB framebuffer. The framebuffer is split into
+/// tiles which are rasterized by several threads; the tiles do not overlap, so no
+/// locking is needed during rasterization. Images are stored as BMP or PNG, either
+/// immediately or by a background writer thread, so that the computation does not
+/// wait for the disk.
+///
+/// Unlike the GLUT views, OffscreenView is available even if NOGLUT is defined.
+///
+class H2D_API OffscreenView
+{
+public:
+
+  OffscreenView(int width = 1000, int height = 800, int num_threads = 0); ///< Creates the view. If num_threads is zero, the number of CPUs is used.
+  ~OffscreenView(); ///< Waits for all pending writes.
+
+  /// Linearizes and renders a scalar solution (cf. ScalarView::show()).
+  void show(MeshFunction* sln, double eps = H2D_EPS_NORMAL, int item = H2D_FN_VAL_0);
+  /// Renders the polynomial orders of a space (cf. OrderView::show()).
+  void show(Space* space);
+  /// Linearizes and renders a vector field (cf. VectorView::show()).
+  void show(MeshFunction* xsln, MeshFunction* ysln, double eps = H2D_EPS_NORMAL,
+            int xitem = H2D_FN_VAL_0, int yitem = H2D_FN_VAL_0);
+
+  void render_scalar(const Linearizer* lin);   ///< Renders the data of a Linearizer which has already been processed.
+  void render_orders(const Orderizer* ord);    ///< Renders the data of an Orderizer which has already been processed.
+  void render_vectors(const Vectorizer* vec);  ///< Renders the data of a Vectorizer which has already been processed.
+
+  void set_palette(ViewPaletteType type) { pal_type = type; }
+  void set_num_palette_steps(int num);         ///< Number of color steps of the palette (2 to 256).
+  void set_min_max_range(double min, double max); ///< Fixes the range of values mapped onto the palette.
+  void set_auto_range() { range_auto = true; } ///< Uses the minimum and maximum of the rendered data.
+
+  void show_contours(double step, double orig = 0.0); ///< Draws isolines of the scalar value.
+  void hide_contours() { contours = false; }
+  void show_edges(bool show = true) { edges = show; } ///< Draws all edges (boundary edges are always drawn).
+  void set_arrow_spacing(double pixels, double length_coef = 1.0); ///< Grid spacing and scaling of arrows of vector fields.
+
+  void set_background_color(float r, float g, float b);
+  void set_edges_color(float r, float g, float b);
+  void set_contours_color(float r, float g, float b);
+
+  /// Renders the given part of the domain instead of the bounding box of the data.
+  /// This keeps the view fixed in sequences of images, e.g., during adaptivity.
+  void set_bounding_box(double min_x, double max_x, double min_y, double max_y);
+  void reset_bounding_box() { box_fixed = false; }
+
+  int get_width() const { return width; }
+  int get_height() const { return height; }
+  int get_num_threads() const { return num_threads; }
+  const unsigned char* get_pixels() const { return pixels; } ///< RGB triplets, rows from top to bottom.
+
+  /// Saves the framebuffer. The format is PNG if the file name ends with ".png", otherwise BMP.
+  /// If async is true, a copy of the framebuffer is handed to the writer thread and
+  /// the function returns immediately.
+  void save_image(const char* filename, bool async = false);
+  void save_numbered(const char* format, int number, bool async = false);
+  void wait_for_writes(); ///< Blocks until all asynchronous writes are finished.
+
+  static bool write_bmp(const char* filename, const unsigned char* rgb, int width, int height);
+  static bool write_png(const char* filename, const unsigned char* rgb, int width, int height);
+
+protected:
+
+  struct RasterTri
+  {
+    double x[3], y[3];  ///< screen coordinates
+    double ta, tb, tc;  ///< palette coordinate t = ta*x + tb*y + tc
+    int color;          ///< packed RGB of a flat triangle, -1 if the palette is used
+  };
+
+  struct RasterLine
+  {
+    double x0, y0, x1, y1;
+    int color;
+  };
+
+  struct WriteJob
+  {
+    std::string filename;
+    unsigned char* rgb;
+    int width, height;
+  };
+
+  int width, height;
+  int num_threads;
+  unsigned char* pixels;
+
+  ViewPaletteType pal_type;
+  int pal_steps;
+  unsigned char palette[256][3];
+
+  bool range_auto;
+  double range_min, range_max;
+  bool contours, edges;
+  double cont_orig, cont_step;
+  double arrow_spacing, arrow_length;
+  int back_color, edges_color, cont_color;
+
+  bool box_fixed;
+  double box_min_x, box_max_x, box_min_y, box_max_y;
+  double scale, trans_x, trans_y;
+
+  std::vector<RasterTri> tris;
+  std::vector<RasterLine> lines;
+  int tiles_x, tiles_y;
+  std::vector< std::vector<int> > tile_tris, tile_lines;
+  int next_tile;
+  pthread_mutex_t tile_mutex;
+
+  std::deque<WriteJob*> write_queue;
+  int writes_pending;
+  bool writer_started, writer_quit;
+  pthread_t writer;
+  pthread_mutex_t write_mutex;
+  pthread_cond_t write_cond, write_done;
+
+  void fit_view(double min_x, double max_x, double min_y, double max_y);
+  double screen_x(double x) const { return trans_x + x * scale; }
+  double screen_y(double y) const { return trans_y - y * scale; }
+
+  void init_palette();
+  void add_triangle(const double* x, const double* y, const double* t, int color);
+  void add_line(double x0, double y0, double x1, double y1, int color);
+  void add_contours(double3* vert, int3& tri);
+  void add_edges(const double* vert, int stride, int3* edges, int ne, bool all);
+  void add_arrows(double4* vert, int3& tri, double max);
+
+  void rasterize();
+  void rasterize_tile(int tile);
+  static void* raster_thread(void* arg);
+
+  void start_writer();
+  static void* writer_thread(void* arg);
+};
+
+#endif
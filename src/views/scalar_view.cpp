@@ -451,7 +451,7 @@ void ScalarView::init_element_info(Mesh* mesh)
 
   //build element info
   Element *element = NULL;
-  for_all_active_elements(element, mesh)
+  for_all_active_elements_fast(element, mesh)
   {
     double sum_x = 0.0, sum_y = 0.0;
     double max_x, max_y, min_x, min_y;
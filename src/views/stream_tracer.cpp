@@ -0,0 +1,468 @@
+// This file is part of Hermes2D.
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef WIN32
+# include <unistd.h>
+#endif
+
+#include "../common.h"
+#include "stream_tracer.h"
+
+///////////////// private constants /////////////////
+#define H2DST_MAX_WALK 16       ///< Maximum number of steps of the walk before the grid is used.
+#define H2DST_BUFFER_LENGTH 5000 ///< Maximum number of points of a streamline.
+
+StreamTracer::StreamTracer(int num_threads)
+  : nv(0), nt(0), ne(0), verts(NULL), tris(NULL), adj(NULL), edges(NULL),
+    cell_start(NULL), cell_tris(NULL)
+{
+  set_num_threads(num_threads);
+}
+
+
+StreamTracer::~StreamTracer()
+{
+  free();
+}
+
+
+void StreamTracer::free()
+{
+  delete [] verts; verts = NULL;
+  delete [] tris; tris = NULL;
+  delete [] adj; adj = NULL;
+  delete [] edges; edges = NULL;
+  delete [] cell_start; cell_start = NULL;
+  delete [] cell_tris; cell_tris = NULL;
+  nv = nt = ne = 0;
+}
+
+
+void StreamTracer::set_num_threads(int num_threads)
+{
+  if (num_threads <= 0)
+  {
+#ifndef WIN32
+    num_threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (num_threads <= 0) num_threads = 1;
+  }
+  this->num_threads = num_threads;
+}
+
+
+void StreamTracer::init(const Vectorizer* vec)
+{
+  free();
+
+  nv = vec->get_num_vertices();
+  nt = vec->get_num_triangles();
+  ne = vec->get_num_edges();
+  if (nt <= 0) error("No triangles to trace streamlines in.");
+
+  verts = new double4[nv];
+  memcpy(verts, vec->get_vertices(), sizeof(double4) * nv);
+  tris = new int3[nt];
+  memcpy(tris, vec->get_triangles(), sizeof(int3) * nt);
+  edges = new int3[ne];
+  memcpy(edges, vec->get_edges(), sizeof(int3) * ne);
+  max_mag = vec->get_max_value();
+
+  vec->calc_vertices_aabb(&min_x, &max_x, &min_y, &max_y);
+  initial_tau = std::max(max_x - min_x, max_y - min_y) / 100;
+  max_tau = initial_tau * 10;
+  min_tau = initial_tau / 50;
+
+  build_adjacency();
+  build_grid();
+}
+
+
+///////////////// point location /////////////////
+
+// Tests whether given point (x,y) lies in given triangle
+// using barycentric coordinates (returned as side efect)
+bool StreamTracer::is_in_triangle(int idx, double x, double y, double3& bar) const
+{
+  int3& tri = tris[idx];
+  double x1 = verts[tri[0]][0], x2 = verts[tri[1]][0], x3 = verts[tri[2]][0];
+  double y1 = verts[tri[0]][1], y2 = verts[tri[1]][1], y3 = verts[tri[2]][1];
+  double jac = ((x1 - x3)*(y2 - y3) - (x2 - x3)*(y1 - y3));
+  if (jac == 0.0) { bar[0] = bar[1] = bar[2] = -1.0; return false; }
+  double a = ((y2 - y3) * (x - x3) - (x2 - x3) * (y - y3));
+  double b = ((x1 - x3) * (y - y3) - (y1 - y3) * (x - x3));
+  bar[0] = a / jac; bar[1] = b / jac; bar[2] = 1.0 - bar[0] - bar[1];
+  const double eps = 1e-8;
+  for (int k = 0; k < 3; k++)
+    if (bar[k] < -eps || bar[k] > 1.0 + eps) return false;
+  return true;
+}
+
+
+void StreamTracer::build_adjacency()
+{
+  // edges are bucketed by their smaller vertex index; the buckets are short, so
+  // the matching edge is found by a linear search. Vectorizer shares vertices of
+  // neighboring triangles unless the field is discontinuous there; across such
+  // edges the walk stops and the grid is used instead.
+  int i, k, m;
+  std::vector<int> start(nv + 1, 0), other(3 * nt), slot(3 * nt);
+  for (i = 0; i < nt; i++)
+    for (k = 0; k < 3; k++)
+      start[std::min(tris[i][(k + 1) % 3], tris[i][(k + 2) % 3]) + 1]++;
+  for (i = 0; i < nv; i++)
+    start[i + 1] += start[i];
+
+  std::vector<int> pos(start.begin(), start.end() - 1);
+  for (i = 0; i < nt; i++)
+    for (k = 0; k < 3; k++)
+    {
+      int a = tris[i][(k + 1) % 3], b = tris[i][(k + 2) % 3];
+      int p = pos[std::min(a, b)]++;
+      other[p] = std::max(a, b);
+      slot[p] = 3*i + k;
+    }
+
+  adj = new int3[nt];
+  for (i = 0; i < nt; i++)
+    adj[i][0] = adj[i][1] = adj[i][2] = -1;
+  for (int v = 0; v < nv; v++)
+    for (i = start[v]; i < start[v + 1]; i++)
+      for (m = i + 1; m < start[v + 1]; m++)
+        if (other[i] == other[m])
+        {
+          int s1 = slot[i], s2 = slot[m];
+          adj[s1 / 3][s1 % 3] = s2 / 3;
+          adj[s2 / 3][s2 % 3] = s1 / 3;
+        }
+}
+
+
+void StreamTracer::build_grid()
+{
+  // uniform grid with about one triangle per cell, stored in the CSR format
+  double w = std::max(max_x - min_x, 1e-12), h = std::max(max_y - min_y, 1e-12);
+  grid_nx = std::max(1, (int) ceil(sqrt(nt * w / h)));
+  grid_ny = std::max(1, (int) ceil((double) nt / grid_nx));
+  grid_hx = w / grid_nx;
+  grid_hy = h / grid_ny;
+
+  int ncells = grid_nx * grid_ny, i, c, ix, iy;
+  cell_start = new int[ncells + 1];
+  memset(cell_start, 0, sizeof(int) * (ncells + 1));
+
+  std::vector<int> range(4 * nt);
+  for (i = 0; i < nt; i++)
+  {
+    double x0 = verts[tris[i][0]][0], x1 = x0, y0 = verts[tris[i][0]][1], y1 = y0;
+    for (int k = 1; k < 3; k++) {
+      x0 = std::min(x0, verts[tris[i][k]][0]); x1 = std::max(x1, verts[tris[i][k]][0]);
+      y0 = std::min(y0, verts[tris[i][k]][1]); y1 = std::max(y1, verts[tris[i][k]][1]);
+    }
+    range[4*i + 0] = std::max(0, std::min(grid_nx - 1, (int) floor((x0 - min_x) / grid_hx)));
+    range[4*i + 1] = std::max(0, std::min(grid_nx - 1, (int) floor((x1 - min_x) / grid_hx)));
+    range[4*i + 2] = std::max(0, std::min(grid_ny - 1, (int) floor((y0 - min_y) / grid_hy)));
+    range[4*i + 3] = std::max(0, std::min(grid_ny - 1, (int) floor((y1 - min_y) / grid_hy)));
+    for (iy = range[4*i + 2]; iy <= range[4*i + 3]; iy++)
+      for (ix = range[4*i + 0]; ix <= range[4*i + 1]; ix++)
+        cell_start[iy * grid_nx + ix + 1]++;
+  }
+  for (c = 0; c < ncells; c++)
+    cell_start[c + 1] += cell_start[c];
+
+  cell_tris = new int[cell_start[ncells]];
+  std::vector<int> pos(cell_start, cell_start + ncells);
+  for (i = 0; i < nt; i++)
+    for (iy = range[4*i + 2]; iy <= range[4*i + 3]; iy++)
+      for (ix = range[4*i + 0]; ix <= range[4*i + 1]; ix++)
+        cell_tris[pos[iy * grid_nx + ix]++] = i;
+}
+
+
+int StreamTracer::find_triangle(double x, double y, double3& bar, int hint) const
+{
+  // walk from the hint towards the point
+  int cur = hint;
+  for (int step = 0; cur >= 0 && step < H2DST_MAX_WALK; step++)
+  {
+    if (is_in_triangle(cur, x, y, bar)) return cur;
+    int k = 0;
+    if (bar[1] < bar[k]) k = 1;
+    if (bar[2] < bar[k]) k = 2;
+    cur = adj[cur][k];
+  }
+
+  // the walk left the domain or was too long: use the grid
+  double fx = (x - min_x) / grid_hx, fy = (y - min_y) / grid_hy;
+  if (fx < -1e-8 * grid_nx || fx > grid_nx * (1.0 + 1e-8) || fy < -1e-8 * grid_ny || fy > grid_ny * (1.0 + 1e-8))
+    return -1;
+  int ix = std::max(0, std::min(grid_nx - 1, (int) floor(fx)));
+  int iy = std::max(0, std::min(grid_ny - 1, (int) floor(fy)));
+  int c = iy * grid_nx + ix;
+  for (int i = cell_start[c]; i < cell_start[c + 1]; i++)
+    if (is_in_triangle(cell_tris[i], x, y, bar))
+      return cell_tris[i];
+  return -1;
+}
+
+
+bool StreamTracer::get_values(double x, double y, double& xval, double& yval, int& hint) const
+{
+  double3 bar;
+  int e_idx = find_triangle(x, y, bar, hint);
+  if (e_idx < 0) return false;
+  hint = e_idx;
+  int3& tri = tris[e_idx];
+  xval = bar[0] * verts[tri[0]][2] + bar[1] * verts[tri[1]][2] + bar[2] * verts[tri[2]][2];
+  yval = bar[0] * verts[tri[0]][3] + bar[1] * verts[tri[1]][3] + bar[2] * verts[tri[2]][3];
+  return true;
+}
+
+
+///////////////// tracing /////////////////
+
+// Starts from initial point (x_start, y_start)
+// and using adaptive RK method finds the streamline
+int StreamTracer::create_streamline(double x_start, double y_start, double2*& points) const
+{
+  double ODE_EPS = 1e-5;
+  double tau = initial_tau;
+  double x = x_start;
+  double y = y_start;
+  int k = 0, hint = -1;
+  double2* buffer = new double2[H2DST_BUFFER_LENGTH];
+  bool tau_ok = false;
+  bool end = false;
+  bool almost_end_of_domain = false;
+
+  double k1, k2, k3, k4, k5;
+  double l1, l2, l3, l4, l5;
+  double x1, x2, x3, x4, x5;
+  double y1, y2, y3, y4, y5;
+
+  while(1)
+  {
+    if (get_values(x, y, k1, l1, hint) == false) // point (x,y) does not lie in the domain
+    {
+      tau = tau/2;  // draw streamline to the end of the domain
+      if (tau < min_tau) break;
+      continue;
+    }
+    if (fabs(k1) / max_mag  < 1e-5 && fabs(l1) / max_mag < 1e-5) break;  // stop streamline when zero solution
+
+    // add new point to steamline
+    buffer[k][0] = x;
+    buffer[k][1] = y;
+    k++;
+    if (k >= H2DST_BUFFER_LENGTH) break;
+
+    do
+    {
+      if (almost_end_of_domain)  // draw streamline to the end of the domain
+      {
+        almost_end_of_domain = false;
+        tau = tau/2;
+        if (tau < min_tau) { end = true; break; }
+      }
+
+      // Merson's adaptive Runge-Kutta method; the stages are close to (x,y),
+      // so their triangles are found by a short walk from the current one
+      int h = hint;
+      x1 = x + 1.0/3.0 * tau * k1; y1 = y + 1.0/3.0 * tau * l1;
+      if (get_values(x1, y1, k2, l2, h) == false) {  almost_end_of_domain = true;  continue;  }
+      x2 = x + 1.0/6.0 * tau * (k1 + k2); y2 = y + 1.0/6.0 * tau * (l1 + l2);
+      if (get_values(x2, y2, k3, l3, h) == false) {  almost_end_of_domain = true;  continue;  }
+      x3 = x + tau * (0.125 * k1 + 0.375 * k3); y3 = y + tau * (0.125 * l1 + 0.375 * l3);
+      if (get_values(x3, y3, k4, l4, h) == false) {  almost_end_of_domain = true;  continue;  }
+      x4 = x + tau * (0.5 * k1 - 1.5 * k3 + 2.0 * k4); y4 = y + tau * (0.5 * l1 - 1.5 * l3 + 2.0 * l4);
+      if (get_values(x4, y4, k5, l5, h) == false) {  almost_end_of_domain = true;  continue;  }
+      x5 = x + tau * 1.0/6.0 * (k1 + 4.0 * k4 + k5); y5 = y + tau * 1.0/6.0 * (l1 + 4.0 * l4 + l5);
+
+      // error according to Merson
+      double x_err = 1.0/5.0 * (x4 - x5) / (max_x - min_x);
+      double y_err = 1.0/5.0 * (y4 - y5) / (max_y - min_y);
+      double err = std::max(fabs(x_err),fabs(y_err));
+      if (err < ODE_EPS)
+      {
+        tau_ok = true;  x = x5;  y = y5;
+      }
+      else
+      {
+        tau_ok = false; tau = tau/2;
+        if (tau < min_tau)  tau = min_tau;
+      }
+
+      if (err < ODE_EPS/32)
+      {
+        // new tau according to Merson
+        tau = 0.8 * tau * pow(ODE_EPS/err, 0.2);
+        if (tau > max_tau)  tau = max_tau;
+      }
+    }
+    while (!tau_ok);
+    if (end) break; // get out from both while cycles
+  }
+
+  points = new double2[k];
+  memcpy(points, buffer, k*sizeof(double2));
+  delete [] buffer;
+
+  return k;
+}
+
+
+struct StreamTracer::TraceJob
+{
+  const StreamTracer* tracer;
+  int num, next;
+  const double2* seeds;
+  double2** points;
+  int* lengths;
+  pthread_mutex_t mutex;
+};
+
+
+void* StreamTracer::trace_thread(void* arg)
+{
+  TraceJob* job = (TraceJob*) arg;
+  while (true)
+  {
+    pthread_mutex_lock(&job->mutex);
+    int i = job->next++;
+    pthread_mutex_unlock(&job->mutex);
+    if (i >= job->num) break;
+    job->lengths[i] = job->tracer->create_streamline(job->seeds[i][0], job->seeds[i][1], job->points[i]);
+  }
+  return NULL;
+}
+
+
+void StreamTracer::create_streamlines(int num, const double2* seeds, double2** points, int* lengths) const
+{
+  if (nt <= 0) error("StreamTracer::init() has not been called.");
+
+  TraceJob job;
+  job.tracer = this;
+  job.num = num;
+  job.next = 0;
+  job.seeds = seeds;
+  job.points = points;
+  job.lengths = lengths;
+  pthread_mutex_init(&job.mutex, NULL);
+
+  // the calling thread traces too
+  int nthreads = std::min(num_threads, num) - 1, started = 0, i;
+  std::vector<pthread_t> threads(std::max(nthreads, 0));
+  for (i = 0; i < nthreads; i++, started++)
+    if (pthread_create(&threads[i], NULL, trace_thread, &job) != 0)
+      break;
+  trace_thread(&job);
+  for (i = 0; i < started; i++)
+    pthread_join(threads[i], NULL);
+
+  pthread_mutex_destroy(&job.mutex);
+}
+
+
+///////////////// seeds /////////////////
+
+struct StreamBndEdge
+{
+  int v1, v2;
+  bool visited;
+};
+
+
+struct StreamBndEdgeLess
+{
+  const double4* verts;
+  StreamBndEdgeLess(const double4* verts) : verts(verts) {}
+  // sort edges by their first vertex coordinates, first by x, then by y
+  bool operator()(const StreamBndEdge& e1, const StreamBndEdge& e2) const
+  {
+    double x1 = verts[e1.v1][0], y1 = verts[e1.v1][1];
+    double x2 = verts[e2.v1][0], y2 = verts[e2.v1][1];
+    return x1 < x2 || (x1 == x2 && y1 < y2);
+  }
+};
+
+
+int StreamTracer::find_seeds(int marker, double step, double2*& seeds) const
+{
+  int i, j, k = 0;
+  std::vector<StreamBndEdge> bnd;
+  for (i = 0; i < ne; i++)
+  {
+    if (edges[i][2] == marker)
+    {
+      StreamBndEdge e = { edges[i][0], edges[i][1], false };
+      bnd.push_back(e);
+    }
+  }
+  int num_edges = bnd.size();
+  StreamBndEdgeLess less(verts);
+  std::sort(bnd.begin(), bnd.end(), less);
+
+  std::vector<double> pts;
+  while (true)
+  {
+    // find initial boundary edge (one whose first vertex is not second vertex for any other edge)
+    int idx = -1;
+    for (i = 0; i < num_edges && idx < 0; i++)
+    {
+      if (bnd[i].visited) continue;
+      for (j = 0; j < num_edges; j++)
+        if (verts[bnd[j].v2][0] == verts[bnd[i].v1][0] && verts[bnd[j].v2][1] == verts[bnd[i].v1][1])
+          break;
+      if (j == num_edges) idx = i;
+    }
+    if (idx < 0) break;
+
+    double tmp_step = step;
+    do
+    {
+      bnd[idx].visited = true;
+      double ax = verts[bnd[idx].v1][0]; double bx = verts[bnd[idx].v2][0];
+      double ay = verts[bnd[idx].v1][1]; double by = verts[bnd[idx].v2][1];
+      double len = sqrt(sqr(bx - ax) + sqr(by - ay));
+      double remaining_len = len; double init_x = ax; double init_y = ay;
+      while (tmp_step < remaining_len)
+      {
+        init_x += tmp_step * ((bx - ax) / len);
+        init_y += tmp_step * ((by - ay) / len);
+        pts.push_back(init_x);
+        pts.push_back(init_y);
+        remaining_len = remaining_len - tmp_step;
+        tmp_step = step;
+      }
+      tmp_step = tmp_step - remaining_len;
+
+      // find the edge adjacent to the end vertex
+      StreamBndEdge key = { bnd[idx].v2, 0, false };
+      std::vector<StreamBndEdge>::iterator it = std::lower_bound(bnd.begin(), bnd.end(), key, less);
+      if (it == bnd.end() || less(key, *it) || it->visited) break;
+      idx = it - bnd.begin();
+    }
+    while (true);
+  }
+
+  k = pts.size() / 2;
+  seeds = new double2[k];
+  for (i = 0; i < k; i++) {
+    seeds[i][0] = pts[2*i];
+    seeds[i][1] = pts[2*i + 1];
+  }
+  return k;
+}
@@ -0,0 +1,90 @@
+// This file is part of Hermes2D.
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __H2D_STREAM_TRACER_H
+#define __H2D_STREAM_TRACER_H
+
+#include "../common.h"
+#include "../linear.h"
+
+/// \brief Computes streamlines of a linearized vector field.
+///
+/// StreamTracer takes a copy of the triangles of a Vectorizer and integrates
+/// streamlines by the adaptive Runge-Kutta-Merson method. Points are located
+/// by walking across the neighbors of the last triangle, with a uniform grid
+/// of triangles as a fallback, so a step usually costs a few barycentric tests.
+/// Streamlines are independent and are traced by several threads.
+///
+/// The class does not use OpenGL; it is used by StreamView and can also be used
+/// directly to obtain streamlines as polylines (e.g., to export them).
+///
+class H2D_API StreamTracer
+{
+public:
+
+  StreamTracer(int num_threads = 0); ///< If num_threads is zero, the number of CPUs is used.
+  ~StreamTracer();
+
+  /// Copies the data of a processed Vectorizer and builds the point locator. Assumes lock.
+  void init(const Vectorizer* vec);
+  void free();
+
+  /// Finds the triangle containing the point (x,y). Returns -1 if the point lies outside.
+  /// 'hint' is a triangle near the point (or -1), e.g., the result of the previous call.
+  int find_triangle(double x, double y, double3& bar, int hint = -1) const;
+  /// Interpolates the vector field at the point (x,y). Returns false if the point lies outside.
+  bool get_values(double x, double y, double& xval, double& yval, int& hint) const;
+
+  /// Integrates the streamline starting at (x,y). Returns the number of points
+  /// and the polyline, allocated by new[].
+  int create_streamline(double x, double y, double2*& points) const;
+  /// Integrates num streamlines in parallel.
+  void create_streamlines(int num, const double2* seeds, double2** points, int* lengths) const;
+
+  /// Returns starting points along the boundary with the given marker, "step" apart.
+  /// The array is allocated by new[].
+  int find_seeds(int marker, double step, double2*& seeds) const;
+
+  void set_num_threads(int num_threads);
+  int get_num_triangles() const { return nt; }
+
+protected:
+
+  int num_threads;
+
+  int nv, nt, ne;
+  double4* verts;   ///< (x, y, xvalue, yvalue)
+  int3* tris;
+  int3* adj;        ///< adj[i][k] is the triangle across the edge opposite to vertex k, or -1
+  int3* edges;
+  double max_mag;
+
+  double min_x, max_x, min_y, max_y;
+  double initial_tau, min_tau, max_tau;
+
+  int grid_nx, grid_ny;
+  double grid_hx, grid_hy;
+  int* cell_start;  ///< triangles of cell c are cell_tris[cell_start[c] .. cell_start[c+1]-1]
+  int* cell_tris;
+
+  bool is_in_triangle(int idx, double x, double y, double3& bar) const;
+  void build_adjacency();
+  void build_grid();
+
+  struct TraceJob;
+  static void* trace_thread(void* arg);
+};
+
+#endif
@@ -27,12 +27,10 @@ StreamView::StreamView(const char* title, int x, int y, int width, int height)
 {
   lines = false;
   pmode = false;
+  traced = false;
   num_stream = 0;
-  root_x_min = 1e100;
-  root_y_min = 1e100;
-  root_x_max = -1e100;
-  root_y_max = -1e100;
-  root = NULL;
+  streamlines = NULL;
+  streamlength = NULL;
 }
 
 
@@ -44,345 +42,15 @@ void StreamView::show(MeshFunction* xsln, MeshFunction* ysln, int marker, double
 }
 
 
-// Tests whether given point (x,y) lies in given triangle
-// using barycentric coordinates (returned as side efect)
-bool StreamView::is_in_triangle(int idx, double x, double y, double3& bar)
+void StreamView::free_streamlines()
 {
-  double4* vert = vec.get_vertices();
-  int3* xtris = vec.get_triangles();
-  int3& tri = xtris[idx];
-  double x1 = vert[tri[0]][0], x2 = vert[tri[1]][0], x3 = vert[tri[2]][0];
-  double y1 = vert[tri[0]][1], y2 = vert[tri[1]][1], y3 = vert[tri[2]][1];
-  double jac = ((x1 - x3)*(y2 - y3) - (x2 - x3)*(y1 - y3));
-  double eps = jac * 1e-8;
-  double a = ((y2 - y3) * (x - x3) - (x2 - x3) * (y - y3));
-  double b = ((x1 - x3) * (y - y3) - (y1 - y3) * (x - x3));
-  double c = jac - a - b;
-  bar[0] = a / jac; bar[1] = b / jac; bar[2] = c / jac;
-  if ((a >= - eps && a <= jac + eps) && (b >= - eps && b <= jac + eps) && (c >= - eps && c <= jac + eps))
-    return true;
-  else
-    return false;
-}
-
-
-// Adds triangle to the kD-tree
-// If father Node has more than 100 elements
-// it splits computation domain into 2 parts (vertically or horizontally)
-void StreamView::add_element_to_tree(Node* father, int e_idx, double x_min, double x_max, double y_min, double y_max)
-{
-  double4* vert = vec.get_vertices();
-  int3* xtris = vec.get_triangles();
-  if (father->leaf == true)
-  {
-    father->elements[father->num_elem++] = e_idx;
-    if (father->num_elem >= 100) // too many elements
-    {
-      father->leaf = false;
-      for (int k = 0; k < 2; k++)
-      {
-        father->sons[k] = new Node;
-        father->sons[k]->level = father->level + 1;
-        father->sons[k]->leaf = true;
-        father->sons[k]->num_elem = 0;
-      }
-      for (int i = 0; i < father->num_elem; i++)
-        add_element_to_tree(father, father->elements[i], x_min, x_max, y_min, y_max);
-    }
-  }
-  else
-  {
-    double x_mid = (x_min + x_max)/2;
-    double y_mid = (y_min + y_max)/2;
-    int3& tri = xtris[e_idx];
-    if (father->level % 2) // level = 1, 3, 5,...
-    {
-      if (vert[tri[0]][1] <= y_mid || vert[tri[1]][1] <= y_mid || vert[tri[2]][1] <= y_mid)
-        add_element_to_tree(father->sons[0], e_idx, x_min, x_max, y_min, y_mid);
-      if (vert[tri[0]][1] >= y_mid || vert[tri[1]][1] >= y_mid || vert[tri[2]][1] >= y_mid)
-        add_element_to_tree(father->sons[1], e_idx, x_min, x_max, y_mid, y_max);
-    }
-    else // level 0, 2, 4,...
-    {
-      if (vert[tri[0]][0] <= x_mid || vert[tri[1]][0] <= x_mid || vert[tri[2]][0] <= x_mid)
-        add_element_to_tree(father->sons[0], e_idx, x_min, x_mid, y_min, y_max);
-      if (vert[tri[0]][0] >= x_mid || vert[tri[1]][0] >= x_mid || vert[tri[2]][0] >= x_mid)
-        add_element_to_tree(father->sons[1], e_idx, x_mid, x_max, y_min, y_max);
-    }
-  }
-}
-
-
-// Builds kD-tree
-void StreamView::build_tree()
-{
-  root->leaf = true;
-  root->level = 0;
-  root->num_elem = 0;
-  for (int i = 0; i < vec.get_num_triangles(); i++)
-  {
-    add_element_to_tree(root, i, root_x_min, root_x_max, root_y_min, root_y_max);
-  }
-}
-
-
-// Recurent function that finds linearized triangle which contain point (x,y)
-// As side effect it returns bacycentric coordinates of point (x,y) in that triangle
-int StreamView::find_triangle_in_tree(double x, double y, Node* father, double x_min, double x_max, double y_min, double y_max, double3& bar)
-{
-  if (father->leaf == true)
-  {
-    double4* vert = vec.get_vertices();
-    int3* xtris = vec.get_triangles();
-    for (int idx = 0; idx < father->num_elem; idx++)
-    {
-      int i = father->elements[idx];
-      if (is_in_triangle(i, x, y, bar)) return i;
-    }
-    return -1;
-  }
-  else
-  {
-    double x_mid = (x_max + x_min)/2;
-    double y_mid = (y_max + y_min)/2;
-    if (father->level % 2) // level = 1, 3, 5,...
-      if (y <= y_mid)
-        return find_triangle_in_tree(x, y, father->sons[0], x_min, x_max, y_min, y_mid, bar);
-      else
-        return find_triangle_in_tree(x, y, father->sons[1], x_min, x_max, y_mid, y_max, bar);
-    else // level 0, 2, 4,...
-      if (x <= x_mid)
-        return find_triangle_in_tree(x, y, father->sons[0], x_min, x_mid, y_min, y_max, bar);
-      else
-        return find_triangle_in_tree(x, y, father->sons[1], x_mid, x_max, y_min, y_max, bar);
-  }
-}
-
-
-// Gets values of velocities at given point using built kD-tree
-bool StreamView::get_solution_values(double x, double y, double& xval, double& yval)
-{
-  double4* vert = vec.get_vertices();
-  int3* xtris = vec.get_triangles();
-  double3 bar;
-  int e_idx;
-  if ((e_idx = find_triangle_in_tree(x, y, root, root_x_min, root_x_max, root_y_min, root_y_max, bar)) == -1) return false;
-  int3& tri = xtris[e_idx];
-  xval = bar[0] * vert[tri[0]][2] + bar[1] * vert[tri[1]][2] + bar[2] * vert[tri[2]][2];
-  yval = bar[0] * vert[tri[0]][3] + bar[1] * vert[tri[1]][3] + bar[2] * vert[tri[2]][3];
-  return true;
-}
-
-
-void StreamView::delete_tree(Node* father)
-{
-  if (father->leaf == false)
-  {
-    delete_tree(father->sons[0]);
-    delete_tree(father->sons[1]);
-  }
-  delete [] father;
-}
-
-
-// Starts from initial point (x_start, y_start)
-// and using adaptive RK method finds streamline with "idx"
-int StreamView::create_streamline(double x_start, double y_start, int idx)
-{
-  double ODE_EPS = 1e-5;
-  double tau = initial_tau;
-  double x = x_start;
-  double y = y_start;
-  int k = 0;
-  const int buffer_length = 5000;
-  double2* buffer = new double2[buffer_length];
-  bool tau_ok = false;
-  bool end = false;
-  bool almost_end_of_domain = false;
-
-  double k1, k2, k3, k4, k5;
-  double l1, l2, l3, l4, l5;
-  double x1, x2, x3, x4, x5;
-  double y1, y2, y3, y4, y5;
-
-  while(1)
-  {
-    if (get_solution_values(x, y, k1, l1) == false) // point (x,y) does not lie in the domain
-    {
-      tau = tau/2;  // draw streamline to the end of the domain
-      if (tau < min_tau) break;
-      continue;
-    }
-    if (fabs(k1) / max_mag  < 1e-5 && fabs(l1) / max_mag < 1e-5) break;  // stop streamline when zero solution
-
-    // add new point to steamline
-    buffer[k][0] = x;
-    buffer[k][1] = y;
-    k++;
-    if (k >= buffer_length) break;
-
-    do
-    {
-      if (almost_end_of_domain)  // draw streamline to the end of the domain
-      {
-        almost_end_of_domain = false;
-        tau = tau/2;
-        if (tau < min_tau) { end = true; break; }
-      }
-
-      // Merson's adaptive Runge-Kutta method
-      x1 = x + 1.0/3.0 * tau * k1; y1 = y + 1.0/3.0 * tau * l1;
-      if (get_solution_values(x1, y1, k2, l2) == false) {  almost_end_of_domain = true;  continue;  }
-      x2 = x + 1.0/6.0 * tau * (k1 + k2); y2 = y + 1.0/6.0 * tau * (l1 + l2);
-      if (get_solution_values(x2, y2, k3, l3) == false) {  almost_end_of_domain = true;  continue;  }
-      x3 = x + tau * (0.125 * k1 + 0.375 * k3); y3 = y + tau * (0.125 * l1 + 0.375 * l3);
-      if (get_solution_values(x3, y3, k4, l4) == false) {  almost_end_of_domain = true;  continue;  }
-      x4 = x + tau * (0.5 * k1 - 1.5 * k3 + 2.0 * k4); y4 = y + tau * (0.5 * l1 - 1.5 * l3 + 2.0 * l4);
-      if (get_solution_values(x4, y4, k5, l5) == false) {  almost_end_of_domain = true;  continue;  }
-      x5 = x + tau * 1.0/6.0 * (k1 + 4.0 * k4 + k5); y5 = y + tau * 1.0/6.0 * (l1 + 4.0 * l4 + l5);
-
-      // error according to Merson
-      double x_err = 1.0/5.0 * (x4 - x5) / (root_x_max - root_x_min);
-      double y_err = 1.0/5.0 * (y4 - y5) / (root_y_max - root_y_min);
-      double err = std::max(fabs(x_err),fabs(y_err));
-      if (err < ODE_EPS)
-      {
-        tau_ok = true;  x = x5;  y = y5;
-      }
-      else
-      {
-        tau_ok = false; tau = tau/2;
-        if (tau < min_tau)  tau = min_tau;
-      }
-
-      if (err < ODE_EPS/32)
-      {
-        // new tau according to Merson
-        tau = 0.8 * tau * pow(ODE_EPS/err, 0.2);
-        if (tau > max_tau)  tau = max_tau;
-      }
-    }
-    while (!tau_ok);
-    if (end) break; // get out from both while cycles
-
-  }
-
-  streamlines[idx] = new double2[k];
-  memcpy(streamlines[idx], buffer, k*sizeof(double2));
-  delete [] buffer;
-
-  return k;
-}
-
-
-double4* comp_vert;
-static int compare(const void* p1, const void* p2)
-{
-  const int3* e1 = ((const int3*) p1);
-  const int3* e2 = ((const int3*) p2);
-  double x1 = comp_vert[(*e1)[0]][0];
-  double y1 = comp_vert[(*e1)[0]][1];
-  double x2 = comp_vert[(*e2)[0]][0];
-  double y2 = comp_vert[(*e2)[0]][1];
-  if (x1 < x2) return -1;
-  if (x1 == x2 && y1 < y2) return -1;
-  if (x1 > x2) return 1;
-  if (x1 == x2 && y1 > y2) return 1;
-  if (x1 == x2 && y1 == y2) return 0;
-}
-
-
-// Finds initial boundary edge
-// (one whose first vertex is not second vertex for any other edge)
-int StreamView::find_initial_edge(int num_edges, int3* edges)
-{
-  int i, j;
-  double4* vert = vec.get_vertices();
-  for (i = 0; i < num_edges; i++)
-  {
-    if (edges[i][2] == 0) // not visited yet
-    {
-      for (j = 0; j < num_edges; j++)
-        if (vert[edges[j][1]][0] == vert[edges[i][0]][0] && vert[edges[j][1]][1] == vert[edges[i][0]][1])
-          break;
-      if (j == num_edges) return i;
-    }
-  }
-  return -1;
-}
-
-
-// Finds edge adjacent to vertex "b_idx"
-int find_next_edge(int num_edges, int3* edges, int b_idx)
-{
-  int3 key;
-  key[0] = b_idx;
-  int3* edge = (int3*) bsearch(&key, edges, num_edges, sizeof(int3), compare);
-  if (edge == NULL)
-    return -1; // not found
-  else
-    return edge - edges;
-}
-
-
-// Finds initial points for all steamlines along boundary with given marker
-// with "step" distance between each other
-void StreamView::find_initial_points(int marker, double step, double2*& initial_points)
-{
-  int k = 0;
-  int ne = vec.get_num_edges();
-  int3* edges = vec.get_edges();
-  double4* vert = vec.get_vertices();
-  int3* bnd_edges = new int3[ne];
-  for (int i = 0; i < ne; i++)
-  {
-    if (edges[i][2] == marker)
-    {
-      bnd_edges[k][0] = edges[i][0];
-      bnd_edges[k][1] = edges[i][1];
-      bnd_edges[k++][2] = 0; // not visited
-    }
-  }
-  int num_edges = k;
-
-  // sort edges by their first vertex coordinates
-  // sort first by x, then by y
-  comp_vert = vert;
-  qsort(bnd_edges, num_edges, sizeof(int3), compare);
-
-  // create list of initial points
-  int buffer_length = 1000;
-  initial_points = new double2[buffer_length];
-  k = 0;
-  int idx;
-  while ((idx = find_initial_edge(num_edges, bnd_edges)) != -1)
-  {
-    double tmp_step = step;
-    do
-    {
-      bnd_edges[idx][2] = 1; // visited
-      double ax = vert[bnd_edges[idx][0]][0]; double bx = vert[bnd_edges[idx][1]][0];
-      double ay = vert[bnd_edges[idx][0]][1]; double by = vert[bnd_edges[idx][1]][1];
-      double len = sqrt(sqr(bx - ax) + sqr(by - ay));
-      double remaining_len = len; double init_x = ax; double init_y = ay;
-      while (tmp_step < remaining_len)
-      {
-        initial_points[k][0] = init_x + tmp_step * ((bx - ax) / len);
-        initial_points[k][1] = init_y + tmp_step * ((by - ay) / len);
-        remaining_len = remaining_len - tmp_step;
-        tmp_step = step;
-        init_x = initial_points[k][0];
-        init_y = initial_points[k][1];
-        k++;
-      }
-      tmp_step = tmp_step - remaining_len;
-    }
-    while ((idx = find_next_edge(num_edges, bnd_edges, bnd_edges[idx][1])) != -1);
-
-  }
-  num_stream = k;
-
-  delete [] bnd_edges;
+  for (int i = 0; i < num_stream; i++)
+    delete [] streamlines[i];
+  ::free(streamlines);
+  ::free(streamlength);
+  streamlines = NULL;
+  streamlength = NULL;
+  num_stream = 0;
 }
 
 
@@ -398,33 +66,20 @@ void StreamView::show(MeshFunction* xsln, MeshFunction* ysln, int marker, double
   vec.calc_vertices_aabb(&vertices_min_x, &vertices_max_x, &vertices_min_y, &vertices_max_y);
 
   // create streamlines
-  double4* vert = vec.get_vertices();
-  for (int i = 0; i < vec.get_num_vertices(); i++)
-  {
-    if (vert[i][0] < root_x_min) root_x_min = vert[i][0];
-    if (vert[i][0] > root_x_max) root_x_max = vert[i][0];
-    if (vert[i][1] < root_y_min) root_y_min = vert[i][1];
-    if (vert[i][1] > root_y_max) root_y_max = vert[i][1];
-  }
-
-  initial_tau = std::max(root_x_max - root_x_min, root_y_max - root_y_min) / 100;
-  max_tau = initial_tau * 10;
-  min_tau = initial_tau / 50;
-  max_mag = vec.get_max_value();
-
   TimePeriod cpu_time;
-  root = new Node;
-  build_tree();
-  report_time("Time to build searching tree: %g s", cpu_time.tick().last());
+  tracer.init(&vec);
+  traced = true;
+  report_time("Time to build searching structures: %g s", cpu_time.tick().last());
 
   double2* initial_points;
-  find_initial_points(marker, step, initial_points);
+  int num = tracer.find_seeds(marker, step, initial_points);
   report_time("Time to find initial points: %g s", cpu_time.tick().last());
 
-  streamlines = (double2**) malloc(sizeof(double2*) * (num_stream));
-  streamlength = (int*) malloc(sizeof(int) * (num_stream));
-  for (int i = 0; i < num_stream; i++)
-    streamlength[i] =  create_streamline(initial_points[i][0], initial_points[i][1], i);
+  free_streamlines();
+  streamlines = (double2**) malloc(sizeof(double2*) * num);
+  streamlength = (int*) malloc(sizeof(int) * num);
+  tracer.create_streamlines(num, initial_points, streamlines, streamlength);
+  num_stream = num;
   report_time("Time to create streamlines: %g s", cpu_time.tick().last());
 
   delete [] initial_points;
@@ -441,12 +96,12 @@ void StreamView::show(MeshFunction* xsln, MeshFunction* ysln, int marker, double
 
 void StreamView::add_streamline(double x, double y)
 {
-  if (root == NULL)
+  if (!traced)
     error("Function add_streamline must be called after StreamView::show().");
   TimePeriod cpu_time;
   streamlines = (double2**) realloc(streamlines, sizeof(double2*) * (num_stream + 1));
   streamlength = (int*) realloc(streamlength, sizeof(int) * (num_stream + 1));
-  streamlength[num_stream] = create_streamline(x, y, num_stream);
+  streamlength[num_stream] = tracer.create_streamline(x, y, streamlines[num_stream]);
   num_stream++;
   refresh();
   report_time("Time to create streamline: %g s", cpu_time.tick().last());
@@ -594,12 +249,12 @@ void StreamView::on_left_mouse_down(int x, int y)
   View::on_left_mouse_down(x, y);
 
   // adding streamline (initial point set at (x,y))
-  if (!scale_focused && glutGetModifiers() == GLUT_ACTIVE_CTRL)
+  if (traced && !scale_focused && glutGetModifiers() == GLUT_ACTIVE_CTRL)
   {
     TimePeriod cpu_time;
     streamlines = (double2**) realloc(streamlines, sizeof(double2*) * (num_stream + 1));
     streamlength = (int*) realloc(streamlength, sizeof(int) * (num_stream + 1));
-    streamlength[num_stream] = create_streamline(untransform_x(x), untransform_y(y), num_stream);
+    streamlength[num_stream] = tracer.create_streamline(untransform_x(x), untransform_y(y), streamlines[num_stream]);
     num_stream++;
     refresh();
     report_time("Time to create streamline: %g s", cpu_time.tick().last());
@@ -629,11 +284,7 @@ const char* StreamView::get_help_text() const
 
 StreamView::~StreamView()
 {
-  delete_tree(root);
-  for (int i = 0; i < num_stream; i++)
-    delete [] streamlines[i];
-  delete [] streamlines;
-  delete [] streamlength;
+  free_streamlines();
 }
 
 
@@ -23,6 +23,7 @@
 #define __H2D_STREAM_VIEW_H
 
 #include "view.h"
+#include "stream_tracer.h"
 
 // you can define NOGLUT to turn off all OpenGL stuff in Hermes2D
 #ifndef NOGLUT
@@ -49,42 +50,16 @@ public:
 
 protected:
 
-  struct Node
-  {
-    bool leaf;
-    int level;
-    Node* sons[2];
-    int elements[100];
-    int num_elem;
-  };
-
   Vectorizer vec;
-  double max_mag;
+  StreamTracer tracer; ///< Point location and integration of streamlines.
+  bool traced;
   bool lines, pmode;
 
-  double initial_tau;
-  double min_tau;
-  double max_tau;
   int num_stream;
   double2** streamlines;
   int* streamlength;
-  Node* root;
-  double root_x_min;
-  double root_x_max;
-  double root_y_min;
-  double root_y_max;
-
-  int find_triangle_in_tree(double x, double y, Node* father, double x_min, double x_max, double y_min, double y_max, double3& bar);
-  void add_element_to_tree(Node* father, int e_idx, double x_min, double x_max, double y_min, double y_max);
-  void build_tree();
-  void delete_tree(Node* father);
-
-  bool is_in_triangle(int idx, double x, double y, double3& bar);
-  bool get_solution_values(double x, double y, double& xval, double& yval);
-
-  int create_streamline(double x_start, double y_start, int idx);
-  void find_initial_points(int marker, double step, double2*& initial_points);
-  int find_initial_edge(int num_edges, int3* edges);
+
+  void free_streamlines();
 
   virtual void on_display();
   virtual void on_mouse_move(int x, int y);
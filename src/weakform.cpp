@@ -19,6 +19,7 @@
 #include "matrix_old.h"
 #include "solution.h"
 #include "forms.h"
+#include "weakform_parser.h"
 
 //// interface /////////////////////////////////////////////////////////////////////////////////////
 
@@ -29,7 +30,16 @@ WeakForm::WeakForm(int neq, bool mat_free)
   this->is_matfree = mat_free;
 }
 
-void WeakForm::add_matrix_form(int i, int j, jacform_val_t fn, jacform_ord_t ord, SymFlag sym, int area, Tuple<MeshFunction*>ext)
+WeakForm::~WeakForm()
+{
+  for (unsigned i = 0; i < jfvol.size(); i++)  delete jfvol[i].prog;
+  for (unsigned i = 0; i < jfsurf.size(); i++) delete jfsurf[i].prog;
+  for (unsigned i = 0; i < rfvol.size(); i++)  delete rfvol[i].prog;
+  for (unsigned i = 0; i < rfsurf.size(); i++) delete rfsurf[i].prog;
+}
+
+void WeakForm::add_matrix_form(int i, int j, jacform_val_t fn, jacform_ord_t ord, SymFlag sym, int area, Tuple<MeshFunction*>ext,
+                               int group)
 {
   if (i < 0 || i >= neq || j < 0 || j >= neq)
     error("Invalid equation number.");
@@ -41,8 +51,10 @@ void WeakForm::add_matrix_form(int i, int j, jacform_val_t fn, jacform_ord_t ord
     error("Invalid area number.");
   if (jfvol.size() > 100)
     warn("Large number of forms (> 100). Is this the intent?");
+  if (group < -1)
+    error("Invalid group number.");
 
-  JacFormVol form = { i, j, sym, area, fn, ord };
+  JacFormVol form = { i, j, sym, area, fn, ord, NULL, 0, group };
   if (ext.size() != 0) {
     int nx = ext.size(); 
     for (int i = 0; i < nx; i++) form.ext.push_back(ext[i]);
@@ -52,7 +64,8 @@ void WeakForm::add_matrix_form(int i, int j, jacform_val_t fn, jacform_ord_t ord
 }
 
 // single equation case
-void WeakForm::add_matrix_form(jacform_val_t fn, jacform_ord_t ord, SymFlag sym, int area, Tuple<MeshFunction*>ext)
+void WeakForm::add_matrix_form(jacform_val_t fn, jacform_ord_t ord, SymFlag sym, int area, Tuple<MeshFunction*>ext,
+                               int group)
 {
   int i = 0, j = 0;
 
@@ -65,8 +78,10 @@ void WeakForm::add_matrix_form(jacform_val_t fn, jacform_ord_t ord, SymFlag sym,
     error("Invalid area number.");
   if (jfvol.size() > 100)
     warn("Large number of forms (> 100). Is this the intent?");
+  if (group < -1)
+    error("Invalid group number.");
 
-  JacFormVol form = { i, j, sym, area, fn, ord };
+  JacFormVol form = { i, j, sym, area, fn, ord, NULL, 0, group };
   if (ext.size() != 0) {
     int nx = ext.size(); 
     for (int i = 0; i < nx; i++) form.ext.push_back(ext[i]);
@@ -75,14 +90,17 @@ void WeakForm::add_matrix_form(jacform_val_t fn, jacform_ord_t ord, SymFlag sym,
   seq++;
 }
 
-void WeakForm::add_matrix_form_surf(int i, int j, jacform_val_t fn, jacform_ord_t ord, int area, Tuple<MeshFunction*>ext)
+void WeakForm::add_matrix_form_surf(int i, int j, jacform_val_t fn, jacform_ord_t ord, int area, Tuple<MeshFunction*>ext,
+                                    int group)
 {
   if (i < 0 || i >= neq || j < 0 || j >= neq)
     error("Invalid equation number.");
   if (area != H2D_ANY && area < 0 && -area > areas.size())
     error("Invalid area number.");
+  if (group < -1)
+    error("Invalid group number.");
 
-  JacFormSurf form = { i, j, area, fn, ord };
+  JacFormSurf form = { i, j, area, fn, ord, NULL, group };
   if (ext.size() != 0) {
     int nx = ext.size(); 
     for (int i = 0; i < nx; i++) form.ext.push_back(ext[i]);
@@ -92,15 +110,18 @@ void WeakForm::add_matrix_form_surf(int i, int j, jacform_val_t fn, jacform_ord_
 }
 
 // single equation case
-void WeakForm::add_matrix_form_surf(jacform_val_t fn, jacform_ord_t ord, int area, Tuple<MeshFunction*>ext)
+void WeakForm::add_matrix_form_surf(jacform_val_t fn, jacform_ord_t ord, int area, Tuple<MeshFunction*>ext,
+                                    int group)
 {
   int i = 0, j = 0;
 
   // FIXME: the code below should be replaced with a call to the full function. 
   if (area != H2D_ANY && area < 0 && -area > areas.size())
     error("Invalid area number.");
+  if (group < -1)
+    error("Invalid group number.");
 
-  JacFormSurf form = { i, j, area, fn, ord };
+  JacFormSurf form = { i, j, area, fn, ord, NULL, group };
   if (ext.size() != 0) {
     int nx = ext.size(); 
     for (int i = 0; i < nx; i++) form.ext.push_back(ext[i]);
@@ -116,7 +137,7 @@ void WeakForm::add_vector_form(int i, resform_val_t fn, resform_ord_t ord, int a
   if (area != H2D_ANY && area < 0 && -area > areas.size())
     error("Invalid area number.");
 
-  ResFormVol form = { i, area, fn, ord };
+  ResFormVol form = { i, area, fn, ord, NULL, 0 };
   if (ext.size() != 0) {
     int nx = ext.size(); 
     for (int i = 0; i < nx; i++) form.ext.push_back(ext[i]);
@@ -134,7 +155,7 @@ void WeakForm::add_vector_form(resform_val_t fn, resform_ord_t ord, int area, Tu
   if (area != H2D_ANY && area < 0 && -area > areas.size())
     error("Invalid area number.");
 
-  ResFormVol form = { i, area, fn, ord };
+  ResFormVol form = { i, area, fn, ord, NULL, 0 };
   if (ext.size() != 0) {
     int nx = ext.size(); 
     for (int i = 0; i < nx; i++) form.ext.push_back(ext[i]);
@@ -150,7 +171,7 @@ void WeakForm::add_vector_form_surf(int i, resform_val_t fn, resform_ord_t ord,
   if (area != H2D_ANY && area < 0 && -area > areas.size())
     error("Invalid area number.");
 
-  ResFormSurf form = { i, area, fn, ord };
+  ResFormSurf form = { i, area, fn, ord, NULL };
   if (ext.size() != 0) {
     int nx = ext.size(); 
     for (int i = 0; i < nx; i++) form.ext.push_back(ext[i]);
@@ -168,7 +189,7 @@ void WeakForm::add_vector_form_surf(resform_val_t fn, resform_ord_t ord, int are
   if (area != H2D_ANY && area < 0 && -area > areas.size())
     error("Invalid area number.");
 
-  ResFormSurf form = { i, area, fn, ord };
+  ResFormSurf form = { i, area, fn, ord, NULL };
   if (ext.size() != 0) {
     int nx = ext.size(); 
     for (int i = 0; i < nx; i++) form.ext.push_back(ext[i]);
@@ -177,6 +198,101 @@ void WeakForm::add_vector_form_surf(resform_val_t fn, resform_ord_t ord, int are
   seq++;
 }
 
+void WeakForm::add_matrix_form(int i, int j, const char* text, SymFlag sym, int area, int group)
+{
+  FormProgram* prog = new FormProgram(text, 2, constants);
+  if (prog->is_surf())
+  {
+    add_matrix_form_surf(i, j, (jacform_val_t) NULL, (jacform_ord_t) NULL, area, Tuple<MeshFunction*>(), group);
+    jfsurf.back().prog = prog;
+  }
+  else
+  {
+    add_matrix_form(i, j, (jacform_val_t) NULL, (jacform_ord_t) NULL, sym, area, Tuple<MeshFunction*>(), group);
+    jfvol.back().prog = prog;
+  }
+}
+
+// single equation case
+void WeakForm::add_matrix_form(const char* text, SymFlag sym, int area, int group)
+{
+  add_matrix_form(0, 0, text, sym, area, group);
+}
+
+void WeakForm::add_vector_form(int i, const char* text, int area)
+{
+  FormProgram* prog = new FormProgram(text, 1, constants);
+  if (prog->is_surf())
+  {
+    add_vector_form_surf(i, (resform_val_t) NULL, (resform_ord_t) NULL, area);
+    rfsurf.back().prog = prog;
+  }
+  else
+  {
+    add_vector_form(i, (resform_val_t) NULL, (resform_ord_t) NULL, area);
+    rfvol.back().prog = prog;
+  }
+}
+
+// single equation case
+void WeakForm::add_vector_form(const char* text, int area)
+{
+  add_vector_form(0, text, area);
+}
+
+void WeakForm::set_constant(const char* name, double value)
+{
+  constants[name] = value;
+}
+
+void WeakForm::set_group_coef(int group, scalar coef)
+{
+  if (group < 0) error("Invalid group number.");
+  if (group >= (int) group_coef.size()) group_coef.resize(group + 1, 1.0);
+  group_coef[group] = coef;
+}
+
+int WeakForm::get_num_groups() const
+{
+  int n = 0;
+  for (unsigned i = 0; i < jfvol.size(); i++)  n = std::max(n, jfvol[i].group + 1);
+  for (unsigned i = 0; i < jfsurf.size(); i++) n = std::max(n, jfsurf[i].group + 1);
+  return n;
+}
+
+void WeakForm::save_order_offsets(const char* filename)
+{
+  FILE* f = fopen(filename, "w");
+  if (f == NULL) error("Could not create %s.", filename);
+  fprintf(f, "# integration order offsets: matrix|vector, form index, offset\n");
+  for (unsigned i = 0; i < jfvol.size(); i++)
+    fprintf(f, "matrix %d %d\n", i, jfvol[i].ord_offset);
+  for (unsigned i = 0; i < rfvol.size(); i++)
+    fprintf(f, "vector %d %d\n", i, rfvol[i].ord_offset);
+  fclose(f);
+}
+
+void WeakForm::load_order_offsets(const char* filename)
+{
+  FILE* f = fopen(filename, "r");
+  if (f == NULL) error("Could not open %s.", filename);
+
+  char line[256], type[16];
+  int idx, offset;
+  while (fgets(line, sizeof(line), f) != NULL)
+  {
+    if (line[0] == '#') continue;
+    if (sscanf(line, "%15s %d %d", type, &idx, &offset) != 3) continue;
+    if (!strcmp(type, "matrix") && idx >= 0 && idx < (int) jfvol.size())
+      jfvol[idx].ord_offset = offset;
+    else if (!strcmp(type, "vector") && idx >= 0 && idx < (int) rfvol.size())
+      rfvol[idx].ord_offset = offset;
+    else
+      warn("%s: no %s form number %d, the offset is ignored.", filename, type, idx);
+  }
+  fclose(f);
+}
+
 void WeakForm::set_ext_fns(void* fn, Tuple<MeshFunction*>ext)
 {
   error("Not implemented yet.");
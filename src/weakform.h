@@ -26,6 +26,7 @@ class Space;
 class MeshFunction;
 struct EdgePos;
 class Ord;
+class FormProgram;
 
 struct Element;
 class Shapeset;
@@ -57,6 +58,7 @@ class H2D_API WeakForm
 public:
 
   WeakForm(int neq = 1, bool mat_free = false);
+  ~WeakForm();
 
   // general case
   typedef scalar (*jacform_val_t)(int n, double *wt, Func<scalar> *u[], Func<double> *vi, Func<double> *vj, Geom<double> *e, ExtData<scalar> *);
@@ -64,15 +66,22 @@ public:
   typedef scalar (*resform_val_t)(int n, double *wt, Func<scalar> *u[], Func<double> *vi, Geom<double> *e, ExtData<scalar> *);
   typedef Ord (*resform_ord_t)(int n, double *wt, Func<Ord> *u[], Func<Ord> *vi, Geom<Ord> *e, ExtData<Ord> *);
 
-  // general case
+  /// Matrix forms with 'group' >= 0 are time-invariant: LinSystem assembles each group
+  /// only once (until the spaces or the weak form change) into a separate sparse block and
+  /// in every assembly adds the blocks multiplied by the group coefficients, see
+  /// set_group_coef(). E.g., for the implicit Euler method, the mass form can be put in
+  /// group 0 with the coefficient 1/tau and the stiffness form in group 1; changing the time
+  /// step then does not require any numerical integration of these forms.
   void add_matrix_form(int i, int j, jacform_val_t fn, jacform_ord_t ord, 
-		   SymFlag sym = H2D_UNSYM, int area = H2D_ANY, Tuple<MeshFunction*>ext = Tuple<MeshFunction*>());
+		   SymFlag sym = H2D_UNSYM, int area = H2D_ANY, Tuple<MeshFunction*>ext = Tuple<MeshFunction*>(),
+		   int group = -1);
   void add_matrix_form(jacform_val_t fn, jacform_ord_t ord, 
-		   SymFlag sym = H2D_UNSYM, int area = H2D_ANY, Tuple<MeshFunction*>ext = Tuple<MeshFunction*>()); // single equation case
+		   SymFlag sym = H2D_UNSYM, int area = H2D_ANY, Tuple<MeshFunction*>ext = Tuple<MeshFunction*>(),
+		   int group = -1); // single equation case
   void add_matrix_form_surf(int i, int j, jacform_val_t fn, jacform_ord_t ord, 
-			int area = H2D_ANY, Tuple<MeshFunction*>ext = Tuple<MeshFunction*>());
+			int area = H2D_ANY, Tuple<MeshFunction*>ext = Tuple<MeshFunction*>(), int group = -1);
   void add_matrix_form_surf(jacform_val_t fn, jacform_ord_t ord, 
-			int area = H2D_ANY, Tuple<MeshFunction*>ext = Tuple<MeshFunction*>()); // single equation case
+			int area = H2D_ANY, Tuple<MeshFunction*>ext = Tuple<MeshFunction*>(), int group = -1); // single equation case
   void add_vector_form(int i, resform_val_t fn, resform_ord_t ord, 
 		   int area = H2D_ANY, Tuple<MeshFunction*>ext = Tuple<MeshFunction*>());
   void add_vector_form(resform_val_t fn, resform_ord_t ord, 
@@ -82,6 +91,34 @@ public:
   void add_vector_form_surf(resform_val_t fn, resform_ord_t ord, 
 			int area = H2D_ANY, Tuple<MeshFunction*>ext = Tuple<MeshFunction*>()); // single equation case
 
+  /// Forms given as text, e.g. "vol u,v: ux*vx + uy*vy" or "surf v: k*x*v", see FormProgram.
+  /// The text is compiled to bytecode and the integration order is derived from it. A text
+  /// beginning with "surf" adds a surface form, otherwise a volume form is added.
+  void add_matrix_form(int i, int j, const char* text, SymFlag sym = H2D_UNSYM, int area = H2D_ANY, int group = -1);
+  void add_matrix_form(const char* text, SymFlag sym = H2D_UNSYM, int area = H2D_ANY, int group = -1); // single equation case
+  void add_vector_form(int i, const char* text, int area = H2D_ANY);
+  void add_vector_form(const char* text, int area = H2D_ANY); // single equation case
+
+  /// Defines or changes a named constant for the forms given as text. A constant must be
+  /// defined before it is used in a form; changing its value later affects the next assembly.
+  void set_constant(const char* name, double value);
+
+  /// Sets the coefficient of a group of time-invariant matrix forms (1 by default).
+  /// The new value is used in the next LinSystem::assemble(); the RHS-only assembly
+  /// does not update the matrix.
+  void set_group_coef(int group, scalar coef);
+  scalar get_group_coef(int group) const
+    { return (group >= 0 && group < (int) group_coef.size()) ? group_coef[group] : 1.0; }
+
+  /// Returns the number of groups of time-invariant matrix forms (the highest group + 1).
+  int get_num_groups() const;
+
+  /// Saves and loads the integration order offsets of the volume forms found by
+  /// LinSystem::calibrate_orders(), so that a calibration can be reused in other runs.
+  /// The forms are identified by the order in which they were added.
+  void save_order_offsets(const char* filename);
+  void load_order_offsets(const char* filename);
+
   void set_ext_fns(void* fn, Tuple<MeshFunction*>ext = Tuple<MeshFunction*>());
 
   /// Returns the number of equations
@@ -101,6 +138,9 @@ protected:
 
   struct Area  {  /*std::string name;*/  std::vector<int> markers;  };
 
+  std::map<std::string, double> constants;
+  std::vector<scalar> group_coef;
+
   H2D_API_USED_STL_VECTOR(Area);
   std::vector<Area> areas;
   H2D_API_USED_STL_VECTOR(MeshFunction*);
@@ -109,11 +149,13 @@ protected:
     scalar evaluate_fn(int point_cnt, double *weights, Func<double> *values_v, Geom<double> *geometry, ExtData<scalar> *values_ext_fnc, Element* element, Shapeset* shape_set, int shape_inx); ///< Evaluate value of the user defined function.
     Ord evaluate_ord(int point_cnt, double *weights, Func<Ord> *values_v, Geom<Ord> *geometry, ExtData<Ord> *values_ext_fnc, Element* element, Shapeset* shape_set, int shape_inx); ///< Evaluate order of the user defined function.
 
-  // general case
-  struct JacFormVol  {  int i, j, sym, area;  jacform_val_t fn;  jacform_ord_t ord;  std::vector<MeshFunction *> ext; };
-  struct JacFormSurf {  int i, j, area;       jacform_val_t fn;  jacform_ord_t ord;  std::vector<MeshFunction *> ext; };
-  struct ResFormVol  {  int i, area;          resform_val_t fn;  resform_ord_t ord;  std::vector<MeshFunction *> ext; };
-  struct ResFormSurf {  int i, area;          resform_val_t fn;  resform_ord_t ord;  std::vector<MeshFunction *> ext; };
+  // general case; 'prog' is used instead of 'fn' and 'ord' for forms given as text
+  // 'ord_offset' is added to the integration order of volume forms, see LinSystem::calibrate_orders()
+  // 'group' is the group of a time-invariant matrix form or -1, see add_matrix_form()
+  struct JacFormVol  {  int i, j, sym, area;  jacform_val_t fn;  jacform_ord_t ord;  FormProgram* prog;  int ord_offset;  int group;  std::vector<MeshFunction *> ext; };
+  struct JacFormSurf {  int i, j, area;       jacform_val_t fn;  jacform_ord_t ord;  FormProgram* prog;  int group;  std::vector<MeshFunction *> ext; };
+  struct ResFormVol  {  int i, area;          resform_val_t fn;  resform_ord_t ord;  FormProgram* prog;  int ord_offset;  std::vector<MeshFunction *> ext; };
+  struct ResFormSurf {  int i, area;          resform_val_t fn;  resform_ord_t ord;  FormProgram* prog;  std::vector<MeshFunction *> ext; };
 
   // general case
   std::vector<JacFormVol>  jfvol;
@@ -157,6 +199,10 @@ protected:
 
 private:
 
+  // not copyable: the destructor deletes the programs of the forms given as text
+  WeakForm(const WeakForm&);
+  WeakForm& operator=(const WeakForm&);
+
   Stage* find_stage(std::vector<Stage>& stages, int ii, int jj,
                     Mesh* m1, Mesh* m2, std::vector<MeshFunction*>& ext);
 
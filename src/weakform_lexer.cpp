@@ -0,0 +1,87 @@
+// This file is part of Hermes2D.
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+// $Id$
+
+#include "common.h"
+#include "weakform_lexer.h"
+
+
+static WFType simple_token(char c)
+{
+  switch (c)
+  {
+    case ',': return T_COMMA;
+    case ':': return T_COLON;
+    case '+': return T_PLUS;
+    case '-': return T_MINUS;
+    case '*': return T_STAR;
+    case '/': return T_SLASH;
+    case '(': return T_BRA;
+    case ')': return T_KET;
+    case '^': return T_POWER;
+    default:  return T_ERROR;
+  }
+}
+
+
+void wf_tokenize(const char* input, std::vector<WFToken>& tokens)
+{
+  tokens.clear();
+  const char* s = input;
+  while (true)
+  {
+    while (isspace(*s)) s++;
+
+    WFToken t;
+    t.type = T_ERROR;
+    t.value = 0.0;
+    t.pos = s - input;
+
+    if (!*s)
+    {
+      t.type = T_EOF;
+      t.lexeme = "end of input";
+      tokens.push_back(t);
+      return;
+    }
+
+    const char* begin = s;
+    if (isalpha(*s) || *s == '_')
+    {
+      while (isalnum(*s) || *s == '_') s++;
+      t.lexeme.assign(begin, s - begin);
+      if (t.lexeme == "vol") t.type = T_VOL;
+      else if (t.lexeme == "surf") t.type = T_SURF;
+      else t.type = T_IDENT;
+    }
+    else if (isdigit(*s) || (*s == '.' && isdigit(s[1])))
+    {
+      char* end;
+      t.value = strtod(s, &end);
+      s = end;
+      t.lexeme.assign(begin, s - begin);
+      t.type = T_NUMBER;
+    }
+    else
+    {
+      t.type = simple_token(*s++);
+      t.lexeme.assign(begin, 1);
+      if (t.type == T_ERROR)
+        error("Weak form \"%s\": unexpected character '%c' at position %d.", input, *begin, t.pos + 1);
+    }
+    tokens.push_back(t);
+  }
+}
@@ -18,30 +18,32 @@
 #ifndef __H2D_WEAKFORM_LEXER_H
 #define __H2D_WEAKFORM_LEXER_H
 
+#include <string>
+#include <vector>
+
 
 enum WFType
 {
   T_ERROR, T_EOF,
   T_IDENT, T_NUMBER,
   T_VOL, T_SURF, T_COMMA, T_COLON,
-  T_X, T_Y, T_XX, T_YY, T_XY,
   T_PLUS, T_MINUS, T_STAR, T_SLASH, T_BRA, T_KET,
-  T_POWER, T_UNDER, T_IMAG
+  T_POWER
 };
 
 
 struct WFToken
 {
   WFType type;
-  double value;
-  char*  lexeme;
-  Token* next;
+  double value;        // T_NUMBER only
+  std::string lexeme;
+  int pos;             // position in the input, for error messages
 };
 
 
-void   wf_lexer_init(const char* input);
-Token* wf_get_token();
-void   wf_lexer_free();
+/// Splits the text of a weak form into tokens. The list is always terminated by a T_EOF
+/// token. Identifiers are [A-Za-z_][A-Za-z0-9_]*, "vol" and "surf" are keywords.
+void wf_tokenize(const char* input, std::vector<WFToken>& tokens);
 
 
 #endif
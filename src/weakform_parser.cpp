@@ -16,130 +16,489 @@
 // $Id$
 
 #include "common.h"
-#include "weakform.h"
 #include "weakform_lexer.h"
-//#include "weakform_parser.h"
+#include "weakform_parser.h"
 
 /*
 
-  form    := type [ident "," ident ":"] expr
+  form    := [type] [ident ["," ident] ":"] expr
   type    := "vol" | "surf"
-  expr    := term | term "+" expr | term "-" expr
-  term    := power | power "*" term | power "/" term
-  power   := factor | factor "^" expon
-  expon   := number | "(" expr ")"
-  factor  := number | ident | ident_partial | spvar | "(" expr ")"
-  partial := "x" | "y" | "xx" | "yy" | "xy"
+  expr    := term | expr "+" term | expr "-" term
+  term    := unary | term "*" unary | term "/" unary
+  unary   := power | "-" unary | "+" unary
+  power   := factor | factor "^" unary
+  factor  := number | ident | ident partial | spvar | geom | const
+           | func "(" expr ")" | "(" expr ")"
+  partial := "x" | "y" | "_x" | "_y"
   spvar   := "x" | "y"
+  geom    := "nx" | "ny" | "tx" | "ty"
+  func    := "sqrt" | "exp" | "log" | "sin" | "cos" | "abs"
 
 */
 
 
-static Token * token;
+// Recursive descent parser building an expression tree, and a compiler of the tree to
+// the register bytecode of FormProgram. Registers are allocated as a stack: the value
+// of a subtree compiled into register r may use the registers r, r+1, ... as temporaries.
+class FormCompiler
+{
+public:
 
+  FormCompiler(FormProgram* prog, const char* text, int nfns, const std::map<std::string, double>& constants)
+    : prog(prog), text(text), nfns(nfns), constants(constants)
+  {
+    wf_tokenize(text, tokens);
+    pos = 0;
+    uname = "u";
+    vname = "v";
+  }
 
-static void next_token(void)
-{
-  token = wf_get_token();
-}
+  void compile()
+  {
+    prog->surf = false;
+    if (token().type == T_VOL || token().type == T_SURF)
+    {
+      prog->surf = (token().type == T_SURF);
+      pos++;
+    }
 
+    // optional names of the functions
+    if (look(0) == T_IDENT && look(1) == T_COMMA && look(2) == T_IDENT && look(3) == T_COLON)
+    {
+      if (nfns != 2) parse_error("a linear form has only the test function");
+      uname = tokens[pos].lexeme;
+      vname = tokens[pos + 2].lexeme;
+      if (uname == vname) parse_error("the basis and test functions must have different names");
+      pos += 4;
+    }
+    else if (look(0) == T_IDENT && look(1) == T_COLON)
+    {
+      if (nfns != 1) parse_error("a bilinear form needs the names of both the basis and test functions");
+      vname = tokens[pos].lexeme;
+      pos += 2;
+    }
 
-static volatile void error(char* message)
-{
-  printf("error: '%s' -- %s\n", token->lexeme, message);
-  exit(1);
-}
+    int root = expr();
+    if (token().type != T_EOF) parse_error("operator expected");
 
+    prog->code.clear();
+    prog->nreg = 1;
+    emit(root, 0);
+  }
 
-static void check_for(int type, char* message)
-{
-  if (token->type != type) error(message);
-  next_token();
-}
+protected:
 
+  struct Node
+  {
+    int op;
+    double c;
+    const double* p;
+    int l, r;
+  };
 
-static Node* make_tree(Token* token, Node* left, Node* right, Node* cond)
-{
-  Node* n = (Node*) malloc(sizeof(Node));
-  if (n == NULL) exit(1);
-  n->token = token;
-  n->left = left;
-  n->right = right;
-  n->cond = cond;
-  return n;
-}
+  FormProgram* prog;
+  const char* text;
+  int nfns;
+  const std::map<std::string, double>& constants;
 
+  std::vector<WFToken> tokens;
+  int pos;
+  std::string uname, vname;
+  std::vector<Node> nodes;
 
-NODE* factor(void)
-{
-  TOKEN* t = token;
-  if (t->type != T_IDENT && t->type != T_INTEGER && t->type != T_STRING)
-    error("expecting identifier, integer or string");
-  next_token();
-  return make_tree(t, NULL, NULL, NULL);
-}
+  const WFToken& token() const { return tokens[pos]; }
 
+  WFType look(int k) const
+  {
+    return (pos + k < (int) tokens.size()) ? tokens[pos + k].type : T_EOF;
+  }
 
-NODE* term(void)
-{
-  TOKEN* t;
-  NODE *l, *r;
-  l = factor();
-  if (token->type == T_STAR || token->type == T_SLASH) {
-    t = token;
-    next_token();
-    r = factor();
-    return make_tree(t, l, r, NULL);
-  }
-  return l;
-}
+  void parse_error(const char* message)
+  {
+    error("Weak form \"%s\": %s at position %d ('%s').", text, message, token().pos + 1, token().lexeme.c_str());
+  }
 
+  void check_for(WFType type, const char* message)
+  {
+    if (token().type != type) parse_error(message);
+    pos++;
+  }
 
-NODE* expression(void)
-{
-  TOKEN* t;
-  NODE *l, *r;
-  l = term();
-  if (token->type == T_PLUS || token->type == T_MINUS) {
-    t = token;
-    next_token();
-    r = term();
-    return make_tree(t, l, r, NULL);
-  }
-  return l;
-}
+  //// tree construction, with folding of constant subexpressions ////
+
+  int make_node(int op, int l = -1, int r = -1, double c = 0.0, const double* p = NULL)
+  {
+    Node n = { op, c, p, l, r };
+    nodes.push_back(n);
+    return nodes.size() - 1;
+  }
+
+  bool is_const(int n) const { return nodes[n].op == FormProgram::OP_CONST; }
+
+  int make_unary(int op, int l)
+  {
+    if (is_const(l))
+    {
+      double a = nodes[l].c;
+      switch (op)
+      {
+        case FormProgram::OP_NEG:  a = -a; break;
+        case FormProgram::OP_SQRT: a = sqrt(a); break;
+        case FormProgram::OP_EXP:  a = exp(a); break;
+        case FormProgram::OP_LOG:  a = log(a); break;
+        case FormProgram::OP_SIN:  a = sin(a); break;
+        case FormProgram::OP_COS:  a = cos(a); break;
+        case FormProgram::OP_ABS:  a = fabs(a); break;
+      }
+      return make_node(FormProgram::OP_CONST, -1, -1, a);
+    }
+    return make_node(op, l);
+  }
+
+  int make_binary(int op, int l, int r)
+  {
+    if (is_const(l) && is_const(r))
+    {
+      double a = nodes[l].c, b = nodes[r].c;
+      switch (op)
+      {
+        case FormProgram::OP_ADD: a += b; break;
+        case FormProgram::OP_SUB: a -= b; break;
+        case FormProgram::OP_MUL: a *= b; break;
+        case FormProgram::OP_DIV: a /= b; break;
+        case FormProgram::OP_POW: a = pow(a, b); break;
+      }
+      return make_node(FormProgram::OP_CONST, -1, -1, a);
+    }
+    return make_node(op, l, r);
+  }
+
+  //// parser ////
+
+  int expr()
+  {
+    int n = term();
+    while (token().type == T_PLUS || token().type == T_MINUS)
+    {
+      int op = (token().type == T_PLUS) ? FormProgram::OP_ADD : FormProgram::OP_SUB;
+      pos++;
+      n = make_binary(op, n, term());
+    }
+    return n;
+  }
+
+  int term()
+  {
+    int n = unary();
+    while (token().type == T_STAR || token().type == T_SLASH)
+    {
+      int op = (token().type == T_STAR) ? FormProgram::OP_MUL : FormProgram::OP_DIV;
+      pos++;
+      n = make_binary(op, n, unary());
+    }
+    return n;
+  }
+
+  int unary()
+  {
+    if (token().type == T_MINUS) { pos++; return make_unary(FormProgram::OP_NEG, unary()); }
+    if (token().type == T_PLUS)  { pos++; return unary(); }
+    return power();
+  }
 
+  int power()
+  {
+    int n = factor();
+    if (token().type == T_POWER)
+    {
+      pos++;
+      n = make_binary(FormProgram::OP_POW, n, unary());
+    }
+    return n;
+  }
+
+  int factor()
+  {
+    const WFToken& t = token();
+    if (t.type == T_NUMBER)
+    {
+      pos++;
+      return make_node(FormProgram::OP_CONST, -1, -1, t.value);
+    }
+    if (t.type == T_BRA)
+    {
+      pos++;
+      int n = expr();
+      check_for(T_KET, "')' expected");
+      return n;
+    }
+    if (t.type == T_IDENT)
+    {
+      if (look(1) == T_BRA)
+      {
+        int op = function(t.lexeme);
+        pos += 2;
+        int n = expr();
+        check_for(T_KET, "')' expected");
+        return make_unary(op, n);
+      }
+      int n = identifier(t.lexeme);
+      pos++;
+      return n;
+    }
+    parse_error("number, identifier or '(' expected");
+    return -1;
+  }
+
+  int function(const std::string& name)
+  {
+    if (name == "sqrt") return FormProgram::OP_SQRT;
+    if (name == "exp")  return FormProgram::OP_EXP;
+    if (name == "log")  return FormProgram::OP_LOG;
+    if (name == "sin")  return FormProgram::OP_SIN;
+    if (name == "cos")  return FormProgram::OP_COS;
+    if (name == "abs")  return FormProgram::OP_ABS;
+    parse_error("unknown function");
+    return -1;
+  }
+
+  // matches "f", "fx", "fy", "f_x", "f_y"; returns 0, 1, 2 or -1 if there is no match
+  static int partial(const std::string& name, const std::string& f)
+  {
+    if (name.compare(0, f.length(), f)) return -1;
+    std::string d = name.substr(f.length());
+    if (d == "") return 0;
+    if (d == "x" || d == "_x") return 1;
+    if (d == "y" || d == "_y") return 2;
+    return -1;
+  }
+
+  int identifier(const std::string& name)
+  {
+    int d;
+    if (nfns == 2 && (d = partial(name, uname)) >= 0)
+      return make_node(FormProgram::OP_U + d);
+    if ((d = partial(name, vname)) >= 0)
+      return make_node(FormProgram::OP_V + d);
+
+    if (name == "x") return make_node(FormProgram::OP_X);
+    if (name == "y") return make_node(FormProgram::OP_Y);
+    if (name == "nx" || name == "ny" || name == "tx" || name == "ty")
+    {
+      if (!prog->surf) parse_error("normals and tangents can only be used in surface forms");
+      if (name == "nx") return make_node(FormProgram::OP_NX);
+      if (name == "ny") return make_node(FormProgram::OP_NY);
+      if (name == "tx") return make_node(FormProgram::OP_TX);
+      return make_node(FormProgram::OP_TY);
+    }
+
+    std::map<std::string, double>::const_iterator it = constants.find(name);
+    if (it != constants.end())
+      return make_node(FormProgram::OP_PARAM, -1, -1, 0.0, &it->second);
+    if (name == "pi")
+      return make_node(FormProgram::OP_CONST, -1, -1, M_PI);
+
+    parse_error("unknown identifier");
+    return -1;
+  }
+
+  //// code generation ////
+
+  void instr(int op, int dst, int a = 0, int b = 0, double c = 0.0, const double* p = NULL)
+  {
+    FormProgram::Instr in = { op, dst, a, b, c, p };
+    prog->code.push_back(in);
+    prog->nreg = std::max(prog->nreg, dst + 1);
+  }
+
+  // generates the code for the subtree 'n', leaving the result in register 'r'
+  void emit(int n, int r)
+  {
+    const Node& nd = nodes[n];
+    if (nd.l < 0)
+    {
+      instr(nd.op, r, 0, 0, nd.c, nd.p);
+    }
+    else if (nd.r < 0)
+    {
+      emit(nd.l, r);
+      instr(nd.op, r, r);
+    }
+    else if (is_const(nd.r))
+    {
+      // register-immediate forms
+      double c = nodes[nd.r].c;
+      emit(nd.l, r);
+      switch (nd.op)
+      {
+        case FormProgram::OP_ADD: instr(FormProgram::OP_ADDC, r, r, 0, c); break;
+        case FormProgram::OP_SUB: instr(FormProgram::OP_ADDC, r, r, 0, -c); break;
+        case FormProgram::OP_MUL: instr(FormProgram::OP_MULC, r, r, 0, c); break;
+        case FormProgram::OP_DIV: instr(FormProgram::OP_MULC, r, r, 0, 1.0 / c); break;
+        case FormProgram::OP_POW:
+          if (c == 2.0) instr(FormProgram::OP_MUL, r, r, r);
+          else if (c != 1.0) instr(FormProgram::OP_POWC, r, r, 0, c);
+          break;
+      }
+    }
+    else if (is_const(nd.l) && nd.op != FormProgram::OP_POW)
+    {
+      double c = nodes[nd.l].c;
+      emit(nd.r, r);
+      switch (nd.op)
+      {
+        case FormProgram::OP_ADD: instr(FormProgram::OP_ADDC, r, r, 0, c); break;
+        case FormProgram::OP_SUB: instr(FormProgram::OP_RSUBC, r, r, 0, c); break;
+        case FormProgram::OP_MUL: instr(FormProgram::OP_MULC, r, r, 0, c); break;
+        case FormProgram::OP_DIV: instr(FormProgram::OP_RDIVC, r, r, 0, c); break;
+      }
+    }
+    else
+    {
+      emit(nd.l, r);
+      emit(nd.r, r + 1);
+      instr(nd.op, r, r, r + 1);
+    }
+  }
+};
 
-NODE* ifstatement(void)
+
+//// FormProgram ///////////////////////////////////////////////////////////////////////////////////
+
+FormProgram::FormProgram(const char* text, int nfns, const std::map<std::string, double>& constants)
 {
-  TOKEN* t = token;
-  NODE *l, *r, *c;
-  check_for(T_IF, "'if' expected");
-  check_for(T_BRA, "'(' expected");
-  c = expression();
-  check_for(T_KET, "')' expected");
-  l = goal();
-  r = (token->type == T_ELSE) ? (next_token(), goal()) : NULL;
-  return make_tree(t, l, r, c);
+  FormCompiler compiler(this, text, nfns, constants);
+  compiler.compile();
+  reg.resize(nreg);
+  ord_reg.resize(nreg);
+  ord_const.resize(nreg);
 }
 
 
-NODE* goal(void)
+static inline double* check_load(double* ptr)
 {
-  NODE* n = (token->type == T_IF) ? ifstatement() : expression();
-  check_for(T_SEMICOL, "semicolon expected");
-  return n;
+  if (ptr == NULL) error("FormProgram: function values or geometry not available.");
+  return ptr;
 }
 
 
-void wf_parser_init(const char* input)
+scalar FormProgram::eval(int np, double* wt, Func<double>* u, Func<double>* v, Geom<double>* e)
 {
-  wf_lexer_init(input);
-  token = get_token();
+  if ((int) scratch.size() < nreg * np) scratch.resize(nreg * np);
+
+  for (unsigned int k = 0; k < code.size(); k++)
+  {
+    const Instr& in = code[k];
+    double* out = &scratch[in.dst * np];
+    const double* a = reg[in.a];
+    const double* b = reg[in.b];
+    double c = in.c;
+    int i;
+
+    switch (in.op)
+    {
+      // loads only redirect the register
+      case OP_U:  reg[in.dst] = check_load(u->val); continue;
+      case OP_UX: reg[in.dst] = check_load(u->dx); continue;
+      case OP_UY: reg[in.dst] = check_load(u->dy); continue;
+      case OP_V:  reg[in.dst] = check_load(v->val); continue;
+      case OP_VX: reg[in.dst] = check_load(v->dx); continue;
+      case OP_VY: reg[in.dst] = check_load(v->dy); continue;
+      case OP_X:  reg[in.dst] = check_load(e->x); continue;
+      case OP_Y:  reg[in.dst] = check_load(e->y); continue;
+      case OP_NX: reg[in.dst] = check_load(e->nx); continue;
+      case OP_NY: reg[in.dst] = check_load(e->ny); continue;
+      case OP_TX: reg[in.dst] = check_load(e->tx); continue;
+      case OP_TY: reg[in.dst] = check_load(e->ty); continue;
+
+      case OP_PARAM: c = *in.p; // fall through
+      case OP_CONST: for (i = 0; i < np; i++) out[i] = c; break;
+
+      case OP_ADD:   for (i = 0; i < np; i++) out[i] = a[i] + b[i]; break;
+      case OP_SUB:   for (i = 0; i < np; i++) out[i] = a[i] - b[i]; break;
+      case OP_MUL:   for (i = 0; i < np; i++) out[i] = a[i] * b[i]; break;
+      case OP_DIV:   for (i = 0; i < np; i++) out[i] = a[i] / b[i]; break;
+      case OP_POW:   for (i = 0; i < np; i++) out[i] = pow(a[i], b[i]); break;
+
+      case OP_ADDC:  for (i = 0; i < np; i++) out[i] = a[i] + c; break;
+      case OP_MULC:  for (i = 0; i < np; i++) out[i] = a[i] * c; break;
+      case OP_RSUBC: for (i = 0; i < np; i++) out[i] = c - a[i]; break;
+      case OP_RDIVC: for (i = 0; i < np; i++) out[i] = c / a[i]; break;
+      case OP_POWC:  for (i = 0; i < np; i++) out[i] = pow(a[i], c); break;
+
+      case OP_NEG:   for (i = 0; i < np; i++) out[i] = -a[i]; break;
+      case OP_SQRT:  for (i = 0; i < np; i++) out[i] = sqrt(a[i]); break;
+      case OP_EXP:   for (i = 0; i < np; i++) out[i] = exp(a[i]); break;
+      case OP_LOG:   for (i = 0; i < np; i++) out[i] = log(a[i]); break;
+      case OP_SIN:   for (i = 0; i < np; i++) out[i] = sin(a[i]); break;
+      case OP_COS:   for (i = 0; i < np; i++) out[i] = cos(a[i]); break;
+      case OP_ABS:   for (i = 0; i < np; i++) out[i] = fabs(a[i]); break;
+
+      default: error("FormProgram: invalid instruction.");
+    }
+    reg[in.dst] = out;
+  }
+
+  const double* f = reg[0];
+  double result = 0.0;
+  for (int i = 0; i < np; i++)
+    result += wt[i] * f[i];
+  return result;
 }
 
 
-void wf_parser_free(void)
+Ord FormProgram::eval_ord(Func<Ord>* u, Func<Ord>* v, Geom<Ord>* e)
 {
-  wf_lexer_free();
+  // ord_const[r] is true if register r does not depend on the position
+  const int max_order = Ord().get_max_order();
+  for (unsigned int k = 0; k < code.size(); k++)
+  {
+    const Instr& in = code[k];
+    Ord a = ord_reg[in.a], b = ord_reg[in.b];
+    bool ka = ord_const[in.a], kb = ord_const[in.b];
+    Ord o;
+    bool kc = false;
+
+    switch (in.op)
+    {
+      case OP_U:  o = u->val[0]; break;
+      case OP_UX: o = u->dx[0]; break;
+      case OP_UY: o = u->dy[0]; break;
+      case OP_V:  o = v->val[0]; break;
+      case OP_VX: o = v->dx[0]; break;
+      case OP_VY: o = v->dy[0]; break;
+      case OP_X:  o = e->x[0]; break;
+      case OP_Y:  o = e->y[0]; break;
+      case OP_NX: o = e->nx[0]; break;
+      case OP_NY: o = e->ny[0]; break;
+      case OP_TX: o = e->tx[0]; break;
+      case OP_TY: o = e->ty[0]; break;
+
+      case OP_PARAM:
+      case OP_CONST: kc = true; break;
+
+      case OP_ADD:
+      case OP_SUB:   o = a + b; kc = ka && kb; break;
+      case OP_MUL:   o = a * b; kc = ka && kb; break;
+      case OP_DIV:   o = kb ? a : Ord(max_order); kc = ka && kb; break;
+      case OP_POW:   kc = ka && kb; o = kc ? Ord(0) : Ord(max_order); break;
+
+      case OP_ADDC:
+      case OP_MULC:
+      case OP_RSUBC: o = a; kc = ka; break;
+      case OP_RDIVC: o = ka ? a : Ord(max_order); kc = ka; break;
+      case OP_POWC:  o = pow(a, in.c); kc = ka; break;
+
+      case OP_NEG:
+      case OP_ABS:
+      case OP_SQRT:  o = a; kc = ka; break;
+      case OP_EXP:   o = exp(a); kc = ka; break;
+      case OP_LOG:
+      case OP_SIN:
+      case OP_COS:   kc = ka; o = kc ? Ord(0) : Ord(max_order); break;
+    }
+    ord_reg[in.dst] = o;
+    ord_const[in.dst] = kc;
+  }
+  return ord_reg[0];
 }
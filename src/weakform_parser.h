@@ -0,0 +1,101 @@
+// This file is part of Hermes2D.
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+// $Id$
+
+#ifndef __H2D_WEAKFORM_PARSER_H
+#define __H2D_WEAKFORM_PARSER_H
+
+#include "forms.h"
+
+
+/// \brief A weak form given as text, compiled to register bytecode.
+///
+/// The text has the form
+///
+///   [vol|surf] [u, v :] expr
+///
+/// e.g. "vol u,v: ux*vx + uy*vy" or "surf v: (1 + x^2)*v". The names of the basis and test
+/// functions default to "u" and "v" (a linear form only has the test function). The expression
+/// may contain numbers, + - * / ^, parentheses, the basis and test functions with the optional
+/// derivative suffixes "x", "y" (or "_x", "_y"), the coordinates x, y, the unit normal nx, ny
+/// and tangent tx, ty (surface forms only), the functions sqrt, exp, log, sin, cos, abs, and
+/// named constants defined by WeakForm::set_constant().
+///
+/// The bytecode is evaluated over all integration points at once: every instruction is a loop
+/// over the points, operating on arrays ("registers") of length np. Loads of the basis functions
+/// and of the geometry only redirect a register to the existing arrays, so they cost nothing.
+/// The same bytecode, run with Ord arithmetic, gives the polynomial order of the integrand,
+/// i.e., the integration order is derived from the expression automatically.
+///
+class H2D_API FormProgram
+{
+public:
+
+  /// Compiles 'text'. 'nfns' is 2 for bilinear and 1 for linear forms. Named constants are
+  /// looked up in 'constants' and bound by address, so changing a constant after the form
+  /// was added affects all subsequent assemblies.
+  FormProgram(const char* text, int nfns, const std::map<std::string, double>& constants);
+
+  /// True if the text starts with "surf".
+  bool is_surf() const { return surf; }
+
+  /// Returns sum_i wt[i] * f(x_i). 'u' is NULL for linear forms.
+  scalar eval(int np, double* wt, Func<double>* u, Func<double>* v, Geom<double>* e);
+
+  /// Returns the polynomial order of the integrand.
+  Ord eval_ord(Func<Ord>* u, Func<Ord>* v, Geom<Ord>* e);
+
+  /// Returns the number of instructions and registers (for testing).
+  int get_num_instructions() const { return code.size(); }
+  int get_num_registers() const { return nreg; }
+
+  enum Opcode
+  {
+    // loads
+    OP_U, OP_UX, OP_UY, OP_V, OP_VX, OP_VY,
+    OP_X, OP_Y, OP_NX, OP_NY, OP_TX, OP_TY,
+    OP_CONST, OP_PARAM,
+    // binary operations, register-register
+    OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_POW,
+    // binary operations, register-immediate
+    OP_ADDC, OP_MULC, OP_RSUBC, OP_RDIVC, OP_POWC,
+    // unary operations
+    OP_NEG, OP_SQRT, OP_EXP, OP_LOG, OP_SIN, OP_COS, OP_ABS
+  };
+
+protected:
+
+  struct Instr
+  {
+    int op, dst, a, b;
+    double c;            // immediate operand
+    const double* p;     // named constant (OP_PARAM)
+  };
+
+  std::vector<Instr> code;
+  int nreg;
+  bool surf;
+
+  std::vector<double> scratch;
+  std::vector<double*> reg;
+  std::vector<Ord> ord_reg;
+  std::vector<char> ord_const;
+
+  friend class FormCompiler;
+};
+
+
+#endif
@@ -0,0 +1,160 @@
+#include "hermes2d.h"
+
+// This test checks the coarsening of meshes and spaces by Adapt::coarsen():
+// 1. a quadratic function is represented exactly on the base mesh, so repeated coarsening
+//    returns to the base mesh, keeps the orders and transfers the function exactly,
+// 2. a linear function allows lowering the orders down to one,
+// 3. a steep front keeps the elements next to it while the rest of the mesh is coarsened,
+//    and the error added by one coarsening is bounded by the threshold.
+
+#undef ERROR_SUCCESS
+#undef ERROR_FAILURE
+#define ERROR_SUCCESS                               0
+#define ERROR_FAILURE                               -1
+
+const double THRESHOLD = 0.01;  // relative error added by one coarsening
+const double FRONT = 0.3;       // position of the front
+
+scalar quadratic(double x, double y, scalar& dx, scalar& dy)
+{
+  dx = 2*x + y;
+  dy = x;
+  return x*x + x*y;
+}
+
+scalar linear(double x, double y, scalar& dx, scalar& dy)
+{
+  dx = 1.0;
+  dy = -2.0;
+  return x - 2*y + 1.0;
+}
+
+scalar front(double x, double y, scalar& dx, scalar& dy)
+{
+  double t = 20.0 * (x - FRONT);
+  dx = 20.0 / (1.0 + t*t);
+  dy = 0.0;
+  return atan(t);
+}
+
+BCType bc_types(int marker)
+{
+  return BC_NATURAL;
+}
+
+// refines the mesh uniformly and also locally, anisotropically for quads
+void refine(Mesh* mesh, int num)
+{
+  for (int i = 0; i < num; i++)
+    mesh->refine_all_elements();
+  Element* e = mesh->get_element(mesh->get_max_element_id() - 1);
+  mesh->refine_element(e->id, e->is_quad() ? 1 : 0);
+  mesh->refine_element(mesh->get_max_element_id() - 1);
+}
+
+// number of active elements which intersect the strip |x - x0| < h
+int count_elements(Mesh* mesh, double x0, double h)
+{
+  int count = 0;
+  Element* e;
+  for_all_active_elements(e, mesh)
+  {
+    double min_x = 1e10, max_x = -1e10;
+    for (unsigned int i = 0; i < e->nvert; i++)
+    {
+      min_x = std::min(min_x, e->vn[i]->x);
+      max_x = std::max(max_x, e->vn[i]->x);
+    }
+    if (max_x > x0 - h && min_x < x0 + h) count++;
+  }
+  return count;
+}
+
+// coarsens until nothing changes, returns the number of calls
+int coarsen_all(H1Adapt* hp, Mesh* basemesh)
+{
+  int calls = 0;
+  while (hp->coarsen(THRESHOLD, basemesh) > 0 && calls < 20)
+    calls++;
+  return calls;
+}
+
+bool check_base_mesh(Mesh* mesh, Mesh* basemesh, Space* space, int order)
+{
+  bool ok = mesh->get_num_active_elements() == basemesh->get_num_active_elements();
+  Element* e;
+  for_all_active_elements(e, mesh)
+  {
+    if (!basemesh->get_element(e->id)->active) ok = false;
+    int o = space->get_element_order(e->id);
+    if (o != (e->is_triangle() ? order : H2D_MAKE_QUAD_ORDER(order, order))) ok = false;
+  }
+  return ok;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) error("Missing mesh file name parameter.");
+
+  Mesh basemesh, mesh;
+  H2DReader mloader;
+  mloader.load(argv[1], &basemesh);
+  basemesh.refine_all_elements();
+
+  bool success = true;
+
+  // 1. a quadratic function
+  mesh.copy(&basemesh);
+  refine(&mesh, 2);
+  H1Space space(&mesh, bc_types, NULL, 2);
+  WeakForm wf;
+  LinSystem ls(&wf, &space);
+  Solution sln;
+  ls.project_global(quadratic, &sln);
+
+  H1Adapt hp(&ls);
+  hp.set_solutions(&sln, &sln);
+  int calls = coarsen_all(&hp, &basemesh);
+  ExactSolution exact(&mesh, quadratic);
+  double err = h1_error(&sln, &exact);
+  printf("quadratic: %d calls, %d elements, rel. H1 error %g\n", calls, mesh.get_num_active_elements(), err);
+  if (!check_base_mesh(&mesh, &basemesh, &space, 2) || err > 1e-10) success = false;
+
+  // 2. a linear function
+  mesh.copy(&basemesh);
+  refine(&mesh, 1);
+  space.set_uniform_order(3);
+  ls.project_global(linear, &sln);
+  calls = coarsen_all(&hp, &basemesh);
+  ExactSolution exact_linear(&mesh, linear);
+  err = h1_error(&sln, &exact_linear);
+  printf("linear: %d calls, %d dofs, rel. H1 error %g\n", calls, ls.get_num_dofs(), err);
+  if (!check_base_mesh(&mesh, &basemesh, &space, 1) || err > 1e-10) success = false;
+
+  // 3. a front
+  mesh.copy(&basemesh);
+  refine(&mesh, 3);
+  space.set_uniform_order(2);
+  ls.project_global(front, &sln);
+  Solution sln_fine;
+  sln_fine.copy(&sln);
+  int ndof = ls.get_num_dofs();
+  int near = count_elements(&mesh, FRONT, 0.05), far = count_elements(&mesh, -0.75, 0.25);
+  int changed = hp.coarsen(THRESHOLD, &basemesh);
+  err = h1_error(&sln, &sln_fine);
+  printf("front: %d changes, %d -> %d dofs, elements near the front %d -> %d, far from it %d -> %d, rel. H1 error %g\n",
+         changed, ndof, ls.get_num_dofs(), near, count_elements(&mesh, FRONT, 0.05), far,
+         count_elements(&mesh, -0.75, 0.25), err);
+  if (changed == 0 || ls.get_num_dofs() >= ndof || count_elements(&mesh, FRONT, 0.05) != near
+      || count_elements(&mesh, -0.75, 0.25) >= far || err > 2 * THRESHOLD)
+    success = false;
+
+  if (success) {
+    printf("Success!\n");
+    return ERROR_SUCCESS;
+  }
+  else {
+    printf("Failure!\n");
+    return ERROR_FAILURE;
+  }
+}
@@ -0,0 +1,147 @@
+#include "hermes2d.h"
+
+// This test makes sure that the Dirichlet lift recomputed from the stored
+// couplings after a change of time-dependent essential BC values (i.e., in
+// assemble(true)) gives the same solution as a full assembly of the system.
+//
+// Variant 1: one equation with a symmetric volume form and a Newton surface form.
+// Variant 2: two equations coupled by a symmetric off-diagonal form.
+
+#undef ERROR_SUCCESS
+#undef ERROR_FAILURE
+#define ERROR_SUCCESS                               0
+#define ERROR_FAILURE                               -1
+
+const int NUM_STEPS = 4;     // number of time steps
+const double TAU = 0.1;      // time step
+const double TOL = 1e-10;    // maximum relative difference of the solutions
+
+double TIME = 0.0;
+
+BCType bc_types(int marker)
+{
+  return (marker == 1 || marker == 2) ? BC_ESSENTIAL : BC_NATURAL;
+}
+
+BCType bc_types_all(int marker)
+{
+  return BC_ESSENTIAL;
+}
+
+scalar bc_values(int marker, double x, double y)
+{
+  return (1.0 + TIME) * x * y + sin(3.0 * TIME * x) + TIME;
+}
+
+scalar bc_values_2(int marker, double x, double y)
+{
+  return cos(TIME * y) - TIME * x * x;
+}
+
+template<typename Real, typename Scalar>
+Scalar bilinear_form(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *u, Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  return int_grad_u_grad_v<Real, Scalar>(n, wt, u, v) + int_u_v<Real, Scalar>(n, wt, u, v);
+}
+
+template<typename Real, typename Scalar>
+Scalar bilinear_form_surf(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *u, Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  return 2.0 * int_u_v<Real, Scalar>(n, wt, u, v);
+}
+
+template<typename Real, typename Scalar>
+Scalar coupling_form(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *u, Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  return 0.5 * int_u_v<Real, Scalar>(n, wt, u, v);
+}
+
+template<typename Real, typename Scalar>
+Scalar linear_form(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  return int_v<Real, Scalar>(n, wt, v);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 3)
+  {
+    printf("please input as this format: linsystem-dirichlet-lift meshfile.mesh variant\n");
+    return ERROR_FAILURE;
+  }
+  int variant = atoi(argv[2]);
+  int neq = (variant == 2) ? 2 : 1;
+
+  // refined mesh with hanging nodes on the boundary
+  Mesh mesh;
+  H2DReader mloader;
+  mloader.load(argv[1], &mesh);
+  mesh.refine_all_elements();
+  mesh.refine_all_elements();
+  mesh.refine_element(mesh.get_max_element_id() - 1);
+
+  WeakForm wf(neq);
+  if (variant == 2)
+  {
+    wf.add_matrix_form(0, 0, callback(bilinear_form), H2D_SYM);
+    wf.add_matrix_form(1, 1, callback(bilinear_form), H2D_SYM);
+    wf.add_matrix_form(0, 1, callback(coupling_form), H2D_SYM);
+    wf.add_vector_form(0, callback(linear_form));
+    wf.add_vector_form(1, callback(linear_form));
+  }
+  else
+  {
+    wf.add_matrix_form(callback(bilinear_form), H2D_SYM);
+    wf.add_matrix_form_surf(callback(bilinear_form_surf));
+    wf.add_vector_form(callback(linear_form));
+  }
+
+  // the first system is assembled once and then only its RHS is updated,
+  // the second one is assembled from scratch in every time step
+  H1Space space1(&mesh, variant == 2 ? bc_types_all : bc_types, bc_values, 3);
+  H1Space space2(&mesh, bc_types_all, bc_values_2, 2);
+  H1Space ref1(&mesh, variant == 2 ? bc_types_all : bc_types, bc_values, 3);
+  H1Space ref2(&mesh, bc_types_all, bc_values_2, 2);
+  Tuple<Space*> spaces = (neq == 2) ? Tuple<Space*>(&space1, &space2) : Tuple<Space*>(&space1);
+  Tuple<Space*> ref_spaces = (neq == 2) ? Tuple<Space*>(&ref1, &ref2) : Tuple<Space*>(&ref1);
+  LinSystem ls(&wf, spaces);
+  ls.assemble();
+
+  bool success = true;
+  for (int ts = 1; ts <= NUM_STEPS; ts++)
+  {
+    TIME += TAU;
+
+    Solution sln1, sln2, rsln1, rsln2;
+    ls.update_essential_bc_values();
+    ls.assemble(true);
+    LinSystem rls(&wf, ref_spaces);
+    rls.assemble();
+    if (neq == 2)
+    {
+      ls.solve(&sln1, &sln2);
+      rls.solve(&rsln1, &rsln2);
+    }
+    else
+    {
+      ls.solve(&sln1);
+      rls.solve(&rsln1);
+    }
+
+    double err = h1_error(&sln1, &rsln1) / h1_norm(&rsln1);
+    if (neq == 2) err = std::max(err, h1_error(&sln2, &rsln2) / h1_norm(&rsln2));
+    printf("time = %g, ndof = %d, relative difference = %g\n", TIME, ls.get_num_dofs(), err);
+    if (!(err < TOL)) success = false;
+  }
+
+  if (success)
+  {
+    printf("Success!\n");
+    return ERROR_SUCCESS;
+  }
+  else
+  {
+    printf("Failure!\n");
+    return ERROR_FAILURE;
+  }
+}
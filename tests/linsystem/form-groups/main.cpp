@@ -0,0 +1,209 @@
+#include "hermes2d.h"
+
+// This test makes sure that a system with time-invariant matrix forms (assembled
+// once into group blocks and combined with the group coefficients) gives the same
+// solutions as a system assembled from scratch in every time step, when the time
+// step and the essential BC values change. It also checks that the time-invariant
+// forms are not integrated again.
+//
+// Variant 1: one equation, implicit Euler with a mass form in group 0, stiffness and
+//            Newton surface forms in group 1, and a time-dependent convection form.
+// Variant 2: two equations coupled by a symmetric off-diagonal form in group 1.
+
+#undef ERROR_SUCCESS
+#undef ERROR_FAILURE
+#define ERROR_SUCCESS                               0
+#define ERROR_FAILURE                               -1
+
+const int NUM_STEPS = 5;                                  // number of time steps
+const double TAUS[NUM_STEPS] = { 0.1, 0.05, 0.2, 0.2, 0.1 }; // time steps
+const double TOL = 1e-10;                                 // maximum relative difference of the solutions
+
+double TIME = 0.0;
+double TAU = TAUS[0];
+int mass_evals = 0;
+
+BCType bc_types(int marker)
+{
+  return (marker == 1 || marker == 2) ? BC_ESSENTIAL : BC_NATURAL;
+}
+
+BCType bc_types_all(int marker)
+{
+  return BC_ESSENTIAL;
+}
+
+scalar bc_values(int marker, double x, double y)
+{
+  return (1.0 + TIME) * x * y + sin(3.0 * TIME * x) + TIME;
+}
+
+scalar bc_values_2(int marker, double x, double y)
+{
+  return cos(TIME * y) - TIME * x * x;
+}
+
+template<typename Real, typename Scalar>
+Scalar mass_form(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *u, Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  return int_u_v<Real, Scalar>(n, wt, u, v);
+}
+
+scalar counted_mass_form(int n, double *wt, Func<scalar> *u_ext[], Func<double> *u, Func<double> *v, Geom<double> *e, ExtData<scalar> *ext)
+{
+  mass_evals++;
+  return mass_form<double, scalar>(n, wt, u_ext, u, v, e, ext);
+}
+
+template<typename Real, typename Scalar>
+Scalar mass_tau_form(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *u, Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  return int_u_v<Real, Scalar>(n, wt, u, v) / TAU;
+}
+
+template<typename Real, typename Scalar>
+Scalar stiffness_form(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *u, Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  return int_grad_u_grad_v<Real, Scalar>(n, wt, u, v);
+}
+
+template<typename Real, typename Scalar>
+Scalar convection_form(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *u, Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  return (1.0 + TIME) * int_dudx_v<Real, Scalar>(n, wt, u, v);
+}
+
+template<typename Real, typename Scalar>
+Scalar newton_form_surf(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *u, Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  return 2.0 * int_u_v<Real, Scalar>(n, wt, u, v);
+}
+
+template<typename Real, typename Scalar>
+Scalar coupling_form(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *u, Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  return 0.5 * int_u_v<Real, Scalar>(n, wt, u, v);
+}
+
+template<typename Real, typename Scalar>
+Scalar linear_form(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  return int_u_v<Real, Scalar>(n, wt, ext->fn[0], v) / TAU + int_v<Real, Scalar>(n, wt, v);
+}
+
+// adds the forms of one equation; with 'groups', the time-invariant forms are tagged
+void add_forms(WeakForm& wf, int i, bool groups, Solution* prev)
+{
+  if (groups)
+  {
+    wf.add_matrix_form(i, i, counted_mass_form, mass_form<Ord, Ord>, H2D_SYM, H2D_ANY, Tuple<MeshFunction*>(), 0);
+    wf.add_matrix_form(i, i, callback(stiffness_form), H2D_SYM, H2D_ANY, Tuple<MeshFunction*>(), 1);
+    wf.add_matrix_form_surf(i, i, callback(newton_form_surf), H2D_ANY, Tuple<MeshFunction*>(), 1);
+  }
+  else
+  {
+    wf.add_matrix_form(i, i, callback(mass_tau_form), H2D_SYM);
+    wf.add_matrix_form(i, i, callback(stiffness_form), H2D_SYM);
+    wf.add_matrix_form_surf(i, i, callback(newton_form_surf));
+  }
+  wf.add_matrix_form(i, i, callback(convection_form));
+  wf.add_vector_form(i, callback(linear_form), H2D_ANY, prev);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 3)
+  {
+    printf("please input as this format: linsystem-form-groups meshfile.mesh variant\n");
+    return ERROR_FAILURE;
+  }
+  int variant = atoi(argv[2]);
+  int neq = (variant == 2) ? 2 : 1;
+
+  // refined mesh with hanging nodes on the boundary
+  Mesh mesh;
+  H2DReader mloader;
+  mloader.load(argv[1], &mesh);
+  mesh.refine_all_elements();
+  mesh.refine_all_elements();
+  mesh.refine_element(mesh.get_max_element_id() - 1);
+
+  // previous time levels of both systems
+  Solution prev1, prev2, rprev1, rprev2;
+  prev1.set_zero(&mesh);
+  prev2.set_zero(&mesh);
+  rprev1.set_zero(&mesh);
+  rprev2.set_zero(&mesh);
+
+  WeakForm wf(neq), rwf(neq);
+  add_forms(wf, 0, true, &prev1);
+  add_forms(rwf, 0, false, &rprev1);
+  if (variant == 2)
+  {
+    add_forms(wf, 1, true, &prev2);
+    add_forms(rwf, 1, false, &rprev2);
+    wf.add_matrix_form(0, 1, callback(coupling_form), H2D_SYM, H2D_ANY, Tuple<MeshFunction*>(), 1);
+    rwf.add_matrix_form(0, 1, callback(coupling_form), H2D_SYM);
+  }
+
+  H1Space space1(&mesh, variant == 2 ? bc_types_all : bc_types, bc_values, 3);
+  H1Space space2(&mesh, bc_types_all, bc_values_2, 2);
+  H1Space ref1(&mesh, variant == 2 ? bc_types_all : bc_types, bc_values, 3);
+  H1Space ref2(&mesh, bc_types_all, bc_values_2, 2);
+  Tuple<Space*> spaces = (neq == 2) ? Tuple<Space*>(&space1, &space2) : Tuple<Space*>(&space1);
+  Tuple<Space*> ref_spaces = (neq == 2) ? Tuple<Space*>(&ref1, &ref2) : Tuple<Space*>(&ref1);
+  LinSystem ls(&wf, spaces);
+
+  bool success = true;
+  int first_evals = 0;
+  for (int ts = 0; ts < NUM_STEPS; ts++)
+  {
+    TAU = TAUS[ts];
+    TIME += TAU;
+    wf.set_group_coef(0, 1.0 / TAU);
+
+    Solution sln1, sln2, rsln1, rsln2;
+    ls.update_essential_bc_values();
+    ls.assemble();
+    if (ts == 0) first_evals = mass_evals;
+    LinSystem rls(&rwf, ref_spaces);
+    rls.assemble();
+    if (neq == 2)
+    {
+      ls.solve(&sln1, &sln2);
+      rls.solve(&rsln1, &rsln2);
+    }
+    else
+    {
+      ls.solve(&sln1);
+      rls.solve(&rsln1);
+    }
+
+    double err = h1_error(&sln1, &rsln1) / h1_norm(&rsln1);
+    if (neq == 2) err = std::max(err, h1_error(&sln2, &rsln2) / h1_norm(&rsln2));
+    printf("time = %g, tau = %g, ndof = %d, relative difference = %g\n", TIME, TAU, ls.get_num_dofs(), err);
+    if (!(err < TOL)) success = false;
+
+    prev1.copy(&sln1);
+    rprev1.copy(&rsln1);
+    if (neq == 2)
+    {
+      prev2.copy(&sln2);
+      rprev2.copy(&rsln2);
+    }
+  }
+
+  printf("mass form evaluations: %d in the first step, %d in total\n", first_evals, mass_evals);
+  if (first_evals == 0 || mass_evals != first_evals) success = false;
+
+  if (success)
+  {
+    printf("Success!\n");
+    return ERROR_SUCCESS;
+  }
+  else
+  {
+    printf("Failure!\n");
+    return ERROR_FAILURE;
+  }
+}
@@ -0,0 +1,69 @@
+#include "hermes2d.h"
+
+// This test checks the dense index of active elements (Mesh::get_active_elements())
+// against a scan of all element slots after refinements, unrefinements, copying
+// and regularization.
+
+#undef ERROR_SUCCESS
+#undef ERROR_FAILURE
+#define ERROR_SUCCESS                               0
+#define ERROR_FAILURE                               -1
+
+// compares the index with the active elements found by for_all_active_elements
+bool check_index(Mesh* mesh)
+{
+  Element* e;
+  int n = 0;
+  for_all_active_elements(e, mesh)
+  {
+    if (n >= mesh->get_num_active_elements() || mesh->get_active_element(n) != e) return false;
+    n++;
+  }
+  if (n != mesh->get_num_active_elements()) return false;
+
+  int m = 0;
+  for_all_active_elements_fast(e, mesh)
+    if (!e->used || !e->active || mesh->get_element(e->id) != e) return false;
+    else m++;
+  return m == n;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) error("Missing mesh file name parameter.");
+
+  Mesh mesh, dup;
+  H2DReader mloader;
+  mloader.load(argv[1], &mesh);
+
+  bool success = check_index(&mesh);
+  for (int i = 0; i < 6; i++)
+  {
+    if (i < 3)
+      mesh.refine_all_elements();
+    else // refine the last active element, reusing the slots freed by unrefinement
+      mesh.refine_element(mesh.get_active_element(mesh.get_num_active_elements() - 1)->id);
+    if (i == 4)
+      mesh.unrefine_all_elements();
+    if (!check_index(&mesh)) success = false;
+
+    dup.copy(&mesh);
+    if (!check_index(&dup)) success = false;
+    printf("step %d: %d active elements, max. element id %d\n", i, mesh.get_num_active_elements(),
+           mesh.get_max_element_id());
+  }
+
+  ::free(mesh.regularize(1));
+  if (!check_index(&mesh)) success = false;
+  dup.copy_base(&mesh);
+  if (!check_index(&dup)) success = false;
+
+  if (success) {
+    printf("Success!\n");
+    return ERROR_SUCCESS;
+  }
+  else {
+    printf("Failure!\n");
+    return ERROR_FAILURE;
+  }
+}
@@ -0,0 +1,78 @@
+#include "hermes2d.h"
+
+// This test makes sure that the reference map coefficients of refined curved
+// elements taken from the cache of the base element curves are the same as
+// the ones projected from scratch. The first mesh fills the cache, its copy
+// (sharing the curves) is refined in the same way and reads from it. With
+// many refinements, the cache overflows and is flushed on the way.
+
+#undef ERROR_SUCCESS
+#undef ERROR_FAILURE
+#define ERROR_SUCCESS                               0
+#define ERROR_FAILURE                               -1
+
+// uniform refinements, the last one anisotropic in quads
+static void refine(Mesh* mesh, int num_ref)
+{
+  for (int i = 0; i < num_ref - 1; i++)
+    mesh->refine_all_elements();
+
+  Element* e;
+  std::vector<int> ids;
+  for_all_active_elements(e, mesh)
+    ids.push_back(e->id);
+  for (unsigned i = 0; i < ids.size(); i++)
+  {
+    Element* f = mesh->get_element(ids[i]);
+    mesh->refine_element(ids[i], f->is_quad() ? 1 + i % 2 : 0);
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 3)
+  {
+    printf("please input as this format: curved_cache meshfile.mesh num_ref\n");
+    return ERROR_FAILURE;
+  }
+  int num_ref = atoi(argv[2]);
+
+  Mesh mesh, dup;
+  H2DReader mloader;
+  mloader.load(argv[1], &mesh);
+  dup.copy_base(&mesh);
+
+  refine(&mesh, num_ref);
+  refine(&dup, num_ref);
+
+  bool success = (mesh.get_max_element_id() == dup.get_max_element_id());
+  int num_curved = 0;
+  double max_diff = 0.0;
+  Element* e;
+  for_all_elements(e, &mesh)
+  {
+    if (!success) break;
+    Element* f = dup.get_element(e->id);
+    if (!f->used || e->is_curved() != f->is_curved()) { success = false; break; }
+    if (!e->is_curved() || e->cm->toplevel) continue;
+
+    num_curved++;
+    if (e->cm->nc != f->cm->nc || e->cm->order != f->cm->order) { success = false; break; }
+    for (int i = 0; i < e->cm->nc; i++)
+      for (int j = 0; j < 2; j++)
+        max_diff = std::max(max_diff, fabs(e->cm->coefs[i][j] - f->cm->coefs[i][j]));
+  }
+  printf("refined curved elements = %d, max. difference = %g\n", num_curved, max_diff);
+  if (num_curved == 0 || max_diff > 1e-14) success = false;
+
+  if (success)
+  {
+    printf("Success!\n");
+    return ERROR_SUCCESS;
+  }
+  else
+  {
+    printf("Failure!\n");
+    return ERROR_FAILURE;
+  }
+}
@@ -0,0 +1,182 @@
+#include "hermes2d.h"
+
+// This test checks the evaluation of curved edges:
+// 1. points of circular arcs lie on the circle (the arcs of the mesh are parts of
+//    the unit circle), and the middle of an arc is in the middle of the angle,
+// 2. points of a general cubic NURBS curve with weights and a double interior knot
+//    are the same as those of the (former) recursive Cox-de Boor evaluation, and the
+//    curve is continuous at the knots,
+// 3. the projected reference maps of the curved base elements (which are computed
+//    from the stored points of the curves) follow the curves: their distance from
+//    the curves is the same as with the former evaluation of the curves.
+
+#undef ERROR_SUCCESS
+#undef ERROR_FAILURE
+#define ERROR_SUCCESS                               0
+#define ERROR_FAILURE                               -1
+
+const int NUM_PTS = 1000;        // number of tested points on each curve
+const double TOL = 1e-13;        // tolerance of the evaluation of the curves
+const double ARC_DIST = 1.23573380920407e-05;  // distances of the reference maps from the
+const double GEN_DIST = 0.00451340410731596;   // curves with the former evaluation
+
+// recursive calculation of the basis function N_i,k (the former implementation)
+double nurbs_basis_fn(int i, int k, double t, double* knot)
+{
+  if (k == 0)
+  {
+    return (t >= knot[i] && t <= knot[i+1] && knot[i] < knot[i+1]) ? 1.0 : 0.0;
+  }
+  else
+  {
+    double N1 = nurbs_basis_fn(i, k-1, t, knot);
+    double N2 = nurbs_basis_fn(i+1, k-1, t, knot);
+
+    double result = 0.0;
+    if (knot[i+k] != knot[i])
+      result += ((t - knot[i]) / (knot[i+k] - knot[i])) * N1;
+    if (knot[i+k+1] != knot[i+1])
+      result += ((knot[i+k+1] - t) / (knot[i+k+1] - knot[i+1])) * N2;
+    return result;
+  }
+}
+
+// the former evaluation of a point of the curve, t goes from 0 to 1
+void nurbs_point_ref(Nurbs* nurbs, double t, double& x, double& y)
+{
+  double3* cp = nurbs->pt;
+  x = y = 0.0;
+  double sum = 0.0;
+  for (int i = 0; i < nurbs->np; i++)
+  {
+    double basis = nurbs_basis_fn(i, nurbs->degree, t, nurbs->kv);
+    sum += cp[i][2] * basis;
+    x   += cp[i][2] * basis * cp[i][0];
+    y   += cp[i][2] * basis * cp[i][1];
+  }
+  x /= sum;
+  y /= sum;
+}
+
+bool is_knot(Nurbs* nurbs, double t)
+{
+  for (int i = nurbs->degree + 1; i < nurbs->nk - nurbs->degree - 1; i++)
+    if (fabs(nurbs->kv[i] - t) < 1e-10) return true;
+  return false;
+}
+
+// distance of the point (x, y) from the curve, approximated by a polyline
+double curve_distance(Element* e, Nurbs* nurbs, int edge, double x, double y)
+{
+  const int n = 4000;
+  double dist = 1e100, x0, y0, x1, y1;
+  nurbs_edge(e, nurbs, edge, -1.0, x0, y0);
+  for (int i = 1; i <= n; i++)
+  {
+    nurbs_edge(e, nurbs, edge, -1.0 + 2.0 * i / n, x1, y1);
+    double dx = x1 - x0, dy = y1 - y0;
+    double s = ((x - x0) * dx + (y - y0) * dy) / (dx*dx + dy*dy);
+    s = std::max(0.0, std::min(1.0, s));
+    dist = std::min(dist, hypot(x - x0 - s*dx, y - y0 - s*dy));
+    x0 = x1; y0 = y1;
+  }
+  return dist;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    printf("please input as this format: nurbs meshfile.mesh\n");
+    return ERROR_FAILURE;
+  }
+
+  Mesh mesh;
+  H2DReader mloader;
+  mloader.load(argv[1], &mesh);
+
+  bool success = true;
+  int num_arcs = 0, num_general = 0;
+  double arc_err = 0.0, gen_err = 0.0, cont_err = 0.0, arc_dist = 0.0, gen_dist = 0.0;
+  Element* e;
+  for_all_base_elements(e, &mesh)
+  {
+    if (e->cm == NULL) continue;
+    for (unsigned int edge = 0; edge < e->nvert; edge++)
+    {
+      Nurbs* nurbs = e->cm->nurbs[edge];
+      if (nurbs == NULL) continue;
+
+      double x, y;
+      if (nurbs->arc)
+      {
+        // 1. points on the unit circle
+        num_arcs++;
+        for (int i = 0; i <= NUM_PTS; i++)
+        {
+          nurbs_edge(e, nurbs, edge, -1.0 + 2.0 * i / NUM_PTS, x, y);
+          arc_err = std::max(arc_err, fabs(hypot(x, y) - 1.0));
+        }
+        double xa, ya, xb, yb;
+        nurbs_edge(e, nurbs, edge, -1.0, xa, ya);
+        nurbs_edge(e, nurbs, edge, 1.0, xb, yb);
+        nurbs_edge(e, nurbs, edge, 0.0, x, y);
+        double mid = 0.5 * (atan2(ya, xa) + atan2(yb, xb));
+        arc_err = std::max(arc_err, hypot(x - cos(mid), y - sin(mid)));
+      }
+      else
+      {
+        // 2. comparison with the recursive evaluation
+        num_general++;
+        for (int i = 0; i <= NUM_PTS; i++)
+        {
+          double t = (double) i / NUM_PTS, xr, yr;
+          nurbs_edge(e, nurbs, edge, 2.0 * t - 1.0, x, y);
+          if (is_knot(nurbs, t))
+          {
+            // the recursive evaluation counts the knot twice, check continuity instead
+            nurbs_point_ref(nurbs, t - 1e-12, xr, yr);
+            cont_err = std::max(cont_err, hypot(x - xr, y - yr));
+            nurbs_point_ref(nurbs, t + 1e-12, xr, yr);
+            cont_err = std::max(cont_err, hypot(x - xr, y - yr));
+          }
+          else
+          {
+            nurbs_point_ref(nurbs, t, xr, yr);
+            gen_err = std::max(gen_err, hypot(x - xr, y - yr));
+          }
+        }
+      }
+
+      // 3. the reference map of the base element
+      RefMap rm;
+      rm.set_quad_2d(&g_quad_2d_std);
+      rm.set_active_element(e);
+      int eo = g_quad_2d_std.get_edge_points(edge);
+      int np = g_quad_2d_std.get_num_points(eo);
+      double *px = rm.get_phys_x(eo), *py = rm.get_phys_y(eo);
+      double& dist = nurbs->arc ? arc_dist : gen_dist;
+      for (int i = 0; i < np; i++)
+        dist = std::max(dist, curve_distance(e, nurbs, edge, px[i], py[i]));
+    }
+  }
+
+  printf("arcs: %d, max. error %g\n", num_arcs, arc_err);
+  printf("general curves: %d, max. difference %g, at the knots %g\n", num_general, gen_err, cont_err);
+  printf("max. distance of the reference maps from the arcs %.15g, from the general curve %.15g\n",
+         arc_dist, gen_dist);
+  if (num_arcs == 0 || num_general == 0) success = false;
+  if (arc_err > TOL || gen_err > TOL || cont_err > 1e-9) success = false;
+  if (fabs(arc_dist - ARC_DIST) > 1e-10 || fabs(gen_dist - GEN_DIST) > 1e-10) success = false;
+
+  if (success)
+  {
+    printf("Success!\n");
+    return ERROR_SUCCESS;
+  }
+  else
+  {
+    printf("Failure!\n");
+    return ERROR_FAILURE;
+  }
+}
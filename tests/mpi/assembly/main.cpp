@@ -0,0 +1,169 @@
+#include "hermes2d.h"
+#include <mpi.h>
+
+// This test makes sure that the assembly restricted to the parts of a partition
+// of the base mesh sums up to the global system, that the partition is balanced,
+// and that MpiCGSolver gives the same solution as a serial solver. Run it with
+// any number of ranks, e.g. "mpirun -np 3 mpi-assembly".
+
+#undef ERROR_SUCCESS
+#undef ERROR_FAILURE
+#define ERROR_SUCCESS                               0
+#define ERROR_FAILURE                               -1
+
+const int P_INIT = 2;
+
+BCType bc_types(int marker)
+{
+  return (marker == 1) ? BC_ESSENTIAL : BC_NATURAL;
+}
+
+scalar bc_values(int marker, double x, double y)
+{
+  return x*x;
+}
+
+template<typename Real, typename Scalar>
+Scalar bilinear_form(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *u, Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  return int_grad_u_grad_v<Real, Scalar>(n, wt, u, v) + int_u_v<Real, Scalar>(n, wt, u, v);
+}
+
+template<typename Real, typename Scalar>
+Scalar linear_form(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  return int_v<Real, Scalar>(n, wt, v);
+}
+
+template<typename Real, typename Scalar>
+Scalar linear_form_surf(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  return 2.0 * int_v<Real, Scalar>(n, wt, v);
+}
+
+// serial reference solver with a tight tolerance
+class RefSolver : public CommonSolverCG
+{
+public:
+  virtual bool _solve(Matrix *mat, double *res) { return CommonSolverCG::_solve(mat, res, 1e-12, 10000); }
+  virtual bool _solve(Matrix *mat, cplx *res) { return false; }
+};
+
+// y = A x for a matrix in CSR format
+static void csr_times(int* Ap, int* Ai, scalar* Ax, int n, double* x, double* y)
+{
+  for (int i = 0; i < n; i++)
+  {
+    y[i] = 0.0;
+    for (int k = Ap[i]; k < Ap[i + 1]; k++)
+      y[i] += Ax[k] * x[Ai[k]];
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+  int rank = MpiCGSolver::get_rank(), size = MpiCGSolver::get_size();
+
+  // hp-mesh with hanging nodes
+  Mesh mesh;
+  H2DReader mloader;
+  mloader.load("square16.mesh", &mesh);
+  mesh.refine_all_elements();
+  mesh.refine_element(mesh.get_num_base_elements());
+  mesh.refine_element(mesh.get_max_element_id() - 1);
+
+  H1Space space(&mesh, bc_types, bc_values, P_INIT);
+  Element* e;
+  for_all_active_elements(e, &mesh)
+    if (e->vn[0]->x > 0.4) space.set_element_order(e->id, H2D_MAKE_QUAD_ORDER(P_INIT + 2, P_INIT + 2));
+
+  WeakForm wf;
+  wf.add_matrix_form(callback(bilinear_form));
+  wf.add_vector_form(callback(linear_form));
+  wf.add_vector_form_surf(callback(linear_form_surf), 3);
+
+  bool success = true;
+
+  // partition balanced by the number of shape functions
+  std::vector<int> part;
+  partition_base_elements(&mesh, size, part, &space);
+  std::vector<double> weights;
+  get_partition_weights(&mesh, part, size, weights, &space);
+  double total = 0.0, wmax = 0.0;
+  for (int i = 0; i < size; i++)
+  {
+    total += weights[i];
+    wmax = std::max(wmax, weights[i]);
+    if (weights[i] == 0.0) success = false;
+  }
+  if (rank == 0) printf("parts = %d, load imbalance = %g\n", size, wmax / (total / size));
+  if (wmax > 1.5 * total / size) success = false;
+
+  // serial reference on every rank
+  RefSolver ref_solver;
+  LinSystem ref(&wf, &ref_solver, &space);
+  ref.assemble();
+  Solution ref_sln;
+  ref.solve(&ref_sln);
+
+  // distributed system
+  MpiCGSolver solver;
+  LinSystem ls(&wf, &solver, &space);
+  ls.set_partition(part, rank);
+  ls.assemble();
+
+  // the rank-local systems sum up to the global one
+  int ndof, n;
+  int *Ap, *Ai, *rAp, *rAi;
+  scalar *Ax, *rAx, *rhs, *ref_rhs;
+  ls.get_matrix(Ap, Ai, Ax, ndof);
+  ref.get_matrix(rAp, rAi, rAx, n);
+  std::vector<double> x(ndof), y(ndof), ysum(ndof), yref(ndof), rhs_sum(ndof);
+  for (int i = 0; i < ndof; i++) x[i] = sin(1.0 + i);
+  csr_times(Ap, Ai, Ax, ndof, &x[0], &y[0]);
+  csr_times(rAp, rAi, rAx, ndof, &x[0], &yref[0]);
+  MPI_Allreduce(&y[0], &ysum[0], ndof, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  ls.get_rhs(rhs, n);
+  ref.get_rhs(ref_rhs, n);
+  MPI_Allreduce(rhs, &rhs_sum[0], ndof, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  double mat_diff = 0.0, rhs_diff = 0.0;
+  for (int i = 0; i < ndof; i++)
+  {
+    mat_diff = std::max(mat_diff, fabs(ysum[i] - yref[i]));
+    rhs_diff = std::max(rhs_diff, fabs(rhs_sum[i] - ref_rhs[i]));
+  }
+  if (mat_diff > 1e-10 || rhs_diff > 1e-10) success = false;
+
+  // distributed solve
+  Solution sln;
+  ls.solve(&sln);
+  scalar *vec, *ref_vec;
+  ls.get_solution_vector(vec, n);
+  ref.get_solution_vector(ref_vec, n);
+  double sln_diff = 0.0;
+  for (int i = 0; i < ndof; i++)
+    sln_diff = std::max(sln_diff, fabs(vec[i] - ref_vec[i]));
+  double err = l2_error(&sln, &ref_sln);
+  if (sln_diff > 1e-8 || err > 1e-8) success = false;
+
+  if (rank == 0)
+    printf("ndof = %d, matrix diff = %g, rhs diff = %g, solution diff = %g, CG iterations = %d\n",
+           ndof, mat_diff, rhs_diff, sln_diff, solver.get_num_iters());
+
+  // all ranks have to agree
+  int ok = success ? 1 : 0, all_ok;
+  MPI_Allreduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  MPI_Finalize();
+
+  if (all_ok)
+  {
+    if (rank == 0) printf("Success!\n");
+    return ERROR_SUCCESS;
+  }
+  else
+  {
+    if (rank == 0) printf("Failure!\n");
+    return ERROR_FAILURE;
+  }
+}
@@ -0,0 +1,157 @@
+#include "hermes2d.h"
+
+// This test makes sure that LinSystem::project_local() reproduces functions
+// from the finite element space exactly (also on meshes with hanging nodes,
+// with Dirichlet lifts and with sources living on a different mesh), and
+// that it is comparable to the global projection for other functions. For
+// Hcurl, a vector field from the space has to be reproduced exactly as well
+// (this exercises the projection of the tangential components on the edges).
+
+#undef ERROR_SUCCESS
+#undef ERROR_FAILURE
+#define ERROR_SUCCESS                               0
+#define ERROR_FAILURE                               -1
+
+const int P_INIT = 3;
+
+// a cubic polynomial, which lies in the space
+scalar cubic(double x, double y, scalar& dx, scalar& dy)
+{
+  dx = 3*x*x - 2*x*y + 1;
+  dy = -x*x + 2*y;
+  return x*x*x - x*x*y + y*y + x;
+}
+
+// a function which does not lie in the space
+scalar smooth(double x, double y, scalar& dx, scalar& dy)
+{
+  dx = 2*cos(2*x) * sin(y + 0.3);
+  dy = sin(2*x) * cos(y + 0.3);
+  return sin(2*x) * sin(y + 0.3);
+}
+
+// a quadratic vector field, which lies in the Hcurl space
+scalar2& quadratic2(double x, double y, scalar2& dx, scalar2& dy)
+{
+  static scalar2 val;
+  val[0] = x*x - y + 1;
+  val[1] = x*y + 2*y*y;
+  dx[0] = 2*x;  dx[1] = y;
+  dy[0] = -1;   dy[1] = x + 4*y;
+  return val;
+}
+
+// squared Hcurl norm of the difference of two vector fields
+double error_fn_hcurl(MeshFunction* sln1, MeshFunction* sln2, RefMap* ru, RefMap* rv)
+{
+  Quad2D* quad = sln1->get_quad_2d();
+
+  int o = 2 * std::max(sln1->get_fn_order(), sln2->get_fn_order()) + 2 + ru->get_inv_ref_order();
+  limit_order_nowarn(o);
+
+  sln1->set_quad_order(o);
+  sln2->set_quad_order(o);
+
+  scalar *uval0 = sln1->get_fn_values(0), *uval1 = sln1->get_fn_values(1);
+  scalar *udx1 = sln1->get_dx_values(1), *udy0 = sln1->get_dy_values(0);
+  scalar *vval0 = sln2->get_fn_values(0), *vval1 = sln2->get_fn_values(1);
+  scalar *vdx1 = sln2->get_dx_values(1), *vdy0 = sln2->get_dy_values(0);
+
+  double result = 0.0;
+  h1_integrate_expression(sqr(uval0[i] - vval0[i]) + sqr(uval1[i] - vval1[i]) +
+                          sqr((udx1[i] - udy0[i]) - (vdx1[i] - vdy0[i])));
+  return result;
+}
+
+BCType bc_types(int marker)
+{
+  return (marker == 1) ? BC_ESSENTIAL : BC_NATURAL;
+}
+
+scalar bc_values(int marker, double x, double y)
+{
+  scalar dx, dy;
+  return cubic(x, y, dx, dy);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    printf("please input as this format: projection-local meshfile.mesh\n");
+    return ERROR_FAILURE;
+  }
+
+  // mesh with hanging nodes
+  Mesh mesh;
+  H2DReader mloader;
+  mloader.load(argv[1], &mesh);
+  mesh.refine_all_elements();
+  mesh.refine_element(mesh.get_num_base_elements());
+  mesh.refine_element(mesh.get_max_element_id() - 1);
+
+  H1Space space(&mesh, bc_types, bc_values, P_INIT);
+  WeakForm wf;
+  LinSystem ls(&wf, &space);
+
+  int success = 1;
+  ExactSolution exact(&mesh, cubic);
+
+  // 1. interpolation of a function from the space
+  Solution sln;
+  ls.project_local(cubic, &sln);
+  double err = h1_error(&sln, &exact) * 100;
+  printf("cubic: rel. H1 error %g%%\n", err);
+  if (err > 1e-8) success = 0;
+
+  // 2. the same with the L2 norm used for the bubbles
+  ls.project_local(cubic, &sln, 0);
+  err = h1_error(&sln, &exact) * 100;
+  printf("cubic (L2 bubbles): rel. H1 error %g%%\n", err);
+  if (err > 1e-8) success = 0;
+
+  // 3. source given on a finer mesh
+  Mesh ref_mesh;
+  ref_mesh.copy(&mesh);
+  ref_mesh.refine_all_elements();
+  H1Space ref_space(&ref_mesh, bc_types, bc_values, P_INIT);
+  WeakForm ref_wf;
+  LinSystem ref_ls(&ref_wf, &ref_space);
+  Solution ref_sln;
+  ref_ls.project_local(cubic, &ref_sln);
+  ls.project_local(&ref_sln, &sln);
+  err = h1_error(&sln, &exact) * 100;
+  printf("cubic from fine mesh: rel. H1 error %g%%\n", err);
+  if (err > 1e-8) success = 0;
+
+  // 4. comparison with the global projection
+  H1Space space_nat(&mesh, NULL, NULL, P_INIT);
+  LinSystem ls_nat(&wf, &space_nat);
+  ExactSolution exact_smooth(&mesh, smooth);
+  Solution sln_global;
+  ls_nat.project_global(smooth, &sln_global);
+  ls_nat.project_local(smooth, &sln);
+  double err_global = h1_error(&sln_global, &exact_smooth) * 100;
+  double err_local = h1_error(&sln, &exact_smooth) * 100;
+  printf("smooth: rel. H1 error %g%% (global), %g%% (local)\n", err_global, err_local);
+  if (err_local > 2 * err_global) success = 0;
+
+  // 5. a vector field from the Hcurl space
+  HcurlSpace hc_space(&mesh, NULL, NULL, P_INIT);
+  LinSystem hc_ls(&wf, &hc_space);
+  Solution hc_exact;
+  hc_exact.set_exact(&mesh, quadratic2);
+  hc_ls.project_local(quadratic2, &sln);
+  err = calc_error(error_fn_hcurl, &sln, &hc_exact);
+  printf("quadratic vector field: abs. Hcurl error %g\n", err);
+  if (err > 1e-10) success = 0;
+
+  if (success == 1) {
+    printf("Success!\n");
+    return ERROR_SUCCESS;
+  }
+  else {
+    printf("Failure!\n");
+    return ERROR_FAILURE;
+  }
+}
@@ -0,0 +1,72 @@
+#include "hermes2d.h"
+
+// This test makes sure that LinSystem::prolong() transfers a coarse mesh
+// solution onto a refined mesh with higher polynomial degrees exactly.
+
+#undef ERROR_SUCCESS
+#undef ERROR_FAILURE
+#define ERROR_SUCCESS                               0
+#define ERROR_FAILURE                               -1
+
+const int P_INIT = 2;
+
+scalar smooth(double x, double y, scalar& dx, scalar& dy)
+{
+  dx = 2*cos(2*x) * sin(y + 0.3);
+  dy = sin(2*x) * cos(y + 0.3);
+  return sin(2*x) * sin(y + 0.3);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    printf("please input as this format: projection-prolong meshfile.mesh\n");
+    return ERROR_FAILURE;
+  }
+
+  // coarse mesh with a hanging node
+  Mesh mesh;
+  H2DReader mloader;
+  mloader.load(argv[1], &mesh);
+  mesh.refine_all_elements();
+  mesh.refine_element(mesh.get_num_base_elements());
+
+  H1Space space(&mesh, NULL, NULL, P_INIT);
+  WeakForm wf;
+  LinSystem ls(&wf, &space);
+  Solution sln_coarse;
+  ls.project_local(smooth, &sln_coarse);
+
+  // refined mesh, higher orders
+  Mesh ref_mesh;
+  ref_mesh.copy(&mesh);
+  ref_mesh.refine_all_elements();
+  ref_mesh.refine_element(ref_mesh.get_max_element_id() - 1);
+  H1Space ref_space(&ref_mesh, NULL, NULL, P_INIT + 1);
+  WeakForm ref_wf;
+  LinSystem ref_ls(&ref_wf, &ref_space);
+
+  int success = 1;
+  Solution sln_fine;
+  ref_ls.prolong(&sln_coarse, &sln_fine);
+  double err = h1_error(&sln_fine, &sln_coarse) * 100;
+  printf("prolongation: rel. H1 error %g%%\n", err);
+  if (err > 1e-8) success = 0;
+
+  // the other way round the meshes are not nested
+  Solution sln_back;
+  ls.prolong(&sln_fine, &sln_back);
+  err = h1_error(&sln_back, &sln_coarse) * 100;
+  printf("restriction: rel. H1 error %g%%\n", err);
+  if (err > 1e-8) success = 0;
+
+  if (success == 1) {
+    printf("Success!\n");
+    return ERROR_SUCCESS;
+  }
+  else {
+    printf("Failure!\n");
+    return ERROR_FAILURE;
+  }
+}
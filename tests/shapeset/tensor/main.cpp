@@ -0,0 +1,99 @@
+#include "hermes2d.h"
+#include "shapeset_common.h"
+#include "shapeset_tensor.h"
+
+// This test checks the recurrence-based evaluation of the quad shape functions
+// (Shapeset::get_value() and get_values()) against the generated function tables
+// for all functions, expansions and components of the H1, L2, Hcurl and Hdiv
+// shapesets built from Lobatto and Legendre polynomials.
+
+#undef ERROR_SUCCESS
+#undef ERROR_FAILURE
+#define ERROR_SUCCESS                               0
+#define ERROR_FAILURE                               -1
+
+const double TOL = 1e-12;  // maximum relative difference
+const int NP = 17;         // number of points in each direction
+
+// gives access to the generated tables of a shapeset
+template<class S>
+class TableShapeset : public S
+{
+public:
+  bool has_expansion(int n) { return this->shape_table[n] != NULL && this->shape_table[n][H2D_MODE_QUAD] != NULL; }
+  double table_value(int n, int index, double x, double y, int c)
+    { return this->shape_table[n][H2D_MODE_QUAD][c][index](x, y); }
+  int tensor_size() { return this->quad_tensor_size; }
+};
+
+template<class S>
+bool check_shapeset(const char* name)
+{
+  TableShapeset<S> ss;
+  ss.set_mode(H2D_MODE_QUAD);
+
+  double x[NP*NP], y[NP*NP], values[NP*NP];
+  for (int i = 0; i < NP; i++)
+    for (int j = 0; j < NP; j++)
+    {
+      // include the vertices and edges of the reference domain
+      x[i*NP + j] = -1.0 + 2.0 * i / (NP - 1);
+      y[i*NP + j] = -1.0 + 2.0 * j / (NP - 1) + 1e-3 * i / NP;
+    }
+
+  double max_err = 0.0;
+  int num = 0;
+  for (int n = 0; n < 6; n++)
+  {
+    if (!ss.has_expansion(n)) continue;
+    for (int c = 0; c < ss.get_num_components(); c++)
+      for (int index = 0; index < ss.tensor_size(); index++)
+      {
+        ss.get_values(n, index, NP*NP, x, y, c, values);
+        for (int k = 0; k < NP*NP; k++)
+        {
+          double ref = ss.table_value(n, index, x[k], y[k], c);
+          double scale = std::max(1.0, fabs(ref));
+          max_err = std::max(max_err, fabs(values[k] - ref) / scale);
+          max_err = std::max(max_err, fabs(ss.get_value(n, index, x[k], y[k], c) - ref) / scale);
+        }
+        num++;
+      }
+  }
+  printf("%s: %d functions and expansions, max. relative difference %g\n", name, num, max_err);
+  return num > 0 && max_err < TOL;
+}
+
+int main(int argc, char* argv[])
+{
+  bool success = true;
+  if (!check_shapeset<H1ShapesetJacobi>("H1ShapesetJacobi")) success = false;
+  if (!check_shapeset<H1ShapesetOrtho>("H1ShapesetOrtho")) success = false;
+  if (!check_shapeset<L2ShapesetLegendre>("L2ShapesetLegendre")) success = false;
+  if (!check_shapeset<HcurlShapesetLegendre>("HcurlShapesetLegendre")) success = false;
+  if (!check_shapeset<HcurlShapesetGradLeg>("HcurlShapesetGradLeg")) success = false;
+  if (!check_shapeset<HdivShapesetLegendre>("HdivShapesetLegendre")) success = false;
+
+  // the one-dimensional functions against the explicit formulas in shapeset_common.h
+  double max_err = 0.0;
+  for (int i = 0; i <= 20; i++)
+  {
+    double t = -1.0 + 0.1 * i;
+    max_err = std::max(max_err, fabs(tensor_fn_1d(10, 0, t) - l10(t)));
+    max_err = std::max(max_err, fabs(tensor_fn_1d(11, 1, t) - dl11(t)));
+    max_err = std::max(max_err, fabs(tensor_fn_1d(7, 2, t) - d2l7(t)));
+    max_err = std::max(max_err, fabs(tensor_fn_1d(0x40 | 9, 0, t) - Legendre9(t)));
+    max_err = std::max(max_err, fabs(tensor_fn_1d(0x40 | 10, 2, t) - Legendre10xx(t)) / 100.0);
+  }
+  printf("one-dimensional functions: max. difference %g\n", max_err);
+  if (max_err > TOL) success = false;
+
+  if (success) {
+    printf("Success!\n");
+    return ERROR_SUCCESS;
+  }
+  else {
+    printf("Failure!\n");
+    return ERROR_FAILURE;
+  }
+}
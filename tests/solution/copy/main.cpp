@@ -0,0 +1,120 @@
+#include "hermes2d.h"
+
+// This test checks Solution::copy(), swap() and assign(). Copies share the mesh
+// and the coefficients of the original, which must survive when the original is
+// freed, recalculated or multiplied, and must not be affected by these changes.
+
+#undef ERROR_SUCCESS
+#undef ERROR_FAILURE
+#define ERROR_SUCCESS                               0
+#define ERROR_FAILURE                               -1
+
+const double EPS = 1e-12;
+
+double SOURCE = 1.0;
+
+BCType bc_types(int marker)
+{
+  return BC_ESSENTIAL;
+}
+
+template<typename Real, typename Scalar>
+Scalar bilinear_form(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *u, Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  return int_grad_u_grad_v<Real, Scalar>(n, wt, u, v);
+}
+
+template<typename Real, typename Scalar>
+Scalar linear_form(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  return SOURCE * int_v<Real, Scalar>(n, wt, v);
+}
+
+bool success = true;
+
+void check(const char* what, bool ok)
+{
+  printf("%s: %s\n", what, ok ? "ok" : "FAILED");
+  if (!ok) success = false;
+}
+
+// the value in the middle of the domain
+double value(Solution* sln)
+{
+  return sln->get_pt_value(0.1, 0.2);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) error("Missing mesh file name parameter.");
+
+  Mesh mesh;
+  H2DReader mloader;
+  mloader.load(argv[1], &mesh);
+  mesh.refine_all_elements();
+  mesh.refine_all_elements();
+
+  H1Space space(&mesh, bc_types, NULL, 3);
+  WeakForm wf;
+  wf.add_matrix_form(callback(bilinear_form), H2D_SYM);
+  wf.add_vector_form(callback(linear_form));
+  LinSystem ls(&wf, &space);
+
+  Solution* sln = new Solution;
+  ls.assemble();
+  ls.solve(sln);
+  double v1 = value(sln);
+  printf("value: %g\n", v1);
+
+  // a copy shares the data and survives the recalculation of the original
+  Solution prev;
+  prev.copy(sln);
+  check("copy shares the mesh", prev.get_mesh() == sln->get_mesh());
+  check("copy has the same value", fabs(value(&prev) - v1) < EPS);
+  check("copy has the same number of DOFs", prev.get_num_dofs() == sln->get_num_dofs());
+
+  SOURCE = 2.0;
+  ls.assemble();
+  ls.solve(sln);
+  check("recalculated original", fabs(value(sln) - 2.0 * v1) < EPS);
+  check("copy after the recalculation", fabs(value(&prev) - v1) < EPS);
+
+  // copy of a copy, original deleted
+  Solution second;
+  second.copy(&prev);
+  Solution* third = new Solution;
+  third->copy(&prev);
+  delete sln;
+  check("copy after deleting the original", fabs(value(&prev) - v1) < EPS);
+
+  // multiplication duplicates the shared data
+  third->multiply(3.0);
+  check("multiplied copy", fabs(value(third) - 3.0 * v1) < EPS);
+  check("multiplied copy has its own mesh", third->get_mesh() != prev.get_mesh());
+  check("other copies are not multiplied", fabs(value(&prev) - v1) < EPS && fabs(value(&second) - v1) < EPS);
+
+  // swap with a constant solution
+  Solution cnst;
+  cnst.set_const(&mesh, 5.0);
+  cnst.swap(third);
+  check("swapped solution", fabs(value(&cnst) - 3.0 * v1) < EPS && fabs(value(third) - 5.0) < EPS);
+  delete third;
+  check("swapped solution after deleting the other one", fabs(value(&cnst) - 3.0 * v1) < EPS);
+
+  // assignment moves the data
+  Solution moved;
+  moved = second;
+  check("moved solution", fabs(value(&moved) - v1) < EPS && moved.get_mesh() == prev.get_mesh());
+  prev.free();
+  check("moved solution after freeing the copy", fabs(value(&moved) - v1) < EPS);
+  check("norm of the moved solution", fabs(h1_norm(&moved) - h1_norm(&moved)) == 0.0 && h1_norm(&moved) > 0.0);
+
+  if (success) {
+    printf("Success!\n");
+    return ERROR_SUCCESS;
+  }
+  else {
+    printf("Failure!\n");
+    return ERROR_FAILURE;
+  }
+}
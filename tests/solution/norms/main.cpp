@@ -0,0 +1,123 @@
+#include "hermes2d.h"
+
+using namespace RefinementSelectors;
+
+// This test makes sure that calc_norms(), which evaluates several errors and norms
+// in one traversal, gives the same values as calc_error() and calc_norm() evaluating
+// them one by one, and that h1_error() and l2_error() (which use calc_norms()) are
+// the ratios of these. The functions are the projection onto an hp-adapted mesh and
+// the exact function on the reference mesh. The per-element contributions returned
+// by calc_norms() have to sum up to the totals and the contributions of the norms
+// have to match the element integrals.
+
+#undef ERROR_SUCCESS
+#undef ERROR_FAILURE
+#define ERROR_SUCCESS                               0
+#define ERROR_FAILURE                               -1
+
+const int NUM_STEPS = 8;     // number of adaptivity steps
+const double TOL = 1e-12;    // relative tolerance
+
+scalar front(double x, double y, scalar& dx, scalar& dy)
+{
+  double t = 10.0 * (x + y);
+  dx = dy = 10.0 / (1.0 + t*t);
+  return atan(t);
+}
+
+BCType bc_types(int marker)
+{
+  return BC_NATURAL;
+}
+
+bool check(const char* name, double value, double ref)
+{
+  double err = fabs(value - ref) / std::max(fabs(ref), 1e-100);
+  printf("%s: %.15g, reference %.15g, rel. difference %g\n", name, value, ref, err);
+  return err < TOL;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) error("Missing mesh file name parameter.");
+
+  Mesh mesh;
+  H2DReader mloader;
+  mloader.load(argv[1], &mesh);
+  mesh.refine_all_elements();
+
+  H1Space space(&mesh, bc_types, NULL, 2);
+  WeakForm wf;
+  LinSystem ls(&wf, &space);
+  H1ProjBasedSelector selector(H2D_HP_ANISO, 1.0, H2DRS_DEFAULT_ORDER);
+
+  // adapt the mesh to the projection of the front
+  Solution sln, ref_sln;
+  for (int step = 0; step < NUM_STEPS; step++)
+  {
+    RefSystem rs(&ls);
+    rs.solve_exact(front, &ref_sln);
+    ls.project_global(front, &sln);
+    if (step == NUM_STEPS - 1) break;
+
+    H1Adapt hp(&ls);
+    hp.set_solutions(&sln, &ref_sln);
+    hp.calc_error();
+    hp.adapt(&selector, 0.3, 0, -1);
+  }
+  printf("elements = %d, ndof = %d\n", mesh.get_num_active_elements(), ls.get_num_dofs());
+
+  std::vector<NormIntegrand> items;
+  items.push_back(NormIntegrand(error_fn_h1, 0, 1));
+  items.push_back(NormIntegrand(norm_fn_h1, 0));
+  items.push_back(NormIntegrand(norm_fn_h1, 1));
+  items.push_back(NormIntegrand(error_fn_l2, 0, 1));
+  items.push_back(NormIntegrand(norm_fn_l2, 1));
+
+  int nc = mesh.get_max_element_id(), nf = ref_sln.get_mesh()->get_max_element_id();
+  std::vector<double> err_elem(nc), norm_elem(nc), ref_norm_elem(nf);
+  double* elem_values[5] = { &err_elem[0], &norm_elem[0], &ref_norm_elem[0], NULL, NULL };
+  double res[5];
+  calc_norms(Tuple<MeshFunction*>(&sln, &ref_sln), items, res, elem_values);
+
+  bool success = true;
+  success &= check("H1 error", res[0], calc_error(error_fn_h1, &sln, &ref_sln));
+  success &= check("H1 norm", res[1], calc_norm(norm_fn_h1, &sln));
+  success &= check("H1 norm (reference)", res[2], calc_norm(norm_fn_h1, &ref_sln));
+  success &= check("L2 error", res[3], calc_error(error_fn_l2, &sln, &ref_sln));
+  success &= check("L2 norm (reference)", res[4], calc_norm(norm_fn_l2, &ref_sln));
+  success &= check("rel. H1 error", h1_error(&sln, &ref_sln), res[0] / res[2]);
+  success &= check("rel. L2 error", l2_error(&sln, &ref_sln), res[3] / res[4]);
+
+  // per-element contributions
+  double sum_err = 0.0, sum_norm = 0.0, sum_ref_norm = 0.0, max_diff = 0.0;
+  Element* e;
+  for_all_active_elements(e, &mesh)
+  {
+    sum_err += err_elem[e->id];
+    sum_norm += norm_elem[e->id];
+    sln.set_quad_2d(&g_quad_2d_std);
+    sln.set_active_element(e);
+    update_limit_table(e->get_mode());
+    double val = norm_fn_h1(&sln, sln.get_refmap());
+    max_diff = std::max(max_diff, fabs(norm_elem[e->id] - val) / std::max(val, 1e-100));
+  }
+  for_all_active_elements(e, ref_sln.get_mesh())
+    sum_ref_norm += ref_norm_elem[e->id];
+  success &= check("sum of element H1 errors", sqrt(sum_err), res[0]);
+  success &= check("sum of element H1 norms", sqrt(sum_norm), res[1]);
+  success &= check("sum of element H1 norms (reference)", sqrt(sum_ref_norm), res[2]);
+  printf("max. rel. difference of the element H1 norms: %g\n", max_diff);
+  if (max_diff > TOL) success = false;
+
+  if (success)
+  {
+    printf("Success!\n");
+    return ERROR_SUCCESS;
+  }
+  else
+  {
+    printf("Failure!\n");
+    return ERROR_FAILURE;
+  }
+}
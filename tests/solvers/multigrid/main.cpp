@@ -0,0 +1,126 @@
+#include "hermes2d.h"
+
+// This test makes sure that the conjugate gradient method preconditioned by
+// MultigridPrecond converges in a number of iterations which does not grow
+// with the refinement of the mesh, and that it gives the correct solution.
+// An optional third argument limits the size of the coarsest level that is
+// solved directly, so that it is only smoothed.
+
+#undef ERROR_SUCCESS
+#undef ERROR_FAILURE
+#define ERROR_SUCCESS                               0
+#define ERROR_FAILURE                               -1
+
+const int NUM_REF = 5;       // number of uniform refinements of the finest mesh
+const int MAX_ITERS = 40;    // maximum allowed number of PCG iterations
+
+// exact solution of -Laplace u = f with zero Dirichlet boundary conditions
+scalar exact(double x, double y, scalar& dx, scalar& dy)
+{
+  dx = M_PI * cos(M_PI*x) * sin(M_PI*y);
+  dy = M_PI * sin(M_PI*x) * cos(M_PI*y);
+  return sin(M_PI*x) * sin(M_PI*y);
+}
+
+BCType bc_types(int marker)
+{
+  return BC_ESSENTIAL;
+}
+
+scalar bc_values(int marker, double x, double y)
+{
+  return 0;
+}
+
+template<typename Real, typename Scalar>
+Scalar bilinear_form(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *u, Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  return int_grad_u_grad_v<Real, Scalar>(n, wt, u, v);
+}
+
+template<typename Real>
+Real rhs(Real x, Real y)
+{
+  return 2 * M_PI * M_PI * sin(M_PI*x) * sin(M_PI*y);
+}
+
+template<typename Real, typename Scalar>
+Scalar linear_form(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  return int_F_v<Real, Scalar>(n, wt, rhs, v, e);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 3)
+  {
+    printf("please input as this format: solvers-multigrid meshfile.mesh order [max_direct_size]\n");
+    return ERROR_FAILURE;
+  }
+  int p_init = atoi(argv[2]);
+  int max_direct_size = (argc > 3) ? atoi(argv[3]) : 2000;
+
+  Mesh mesh;
+  H2DReader mloader;
+  mloader.load(argv[1], &mesh);
+  mesh.refine_all_elements();
+
+  WeakForm wf;
+  wf.add_matrix_form(callback(bilinear_form));
+  wf.add_vector_form(callback(linear_form));
+
+  Solution sln, ex;
+  ex.set_exact(&mesh, exact);
+
+  bool success = true;
+  int min_iters = 1000000, max_iters = 0;
+  double last_err = 1e100;
+  for (int ref = 1; ref <= NUM_REF; ref++)
+  {
+    // uniform refinement plus a corner refinement producing hanging nodes
+    mesh.refine_all_elements();
+    mesh.refine_element(mesh.get_max_element_id() - 1);
+
+    H1Space space(&mesh, bc_types, bc_values, p_init);
+    CommonSolverCG cg;
+    LinSystem ls(&wf, &cg, &space);
+    ls.assemble();
+
+    MultigridPrecond mg;
+    mg.set_coarse_size(50);
+    mg.set_num_threads(2);
+    mg.set_max_direct_size(max_direct_size);
+    mg.create(&ls);
+    cg.set_precond(&mg);
+    ls.solve(&sln);
+
+    int iters = cg.get_num_iters();
+    double err = h1_error(&sln, &ex) / h1_norm(&ex) * 100;
+    printf("ndof = %d, levels = %d, PCG iterations = %d, H1 error = %g%%\n",
+           ls.get_num_dofs(), mg.get_num_levels(), iters, err);
+
+    // the solution must converge with the refinement
+    if (err > last_err) success = false;
+    last_err = err;
+
+    if (mg.get_num_levels() > 1)
+    {
+      min_iters = std::min(min_iters, iters);
+      max_iters = std::max(max_iters, iters);
+    }
+  }
+
+  // mesh-independent convergence
+  if (max_iters > MAX_ITERS || max_iters > 2 * min_iters) success = false;
+
+  if (success)
+  {
+    printf("Success!\n");
+    return ERROR_SUCCESS;
+  }
+  else
+  {
+    printf("Failure!\n");
+    return ERROR_FAILURE;
+  }
+}
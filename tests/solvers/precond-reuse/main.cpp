@@ -0,0 +1,99 @@
+#include "hermes2d.h"
+
+// This test makes sure that a preconditioner with a reuse policy is rebuilt when
+// the Epetra matrix it was created for is preallocated (and thus reallocated)
+// again between two solves, and that it is kept when the graph is static.
+
+#undef ERROR_SUCCESS
+#undef ERROR_FAILURE
+#define ERROR_SUCCESS                               0
+#define ERROR_FAILURE                               -1
+
+const int N = 200;           // size of the 1D Laplace matrix
+const double TOL = 1e-6;     // tolerance on the solution
+
+// assembles c * tridiag(-1, 2, -1) and the right-hand side for the solution x = 1
+void assemble(EpetraMatrix &m, EpetraVector &rhs, double c)
+{
+  m.prealloc(N);
+  for (int i = 0; i < N; i++)
+    for (int j = std::max(i - 1, 0); j <= std::min(i + 1, N - 1); j++)
+      m.pre_add_ij(i, j);
+  m.alloc();
+  rhs.alloc(N);
+
+  for (int i = 0; i < N; i++)
+  {
+    m.add(i, i, 2.0 * c);
+    if (i > 0) m.add(i, i - 1, -c);
+    if (i < N - 1) m.add(i, i + 1, -c);
+  }
+  m.finish();
+  rhs.add(0, c);
+  rhs.add(N - 1, c);
+}
+
+bool solve(EpetraMatrix &m, EpetraVector &rhs, Precond *pc)
+{
+  AztecOOSolver aztec(m, rhs);
+  aztec.set_solver("cg");
+  aztec.set_tolerance(1e-10);
+  aztec.set_max_iters(1000);
+  aztec.set_precond(pc);
+  if (!aztec.solve()) return false;
+
+  scalar *sln = aztec.get_solution_vector();
+  double err = 0.0;
+  for (int i = 0; i < N; i++) err = std::max(err, std::abs(sln[i] - 1.0));
+  printf("iterations = %d, error = %g\n", aztec.get_num_iters(), err);
+  return err < TOL;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    printf("please input as this format: solvers-precond-reuse ml|ifpack\n");
+    return ERROR_FAILURE;
+  }
+
+  Precond *pc;
+  if (strcmp(argv[1], "ml") == 0) pc = new MlPrecond("sa");
+  else pc = new IfpackPrecond("point-relax", "Jacobi");
+  pc->set_reuse_policy(PC_REUSE_STRUCTURE);
+
+  bool success = true;
+  EpetraMatrix m;
+  EpetraVector rhs;
+
+  // the second prealloc() destroys the matrix the preconditioner was built on
+  assemble(m, rhs, 1.0);
+  unsigned seq = m.get_structure_seq();
+  if (!solve(m, rhs, pc)) success = false;
+  assemble(m, rhs, 2.0);
+  if (m.get_structure_seq() == seq) success = false;
+  if (!solve(m, rhs, pc)) success = false;
+
+  // with a static graph the matrix survives and the preconditioner is only updated
+  m.set_static_graph(true);
+  assemble(m, rhs, 3.0);
+  seq = m.get_structure_seq();
+  if (!solve(m, rhs, pc)) success = false;
+  assemble(m, rhs, 4.0);
+  if (m.get_structure_seq() != seq) success = false;
+  if (!solve(m, rhs, pc)) success = false;
+  m.set_static_graph(false);
+
+  delete pc;
+
+  if (success)
+  {
+    printf("Success!\n");
+    return ERROR_SUCCESS;
+  }
+  else
+  {
+    printf("Failure!\n");
+    return ERROR_FAILURE;
+  }
+}
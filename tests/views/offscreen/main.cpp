@@ -0,0 +1,140 @@
+#include "hermes2d.h"
+
+// This test renders a linear function and the polynomial orders of a space
+// with OffscreenView and checks that:
+// 1. the result does not depend on the number of rasterizer threads,
+// 2. the whole domain is covered by triangles and the colors follow the values,
+// 3. the elements have the colors of their orders,
+// 4. BMP and PNG files (also written asynchronously) have the expected size.
+
+#undef ERROR_SUCCESS
+#undef ERROR_FAILURE
+#define ERROR_SUCCESS                               0
+#define ERROR_FAILURE                               -1
+
+const int WIDTH = 200, HEIGHT = 160;
+
+scalar exact(double x, double y, scalar& dx, scalar& dy)
+{
+  dx = 1.0;
+  dy = 0.0;
+  return x + 1.0;
+}
+
+BCType bc_types(int marker)
+{
+  return BC_NATURAL;
+}
+
+// the square (-1,1)^2 is fitted into the framebuffer with a margin of 5%
+void to_pixel(double x, double y, int& i, int& j)
+{
+  double scale = 0.9 * HEIGHT / 2.0;
+  i = (int) floor(0.5 * WIDTH + x * scale);
+  j = (int) floor(0.5 * HEIGHT - y * scale);
+}
+
+const unsigned char* pixel(OffscreenView& view, int i, int j)
+{
+  return view.get_pixels() + 3 * (j * view.get_width() + i);
+}
+
+long file_size(const char* filename)
+{
+  FILE* f = fopen(filename, "rb");
+  if (f == NULL) return -1;
+  fseek(f, 0, SEEK_END);
+  long size = ftell(f);
+  fclose(f);
+  return size;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) error("Missing mesh file name parameter.");
+
+  Mesh mesh;
+  H2DReader mloader;
+  mloader.load(argv[1], &mesh);
+  mesh.refine_all_elements();
+  mesh.refine_all_elements();
+
+  Solution sln;
+  sln.set_exact(&mesh, exact);
+  Linearizer lin;
+  lin.process_solution(&sln);
+
+  bool success = true;
+
+  // 1. serial and parallel rasterization give the same image
+  OffscreenView view1(WIDTH, HEIGHT, 1), view4(WIDTH, HEIGHT, 4);
+  view1.show_contours(0.25);
+  view4.show_contours(0.25);
+  view1.show_edges(true);
+  view4.show_edges(true);
+  view1.render_scalar(&lin);
+  view4.render_scalar(&lin);
+  if (memcmp(view1.get_pixels(), view4.get_pixels(), 3 * WIDTH * HEIGHT) != 0) {
+    printf("Serial and parallel images differ.\n");
+    success = false;
+  }
+
+  // 2. grayscale image without lines: the gray level is proportional to x + 1
+  OffscreenView view(WIDTH, HEIGHT);
+  view.set_palette(H2DV_PT_GRAYSCALE);
+  view.set_num_palette_steps(256);
+  view.set_background_color(1.0f, 0.0f, 0.0f);
+  view.show_edges(false);
+  view.render_scalar(&lin);
+  int i0, j0, i1, j1, i, j;
+  to_pixel(-1.0, 1.0, i0, j0);
+  to_pixel(1.0, -1.0, i1, j1);
+  int max_diff = 0, uncovered = 0;
+  for (j = j0 + 2; j < j1 - 2; j++)
+    for (i = i0 + 2; i < i1 - 2; i++)
+    {
+      const unsigned char* px = pixel(view, i, j);
+      if (px[0] != px[1] || px[1] != px[2]) { uncovered++; continue; }
+      double x = (i + 0.5 - 0.5 * WIDTH) / (0.9 * HEIGHT / 2.0);
+      int expected = (int) floor((x + 1.0) / 2.0 * 256);
+      max_diff = std::max(max_diff, abs((int) px[0] - std::min(255, expected)));
+    }
+  printf("uncovered pixels: %d, max. gray level difference: %d\n", uncovered, max_diff);
+  if (uncovered > 0 || max_diff > 2) success = false;
+
+  // 3. polynomial orders
+  H1Space space(&mesh, bc_types, NULL, 3);
+  view.set_palette(H2DV_PT_DEFAULT);
+  view.show(&space);
+  to_pixel(-0.75, -0.75, i, j);
+  const unsigned char* px = pixel(view, i, j);
+  if (px[0] != 0x2a || px[1] != 0x7f || px[2] != 0xff) {
+    printf("Wrong color of order 3: %02x%02x%02x\n", px[0], px[1], px[2]);
+    success = false;
+  }
+
+  // 4. output files
+  view.save_image("offscreen_test.bmp");
+  view.save_image("offscreen_test.png", true);
+  view.save_numbered("offscreen_test_%d.bmp", 1, true);
+  view.wait_for_writes();
+  long bmp_size = 54 + ((3 * WIDTH + 3) & ~3) * HEIGHT;
+  long png_size = 8 + 25 + 12 + 2 + (3 * WIDTH + 1) * HEIGHT + 5 * ((3 * WIDTH + 1) * HEIGHT / 65535 + 1) + 4 + 12;
+  printf("file sizes: %ld %ld %ld\n", file_size("offscreen_test.bmp"), file_size("offscreen_test.png"),
+         file_size("offscreen_test_1.bmp"));
+  if (file_size("offscreen_test.bmp") != bmp_size || file_size("offscreen_test_1.bmp") != bmp_size
+      || file_size("offscreen_test.png") != png_size)
+    success = false;
+  remove("offscreen_test.bmp");
+  remove("offscreen_test.png");
+  remove("offscreen_test_1.bmp");
+
+  if (success) {
+    printf("Success!\n");
+    return ERROR_SUCCESS;
+  }
+  else {
+    printf("Failure!\n");
+    return ERROR_FAILURE;
+  }
+}
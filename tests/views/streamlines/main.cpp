@@ -0,0 +1,107 @@
+#include "hermes2d.h"
+
+// This test traces streamlines of the rotation field (-y, x) with StreamTracer.
+// The streamlines are arcs of circles centered at the origin; the test checks
+// that the radius is preserved, that serial and parallel tracing give the same
+// polylines, and that the point locator agrees with a brute force search.
+
+#undef ERROR_SUCCESS
+#undef ERROR_FAILURE
+#define ERROR_SUCCESS                               0
+#define ERROR_FAILURE                               -1
+
+const double TOL = 1e-3;  // maximum relative change of the radius along a streamline
+
+scalar vx(double x, double y, scalar& dx, scalar& dy)
+{
+  dx = 0.0; dy = -1.0;
+  return -y;
+}
+
+scalar vy(double x, double y, scalar& dx, scalar& dy)
+{
+  dx = 1.0; dy = 0.0;
+  return x;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) error("Missing mesh file name parameter.");
+
+  Mesh mesh;
+  H2DReader mloader;
+  mloader.load(argv[1], &mesh);
+  for (int i = 0; i < 4; i++)
+    mesh.refine_all_elements();
+
+  Solution xsln, ysln;
+  xsln.set_exact(&mesh, vx);
+  ysln.set_exact(&mesh, vy);
+  Vectorizer vec;
+  vec.process_solution(&xsln, H2D_FN_VAL_0, &ysln, H2D_FN_VAL_0, H2D_EPS_NORMAL);
+
+  bool success = true;
+  StreamTracer serial(1), parallel(4);
+  serial.init(&vec);
+  parallel.init(&vec);
+
+  // seeds along the bottom edge (marker 1)
+  double2* seeds;
+  int num = serial.find_seeds(1, 0.1, seeds);
+  printf("number of streamlines: %d\n", num);
+  if (num != 19) success = false;
+
+  double2** lines1 = new double2*[num];
+  double2** lines4 = new double2*[num];
+  int* len1 = new int[num];
+  int* len4 = new int[num];
+  serial.create_streamlines(num, seeds, lines1, len1);
+  parallel.create_streamlines(num, seeds, lines4, len4);
+
+  double max_err = 0.0;
+  int total = 0, i, j;
+  for (i = 0; i < num; i++)
+  {
+    if (len1[i] != len4[i] || memcmp(lines1[i], lines4[i], len1[i] * sizeof(double2)) != 0) {
+      printf("Streamline %d differs in serial and parallel tracing.\n", i);
+      success = false;
+    }
+    double r0 = sqrt(sqr(seeds[i][0]) + sqr(seeds[i][1]));
+    for (j = 0; j < len1[i]; j++)
+      max_err = std::max(max_err, fabs(sqrt(sqr(lines1[i][j][0]) + sqr(lines1[i][j][1])) - r0) / r0);
+    total += len1[i];
+    delete [] lines1[i];
+    delete [] lines4[i];
+  }
+  printf("points: %d, max. relative radius error: %g\n", total, max_err);
+  if (total < 10 * num || max_err > TOL) success = false;
+
+  // point location with and without a hint
+  int mismatch = 0;
+  for (i = 0; i < 1000; i++)
+  {
+    double x = -1.2 + 2.4 * ((i * 7919) % 1000) / 1000.0;
+    double y = -1.2 + 2.4 * ((i * 104729) % 997) / 997.0;
+    double3 bar;
+    int found = serial.find_triangle(x, y, bar, i % serial.get_num_triangles());
+    bool inside = fabs(x) <= 1.0 && fabs(y) <= 1.0;
+    if ((found >= 0) != inside) mismatch++;
+  }
+  printf("point location mismatches: %d\n", mismatch);
+  if (mismatch > 0) success = false;
+
+  delete [] seeds;
+  delete [] lines1;
+  delete [] lines4;
+  delete [] len1;
+  delete [] len4;
+
+  if (success) {
+    printf("Success!\n");
+    return ERROR_SUCCESS;
+  }
+  else {
+    printf("Failure!\n");
+    return ERROR_FAILURE;
+  }
+}
@@ -0,0 +1,152 @@
+#include "hermes2d.h"
+
+// This test makes sure that forms given as text (WeakForm::add_matrix_form(const char*),
+// add_vector_form(const char*)) assemble to the same matrix and right-hand side as the
+// equivalent forms given by callbacks, including surface forms and named constants.
+
+#undef ERROR_SUCCESS
+#undef ERROR_FAILURE
+#define ERROR_SUCCESS                               0
+#define ERROR_FAILURE                               -1
+
+const double TOL = 1e-12;
+
+double K = 3.0;   // the constant "k" of the text forms
+
+BCType bc_types(int marker)
+{
+  return (marker == 1) ? BC_ESSENTIAL : BC_NATURAL;
+}
+
+scalar bc_values(int marker, double x, double y)
+{
+  return x*x + y;
+}
+
+// (1 + x^2) ux vx + uy vy + k u v - 0.5 u vx
+template<typename Real, typename Scalar>
+Scalar bilinear_form(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *u, Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  Scalar result = 0;
+  for (int i = 0; i < n; i++)
+    result += wt[i] * ((1 + e->x[i]*e->x[i]) * u->dx[i] * v->dx[i] + u->dy[i] * v->dy[i]
+                       + K * u->val[i] * v->val[i] - 0.5 * u->val[i] * v->dx[i]);
+  return result;
+}
+
+// k u v on the boundary with marker 2
+template<typename Real, typename Scalar>
+Scalar bilinear_form_surf(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *u, Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  return K * int_u_v<Real, Scalar>(n, wt, u, v);
+}
+
+// (x*y - 2)^3 v / 4
+template<typename Real, typename Scalar>
+Scalar linear_form(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  Scalar result = 0;
+  for (int i = 0; i < n; i++)
+  {
+    Real t = e->x[i] * e->y[i] - 2;
+    result += wt[i] * t * t * t * v->val[i] / 4;
+  }
+  return result;
+}
+
+// (nx + 2 ny) v on the boundary with marker 3
+template<typename Real, typename Scalar>
+Scalar linear_form_surf(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  Scalar result = 0;
+  for (int i = 0; i < n; i++)
+    result += wt[i] * (e->nx[i] + 2 * e->ny[i]) * v->val[i];
+  return result;
+}
+
+// returns the maximum difference of the matrices and right-hand sides
+double compare(LinSystem& ls1, LinSystem& ls2)
+{
+  int *Ap1, *Ai1, *Ap2, *Ai2, n1, n2;
+  scalar *Ax1, *Ax2, *rhs1, *rhs2;
+  ls1.get_matrix(Ap1, Ai1, Ax1, n1);
+  ls2.get_matrix(Ap2, Ai2, Ax2, n2);
+  if (n1 != n2 || Ap1[n1] != Ap2[n2]) return 1e100;
+
+  double diff = 0.0;
+  for (int i = 0; i < Ap1[n1]; i++)
+  {
+    if (Ai1[i] != Ai2[i]) return 1e100;
+    diff = std::max(diff, (double) std::abs(Ax1[i] - Ax2[i]));
+  }
+  ls1.get_rhs(rhs1, n1);
+  ls2.get_rhs(rhs2, n2);
+  for (int i = 0; i < n1; i++)
+    diff = std::max(diff, (double) std::abs(rhs1[i] - rhs2[i]));
+  return diff;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 3)
+  {
+    printf("please input as this format: weakform-dsl meshfile.mesh order\n");
+    return ERROR_FAILURE;
+  }
+  int p_init = atoi(argv[2]);
+
+  Mesh mesh;
+  H2DReader mloader;
+  mloader.load(argv[1], &mesh);
+  mesh.refine_all_elements();
+  mesh.refine_all_elements();
+  mesh.refine_element(mesh.get_max_element_id() - 1);
+
+  H1Space space(&mesh, bc_types, bc_values, p_init);
+
+  // forms given by callbacks
+  WeakForm wf1;
+  wf1.add_matrix_form(callback(bilinear_form));
+  wf1.add_matrix_form_surf(callback(bilinear_form_surf), 2);
+  wf1.add_vector_form(callback(linear_form));
+  wf1.add_vector_form_surf(callback(linear_form_surf), 3);
+
+  // the same forms given as text
+  WeakForm wf2;
+  wf2.set_constant("k", K);
+  wf2.add_matrix_form("vol u,v: (1 + x^2)*ux*vx + u_y*v_y + k*u*v - u*vx/2");
+  wf2.add_matrix_form("surf phi,psi: k*phi*psi", H2D_UNSYM, 2);
+  wf2.add_vector_form("vol v: (x*y - 2)^3 * v / 4");
+  wf2.add_vector_form("surf w: (nx + 2*ny)*w", 3);
+
+  CommonSolverCG solver;
+  LinSystem ls1(&wf1, &solver, &space);
+  LinSystem ls2(&wf2, &solver, &space);
+
+  bool success = true;
+  ls1.assemble();
+  ls2.assemble();
+  double diff = compare(ls1, ls2);
+  printf("ndof = %d, difference = %g\n", ls1.get_num_dofs(), diff);
+  if (diff > TOL) success = false;
+
+  // changing a constant affects the next assembly
+  K = 5.0;
+  wf2.set_constant("k", K);
+  ls1.assemble();
+  ls2.assemble();
+  diff = compare(ls1, ls2);
+  printf("k = %g, difference = %g\n", K, diff);
+  if (diff > TOL) success = false;
+
+  if (success)
+  {
+    printf("Success!\n");
+    return ERROR_SUCCESS;
+  }
+  else
+  {
+    printf("Failure!\n");
+    return ERROR_FAILURE;
+  }
+}
@@ -0,0 +1,156 @@
+#include "hermes2d.h"
+
+// This test makes sure that LinSystem::calibrate_orders() lowers the integration orders
+// of forms with transcendental coefficients (for which the automatic order is the maximum
+// one), that the system assembled with the calibrated orders agrees with the original one
+// within the tolerance, and that the calibration can be saved and loaded.
+
+#undef ERROR_SUCCESS
+#undef ERROR_FAILURE
+#define ERROR_SUCCESS                               0
+#define ERROR_FAILURE                               -1
+
+const int P_INIT = 3;
+const double TOL = 1e-10;
+
+BCType bc_types(int marker)
+{
+  return (marker == 1) ? BC_ESSENTIAL : BC_NATURAL;
+}
+
+scalar bc_values(int marker, double x, double y)
+{
+  return 0;
+}
+
+template<typename Real>
+Real coef(Real x, Real y)
+{
+  return 2.0 + sin(x) * cos(y);
+}
+
+template<typename Real, typename Scalar>
+Scalar bilinear_form(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *u, Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  Scalar result = 0;
+  for (int i = 0; i < n; i++)
+    result += wt[i] * (coef(e->x[i], e->y[i]) * (u->dx[i] * v->dx[i] + u->dy[i] * v->dy[i])
+                       + exp(e->x[i]) * u->val[i] * v->val[i]);
+  return result;
+}
+
+template<typename Real, typename Scalar>
+Scalar linear_form(int n, double *wt, Func<Scalar> *u_ext[], Func<Real> *v, Geom<Real> *e, ExtData<Scalar> *ext)
+{
+  Scalar result = 0;
+  for (int i = 0; i < n; i++)
+    result += wt[i] * log(3.0 + e->x[i] + e->y[i]) * v->val[i];
+  return result;
+}
+
+// maximum difference of the matrices and right-hand sides, relative to the largest entry
+double compare(LinSystem& ls1, LinSystem& ls2)
+{
+  int *Ap1, *Ai1, *Ap2, *Ai2, n1, n2;
+  scalar *Ax1, *Ax2, *rhs1, *rhs2;
+  ls1.get_matrix(Ap1, Ai1, Ax1, n1);
+  ls2.get_matrix(Ap2, Ai2, Ax2, n2);
+  if (n1 != n2 || Ap1[n1] != Ap2[n2]) return 1e100;
+
+  double diff = 0.0, scale = 0.0;
+  for (int i = 0; i < Ap1[n1]; i++)
+  {
+    diff = std::max(diff, (double) std::abs(Ax1[i] - Ax2[i]));
+    scale = std::max(scale, (double) std::abs(Ax1[i]));
+  }
+  ls1.get_rhs(rhs1, n1);
+  ls2.get_rhs(rhs2, n2);
+  for (int i = 0; i < n1; i++)
+  {
+    diff = std::max(diff, (double) std::abs(rhs1[i] - rhs2[i]));
+    scale = std::max(scale, (double) std::abs(rhs1[i]));
+  }
+  return diff / scale;
+}
+
+// reads the offsets written by WeakForm::save_order_offsets()
+void read_offsets(const char* filename, std::vector<int>& offsets)
+{
+  char line[256], type[16];
+  int idx, offset;
+  FILE* f = fopen(filename, "r");
+  if (f == NULL) return;
+  while (fgets(line, sizeof(line), f) != NULL)
+    if (line[0] != '#' && sscanf(line, "%15s %d %d", type, &idx, &offset) == 3)
+      offsets.push_back(offset);
+  fclose(f);
+}
+
+int main(int argc, char* argv[])
+{
+  Mesh mesh;
+  H2DReader mloader;
+  mloader.load("square.mesh", &mesh);
+  for (int i = 0; i < 3; i++) mesh.refine_all_elements();
+
+  H1Space space(&mesh, bc_types, bc_values, P_INIT);
+
+  WeakForm wf1, wf2, wf3;
+  WeakForm* wfs[3] = { &wf1, &wf2, &wf3 };
+  for (int i = 0; i < 3; i++)
+  {
+    wfs[i]->add_matrix_form(callback(bilinear_form));
+    wfs[i]->add_vector_form(callback(linear_form));
+  }
+
+  CommonSolverCG solver;
+  LinSystem ls1(&wf1, &solver, &space);
+  LinSystem ls2(&wf2, &solver, &space);
+  LinSystem ls3(&wf3, &solver, &space);
+
+  bool success = true;
+
+  // automatic orders
+  TimePeriod cpu_time;
+  ls1.assemble();
+  double t1 = cpu_time.tick().last();
+
+  // calibrated orders
+  ls2.calibrate_orders(TOL, 5);
+  cpu_time.tick();
+  ls2.assemble();
+  double t2 = cpu_time.tick().last();
+  double diff = compare(ls1, ls2);
+  printf("assembly time: automatic %g s, calibrated %g s\n", t1, t2);
+  printf("relative difference = %g\n", diff);
+  if (diff > 100 * TOL) success = false;
+
+  std::vector<int> offsets;
+  wf2.save_order_offsets("order_offsets.txt");
+  read_offsets("order_offsets.txt", offsets);
+  printf("offsets:");
+  for (unsigned i = 0; i < offsets.size(); i++) printf(" %d", offsets[i]);
+  printf("\n");
+  if (offsets.size() != 2) success = false;
+  for (unsigned i = 0; i < offsets.size(); i++)
+    if (offsets[i] >= 0) success = false;
+
+  // loaded calibration gives the same system
+  wf3.load_order_offsets("order_offsets.txt");
+  ls3.assemble();
+  diff = compare(ls2, ls3);
+  printf("difference after loading = %g\n", diff);
+  if (diff != 0.0) success = false;
+  remove("order_offsets.txt");
+
+  if (success)
+  {
+    printf("Success!\n");
+    return ERROR_SUCCESS;
+  }
+  else
+  {
+    printf("Failure!\n");
+    return ERROR_FAILURE;
+  }
+}
@@ -187,7 +187,7 @@ int main(int argc, char* argv[])
     // Set initial condition for the Newton's method on the fine mesh.
     if (as == 1) {
       info("Projecting coarse mesh solution to obtain initial vector on new fine mesh.");
-      rnls.project_global(&sln_coarse, &u_prev);
+      rnls.prolong(&sln_coarse, &u_prev);
     }
     else {
       info("Projecting fine mesh solution to obtain initial vector on new fine mesh.");